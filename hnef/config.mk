@@ -76,13 +76,15 @@ PREFIX_X11_LIB=                /usr/X11R6/lib
 #                                Depends: HT_AI_MINIMAX.
 # HT_AI_MINIMAX_HASH                AI transposition table (hashing).
 #                                Depends: HT_AI_MINIMAX.
-# HT_AI_MINIMAX_HASH_MEM_TAB        AI hash memory for hash table.
-#                                Depends: HT_AI_MINIMAX_HASH.
-# HT_AI_MINIMAX_HASH_MEM_COL        AI hash memory for collision lists.
+# HT_AI_MINIMAX_HASH_MEM_TAB        Default AI hash memory for hash table.
 #                                Depends: HT_AI_MINIMAX_HASH.
+# HT_AI_MINIMAX_HASH_HUGE        Hash table in huge pages, if available.
+#                                Depends: HT_AI_MINIMAX_HASH, HT_POSIX.
 # HT_UI_CLI                        Command line interface.
 # HT_UI_XLIB                        XLib interface.
 #                                Depends: LIB_XLIB.
+# HT_UI_ENGINE                        Engine protocol interface.
+#                                Depends: HT_AI_MINIMAX.
 ########################################################################
 MACRO_C99=                        -DHT_C99
 MACRO_POSIX=                        -DHT_POSIX
@@ -90,11 +92,12 @@ MACRO_POSIX=                        -DHT_POSIX
 MACRO_AI_MINIMAX=                -DHT_AI_MINIMAX
 #MACRO_AI_MINIMAX_UNSAFE=        -DHT_AI_MINIMAX_UNSAFE
 MACRO_AIM_HASH=                        -DHT_AI_MINIMAX_HASH
-MACRO_AIM_HASH_MEM_TAB=                -DHT_AI_MINIMAX_HASH_MEM_TAB=32000000
-MACRO_AIM_HASH_MEM_COL=                -DHT_AI_MINIMAX_HASH_MEM_COL=48000000
+MACRO_AIM_HASH_MEM_TAB=                -DHT_AI_MINIMAX_HASH_MEM_TAB=67108864
+MACRO_AIM_HASH_HUGE=                -DHT_AI_MINIMAX_HASH_HUGE
 MACRO_UI_CLI=                        -DHT_UI_CLI
 MACRO_UI_XLIB=                        -DHT_UI_XLIB
 MACRO_UI_MSQU=                        -DHT_UI_MSQU
+MACRO_UI_ENGINE=                      -DHT_UI_ENGINE
 MACROS=                                -DHT_VERSION=$(VERSION)\
                                 -DHT_FILE_RC_DEF=\"$(FILE_RC)\"\
 -DHT_FILE_RULE_DEF=\"$(PREFIX_DATA_RULES_CONF)/$(FILE_RULE_DEF)\"\
@@ -102,9 +105,24 @@ MACROS=                                -DHT_VERSION=$(VERSION)\
                                 $(MACRO_UNSAFE) $(MACRO_AI_MINIMAX)\
                                 $(MACRO_AI_MINIMAX_UNSAFE)\
                                 $(MACRO_UI_MSQU)
-                                #$(MACRO_UI_CLI) $(MACRO_UI_XLIB) 
+                                #$(MACRO_UI_CLI) $(MACRO_UI_XLIB) $(MACRO_UI_ENGINE)
                                 
 
+########################################################################
+# Preprocessor macros for `make bench`.
+#
+# The benchmark needs a native build with the computer player, so it
+# does not use `$(MACROS)` (which may select HT_UI_MSQU). The rulesets
+# are read from `rules/` in the source tree.
+########################################################################
+MACROS_BENCH=                        -DHT_VERSION=$(VERSION)\
+                                -DHT_FILE_RC_DEF=\"$(FILE_RC)\"\
+-DHT_FILE_RULE_DEF=\"$(PREFIX_DATA_RULES_CONF)/$(FILE_RULE_DEF)\"\
+                                $(MACRO_C99) $(MACRO_POSIX)\
+                                $(MACRO_AI_MINIMAX) $(MACRO_AIM_HASH)\
+                                $(MACRO_AIM_HASH_MEM_TAB)\
+                                $(MACRO_AIM_HASH_HUGE) $(MACRO_UI_CLI)
+
 ########################################################################
 # Libraries.
 #
@@ -151,6 +169,8 @@ LIBS=                $(LIB_C) $(LIB_XLIB) -lpthread
 # -Wframe-larger-than changed from 128 to 256 for O3.
 #
 # When not using HT_C99 or HT_POSIX, you can compile with -std=c89.
+# Without HT_C99, 64-bit keys use unsigned long if it has 64 bits,
+# else GCC's unsigned long long.
 # When not using HT_POSIX, you can compile with -std=c99.
 # When using HT_C99 and HT_POSIX, you should compile with std=gnu99, or
 # it will not find `symlink` in `unistd.h`.
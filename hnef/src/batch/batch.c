@@ -0,0 +1,1118 @@
+/* Copyright 2013 Alexander Söderlund.
+ *
+ * This file is part of HNEFATAFL.
+ *
+ * HNEFATAFL is free software: you can distribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * HNEFATAFL is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HT_AI_MINIMAX
+
+#include <stdio.h>	/* fopen, fclose, printf, fprintf, stderr */
+#include <stdlib.h>	/* malloc, realloc, free */
+#include <string.h>	/* strcmp, strlen, strcpy */
+
+#ifdef HT_POSIX
+#include <pthread.h>	/* pthread_* */
+#include <unistd.h>	/* sysconf */
+#endif
+
+#include "aimalgo.h"	/* aiminimax_command */
+#include "aiminimax.h"	/* alloc_aiminimax_init, free_aiminimax */
+#include "batch.h"
+#include "board.h"	/* game_over */
+#include "func.h"	/* fail_rreader_what */
+#include "game.h"	/* alloc_game_share, free_game */
+#include "grecord.h"	/* grecord_read, grecord_replay */
+#include "invoct.h"	/* invoc */
+#include "iogen.h"	/* print_err_fr_rreader */
+#include "iotextparse.h"	/* alloc_ht_line, ht_line_readtext */
+#include "lang.h"	/* HT_L_* */
+#include "listm.h"	/* alloc_listm, free_listm, listm_reserve */
+#include "num.h"	/* texttoushort, texttoulong */
+#include "playert.h"	/* HT_PLAYER_UNINIT */
+#include "rcache.h"	/* alloc_game_rcache */
+#include "rvalid.h"	/* ruleset_valid */
+#include "timer.h"	/* ht_timer_ms */
+#include "ui.h"		/* ui_action_init */
+#include "uit.h"	/* ui, ui_action */
+
+/*
+ * Default search depth.
+ */
+/*@unchecked@*/
+static
+const unsigned short HT_BATCH_DEPTH_DEF		= (unsigned short)4;
+
+/*
+ * Default capacity of the move lists.
+ */
+/*@unchecked@*/
+static
+const size_t HT_BATCH_LIST_CAP_DEF		= (size_t)80;
+
+/*
+ * Player 0 and 1, who have a computer player each in every worker.
+ */
+#define HT_BATCH_SIDES 2
+
+/*
+ * A game record in the batch file, and the positions in it to analyze.
+ */
+struct batch_record
+{
+
+/*@only@*/
+/*@notnull@*/
+	char *		file;
+
+	/*
+	 * The moves of the record, or NULL before it's read.
+	 */
+/*@only@*/
+/*@null@*/
+	struct listm *	moves;
+
+	/*
+	 * If all, every position in the record is analyzed, except the
+	 * last one if the game is over. Else only the position after
+	 * ply moves.
+	 */
+	HT_BOOL		all;
+
+	size_t		ply;
+
+	/*
+	 * Positions to analyze, which are the positions after first,
+	 * first + 1, ..., first + posc - 1 moves.
+	 */
+	size_t		first;
+
+	size_t		posc;
+
+};
+
+/*
+ * Settings read from the batch file.
+ */
+struct batch_conf
+{
+
+	/*
+	 * Maximum search depth.
+	 */
+	unsigned short		depth;
+
+	/*
+	 * If not 0, every position is searched one depth deeper at a
+	 * time until time milliseconds have passed, or until depth is
+	 * reached. The depth that was started is always completed.
+	 */
+	unsigned long		time;
+
+	/*
+	 * Amount of positions searched at the same time, or 0 for one
+	 * per processor.
+	 */
+	unsigned short		threads;
+
+/*@only@*/
+/*@null@*/
+	struct batch_record *	records;
+
+	size_t			recordc;
+
+	/*
+	 * Length of records.
+	 */
+	size_t			recordcap;
+
+};
+
+/*
+ * State shared by all workers. Guarded by mutex with HT_POSIX.
+ */
+struct batch
+{
+
+/*@dependent@*/
+/*@notnull@*/
+	const struct batch_conf *	conf;
+
+	/*
+	 * Record and position (an index from 0 to its posc) of the next
+	 * position to analyze.
+	 */
+	size_t				rec;
+
+	size_t				pos;
+
+	/*
+	 * Set when a worker has failed. No more positions are started.
+	 */
+	HT_BOOL				stop;
+
+	/*
+	 * First failure of a worker.
+	 */
+	enum HT_FR			fr;
+
+#ifdef HT_POSIX
+	pthread_mutex_t			mutex;
+#endif
+
+};
+
+/*
+ * A worker, which analyzes one position at a time.
+ */
+struct batch_worker
+{
+
+/*@dependent@*/
+/*@notnull@*/
+	struct batch *		b;
+
+/*@owned@*/
+/*@null@*/
+	struct game *		g;
+
+	/*
+	 * The computer players of player 0 and 1, which are allocated
+	 * when they're first needed.
+	 */
+/*@owned@*/
+/*@null@*/
+	struct aiminimax *	aim[HT_BATCH_SIDES];
+
+	/*
+	 * The moves up to the position that is analyzed.
+	 */
+/*@owned@*/
+/*@null@*/
+	struct listm *		moves;
+
+#ifdef HT_POSIX
+	pthread_t		thread;
+#endif
+
+};
+
+/*
+ * Prints the analysis of the position after ply moves in r: the depth
+ * that was searched, the amount of positions visited, and the value
+ * and coordinates of the best move. The value and move are "-" if there
+ * is no move.
+ *
+ * With HT_POSIX, b->mutex must be locked.
+ */
+static
+enum HT_FR
+batch_print (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const		g,
+/*@in@*/
+/*@notnull@*/
+	const struct batch_record * const	r,
+	const size_t				ply,
+	const unsigned short			depth,
+	const unsigned long			nodes,
+/*@in@*/
+/*@null@*/
+	const struct aiminimax * const		aim,
+/*@in@*/
+/*@notnull@*/
+	const struct ui_action * const		act
+	)
+/*@globals fileSystem, errno, stdout@*/
+/*@modifies fileSystem, errno, stdout@*/
+{
+	const unsigned short	bwidth	= g->rules->bwidth;
+	int			rv;
+
+	if (NULL != aim && HT_UI_ACT_MOVE == act->type)
+	{
+		rv	= printf("%s\t%lu\t%hu\t%lu\t%d"
+			"\t%hu %hu %hu %hu\n",
+			r->file, (unsigned long)ply, depth, nodes,
+			aim->value,
+			(unsigned short)(act->info.mov.pos % bwidth),
+			(unsigned short)(act->info.mov.pos / bwidth),
+			(unsigned short)(act->info.mov.dest % bwidth),
+			(unsigned short)(act->info.mov.dest / bwidth));
+	}
+	else
+	{
+		rv	= printf("%s\t%lu\t%hu\t%lu\t-\n", r->file,
+			(unsigned long)ply, depth, nodes);
+	}
+	/*
+	 * Every position is printed when it's done, so it can be read
+	 * from a pipe while the rest are analyzed.
+	 */
+	return	rv < 0 || 0 != fflush(stdout) ? HT_FR_FAIL_IO_PRINT
+		: HT_FR_SUCCESS;
+}
+
+/*
+ * Locks b->mutex with HT_POSIX.
+ */
+static
+void
+batch_lock (
+/*@in@*/
+/*@notnull@*/
+	struct batch * const	b
+	)
+/*@modifies * b@*/
+{
+#ifdef HT_POSIX
+	(void) pthread_mutex_lock	(& b->mutex);
+#else
+	(void) b;
+#endif
+}
+
+static
+void
+batch_unlock (
+/*@in@*/
+/*@notnull@*/
+	struct batch * const	b
+	)
+/*@modifies * b@*/
+{
+#ifdef HT_POSIX
+	(void) pthread_mutex_unlock	(& b->mutex);
+#else
+	(void) b;
+#endif
+}
+
+/*
+ * Searches the position in w->g with the computer player of the player
+ * to move, and sets act to its move, depth to the depth that was
+ * searched and nodes to the amount of positions visited.
+ */
+static
+enum HT_FR
+batch_search (
+/*@in@*/
+/*@notnull@*/
+	struct batch_worker * const	w,
+/*@out@*/
+/*@notnull@*/
+	struct aiminimax * * const	aim_out,
+/*@out@*/
+/*@notnull@*/
+	struct ui_action * const	act,
+/*@out@*/
+/*@notnull@*/
+	unsigned short * const		depth,
+/*@out@*/
+/*@notnull@*/
+	unsigned long * const		nodes
+	)
+/*@globals errno, fileSystem, stdout, internalState@*/
+/*@modifies errno, fileSystem, stdout, internalState, * w, * aim_out@*/
+/*@modifies * act, * depth, * nodes@*/
+{
+	const struct batch_conf * const conf	= w->b->conf;
+	const unsigned short	turn	= w->g->b->turn;
+	const unsigned long	start	= ht_timer_ms();
+	struct aiminimax *	aim	= NULL;
+	struct ui		interf;
+	enum HT_FR		fr	= HT_FR_NONE;
+
+	interf.type	= HT_UIT_NONE;
+	ui_action_init(act);
+	* aim_out	= NULL;
+	* nodes		= 0ul;
+
+	if (NULL == w->aim[turn])
+	{
+		w->aim[turn]	= alloc_aiminimax_init(w->g, turn,
+			conf->depth, & fr
+#ifdef HT_AI_MINIMAX_HASH
+			, NULL
+#endif
+			);
+		if (HT_FR_SUCCESS != fr || NULL == w->aim[turn])
+		{
+			return	HT_FR_SUCCESS == fr ? HT_FR_FAIL_ALLOC
+				: fr;
+		}
+	}
+	aim	= w->aim[turn];
+
+	/*
+	 * aim has room to search conf->depth, so depth_max can be
+	 * lowered when the time is limited.
+	 */
+	* depth	= conf->time > 0ul ? (unsigned short)1 : conf->depth;
+	for (;;)
+	{
+		aim->depth_max	= * depth;
+		ui_action_init(act);
+		fr	= aiminimax_command(w->g, & interf, aim, act);
+		if (HT_FR_SUCCESS != fr)
+		{
+			return	fr;
+		}
+		* nodes	+= aim->nodes;
+		if (* depth >= conf->depth
+		|| ht_timer_ms() - start >= conf->time)
+		{
+			break;
+		}
+		(* depth)++;
+	}
+
+	* aim_out	= aim;
+	return		HT_FR_SUCCESS;
+}
+
+/*
+ * Analyzes the position after ply moves in r and prints it.
+ */
+static
+enum HT_FR
+batch_position (
+/*@in@*/
+/*@notnull@*/
+	struct batch_worker * const		w,
+/*@in@*/
+/*@notnull@*/
+	const struct batch_record * const	r,
+	const size_t				ply
+	)
+/*@globals errno, fileSystem, stdout, internalState@*/
+/*@modifies errno, fileSystem, stdout, internalState, * w@*/
+{
+	struct aiminimax *	aim	= NULL;
+	struct ui_action	act;
+	enum HT_FR		fr	= HT_FR_NONE;
+	unsigned short		depth	= 0;
+	unsigned long		nodes	= 0ul;
+	unsigned short		winner	= HT_PLAYER_UNINIT;
+	HT_BOOL			valid	= HT_FALSE;
+	size_t			i;
+
+#ifndef HT_UNSAFE
+	if (NULL == w->g || NULL == w->moves || NULL == r->moves)
+	{
+		return	HT_FR_FAIL_NULLPTR;
+	}
+#endif
+
+	/*
+	 * The record has already been played with every move checked,
+	 * so it can be trusted.
+	 */
+	fr	= listm_reserve(w->moves, ply);
+	if (HT_FR_SUCCESS != fr)
+	{
+		return	fr;
+	}
+	for (i = 0; i < ply; i++)
+	{
+		w->moves->elems[i]	= r->moves->elems[i];
+	}
+	w->moves->elemc	= ply;
+	fr	= grecord_replay(w->g, w->moves, HT_TRUE, & valid);
+	if (HT_FR_SUCCESS != fr)
+	{
+		return	fr;
+	}
+	else if (!valid)
+	{
+		return	HT_FR_FAIL_ILL_STATE;
+	}
+
+	ui_action_init(& act);
+	if (!game_over(w->g, & winner))
+	{
+		fr	= batch_search(w, & aim, & act, & depth,
+			& nodes);
+		if (HT_FR_SUCCESS != fr)
+		{
+			return	fr;
+		}
+	}
+
+	batch_lock	(w->b);
+	fr	= batch_print(w->g, r, ply, depth, nodes, aim, & act);
+	batch_unlock	(w->b);
+	return		fr;
+}
+
+/*
+ * Analyzes the next position in w->b until there are none left, or
+ * until a worker has failed.
+ */
+static
+void
+batch_work (
+/*@in@*/
+/*@notnull@*/
+	struct batch_worker * const	w
+	)
+/*@globals errno, fileSystem, stdout, internalState@*/
+/*@modifies errno, fileSystem, stdout, internalState, * w@*/
+{
+	struct batch * const		b	= w->b;
+	const struct batch_conf * const	conf	= b->conf;
+
+	for (;;)
+	{
+		const struct batch_record *	r;
+		enum HT_FR			fr;
+		size_t				ply;
+
+		batch_lock	(b);
+		while (b->rec < conf->recordc
+		&& b->pos >= conf->records[b->rec].posc)
+		{
+			b->rec++;
+			b->pos	= 0;
+		}
+		if (b->stop || b->rec >= conf->recordc)
+		{
+			batch_unlock	(b);
+			return;
+		}
+		r	= & conf->records[b->rec];
+		ply	= r->first + b->pos++;
+		batch_unlock	(b);
+
+		fr	= batch_position(w, r, ply);
+
+		if (HT_FR_SUCCESS != fr)
+		{
+			batch_lock	(b);
+			if (HT_FR_SUCCESS == b->fr)
+			{
+				b->fr	= fr;
+				b->stop	= HT_TRUE;
+			}
+			batch_unlock	(b);
+		}
+	}
+}
+
+#ifdef HT_POSIX
+
+/*@null@*/
+static
+void *
+batch_work_thread (
+/*@in@*/
+/*@notnull@*/
+	void * const	arg
+	)
+/*@globals errno, fileSystem, stdout, internalState@*/
+/*@modifies errno, fileSystem, stdout, internalState, arg@*/
+{
+	batch_work	(arg);
+	return		NULL;
+}
+
+#endif
+
+/*
+ * Reads the ruleset for w, or shares the one of g if it's not NULL.
+ * Only the first worker reads it.
+ */
+static
+enum HT_FR
+batch_worker_init (
+/*@in@*/
+/*@notnull@*/
+	const struct invoc * const	inv,
+/*@in@*/
+/*@notnull@*/
+	struct ht_line * const		line,
+/*@in@*/
+/*@null@*/
+	const struct game * const	shared,
+/*@in@*/
+/*@notnull@*/
+	struct batch_worker * const	w
+	)
+/*@globals fileSystem, errno, stderr@*/
+/*@modifies fileSystem, errno, stderr, * line, * w@*/
+{
+	enum HT_FR		fr		= HT_FR_NONE;
+	enum HT_FAIL_RREADER	fail_read	= HT_FAIL_RREADER_NONE;
+	HT_BOOL			valid		= HT_FALSE;
+	struct game *		g;
+
+	w->moves	= alloc_listm(HT_BATCH_LIST_CAP_DEF);
+	if (NULL == w->moves)
+	{
+		return	HT_FR_FAIL_ALLOC;
+	}
+
+	if (NULL != shared)
+	{
+		w->g	= alloc_game_share(shared);
+		return	NULL == w->g ? HT_FR_FAIL_ALLOC : HT_FR_SUCCESS;
+	}
+
+	g	= alloc_game_rcache(inv->file_rc, inv->file_rcache,
+		line, & fr, & fail_read, & valid);
+	if (HT_FR_SUCCESS != fr || NULL == g)
+	{
+		(void) print_err_fr_rreader(stderr, fr, fail_read,
+			line);
+		if (NULL != g)
+		{
+			free_game	(g);
+		}
+		return	HT_FR_FAIL_RREADER;
+	}
+	w->g	= g;
+
+	fr	= HT_FR_SUCCESS;
+#ifdef HT_AI_MINIMAX_HASH
+	if (inv->zobrist_seed_set)
+	{
+		fr	= game_zobrist_seed(g, inv->zobrist_seed);
+	}
+	if (inv->hash_mem_set)
+	{
+		g->hash_conf.mem_tab		= inv->hash_mem;
+	}
+#endif
+	if (HT_FR_SUCCESS == fr)
+	{
+		fr	= game_board_reset(g);
+	}
+	if (HT_FR_SUCCESS != fr)
+	{
+		return	fr;
+	}
+	if (!valid)
+	{
+		const char * const why	= ruleset_valid(g);
+		if (NULL != why)
+		{
+			(void) fputs	(why,	stderr);
+			(void) fputc	('\n',	stderr);
+			return		HT_FR_FAIL_RREADER;
+		}
+	}
+	return	HT_FR_SUCCESS;
+}
+
+static
+void
+batch_worker_free (
+/*@in@*/
+/*@notnull@*/
+	struct batch_worker * const	w
+	)
+/*@modifies * w@*/
+{
+	unsigned short i;
+	for (i = (unsigned short)0; i < HT_BATCH_SIDES; i++)
+	{
+		if (NULL != w->aim[i])
+		{
+			free_aiminimax	(w->aim[i]);
+			w->aim[i]	= NULL;
+		}
+	}
+	if (NULL != w->g)
+	{
+		free_game	(w->g);
+		w->g		= NULL;
+	}
+	if (NULL != w->moves)
+	{
+		free_listm	(w->moves);
+		w->moves	= NULL;
+	}
+}
+
+/*
+ * Adds the game record file to conf, to analyze every position in it if
+ * all, or else only the position after ply moves.
+ */
+static
+enum HT_FR
+batch_conf_record (
+/*@in@*/
+/*@notnull@*/
+	struct batch_conf * const	conf,
+/*@in@*/
+/*@notnull@*/
+	const char * const		file,
+	const HT_BOOL			all,
+	const size_t			ply
+	)
+/*@modifies * conf@*/
+{
+	struct batch_record * r;
+
+	if (conf->recordc >= conf->recordcap)
+	{
+		const size_t cap = conf->recordcap < (size_t)1
+			? (size_t)16 : conf->recordcap * 2;
+		struct batch_record * const records =
+			realloc(conf->records, sizeof(* records) * cap);
+		if (NULL == records)
+		{
+/* splint realloc */ /*@i2@*/\
+			return	HT_FR_FAIL_ALLOC;
+		}
+		conf->records	= records;
+		conf->recordcap	= cap;
+	}
+
+	r	= & conf->records[conf->recordc];
+	r->file	= malloc(strlen(file) + (size_t)1);
+	if (NULL == r->file)
+	{
+		return	HT_FR_FAIL_ALLOC;
+	}
+	(void) strcpy	(r->file, file);
+	r->moves	= NULL;
+	r->all		= all;
+	r->ply		= ply;
+	r->first	= r->posc	= 0;
+	conf->recordc++;
+/* splint realloc */ /*@i1@*/\
+	return	HT_FR_SUCCESS;
+}
+
+/*
+ * Reads a line of the batch file into conf. fail_read is set if it's
+ * not valid.
+ */
+static
+enum HT_FR
+batch_conf_line (
+/*@in@*/
+/*@notnull@*/
+	const struct ht_line * const		line,
+/*@in@*/
+/*@notnull@*/
+	struct batch_conf * const		conf,
+/*@in@*/
+/*@notnull@*/
+	enum HT_FAIL_RREADER * const		fail_read
+	)
+/*@globals errno@*/
+/*@modifies errno, * conf, * fail_read@*/
+{
+	const char * const	arg0	= line->words[0].chars;
+	size_t			argc	= (size_t)2;
+	HT_BOOL			valid	= HT_FALSE;
+
+	/*
+	 * "record" has an optional ply.
+	 */
+	if (0 == strcmp(arg0, HT_L_BATCH_CMD_RECORD)
+	&& line->wordc > (size_t)2)
+	{
+		argc	= (size_t)3;
+	}
+	if (line->wordc < argc)
+	{
+		* fail_read	= HT_FAIL_RREADER_ARG_MISS;
+		return		HT_FR_FAIL_RREADER;
+	}
+	else if (line->wordc > argc)
+	{
+		* fail_read	= HT_FAIL_RREADER_ARG_EXCESS;
+		return		HT_FR_FAIL_RREADER;
+	}
+
+	if (0 == strcmp(arg0, HT_L_BATCH_CMD_DEPTH))
+	{
+		valid	= texttoushort(line->words[1].chars,
+				& conf->depth)
+			&& aiminimax_depth_max_valid(conf->depth);
+	}
+	else if (0 == strcmp(arg0, HT_L_BATCH_CMD_TIME))
+	{
+		valid	= texttoulong(line->words[1].chars,
+			& conf->time);
+	}
+	else if (0 == strcmp(arg0, HT_L_BATCH_CMD_THREADS))
+	{
+		valid	= texttoushort(line->words[1].chars,
+			& conf->threads);
+	}
+	else if (0 == strcmp(arg0, HT_L_BATCH_CMD_RECORD))
+	{
+		unsigned long	ply	= 0ul;
+		valid	= (size_t)2 == argc
+			|| texttoulong(line->words[2].chars, & ply);
+		if (valid && HT_FR_SUCCESS != batch_conf_record(conf,
+			line->words[1].chars, (size_t)2 == argc,
+			(size_t)ply))
+		{
+			return	HT_FR_FAIL_ALLOC;
+		}
+	}
+	else
+	{
+		* fail_read	= HT_FAIL_RREADER_ARG_UNK;
+		return		HT_FR_FAIL_RREADER;
+	}
+
+	if (!valid)
+	{
+		* fail_read	= HT_FAIL_RREADER_NOOB;
+		return		HT_FR_FAIL_RREADER;
+	}
+	return	HT_FR_SUCCESS;
+}
+
+/*
+ * Reads the batch file inv->file_batch into conf, which must be
+ * initialized. A line that's not valid is printed with its line
+ * number, and HT_FR_FAIL_RREADER is returned.
+ */
+static
+enum HT_FR
+batch_conf_read (
+/*@in@*/
+/*@notnull@*/
+	const struct invoc * const	inv,
+/*@in@*/
+/*@notnull@*/
+	struct ht_line * const		line,
+/*@in@*/
+/*@notnull@*/
+	struct batch_conf * const	conf
+	)
+/*@globals fileSystem, errno, stderr@*/
+/*@modifies fileSystem, errno, stderr, * line, * conf@*/
+{
+	enum HT_FR		fr		= HT_FR_SUCCESS;
+	enum HT_FAIL_RREADER	fail_read	= HT_FAIL_RREADER_NONE;
+	unsigned long		lineno		= 0;
+	FILE * const		file	= fopen(inv->file_batch, "r");
+	struct ht_text *	text	= NULL;
+
+	if (NULL == file)
+	{
+		return	HT_FR_FAIL_IO_FILE_R;
+	}
+	text	= alloc_ht_text(file, & fr);
+	if (0 != fclose(file) && HT_FR_SUCCESS == fr)
+	{
+		fr	= HT_FR_FAIL_IO_FILE_R;
+	}
+	if (HT_FR_SUCCESS != fr || NULL == text)
+	{
+		if (NULL != text)
+		{
+			free_ht_text	(text);
+		}
+		return	fr;
+	}
+
+	while (HT_FR_SUCCESS == fr && !ht_text_eof(text))
+	{
+		fr	= ht_line_readtext(text, line);
+		lineno++;
+		if (HT_FR_SUCCESS != fr || ht_line_empty(line))
+		{
+			continue;
+		}
+		fr	= batch_conf_line(line, conf, & fail_read);
+		if (HT_FR_FAIL_RREADER == fr)
+		{
+			(void) fprintf(stderr, "%s:%lu: %s\n",
+				inv->file_batch, lineno,
+				fail_rreader_what(fail_read));
+		}
+	}
+
+	free_ht_text	(text);
+	return		fr;
+}
+
+/*
+ * Reads the game record in r and plays it in g, with every move
+ * checked, to find the positions to analyze. A record that's not valid
+ * for g's ruleset, or that has no position at r->ply, is printed and
+ * HT_FR_FAIL_RREADER is returned.
+ */
+static
+enum HT_FR
+batch_record_read (
+/*@in@*/
+/*@notnull@*/
+	struct game * const		g,
+/*@in@*/
+/*@notnull@*/
+	struct batch_record * const	r
+	)
+/*@globals fileSystem, errno, stderr@*/
+/*@modifies fileSystem, errno, stderr, * g, * r@*/
+{
+	enum HT_FR	fr;
+	unsigned short	winner	= HT_PLAYER_UNINIT;
+	HT_BOOL		valid	= HT_FALSE;
+	HT_BOOL		over;
+	size_t		movec;
+
+	r->moves	= alloc_listm(HT_BATCH_LIST_CAP_DEF);
+	if (NULL == r->moves)
+	{
+		return	HT_FR_FAIL_ALLOC;
+	}
+
+	fr	= grecord_read(g, r->file, r->moves, & valid);
+	if (HT_FR_SUCCESS == fr && valid)
+	{
+		fr	= grecord_replay(g, r->moves, HT_FALSE,
+			& valid);
+	}
+	if (HT_FR_SUCCESS != fr && HT_FR_FAIL_IO_FILE_R != fr)
+	{
+		return	fr;
+	}
+
+	movec	= r->moves->elemc;
+	over	= game_over(g, & winner);
+	if (!valid || HT_FR_SUCCESS != fr
+	|| (!r->all && r->ply > movec))
+	{
+		(void) fprintf(stderr, "%s: %s\n", r->file,
+			HT_L_BATCH_FAIL_RECORD);
+		return	HT_FR_FAIL_RREADER;
+	}
+
+	if (r->all)
+	{
+		r->first	= 0;
+		r->posc		= over ? movec : movec + (size_t)1;
+	}
+	else
+	{
+		r->first	= r->ply;
+		r->posc		= (size_t)1;
+	}
+	return	HT_FR_SUCCESS;
+}
+
+/*
+ * Returns the amount of workers, which is conf->threads if set, or
+ * else one per processor.
+ */
+static
+size_t
+batch_workc (
+/*@in@*/
+/*@notnull@*/
+	const struct batch_conf * const	conf
+	)
+/*@modifies nothing@*/
+{
+	size_t workc	= (size_t)conf->threads;
+#if defined(HT_POSIX) && !defined(HT_AI_MINIMAX_UNSAFE)
+	if (workc < (size_t)1)
+	{
+		const long cpus	= sysconf(_SC_NPROCESSORS_ONLN);
+		workc	= cpus < 1 ? (size_t)1 : (size_t)cpus;
+	}
+#else
+	/*
+	 * HT_AI_MINIMAX_UNSAFE has a global in aimalgo.c, so only one
+	 * position can be searched at a time.
+	 */
+	workc	= (size_t)1;
+#endif
+	return	workc;
+}
+
+/*
+ * Runs the workers, in their own threads with HT_POSIX.
+ */
+static
+enum HT_FR
+batch_play (
+/*@in@*/
+/*@notnull@*/
+	struct batch_worker * const	workers,
+	const size_t			workc
+	)
+/*@globals errno, fileSystem, stdout, internalState@*/
+/*@modifies errno, fileSystem, stdout, internalState, * workers@*/
+{
+#ifdef HT_POSIX
+	enum HT_FR	fr	= HT_FR_SUCCESS;
+	size_t		threadc	= (size_t)1;
+	size_t		i;
+
+	/*
+	 * The first worker runs in this thread.
+	 */
+	for (; threadc < workc; threadc++)
+	{
+		if (0 != pthread_create(& workers[threadc].thread, NULL,
+			batch_work_thread, & workers[threadc]))
+		{
+			fr	= HT_FR_FAIL_POSIX;
+			break;
+		}
+	}
+	batch_work	(& workers[0]);
+	for (i = (size_t)1; i < threadc; i++)
+	{
+		if (0 != pthread_join(workers[i].thread, NULL))
+		{
+			fr	= HT_FR_FAIL_POSIX;
+		}
+	}
+	return	fr;
+#else
+	(void) workc;
+	batch_work	(& workers[0]);
+	return		HT_FR_SUCCESS;
+#endif
+}
+
+/*
+ * Analyzes the positions in the game records listed in the batch file
+ * inv->file_batch on the ruleset inv->file_rc, and prints the best
+ * move, its value and the amount of positions visited for every one.
+ *
+ * Every worker keeps its own game and computer players, so positions
+ * are searched at the same time in different threads with HT_POSIX.
+ * The ruleset is only read once, and shared by the workers' games.
+ * The lines are printed as the positions are done, which isn't
+ * necessarily in the order of the batch file.
+ */
+enum HT_FR
+batch_run (
+	const struct invoc * const	inv
+	)
+{
+	enum HT_FR		fr		= HT_FR_NONE;
+	struct ht_line *	line		= NULL;
+	struct batch_worker *	workers		= NULL;
+	struct batch_conf *	conf		= NULL;
+	struct batch *		b		= NULL;
+	size_t			workc		= 0;
+	size_t			i;
+
+#ifndef HT_UNSAFE
+	if (NULL == inv || NULL == inv->file_batch)
+	{
+		return	HT_FR_FAIL_NULLPTR;
+	}
+#endif
+
+	line	= alloc_ht_line((size_t)3, (size_t)18);
+	conf	= malloc(sizeof(* conf));
+	b	= malloc(sizeof(* b));
+	if (NULL == line || NULL == conf || NULL == b)
+	{
+		if (NULL != line)
+		{
+			free_ht_line	(line);
+		}
+		free	(conf);
+		free	(b);
+		return	HT_FR_FAIL_ALLOC;
+	}
+
+	conf->depth	= HT_BATCH_DEPTH_DEF;
+	conf->time	= 0ul;
+	conf->threads	= (unsigned short)0;
+	conf->records	= NULL;
+	conf->recordc	= conf->recordcap	= 0;
+
+	b->conf	= conf;
+	b->rec	= b->pos	= 0;
+	b->stop	= HT_FALSE;
+	b->fr	= HT_FR_SUCCESS;
+
+	fr	= batch_conf_read(inv, line, conf);
+	if (HT_FR_SUCCESS == fr)
+	{
+		workc	= batch_workc(conf);
+		workers	= malloc(sizeof(* workers) * workc);
+		fr	= NULL == workers ? HT_FR_FAIL_ALLOC
+			: HT_FR_SUCCESS;
+	}
+	for (i = (size_t)0; NULL != workers && i < workc; i++)
+	{
+		workers[i].b		= b;
+		workers[i].g		= NULL;
+		workers[i].aim[0]	= workers[i].aim[1]	= NULL;
+		workers[i].moves	= NULL;
+	}
+	for (i = (size_t)0; HT_FR_SUCCESS == fr && i < workc; i++)
+	{
+		fr	= batch_worker_init(inv, line, i > 0
+			? workers[0].g : NULL, & workers[i]);
+	}
+	for (i = (size_t)0; HT_FR_SUCCESS == fr && i < conf->recordc;
+		i++)
+	{
+		fr	= batch_record_read(workers[0].g,
+			& conf->records[i]);
+	}
+
+#ifdef HT_POSIX
+	if (HT_FR_SUCCESS == fr && 0 != pthread_mutex_init(& b->mutex,
+		NULL))
+	{
+		fr	= HT_FR_FAIL_POSIX;
+	}
+	else if (HT_FR_SUCCESS == fr)
+	{
+		fr	= batch_play(workers, workc);
+		(void) pthread_mutex_destroy	(& b->mutex);
+	}
+#else
+	if (HT_FR_SUCCESS == fr)
+	{
+		fr	= batch_play(workers, workc);
+	}
+#endif
+	if (HT_FR_SUCCESS == fr)
+	{
+		fr	= b->fr;
+	}
+
+	for (i = (size_t)0; NULL != workers && i < workc; i++)
+	{
+		batch_worker_free	(& workers[i]);
+	}
+	free	(workers);
+	for (i = (size_t)0; i < conf->recordc; i++)
+	{
+		if (NULL != conf->records[i].moves)
+		{
+			free_listm	(conf->records[i].moves);
+		}
+		free	(conf->records[i].file);
+	}
+	free		(conf->records);
+	free		(conf);
+	free		(b);
+	free_ht_line	(line);
+	return		fr;
+}
+
+#endif
+
@@ -0,0 +1,510 @@
+/* Copyright 2013 Alexander Söderlund.
+ *
+ * This file is part of HNEFATAFL.
+ *
+ * HNEFATAFL is free software: you can distribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * HNEFATAFL is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HT_AI_MINIMAX
+
+#include <stdio.h>	/* printf, fputs, stderr */
+#include <stdlib.h>	/* malloc, free */
+#include <string.h>	/* strlen, strcpy, strcat */
+#include <time.h>	/* clock, clock_t, CLOCKS_PER_SEC */
+
+#include "aimalgo.h"	/* aiminimax_command */
+#ifdef HT_AI_MINIMAX_HASH
+#include "aimhash.h"	/* zhash_pages_name */
+#endif
+#include "aiminimax.h"	/* alloc_aiminimax_init, free_aiminimax */
+#include "bench.h"
+#include "board.h"	/* board_moves_get, game_move, game_over */
+#include "game.h"	/* game_initopt, game_board_reset, free_game */
+#include "invoct.h"	/* invoc */
+#include "iogen.h"	/* print_err_fr, print_err_fr_rreader */
+#include "iotextparse.h"	/* alloc_ht_line, free_ht_line */
+#include "listm.h"	/* alloc_listm, free_listm, listm_clear */
+#include "rreader.h"	/* alloc_game_read */
+#include "rvalid.h"	/* ruleset_valid */
+#include "ui.h"		/* ui_action_init */
+#include "uit.h"	/* ui, ui_action */
+
+/*
+ * Seed for the random walk that selects the positions to search. The
+ * walk uses its own generator, so that it's not affected by the
+ * Zobrist seed or by anything else.
+ */
+/*@unchecked@*/
+static
+const unsigned long HT_BENCH_WALK_SEED	= 0x2545F491ul;
+
+/*
+ * Default capacity of the move list used by the random walk.
+ */
+/*@unchecked@*/
+static
+const size_t HT_BENCH_LIST_CAP_DEF	= (size_t)80;
+
+/*
+ * A ruleset file in invoc.dir_bench, and the depth to search its
+ * positions to.
+ */
+struct bench_rules
+{
+
+/*@observer@*/
+	const char *	file;
+
+	unsigned short	depth;
+
+};
+
+/*
+ * Rulesets that are benchmarked, in order, and the depth that each
+ * one's positions are searched to.
+ *
+ * NOTE:	Changing these (or HT_BENCH_PLIES) changes the node
+ *		count signature.
+ */
+/*@observer@*/
+/*@unchecked@*/
+static
+const char * const HT_BENCH_FILES[] =
+{
+	"brandub",
+	"tablut",
+	"hnefatafl11_v1",
+	"hnefatafl13_v1",
+	"alea_evangelii"
+};
+
+/*@unchecked@*/
+static
+const unsigned short HT_BENCH_DEPTHS[] =
+{
+	(unsigned short)4,
+	(unsigned short)3,
+	(unsigned short)3,
+	(unsigned short)3,
+	(unsigned short)2
+};
+
+/*
+ * Amount of plies (made by the random walk from the initial position)
+ * after which a position is searched. Must be increasing.
+ */
+/*@unchecked@*/
+static
+const unsigned short HT_BENCH_PLIES[] =
+{
+	(unsigned short)0,
+	(unsigned short)4,
+	(unsigned short)10
+};
+
+/*
+ * Totals over all searched positions.
+ */
+struct bench_total
+{
+
+	unsigned long	nodes;
+
+	clock_t		ticks;
+
+	unsigned short	posc;
+
+#ifdef HT_AI_MINIMAX_HASH
+	/*
+	 * zhashtable->pages of the last search's table.
+	 */
+	enum HT_ZHASH_PAGES	pages;
+#endif
+
+};
+
+/*
+ * Returns the next number from the random walk generator, which is a
+ * plain 32-bit linear congruential generator.
+ */
+static
+unsigned long
+bench_walk_next (
+/*@notnull@*/
+	unsigned long * const	walk
+	)
+/*@modifies * walk@*/
+{
+	* walk	= (* walk * 1103515245ul + 12345ul) & 0xFFFFFFFFul;
+	return	* walk >> 16;
+}
+
+/*
+ * Makes random moves in g until g->movehist->elemc reaches plies.
+ *
+ * over is set to true if the game ended before that.
+ */
+static
+enum HT_FR
+bench_walk (
+/*@in@*/
+/*@notnull@*/
+	struct game * const		g,
+/*@in@*/
+/*@notnull@*/
+	struct listm * const		moves,
+/*@notnull@*/
+	unsigned long * const		walk,
+	const unsigned short		plies,
+/*@notnull@*/
+	HT_BOOL * const			over
+	)
+/*@modifies * g, * moves, * walk, * over@*/
+{
+	enum HT_FR	fr	= HT_FR_NONE;
+	unsigned short	winner	= HT_PLAYER_UNINIT;
+
+	* over	= HT_FALSE;
+	while (g->movehist->elemc < (size_t)plies)
+	{
+		const struct move *	mov;
+		HT_BOOL			legal	= HT_FALSE;
+
+		if (game_over(g, & winner))
+		{
+			* over	= HT_TRUE;
+			return	HT_FR_SUCCESS;
+		}
+
+		listm_clear(moves);
+		fr	= board_moves_get(g, g->b, g->movehist, moves);
+		if (HT_FR_SUCCESS != fr)
+		{
+			return	fr;
+		}
+		if (moves->elemc < (size_t)1)
+		{
+			* over	= HT_TRUE;
+			return	HT_FR_SUCCESS;
+		}
+
+		mov	= & moves->elems[bench_walk_next(walk)
+			% (unsigned long)moves->elemc];
+		fr	= game_move(g, mov->pos, mov->dest, & legal);
+		if (HT_FR_SUCCESS != fr)
+		{
+			return	fr;
+		}
+		if (!legal)
+		{
+			return	HT_FR_FAIL_ILL_STATE;
+		}
+	}
+
+	* over	= game_over(g, & winner);
+	return	HT_FR_SUCCESS;
+}
+
+/*
+ * Searches the position in g to depth for the player to move, and
+ * prints a line with the ruleset file, ply, depth, node count and the
+ * move that was found.
+ */
+static
+enum HT_FR
+bench_search (
+/*@in@*/
+/*@notnull@*/
+	struct game * const			g,
+/*@in@*/
+/*@notnull@*/
+	const struct bench_rules * const	br,
+/*@in@*/
+/*@notnull@*/
+	struct bench_total * const		total
+	)
+/*@globals fileSystem, errno, stdout, internalState@*/
+/*@modifies fileSystem, errno, stdout, internalState, * total@*/
+{
+	enum HT_FR		fr	= HT_FR_NONE;
+	struct aiminimax *	aim	= NULL;
+	struct ui		interf;
+	struct ui_action	act;
+	clock_t			start;
+	const unsigned short	bwidth	= g->rules->bwidth;
+
+	interf.type	= HT_UIT_NONE;
+	ui_action_init(& act);
+
+	aim	= alloc_aiminimax_init(g, g->b->turn, br->depth, & fr
+#ifdef HT_AI_MINIMAX_HASH
+		, NULL
+#endif
+		);
+	if (NULL == aim || HT_FR_SUCCESS != fr)
+	{
+		if (NULL != aim)
+		{
+			free_aiminimax	(aim);
+		}
+		return	HT_FR_SUCCESS == fr ? HT_FR_FAIL_ALLOC : fr;
+	}
+
+	start	= clock();
+	fr	= aiminimax_command(g, & interf, aim, & act);
+	total->ticks	+= clock() - start;
+	if (HT_FR_SUCCESS != fr)
+	{
+		free_aiminimax	(aim);
+		return		fr;
+	}
+
+	total->nodes	+= aim->nodes;
+	total->posc++;
+#ifdef HT_AI_MINIMAX_HASH
+	total->pages	= aim->tp_tab->pages;
+#endif
+
+	if (printf("%s\t%lu\t%hu\t%lu", br->file,
+		(unsigned long)g->movehist->elemc, br->depth,
+		aim->nodes) < 0)
+	{
+		fr	= HT_FR_FAIL_IO_PRINT;
+	}
+	else if (HT_UI_ACT_MOVE == act.type)
+	{
+		if (printf("\t%hu,%hu\t%hu,%hu\n",
+			(unsigned short)(act.info.mov.pos % bwidth),
+			(unsigned short)(act.info.mov.pos / bwidth),
+			(unsigned short)(act.info.mov.dest % bwidth),
+			(unsigned short)(act.info.mov.dest / bwidth)) < 0)
+		{
+			fr	= HT_FR_FAIL_IO_PRINT;
+		}
+	}
+	else if (puts("\t-") < 0)
+	{
+		fr	= HT_FR_FAIL_IO_PRINT;
+	}
+
+	free_aiminimax	(aim);
+	return		fr;
+}
+
+/*
+ * Reads the ruleset br->file in inv->dir_bench and searches every
+ * position in HT_BENCH_PLIES that the random walk reaches.
+ */
+static
+enum HT_FR
+bench_rules_run (
+/*@in@*/
+/*@notnull@*/
+	const struct invoc * const		inv,
+/*@in@*/
+/*@notnull@*/
+	const struct bench_rules * const	br,
+/*@in@*/
+/*@notnull@*/
+	struct ht_line * const			line,
+/*@in@*/
+/*@notnull@*/
+	struct listm * const			moves,
+/*@in@*/
+/*@notnull@*/
+	struct bench_total * const		total
+	)
+/*@globals fileSystem, errno, stdout, stderr, internalState@*/
+/*@modifies fileSystem, errno, stdout, stderr, internalState@*/
+/*@modifies * line, * moves, * total@*/
+{
+	enum HT_FR		fr		= HT_FR_NONE;
+	enum HT_FAIL_RREADER	fail_read	= HT_FAIL_RREADER_NONE;
+	struct game *		g		= NULL;
+	char *			file		= NULL;
+	unsigned long		walk		= HT_BENCH_WALK_SEED;
+	const char * const	dir_rules	= inv->dir_bench;
+	size_t			i;
+
+	file	= malloc(strlen(dir_rules) + strlen(br->file) + (size_t)2);
+	if (NULL == file)
+	{
+		return	HT_FR_FAIL_ALLOC;
+	}
+	(void) strcpy	(file, dir_rules);
+	(void) strcat	(file, "/");
+	(void) strcat	(file, br->file);
+
+	g	= alloc_game_read(file, line, & fr, & fail_read);
+	if (HT_FR_SUCCESS != fr || NULL == g)
+	{
+		(void) fputs	(file, stderr);
+		(void) fputc	('\n', stderr);
+		(void) print_err_fr_rreader(stderr, fr, fail_read, line);
+		if (NULL != g)
+		{
+			free_game	(g);
+		}
+		free	(file);
+		return	HT_FR_SUCCESS == fr ? HT_FR_FAIL_NULLPTR : fr;
+	}
+	free	(file);
+
+	game_initopt(g);
+	fr	= HT_FR_SUCCESS;
+#ifdef HT_AI_MINIMAX_HASH
+	if (inv->zobrist_seed_set)
+	{
+		fr	= game_zobrist_seed(g, inv->zobrist_seed);
+	}
+	if (inv->hash_mem_set)
+	{
+		g->hash_conf.mem_tab		= inv->hash_mem;
+	}
+#endif
+	if (HT_FR_SUCCESS == fr)
+	{
+		fr	= game_board_reset(g);
+	}
+	if (HT_FR_SUCCESS != fr)
+	{
+		free_game	(g);
+		return		fr;
+	}
+	{
+		const char * const rvalid_why	= ruleset_valid(g);
+		if (NULL != rvalid_why)
+		{
+			(void) fputs	(rvalid_why,	stderr);
+			(void) fputc	('\n',		stderr);
+			free_game	(g);
+			return		HT_FR_FAIL_ILL_STATE;
+		}
+	}
+
+	for (i = (size_t)0; i < sizeof(HT_BENCH_PLIES)
+		/ sizeof(* HT_BENCH_PLIES); i++)
+	{
+		HT_BOOL over	= HT_FALSE;
+		fr	= bench_walk(g, moves, & walk, HT_BENCH_PLIES[i],
+			& over);
+		if (HT_FR_SUCCESS != fr)
+		{
+			free_game	(g);
+			return		fr;
+		}
+		if (over)
+		{
+			break;
+		}
+
+		fr	= bench_search(g, br, total);
+		if (HT_FR_SUCCESS != fr)
+		{
+			free_game	(g);
+			return		fr;
+		}
+	}
+
+	free_game	(g);
+	return		HT_FR_SUCCESS;
+}
+
+/*
+ * Searches a fixed set of positions for every ruleset in
+ * HT_BENCH_FILES, which are read from inv->dir_bench.
+ *
+ * The positions are reached by a seeded random walk from the initial
+ * position, and every search uses the same Zobrist seed (the ruleset's
+ * own, or inv->zobrist_seed if given), so the total node count is a
+ * signature that only changes if the search does.
+ * Performance changes that are not supposed to change the search can
+ * therefore be checked against it.
+ *
+ * Prints one line per position, and then the total amount of nodes,
+ * the time spent searching (in seconds) and the amount of nodes per
+ * second. With HT_AI_MINIMAX_HASH, it also prints the kind of pages
+ * the transposition table is in.
+ */
+enum HT_FR
+bench_run (
+	const struct invoc * const	inv
+	)
+{
+	enum HT_FR		fr	= HT_FR_NONE;
+	struct ht_line *	line	= NULL;
+	struct listm *		moves	= NULL;
+	struct bench_total	total;
+	double			secs;
+	size_t			i;
+
+#ifndef HT_UNSAFE
+	if (NULL == inv || NULL == inv->dir_bench)
+	{
+		return	HT_FR_FAIL_NULLPTR;
+	}
+#endif
+
+	total.nodes	= 0;
+	total.ticks	= 0;
+	total.posc	= (unsigned short)0;
+#ifdef HT_AI_MINIMAX_HASH
+	total.pages	= HT_ZHASH_PAGES_HEAP;
+#endif
+
+	line	= alloc_ht_line((size_t)3, (size_t)18);
+	if (NULL == line)
+	{
+		return	HT_FR_FAIL_ALLOC;
+	}
+	moves	= alloc_listm(HT_BENCH_LIST_CAP_DEF);
+	if (NULL == moves)
+	{
+		free_ht_line	(line);
+		return		HT_FR_FAIL_ALLOC;
+	}
+
+	for (i = (size_t)0; i < sizeof(HT_BENCH_FILES)
+		/ sizeof(* HT_BENCH_FILES); i++)
+	{
+		struct bench_rules	br;
+		br.file		= HT_BENCH_FILES[i];
+		br.depth	= HT_BENCH_DEPTHS[i];
+		fr	= bench_rules_run(inv, & br, line, moves, & total);
+		if (HT_FR_SUCCESS != fr)
+		{
+			free_listm	(moves);
+			free_ht_line	(line);
+			return		fr;
+		}
+	}
+	free_listm	(moves);
+	free_ht_line	(line);
+
+	secs	= (double)total.ticks / (double)CLOCKS_PER_SEC;
+	if (printf("positions\t%hu\nnodes\t\t%lu\ntime\t\t%.3f\n"
+		"nps\t\t%.0f\n", total.posc, total.nodes, secs,
+		secs > 0.0 ? (double)total.nodes / secs : 0.0) < 0)
+	{
+		return	HT_FR_FAIL_IO_PRINT;
+	}
+#ifdef HT_AI_MINIMAX_HASH
+	if (printf("pages\t\t%s\n", zhash_pages_name(total.pages)) < 0)
+	{
+		return	HT_FR_FAIL_IO_PRINT;
+	}
+#endif
+	return	HT_FR_SUCCESS;
+}
+
+#endif
@@ -26,16 +26,18 @@
  *	HT_UNSAFE
  *	HT_AI_MINIMAX
  *	HT_AI_MINIMAX_HASH
+ *	HT_AI_MINIMAX_HASH_HUGE
  *	HT_AI_MINIMAX_UNSAFE
  *	HT_UI_CLI
  *	HT_UI_XLIB
  *	HT_UI_MSQU
+ *	HT_UI_ENGINE
  *
  * This string gives no clue about (other than that they must have at
- * least the minimum allowed values if HT_AI_MINIMAX_HASH is 1):
+ * least the minimum allowed values if HT_AI_MINIMAX_HASH is 1, and it
+ * is only a default):
  *
  *	HT_AI_MINIMAX_HASH_MEM_TAB
- *	HT_AI_MINIMAX_HASH_MEM_COL
  */
 const char * HT_PREPROC =
 #ifdef HT_C99
@@ -63,6 +65,11 @@ const char * HT_PREPROC =
 #else
 	"0"
 #endif
+#ifdef HT_AI_MINIMAX_HASH_HUGE
+	"1"
+#else
+	"0"
+#endif
 #ifdef HT_AI_MINIMAX_UNSAFE
 	"1"
 #else
@@ -83,5 +90,10 @@ const char * HT_PREPROC =
 #else
 	"0"
 #endif
+#ifdef HT_UI_ENGINE
+	"1"
+#else
+	"0"
+#endif
 ;
 
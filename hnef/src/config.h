@@ -78,8 +78,17 @@
  * will complain and fail to start if you attempt to use it without a
  * user interface anyway.
  */
-#if	!defined(HT_UI_CLI)	&& !defined(HT_UI_XLIB) && !defined(HT_UI_MSQU)
-#error	"No user interface. Use HT_UI_CLI, HT_UI_XLIB or HT_UI_MSQU."
+#if	!defined(HT_UI_CLI)	&& !defined(HT_UI_XLIB) && !defined(HT_UI_MSQU)\
+	&& !defined(HT_UI_ENGINE)
+#error	"No user interface. Use HT_UI_CLI, HT_UI_XLIB, HT_UI_MSQU or"\
+	"HT_UI_ENGINE."
+#endif
+
+/*
+ * The engine interface only drives the computer player.
+ */
+#if	defined(HT_UI_ENGINE)	&& !defined(HT_AI_MINIMAX)
+#error	"HT_UI_ENGINE requires HT_AI_MINIMAX."
 #endif
 
 /*
@@ -94,24 +103,30 @@
  * Undefine memory settings if transposition table is disabled.
  */
 #ifndef	HT_AI_MINIMAX_HASH
-#undef	HT_AI_MINIMAX_MEM_INIT
-#undef	HT_AI_MINIMAX_MEM_COL_INIT
-#undef	HT_AI_MINIMAX_MEM_COL_GROW
-#undef	HT_AI_MINIMAX_MEM_COL_MAX
+#undef	HT_AI_MINIMAX_HASH_MEM_TAB
+#undef	HT_AI_MINIMAX_HASH_HUGE
+#endif
+
+/*
+ * Huge pages for the transposition table are allocated with mmap.
+ */
+#ifndef	HT_POSIX
+#undef	HT_AI_MINIMAX_HASH_HUGE
 #endif
 
 /*
  * Space is given in bytes.
  *
- * *_HASH_MEM_TAB is the space for the hash table.
- *
- * *_HASH_MEM_COL is the space for collision lists.
+ * *_HASH_MEM_TAB is the default space for the hash table. It can be
+ * changed at runtime (zhashconf->mem_tab), so it's optional.
  */
 #ifdef	HT_AI_MINIMAX_HASH
-#if	HT_AI_MINIMAX_HASH_MEM_TAB	< 8000000 \
-	|| HT_AI_MINIMAX_HASH_MEM_COL	< 8000000
+#ifndef	HT_AI_MINIMAX_HASH_MEM_TAB
+#define	HT_AI_MINIMAX_HASH_MEM_TAB	67108864
+#endif
+#if	HT_AI_MINIMAX_HASH_MEM_TAB	< 1048576
 #error	"Insufficient memory for transposition table."\
-	"Disable HT_AI_MINIMAX_HASH or use at least 8 + 8 MB."
+	"Disable HT_AI_MINIMAX_HASH or use at least 1 MiB."
 #endif
 #endif
 /*@observer@*/
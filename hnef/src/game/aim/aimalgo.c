@@ -21,12 +21,19 @@
 
 #include "aimalgo.h"
 #ifdef HT_AI_MINIMAX_HASH
-#include "aimhash.h"	/* zhashtable_clearunused, ... */
+#include "aimhash.h"	/* zhashtable_age, ... */
 #endif
+#include "aimevalt.h"	/* HT_AIM_EVAL_* */
+#include "aiminimax.h"	/* aiminimax_psq_features */
 #include "aiminimaxt.h"	/* HT_AIM_DEPTHMAX_MAX */
 #include "board.h"	/* board_* */
 #include "listm.h"	/* listm_clear */
-#include "listmh.h"	/* listmh_copy */
+#include "listmh.h"	/* listmh_copy_rev */
+#ifdef HT_AI_MINIMAX_HASH
+#include "movet.h"	/* HT_BOARDPOS_NONE */
+#endif
+#include "timer.h"	/* ht_timer_ms */
+#include "types.h"	/* type_index_get */
 #include "ui.h"		/* ui_ai_progress */
 
 /*
@@ -60,40 +67,12 @@ static
 const int HT_AIM_VALUE_WIN = INT_MAX - (HT_AIM_DEPTHMAX_MAX + 1);
 
 /*
- * Value of a piece on the board.
- *
- * NOTE:	You can tune this value.
- */
-/*@unchecked@*/
-static
-const int HT_AIM_VALUE_PIECE		= 1000;
-
-/*
- * Value of a possible move by the king (piece with type_piece.escapes).
- *
- * NOTE:	You can tune this value.
- */
-/*@unchecked@*/
-static
-const int HT_AIM_VALUE_MOVE_KING	= 200;
-
-/*
- * When a piece with escape is near an escape square, the value in
- * aiminimax->board_escval for that position is multiplied by this
- * value.
- */
-/*@unchecked@*/
-static
-const int HT_AIM_ESCVAL_KING	= 10;
-
-/*
- * When a piece is near an escape square, the value in
- * aiminimax->board_escval for that position is multiplied by this
- * value.
+ * aim->halt and aim->time_max are looked at when the amount of
+ * positions visited is a multiple of this mask plus 1.
  */
 /*@unchecked@*/
 static
-const int HT_AIM_ESCVAL_NORM	= 1;
+const unsigned long HT_AIM_HALT_MASK = 4095ul;
 
 #ifdef HT_AI_MINIMAX_UNSAFE
 
@@ -104,7 +83,8 @@ const int HT_AIM_ESCVAL_NORM	= 1;
  *
  * If HT_AI_MINIMAX_UNSAFE is enabled, it's still possible that min() or
  * max() calls board_moves_get() which has to allocate memory for more
- * moves in the move list (listm_add() which calls listm_grow()). Thus
+ * moves in the move list (listm_reserve()). The lists in the search
+ * arena never need to, but board_moves_get() can't know that. Thus
  * it's conceivable that we get a HT_FR_FAIL_ALLOC that must be caught.
  * It's not reasonable to ignore out of memory conditions under any
  * circumstances, so this global allows us to check it in search() after
@@ -119,14 +99,112 @@ enum HT_FR opt_fr	= HT_FR_SUCCESS;
 
 #endif /* HT_AI_MINIMAX_UNSAFE */
 
+/*
+ * Returns 1 if the piece adj, next to a king, is owned by the king's
+ * opponent; else 0.
+ */
+static
+int
+aiminimax_attacker (
+	const HT_BIT_U8		adj,
+	const unsigned int	p_owned,
+	const HT_BOOL		king_owned
+	)
+/*@modifies nothing@*/
+{
+	return	HT_BIT_U8_EMPTY != adj
+		&& (((unsigned int)adj & p_owned) == (unsigned int)adj)
+			!= king_owned ? 1 : 0;
+}
+
+/*
+ * Returns the amount of opponent's pieces next to p_index's kings
+ * (pieces with escape), minus the amount of p_index's pieces next to
+ * the opponent's kings.
+ */
+static
+int
+aiminimax_king_attackers (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const HT_RSTR	g,
+/*@in@*/
+/*@notnull@*/
+	const struct board * const HT_RSTR	b,
+	const unsigned short			p_index
+	)
+/*@modifies nothing@*/
+{
+	const struct ruleset * const HT_RSTR r	= g->rules;
+	const unsigned int p_owned =
+		(unsigned int)g->players[p_index]->opt_owned;
+	int		count	= 0;
+	unsigned short	pos;
+
+	for (pos = (unsigned short)0; pos < r->opt_blen; pos++)
+	{
+		const unsigned int pbit	= (unsigned int)b->pieces[pos];
+		const unsigned short x	=
+			(unsigned short)(pos % r->bwidth);
+		const unsigned short y	=
+			(unsigned short)(pos / r->bwidth);
+		HT_BOOL		king_owned;
+		int		adjc	= 0;
+		if (HT_BIT_U8_EMPTY == (HT_BIT_U8)pbit
+		|| (pbit & (unsigned int)r->opt_tp_escape) != pbit)
+		{
+			continue;
+		}
+		king_owned = (pbit & p_owned) == pbit;
+
+		if (x > 0)
+		{
+			adjc += aiminimax_attacker(b->pieces[pos - 1],
+				p_owned, king_owned);
+		}
+		if (x + 1 < r->bwidth)
+		{
+			adjc += aiminimax_attacker(b->pieces[pos + 1],
+				p_owned, king_owned);
+		}
+		if (y > 0)
+		{
+			adjc += aiminimax_attacker(
+				b->pieces[pos - r->bwidth],
+				p_owned, king_owned);
+		}
+		if (y + 1 < r->bheight)
+		{
+			adjc += aiminimax_attacker(
+				b->pieces[pos + r->bwidth],
+				p_owned, king_owned);
+		}
+		count	+= king_owned ? adjc : -adjc;
+	}
+	return	count;
+}
+
 /*
  * Evaluates the board position for aim->p_index.
  *
  * For every player:
  *
- * *	A piece on the board is worth HT_AIM_VALUE_PIECE.
+ * *	A piece on the board is worth aim->eval_psq for its square. This
+ *	is material, which board_move_unsafe keeps up to date.
  *
- * *	A possible move by the king is worth HT_AIM_VALUE_MOVE_KING.
+ * *	A possible move by the king is worth HT_AIM_EVAL_MOVE_KING.
+ *
+ * *	An opponent's piece next to the king is worth
+ *	HT_AIM_EVAL_KING_ATTACKERS.
+ *
+ * The weights are g->eval_conf.weights.
+ *
+ * With HT_AI_MINIMAX_HASH, every leaf is stored in the transposition
+ * table as an exact value, so the table is also the cache of static
+ * evaluations. There is no separate one, since the table is probed
+ * first and would leave it almost nothing.
+ *
+ * NOTE:	aiminimax_features must agree with this.
  */
 static
 int
@@ -139,45 +217,13 @@ aiminimax_evaluate (
 	const struct board * const HT_RSTR	b,
 /*@in@*/
 /*@notnull@*/
-	const struct aiminimax * const HT_RSTR	aim
+	const struct aiminimax * const HT_RSTR	aim,
+	const int				material
 	)
 /*@modifies nothing@*/
 {
-	int		value	= 0;
+	int		value	= material;
 	unsigned short	i;
-	HT_BIT_U8	pbit;
-	HT_BIT_U8	p_owned = g->players[aim->p_index]->opt_owned;
-
-	/*
-	 * Material value.
-	 *
-	 * A piece on the board is worth HT_AIM_VALUE_PIECE.
-	 *
-	 * In addition, it's worth whatever the value of board_escval is
-	 * for that position. For "king" pieces (with escape), it's
-	 * multiplied by HT_AIM_ESCVAL_KING, and for ordinary pieces by
-	 * HT_AIM_ESCVAL_NORM. This makes the computer player a little
-	 * more eager to defend escape squares as well as move the king
-	 * to them.
-	 */
-	for (i = (unsigned short)0; i < g->rules->opt_blen; i++)
-	{
-		pbit	= b->pieces[i];
-		if (HT_BIT_U8_EMPTY != pbit)
-		{
-			const HT_BOOL owned = ((unsigned int)pbit
-				& (unsigned int) p_owned)
-				== (unsigned int)pbit;
-			const HT_BOOL king = ((unsigned int)pbit
-				& (unsigned int)g->rules->opt_tp_escape)
-				== (unsigned int)pbit;
-			value += ((HT_AIM_VALUE_PIECE +
-				aim->board_escval[i] * (king ?
-					HT_AIM_ESCVAL_KING :
-					HT_AIM_ESCVAL_NORM)))
-				* (owned ? 1 : -1);
-		}
-	}
 
 	/*
 	 * Tactical value.
@@ -185,22 +231,275 @@ aiminimax_evaluate (
 	 * It takes a very long time to call board_movec_get, so only do
 	 * it for the player with the king piece. Don't count move value
 	 * for all pieces.
+	 *
+	 * Moves that would repeat a position are counted too, so that the
+	 * value only depends on b, like the transposition table that it's
+	 * stored in assumes.
 	 */
 	for (i = (unsigned short)0; i < g->playerc; i++)
 	{
 		const struct player * const HT_RSTR p = g->players[i];
 		if (HT_BIT_U8_EMPTY != p->opt_owned_esc)
 		{
-			value += ((board_movec_get(g, b,
-				aim->opt_movehist, p->opt_owned_esc)
-				* HT_AIM_VALUE_MOVE_KING)
+			value += ((board_movec_get(g, b, NULL,
+				p->opt_owned_esc)
+				* g->eval_conf.weights
+					[HT_AIM_EVAL_MOVE_KING])
 				* ((aim->p_index == i) ? 1 : -1));
 		}
 	}
 
+	if (0 != g->eval_conf.weights[HT_AIM_EVAL_KING_ATTACKERS])
+	{
+		value += aiminimax_king_attackers(g, b, aim->p_index)
+			* g->eval_conf.weights
+				[HT_AIM_EVAL_KING_ATTACKERS];
+	}
+
 	return	value;
 }
 
+/*
+ * Sets features to the amount of every term in g->eval_conf.weights in
+ * b, from p_index's point of view, and fixed to the sum of
+ * g->eval_conf.psq (which has no weight). aiminimax_evaluate for an
+ * aiminimax of p_index is then fixed plus the sum of every feature
+ * times its weight.
+ *
+ * board_escval is as in aiminimax. This is for tuning the weights, and
+ * is not used by the search.
+ */
+void
+aiminimax_features (
+	const struct game * const HT_RSTR	g,
+	const struct board * const HT_RSTR	b,
+	const int * const HT_RSTR		board_escval,
+	const unsigned short			p_index,
+	int * const HT_RSTR			features,
+	int * const HT_RSTR			fixed
+	)
+{
+	const struct ruleset * const HT_RSTR r	= g->rules;
+	const unsigned int p_owned	=
+		(unsigned int)g->players[p_index]->opt_owned;
+	unsigned short	i;
+	int		t;
+
+	for (t = 0; t < (int)HT_AIM_EVAL_TERMC; t++)
+	{
+		features[t]	= 0;
+	}
+	* fixed	= 0;
+
+	for (i = (unsigned short)0; i < r->opt_blen; i++)
+	{
+		const unsigned int pbit	= (unsigned int)b->pieces[i];
+		int sign;
+		if ((unsigned int)HT_BIT_U8_EMPTY == pbit)
+		{
+			continue;
+		}
+		sign	= (pbit & p_owned) == pbit ? 1 : -1;
+		aiminimax_psq_features(g, board_escval,
+			(pbit & (unsigned int)r->opt_tp_escape) == pbit
+			? HT_TRUE : HT_FALSE, i, sign, features);
+		if (NULL != g->eval_conf.psq)
+		{
+			* fixed	+= sign * g->eval_conf.psq[(size_t)
+				type_index_get((HT_BIT_U8)pbit)
+				* r->opt_blen + i];
+		}
+	}
+
+	for (i = (unsigned short)0; i < g->playerc; i++)
+	{
+		const struct player * const HT_RSTR p = g->players[i];
+		if (HT_BIT_U8_EMPTY != p->opt_owned_esc)
+		{
+			features[HT_AIM_EVAL_MOVE_KING] +=
+				board_movec_get(g, b, NULL,
+				p->opt_owned_esc) * (p_index == i ? 1 : -1);
+		}
+	}
+
+	features[HT_AIM_EVAL_KING_ATTACKERS]	=
+		aiminimax_king_attackers(g, b, p_index);
+}
+
+/*
+ * Sums aim->eval_psq for every piece on b. This is the material that
+ * aiminimax_search starts from; below it, board_move_unsafe updates it
+ * incrementally.
+ */
+static
+int
+aiminimax_material (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const HT_RSTR	g,
+/*@in@*/
+/*@notnull@*/
+	const struct board * const HT_RSTR	b,
+/*@in@*/
+/*@notnull@*/
+	const struct aiminimax * const HT_RSTR	aim
+	)
+/*@modifies nothing@*/
+{
+	int		material	= 0;
+	unsigned short	i;
+	for (i = (unsigned short)0; i < g->rules->opt_blen; i++)
+	{
+		const HT_BIT_U8 pbit	= b->pieces[i];
+		if (HT_BIT_U8_EMPTY != pbit)
+		{
+			material += aim->eval_psq[type_index_get(pbit)
+				* g->rules->opt_blen + i];
+		}
+	}
+	return	material;
+}
+
+#ifdef HT_AI_MINIMAX_HASH
+
+/*
+ * Looks up the position with hashkey and p_turn in aim->tp_tab.
+ *
+ * Returns true if it's stored with at least depthleft, and the stored
+ * value is exact or a bound that falls outside alpha and beta. value is
+ * then set to what aiminimax_min or aiminimax_max should return.
+ *
+ * Otherwise returns false, and sets move_pos and move_dest to the best
+ * move that's stored for the position, or to HT_BOARDPOS_NONE.
+ */
+static
+HT_BOOL
+aiminimax_probe (
+/*@in@*/
+/*@notnull@*/
+	const struct aiminimax * const HT_RSTR	aim,
+	const HT_U64				hashkey,
+	const unsigned short			p_turn,
+	const int				alpha,
+	const int				beta,
+	const unsigned short			depth,
+	const unsigned short			depthleft,
+/*@out@*/
+/*@notnull@*/
+	int * const HT_RSTR			value,
+/*@out@*/
+/*@notnull@*/
+	unsigned short * const HT_RSTR		move_pos,
+/*@out@*/
+/*@notnull@*/
+	unsigned short * const HT_RSTR		move_dest
+	)
+/*@modifies * aim->tp_tab, * value, * move_pos, * move_dest@*/
+{
+	struct zhashnode * const HT_RSTR node =
+		zhashtable_get(aim->tp_tab, hashkey, p_turn);
+	if (NULL == node)
+	{
+		* move_pos	= * move_dest	= HT_BOARDPOS_NONE;
+		return		HT_FALSE;
+	}
+	node->age	= aim->tp_tab->age;
+
+	if ((unsigned short)node->depthleft >= depthleft)
+	{
+		const int nvalue = HT_AIM_VALUE_INFMAX == node->value
+			? node->value - depth : node->value;
+		switch ((enum ZVALUE_TYPE)node->value_type)
+		{
+			case HT_AIM_ZHT_EXACT:
+				* value	= nvalue;
+				return	HT_TRUE;
+			case HT_AIM_ZHT_ALPHA:
+				if (nvalue <= alpha)
+				{
+					* value	= nvalue;
+					return	HT_TRUE;
+				}
+				break;
+			case HT_AIM_ZHT_BETA:
+				if (nvalue >= beta)
+				{
+					* value	= nvalue;
+					return	HT_TRUE;
+				}
+				break;
+			case HT_AIM_ZHT_VACANT:
+			default:
+				break;
+		}
+	}
+
+	* move_pos	= node->move_pos;
+	* move_dest	= node->move_dest;
+	return		HT_FALSE;
+}
+
+/*
+ * Swaps the move from pos to dest to the front of moves, if it's in
+ * moves, so that it's searched first. pos may be HT_BOARDPOS_NONE.
+ */
+static
+void
+aiminimax_order (
+/*@in@*/
+/*@notnull@*/
+	struct listm * const HT_RSTR	moves,
+	const unsigned short		pos,
+	const unsigned short		dest
+	)
+/*@modifies * moves@*/
+{
+	size_t i;
+	if (HT_BOARDPOS_NONE == pos)
+	{
+		return;
+	}
+	for (i = (size_t)1; i < moves->elemc; i++)
+	{
+		if (pos == moves->elems[i].pos
+		&& dest == moves->elems[i].dest)
+		{
+			const struct move mtmp	= moves->elems[i];
+			moves->elems[i]		= moves->elems[0];
+			moves->elems[0]		= mtmp;
+			return;
+		}
+	}
+}
+
+#endif /* HT_AI_MINIMAX_HASH */
+
+/*
+ * Returns true if the search has been stopped by aim->halt or
+ * aim->time_max (and sets aim->halted). Once it has, aiminimax_min and
+ * aiminimax_max return at once, without storing anything in the
+ * transposition table, and their values are meaningless.
+ */
+static
+HT_BOOL
+aiminimax_halt (
+/*@in@*/
+/*@notnull@*/
+	struct aiminimax * const HT_RSTR	aim
+	)
+/*@globals internalState@*/
+/*@modifies internalState, * aim@*/
+{
+	if (!aim->halted && 0ul == (aim->nodes & HT_AIM_HALT_MASK)
+	&& ((NULL != aim->halt && * aim->halt)
+	|| (aim->time_max > 0ul
+	&& ht_timer_ms() - aim->time_start >= aim->time_max)))
+	{
+		aim->halted	= HT_TRUE;
+	}
+	return	aim->halted;
+}
+
 /*@-protoparamname@*/
 static
 int
@@ -218,11 +517,10 @@ aiminimax_min (
 	int					beta,
 	const unsigned short			depth,
 	const unsigned short			depthmax
-#ifdef HT_AI_MINIMAX_HASH
 	,
-	const unsigned int			hashkey,
-	const unsigned int			hashlock
-#endif
+/*@in@*/
+/*@notnull@*/
+	const struct board_inc * const HT_RSTR	inc
 #ifndef HT_AI_MINIMAX_UNSAFE
 	,
 /*@in@*/
@@ -259,11 +557,10 @@ aiminimax_max (
 	const int				beta,
 	const unsigned short			depth,
 	const unsigned short			depthmax
-#ifdef HT_AI_MINIMAX_HASH
 	,
-	const unsigned int			hashkey,
-	const unsigned int			hashlock
-#endif
+/*@in@*/
+/*@notnull@*/
+	const struct board_inc * const HT_RSTR	inc
 #ifndef HT_AI_MINIMAX_UNSAFE
 	,
 /*@in@*/
@@ -279,26 +576,22 @@ aiminimax_max (
 	unsigned short			winner	= HT_PLAYER_UNINIT;
 
 #ifdef HT_AI_MINIMAX_HASH
-	struct zhashnode * const HT_RSTR node	= zhashtable_get
-		(aim->tp_tab, hashkey, hashlock, b_old->turn);
-	if (NULL != node
-	&& node->depthleft >= (unsigned short)(depthmax - depth))
+	unsigned short			move_pos, move_dest;
+	int				hashval;
+#endif
+
+	aim->nodes++;
+	if (aiminimax_halt(aim))
 	{
-		/*
-		 * NOTE:	Assumes that value can't be VACANT.
-		 */
-		if (HT_AIM_ZHT_BETA != node->value_type)
-		{
-			node->used	= HT_TRUE;
-			if (HT_AIM_VALUE_INFMAX == node->value)
-			{
-				return		node->value - depth;
-			}
-			else
-			{
-				return		node->value;
-			}
-		}
+		return	0;
+	}
+
+#ifdef HT_AI_MINIMAX_HASH
+	if (aiminimax_probe(aim, b_old->key, b_old->turn, alpha, beta,
+		depth, (unsigned short)(depthmax - depth), & hashval,
+		& move_pos, & move_dest))
+	{
+		return	hashval;
 	}
 #endif
 
@@ -307,29 +600,35 @@ aiminimax_max (
 		if (aim->p_index == winner)
 		{
 #ifdef HT_AI_MINIMAX_HASH
-			zhashtable_put(aim->tp_tab, b_old,
-				HT_AIM_VALUE_INFMAX, HT_AIM_ZHT_EXACT,
-				(unsigned short)(depthmax - depth));
+			zhashtable_put(aim->tp_tab, b_old->key,
+				b_old->turn, HT_AIM_VALUE_INFMAX,
+				HT_AIM_ZHT_EXACT,
+				(unsigned short)(depthmax - depth),
+				HT_BOARDPOS_NONE, HT_BOARDPOS_NONE);
 #endif
 			return	HT_AIM_VALUE_INFMAX - depth;
 		}
 		else
 		{
 #ifdef HT_AI_MINIMAX_HASH
-			zhashtable_put(aim->tp_tab, b_old,
-				HT_AIM_VALUE_INFMIN, HT_AIM_ZHT_EXACT,
-				(unsigned short)(depthmax - depth));
+			zhashtable_put(aim->tp_tab, b_old->key,
+				b_old->turn, HT_AIM_VALUE_INFMIN,
+				HT_AIM_ZHT_EXACT,
+				(unsigned short)(depthmax - depth),
+				HT_BOARDPOS_NONE, HT_BOARDPOS_NONE);
 #endif
 			return	HT_AIM_VALUE_INFMIN;
 		}
 	}
 	else if (depth >= depthmax)
 	{
-		const int value = aiminimax_evaluate(g, b_old, aim);
+		const int value = aiminimax_evaluate(g, b_old, aim,
+			inc->material);
 #ifdef HT_AI_MINIMAX_HASH
-		zhashtable_put(aim->tp_tab, b_old, value,
-			HT_AIM_ZHT_EXACT,
-			(unsigned short)(depthmax - depth));
+		zhashtable_put(aim->tp_tab, b_old->key, b_old->turn,
+			value, HT_AIM_ZHT_EXACT,
+			(unsigned short)(depthmax - depth),
+			HT_BOARDPOS_NONE, HT_BOARDPOS_NONE);
 #endif
 		return	value;
 	}
@@ -337,11 +636,8 @@ aiminimax_max (
 	{
 		int			tmp	= 0;
 		size_t			i;
-		struct listm * const moves = aim->opt_buf_moves[depth];
+		struct listm * const moves = & aim->opt_buf_moves[depth];
 		struct move * HT_RSTR	mov;
-#ifdef HT_AI_MINIMAX_HASH
-		unsigned int		keytmp, locktmp;
-#endif
 		listm_clear(moves);
 
 #ifndef HT_AI_MINIMAX_UNSAFE
@@ -369,25 +665,26 @@ aiminimax_max (
 			* fr	= HT_FR_FAIL_ILL_STATE;
 			return	HT_AIM_VALUE_INFMIN;
 		}
+#endif
+#ifdef HT_AI_MINIMAX_HASH
+		aiminimax_order(moves, move_pos, move_dest);
+		move_pos	= HT_BOARDPOS_NONE;
 #endif
 		for (i = (size_t)0; i < moves->elemc; i++)
 		{
 			struct board * const b_new =
-				aim->opt_buf_board[depth];
+				& aim->opt_buf_board[depth];
+			struct board_inc * const inc_new =
+				& aim->opt_buf_inc[depth];
 			board_copy(b_old, b_new, g->rules->opt_blen);
-			mov	= & moves->elems[i];
-#ifdef HT_AI_MINIMAX_HASH
-			keytmp	= hashkey;
-			locktmp	= hashlock;
-#endif
+			mov		= & moves->elems[i];
+			* inc_new	= * inc;
 
 #ifndef HT_AI_MINIMAX_UNSAFE
 			* fr =
 				board_move_unsafe(g, b_new,
 				aim->opt_movehist, mov->pos, mov->dest
-#ifdef HT_AI_MINIMAX_HASH
-				, aim->tp_tab, & keytmp, & locktmp
-#endif
+				, inc_new
 				);
 			if (HT_FR_SUCCESS != * fr)
 			{
@@ -396,9 +693,7 @@ aiminimax_max (
 #else /* ifdef HT_AI_MINIMAX_UNSAFE */
 			if (HT_FR_SUCCESS != board_move_unsafe(g, b_new,
 				aim->opt_movehist, mov->pos, mov->dest
-#ifdef HT_AI_MINIMAX_HASH
-				, aim->tp_tab, & keytmp, & locktmp
-#endif
+				, inc_new
 				))
 			{
 				opt_fr	= HT_FR_FAIL_ALLOC;
@@ -408,9 +703,7 @@ aiminimax_max (
 
 			tmp = aiminimax_min(g, b_new, aim, alpha, beta,
 				(unsigned short)(depth + 1), depthmax
-#ifdef HT_AI_MINIMAX_HASH
-				, keytmp, locktmp
-#endif
+				, inc_new
 #ifndef HT_AI_MINIMAX_UNSAFE
 				, fr
 #endif
@@ -423,26 +716,51 @@ aiminimax_max (
 #endif
 
 			aim->opt_movehist->elemc--;
+			if (aim->halted)
+			{
+				return	0;
+			}
 
 			if (tmp > alpha)
 			{
 				alpha	= tmp;
+#ifdef HT_AI_MINIMAX_HASH
+				move_pos	= mov->pos;
+				move_dest	= mov->dest;
+#endif
 			}
 			if (alpha >= beta)
 			{
 #ifdef HT_AI_MINIMAX_HASH
-				zhashtable_put(aim->tp_tab, b_new,
-					alpha, HT_AIM_ZHT_ALPHA,
+				zhashtable_put(aim->tp_tab,
+					b_old->key, b_old->turn,
+					alpha, HT_AIM_ZHT_BETA,
 					(unsigned short)
-						(depthmax - depth));
+						(depthmax - depth),
+					mov->pos, mov->dest);
 #endif
 				return	alpha;
 			}
 		}
 #ifdef HT_AI_MINIMAX_HASH
-		zhashtable_put(aim->tp_tab, b_old, alpha,
-			HT_AIM_ZHT_ALPHA,
-			(unsigned short)(depthmax - depth));
+		/*
+		 * If no move improved alpha, then move_pos is still
+		 * HT_BOARDPOS_NONE and it's only a bound.
+		 */
+		if (HT_BOARDPOS_NONE != move_pos)
+		{
+			zhashtable_put(aim->tp_tab, b_old->key,
+				b_old->turn, alpha, HT_AIM_ZHT_EXACT,
+				(unsigned short)(depthmax - depth),
+				move_pos, move_dest);
+		}
+		else
+		{
+			zhashtable_put(aim->tp_tab, b_old->key,
+				b_old->turn, alpha, HT_AIM_ZHT_ALPHA,
+				(unsigned short)(depthmax - depth),
+				HT_BOARDPOS_NONE, HT_BOARDPOS_NONE);
+		}
 #endif
 		return	alpha;
 	}
@@ -455,7 +773,8 @@ aiminimax_max (
  *
  * Upon successful return, returns an evaluated value.
  *
- * Upon failed return, returns 0.
+ * Upon failed return, or if the search has been stopped (see
+ * aiminimax_halt), returns 0.
  *
  * This function never sets HT_FR fr parameter to anything else but a
  * failure code in the event of a failure. It assumes that the fr
@@ -463,9 +782,9 @@ aiminimax_max (
  * change it upon successful execution.
  *
  * If HT_AI_MINIMAX_UNSAFE is enabled, then this function could possibly
- * receive a HT_FR_FAIL_ALLOC from listm_add(). If so, it aborts. This
- * only happens if HT_AI_MINIMAX_UNSAFE is enabled -- it doesn't abort
- * otherwise.
+ * receive a HT_FR_FAIL_ALLOC from listm_reserve(). If so, it aborts.
+ * This only happens if HT_AI_MINIMAX_UNSAFE is enabled -- it doesn't
+ * abort otherwise.
  *
  * Stops searching when depth >= depth_max.
  */
@@ -479,10 +798,7 @@ aiminimax_min (
 	int					beta,
 	const unsigned short			depth,
 	const unsigned short			depthmax
-#ifdef HT_AI_MINIMAX_HASH
-	, const unsigned int			hashkey,
-	const unsigned int			hashlock
-#endif
+	, const struct board_inc * const HT_RSTR	inc
 #ifndef HT_AI_MINIMAX_UNSAFE
 	,
 	enum HT_FR * const			fr
@@ -497,26 +813,22 @@ aiminimax_min (
 	unsigned short			winner	= HT_PLAYER_UNINIT;
 
 #ifdef HT_AI_MINIMAX_HASH
-	struct zhashnode * const HT_RSTR node	= zhashtable_get
-		(aim->tp_tab, hashkey, hashlock, b_old->turn);
-	if (NULL != node
-	&& node->depthleft >= (unsigned short)(depthmax - depth))
+	unsigned short			move_pos, move_dest;
+	int				hashval;
+#endif
+
+	aim->nodes++;
+	if (aiminimax_halt(aim))
 	{
-		/*
-		 * Position already evaluated.
-		 */
-		if (HT_AIM_ZHT_ALPHA != node->value_type)
-		{
-			node->used	= HT_TRUE;
-			if (HT_AIM_VALUE_INFMAX == node->value)
-			{
-				return		node->value - depth;
-			}
-			else
-			{
-				return		node->value;
-			}
-		}
+		return	0;
+	}
+
+#ifdef HT_AI_MINIMAX_HASH
+	if (aiminimax_probe(aim, b_old->key, b_old->turn, alpha, beta,
+		depth, (unsigned short)(depthmax - depth), & hashval,
+		& move_pos, & move_dest))
+	{
+		return	hashval;
 	}
 #endif
 
@@ -525,29 +837,35 @@ aiminimax_min (
 		if (aim->p_index == winner)
 		{
 #ifdef HT_AI_MINIMAX_HASH
-			zhashtable_put(aim->tp_tab, b_old,
-				HT_AIM_VALUE_INFMAX, HT_AIM_ZHT_EXACT,
-				(unsigned short)(depthmax - depth));
+			zhashtable_put(aim->tp_tab, b_old->key,
+				b_old->turn, HT_AIM_VALUE_INFMAX,
+				HT_AIM_ZHT_EXACT,
+				(unsigned short)(depthmax - depth),
+				HT_BOARDPOS_NONE, HT_BOARDPOS_NONE);
 #endif
 			return	HT_AIM_VALUE_INFMAX - depth;
 		}
 		else
 		{
 #ifdef HT_AI_MINIMAX_HASH
-			zhashtable_put(aim->tp_tab, b_old,
-				HT_AIM_VALUE_INFMIN, HT_AIM_ZHT_EXACT,
-				(unsigned short)(depthmax - depth));
+			zhashtable_put(aim->tp_tab, b_old->key,
+				b_old->turn, HT_AIM_VALUE_INFMIN,
+				HT_AIM_ZHT_EXACT,
+				(unsigned short)(depthmax - depth),
+				HT_BOARDPOS_NONE, HT_BOARDPOS_NONE);
 #endif
 			return	HT_AIM_VALUE_INFMIN;
 		}
 	}
 	else if (depth >= depthmax)
 	{
-		const int value = aiminimax_evaluate(g, b_old, aim);
+		const int value = aiminimax_evaluate(g, b_old, aim,
+			inc->material);
 #ifdef HT_AI_MINIMAX_HASH
-		zhashtable_put(aim->tp_tab, b_old, value,
-			HT_AIM_ZHT_EXACT,
-			(unsigned short)(depthmax - depth));
+		zhashtable_put(aim->tp_tab, b_old->key, b_old->turn,
+			value, HT_AIM_ZHT_EXACT,
+			(unsigned short)(depthmax - depth),
+			HT_BOARDPOS_NONE, HT_BOARDPOS_NONE);
 #endif
 		return	value;
 	}
@@ -555,11 +873,8 @@ aiminimax_min (
 	{
 		int			tmp	= 0;
 		size_t			i;
-		struct listm * const moves = aim->opt_buf_moves[depth];
+		struct listm * const moves = & aim->opt_buf_moves[depth];
 		struct move * HT_RSTR	mov;
-#ifdef HT_AI_MINIMAX_HASH
-		unsigned int		keytmp, locktmp;
-#endif
 		listm_clear(moves);
 
 #ifndef HT_AI_MINIMAX_UNSAFE
@@ -587,25 +902,26 @@ aiminimax_min (
 			* fr	= HT_FR_FAIL_ILL_STATE;
 			return	HT_AIM_VALUE_INFMIN;
 		}
+#endif
+#ifdef HT_AI_MINIMAX_HASH
+		aiminimax_order(moves, move_pos, move_dest);
+		move_pos	= HT_BOARDPOS_NONE;
 #endif
 		for (i = (size_t)0; i < moves->elemc; i++)
 		{
 			struct board * const b_new =
-				aim->opt_buf_board[depth];
+				& aim->opt_buf_board[depth];
+			struct board_inc * const inc_new =
+				& aim->opt_buf_inc[depth];
 			board_copy(b_old, b_new, g->rules->opt_blen);
-			mov	= & moves->elems[i];
-#ifdef HT_AI_MINIMAX_HASH
-			keytmp	= hashkey;
-			locktmp	= hashlock;
-#endif
+			mov		= & moves->elems[i];
+			* inc_new	= * inc;
 
 #ifndef HT_AI_MINIMAX_UNSAFE
 			* fr =
 				board_move_unsafe(g, b_new,
 				aim->opt_movehist, mov->pos, mov->dest
-#ifdef HT_AI_MINIMAX_HASH
-				, aim->tp_tab, & keytmp, & locktmp
-#endif
+				, inc_new
 				);
 			if (HT_FR_SUCCESS != * fr)
 			{
@@ -614,9 +930,7 @@ aiminimax_min (
 #else /* ifdef HT_AI_MINIMAX_UNSAFE */
 			if (HT_FR_SUCCESS != board_move_unsafe(g, b_new,
 				aim->opt_movehist, mov->pos, mov->dest
-#ifdef HT_AI_MINIMAX_HASH
-				, aim->tp_tab, & keytmp, & locktmp
-#endif
+				, inc_new
 				))
 			{
 				opt_fr	= HT_FR_FAIL_ALLOC;
@@ -626,9 +940,7 @@ aiminimax_min (
 
 			tmp = aiminimax_max(g, b_new, aim, alpha, beta,
 				(unsigned short)(depth + 1), depthmax
-#ifdef HT_AI_MINIMAX_HASH
-				, keytmp, locktmp
-#endif
+				, inc_new
 #ifndef HT_AI_MINIMAX_UNSAFE
 				, fr
 #endif
@@ -641,26 +953,51 @@ aiminimax_min (
 #endif
 
 			aim->opt_movehist->elemc--;
+			if (aim->halted)
+			{
+				return	0;
+			}
 
 			if (tmp < beta)
 			{
 				beta	= tmp;
+#ifdef HT_AI_MINIMAX_HASH
+				move_pos	= mov->pos;
+				move_dest	= mov->dest;
+#endif
 			}
 			if (alpha >= beta)
 			{
 #ifdef HT_AI_MINIMAX_HASH
-				zhashtable_put(aim->tp_tab, b_new,
-					beta, HT_AIM_ZHT_BETA,
+				zhashtable_put(aim->tp_tab,
+					b_old->key, b_old->turn,
+					beta, HT_AIM_ZHT_ALPHA,
 					(unsigned short)
-						(depthmax - depth));
+						(depthmax - depth),
+					mov->pos, mov->dest);
 #endif
 				return	beta;
 			}
 		}
 #ifdef HT_AI_MINIMAX_HASH
-		zhashtable_put(aim->tp_tab, b_old, beta,
-			HT_AIM_ZHT_BETA,
-			(unsigned short)(depthmax - depth));
+		/*
+		 * If no move improved beta, then move_pos is still
+		 * HT_BOARDPOS_NONE and it's only a bound.
+		 */
+		if (HT_BOARDPOS_NONE != move_pos)
+		{
+			zhashtable_put(aim->tp_tab, b_old->key,
+				b_old->turn, beta, HT_AIM_ZHT_EXACT,
+				(unsigned short)(depthmax - depth),
+				move_pos, move_dest);
+		}
+		else
+		{
+			zhashtable_put(aim->tp_tab, b_old->key,
+				b_old->turn, beta, HT_AIM_ZHT_BETA,
+				(unsigned short)(depthmax - depth),
+				HT_BOARDPOS_NONE, HT_BOARDPOS_NONE);
+		}
 #endif
 		return	beta;
 	}
@@ -677,6 +1014,9 @@ aiminimax_min (
  * not only the best move that it could find, but also a certain win
  * that should be carried out immediately without calling this function
  * again.
+ *
+ * If the search isn't stopped by the interface, aim->value is set to
+ * the value of the best move.
  */
 static
 enum HT_FR
@@ -714,9 +1054,7 @@ aiminimax_search (
 	struct move * HT_RSTR	mtmp;
 	struct listm *		moves	= NULL;
 	struct move		mcache;
-#ifdef HT_AI_MINIMAX_HASH
-	unsigned int		hashkey, hashlock;
-#endif
+	struct board_inc	inc, inctmp;
 	/*
 	 * aim->opt_moves is the list of moves that we are using in the
 	 * search.
@@ -740,9 +1078,10 @@ aiminimax_search (
 #endif
 
 #ifdef HT_AI_MINIMAX_HASH
-	hashkey		= zhashkey	(aim->tp_tab, b_orig);
-	hashlock	= zhashlock	(aim->tp_tab, b_orig);
+	inc.hashtable	= aim->tp_tab;
 #endif
+	inc.psq		= aim->eval_psq;
+	inc.material	= aiminimax_material(g, b_orig, aim);
 
 	moves		= aim->opt_moves;
 	mcache.pos	= moves->elems[0].pos;
@@ -772,16 +1111,15 @@ aiminimax_search (
 			break;
 		}
 
-		b_new	= aim->opt_buf_board[0];
+		b_new	= & aim->opt_buf_board[0];
 		mtmp	= & moves->elems[i];
 
 		board_copy(b_orig, b_new, g->rules->opt_blen);
+		inctmp	= inc;
 
 		fr = board_move_unsafe(g, b_new, aim->opt_movehist,
 			mtmp->pos, mtmp->dest
-#ifdef HT_AI_MINIMAX_HASH
-			, aim->tp_tab , & hashkey, & hashlock
-#endif
+			, & inctmp
 			);
 		if (HT_FR_SUCCESS != fr)
 		{
@@ -796,9 +1134,7 @@ aiminimax_search (
 #endif
 		value = aiminimax_min(g, b_new, aim, alpha, beta,
 			(unsigned short)1, depth_cur
-#ifdef HT_AI_MINIMAX_HASH
-			, hashkey, hashlock
-#endif
+			, & inctmp
 #ifndef HT_AI_MINIMAX_UNSAFE
 			, & fr
 #endif
@@ -823,6 +1159,16 @@ aiminimax_search (
 		 */
 		aim->opt_movehist->elemc--;
 
+		if (aim->halted)
+		{
+			/*
+			 * value is meaningless: keep the best move found
+			 * so far, like ui_ai_stop does.
+			 */
+			* ui_stop	= HT_TRUE;
+			break;
+		}
+
 		if (value > alpha)
 		{
 			/*
@@ -897,6 +1243,11 @@ aiminimax_search (
 #endif
 	}
 
+	if (!(* ui_stop))
+	{
+		aim->value	= alpha;
+	}
+
 	fr	= ui_ai_progress(interf, HT_AIPROG_DONE);
 	if (HT_FR_SUCCESS != fr)
 	{
@@ -959,13 +1310,20 @@ aiminimax_command (
 	act->type			= HT_UI_ACT_UNK;
 	b_orig				= g->b;
 	win_found	= ui_stop	= HT_FALSE;
+	aim->nodes			= 0;
+	aim->value			= 0;
+	aim->halted			= HT_FALSE;
 
 	/*
 	 * Move count is aim->opt_moves.elemc.
 	 */
 	listm_clear(aim->opt_moves);
 
-	fr	= listmh_copy(g->movehist, aim->opt_movehist);
+	/*
+	 * The search only needs the moves since the last irreversible
+	 * one, however long the game is.
+	 */
+	fr	= listmh_copy_rev(g->movehist, aim->opt_movehist);
 	if (HT_FR_SUCCESS != fr)
 	{
 		return	fr;
@@ -991,21 +1349,9 @@ aiminimax_command (
 	}
 
 #ifdef HT_AI_MINIMAX_HASH
-	fr	= zhashtable_clearunused(aim->tp_tab);
-	if (HT_FR_SUCCESS != fr)
-	{
-		return	fr;
-	}
+	zhashtable_age(aim->tp_tab);
 #endif
 
-	/*
-	 * NOTE:	If aim->tp_tab->cols->elemc >=
-	 *		aim->tp_tab->cols->capc, then we have depleted
-	 *		all available memory for collisions, and
-	 *		increasing HT_AI_MINIMAX_HASH_MEM_COL would
-	 *		help.
-	 */
-
 	/*
 	 * aim->opt_moves->elems[0] will always be the best move.
 	 */
@@ -21,6 +21,7 @@
 #define HT_AIMALGO_H
 
 #include "aiminimaxt.h"	/* aiminimax */
+#include "boardt.h"	/* board */
 #include "boolt.h"	/* HT_BOOL */
 #include "config.h"	/* HT_RSTR */
 #include "funct.h"	/* HT_FR */
@@ -49,6 +50,31 @@ aiminimax_command (
 ;
 /*@=protoparamname@*/
 
+/*@-protoparamname@*/
+extern
+void
+aiminimax_features (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const HT_RSTR	g,
+/*@in@*/
+/*@notnull@*/
+	const struct board * const HT_RSTR	b,
+/*@in@*/
+/*@notnull@*/
+	const int * const HT_RSTR		board_escval,
+	const unsigned short			p_index,
+/*@out@*/
+/*@notnull@*/
+	int * const HT_RSTR			features,
+/*@out@*/
+/*@notnull@*/
+	int * const HT_RSTR			fixed
+	)
+/*@modifies * features, * fixed@*/
+;
+/*@=protoparamname@*/
+
 #endif
 
 #endif
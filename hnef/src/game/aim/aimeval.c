@@ -0,0 +1,147 @@
+/* Copyright 2013 Alexander Söderlund.
+ *
+ * This file is part of HNEFATAFL.
+ *
+ * HNEFATAFL is free software: you can distribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * HNEFATAFL is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HT_AI_MINIMAX
+
+#include <stdlib.h>	/* malloc, free */
+#include <string.h>	/* memcpy */
+
+#include "aimeval.h"
+#include "lang.h"	/* HT_L_AIMEVAL_CMD_* */
+#include "types.h"	/* HT_TYPE_MAX */
+
+const char * const HT_AIM_EVAL_FILE_SUFFIX	= ".weights";
+
+const int HT_AIM_EVAL_WEIGHT_MAX		= 100000;
+
+/*
+ * Default weights, used for every term that the weights file doesn't
+ * set, or for all terms if there is no weights file.
+ *
+ * NOTE:	You can tune these values, but it's better to do it per
+ *		ruleset in its weights file.
+ */
+/*@unchecked@*/
+static
+const int HT_AIM_EVAL_DEF[HT_AIM_EVAL_TERMC] =
+{
+	1000,	/* HT_AIM_EVAL_PIECE */
+	200,	/* HT_AIM_EVAL_MOVE_KING */
+	10,	/* HT_AIM_EVAL_ESCVAL_KING */
+	1,	/* HT_AIM_EVAL_ESCVAL_NORM */
+	0,	/* HT_AIM_EVAL_KING_ESCDIST */
+	0,	/* HT_AIM_EVAL_KING_ATTACKERS */
+	0,	/* HT_AIM_EVAL_EDGE */
+	0	/* HT_AIM_EVAL_CORNER */
+};
+
+/*
+ * Sets conf to the default weights, without piece-square tables.
+ */
+void
+aimevalconf_init (
+	struct aimevalconf * const HT_RSTR	conf
+	)
+{
+	size_t i;
+	for (i = (size_t)0; i < (size_t)HT_AIM_EVAL_TERMC; i++)
+	{
+		conf->weights[i]	= HT_AIM_EVAL_DEF[i];
+	}
+	conf->psq	= NULL;
+}
+
+/*
+ * Returns the name of term in the weights file, or NULL if it's not a
+ * term.
+ */
+const char *
+aimeval_term_name (
+	const enum HT_AIM_EVAL	term
+	)
+{
+	switch (term)
+	{
+		case HT_AIM_EVAL_PIECE:
+			return	HT_L_AIMEVAL_CMD_PIECE;
+		case HT_AIM_EVAL_MOVE_KING:
+			return	HT_L_AIMEVAL_CMD_MOVE_KING;
+		case HT_AIM_EVAL_ESCVAL_KING:
+			return	HT_L_AIMEVAL_CMD_ESCVAL_KING;
+		case HT_AIM_EVAL_ESCVAL_NORM:
+			return	HT_L_AIMEVAL_CMD_ESCVAL_NORM;
+		case HT_AIM_EVAL_KING_ESCDIST:
+			return	HT_L_AIMEVAL_CMD_KING_ESCDIST;
+		case HT_AIM_EVAL_KING_ATTACKERS:
+			return	HT_L_AIMEVAL_CMD_KING_ATTACKERS;
+		case HT_AIM_EVAL_EDGE:
+			return	HT_L_AIMEVAL_CMD_EDGE;
+		case HT_AIM_EVAL_CORNER:
+			return	HT_L_AIMEVAL_CMD_CORNER;
+		case HT_AIM_EVAL_TERMC:
+		default:
+			return	NULL;
+	}
+}
+
+/*
+ * Sets dest, which must be initialized, to the weights and piece-square
+ * tables of src, for a ruleset with blen squares.
+ */
+enum HT_FR
+aimevalconf_copy (
+	struct aimevalconf * const HT_RSTR		dest,
+	const struct aimevalconf * const HT_RSTR	src,
+	const unsigned short				blen
+	)
+{
+	const size_t	len	= sizeof(* src->psq) * HT_TYPE_MAX
+				* (size_t)blen;
+	size_t		i;
+
+	for (i = (size_t)0; i < (size_t)HT_AIM_EVAL_TERMC; i++)
+	{
+		dest->weights[i]	= src->weights[i];
+	}
+	aimevalconf_free(dest);
+	if (NULL == src->psq)
+	{
+		return	HT_FR_SUCCESS;
+	}
+
+	dest->psq	= malloc(len);
+	if (NULL == dest->psq)
+	{
+		return	HT_FR_FAIL_ALLOC;
+	}
+	memcpy	(dest->psq, src->psq, len);
+	return	HT_FR_SUCCESS;
+}
+
+void
+aimevalconf_free (
+	struct aimevalconf * const HT_RSTR	conf
+	)
+{
+	if (NULL != conf->psq)
+	{
+		free	(conf->psq);
+		conf->psq	= NULL;
+	}
+}
+
+#endif
@@ -0,0 +1,95 @@
+/* Copyright 2013 Alexander Söderlund.
+ *
+ * This file is part of HNEFATAFL.
+ *
+ * HNEFATAFL is free software: you can distribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * HNEFATAFL is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HT_AI_MINIMAX
+
+#ifndef HT_AIMEVAL_H
+#define HT_AIMEVAL_H
+
+#include "aimevalt.h"	/* aimevalconf */
+#include "config.h"	/* HT_RSTR */
+#include "funct.h"	/* HT_FR */
+
+/*
+ * Appended to the ruleset file to get its weights file.
+ */
+/*@observer@*/
+/*@unchecked@*/
+extern
+const char * const HT_AIM_EVAL_FILE_SUFFIX;
+
+/*
+ * Largest absolute value of a weight.
+ */
+/*@unchecked@*/
+extern
+const int HT_AIM_EVAL_WEIGHT_MAX;
+
+/*@-protoparamname@*/
+extern
+void
+aimevalconf_init (
+/*@notnull@*/
+/*@out@*/
+	struct aimevalconf * const HT_RSTR	conf
+	)
+/*@modifies * conf@*/
+;
+/*@=protoparamname@*/
+
+/*@-protoparamname@*/
+/*@observer@*/
+/*@null@*/
+extern
+const char *
+aimeval_term_name (
+	const enum HT_AIM_EVAL	term
+	)
+/*@modifies nothing@*/
+;
+/*@=protoparamname@*/
+
+/*@-protoparamname@*/
+extern
+enum HT_FR
+aimevalconf_copy (
+/*@notnull@*/
+	struct aimevalconf * const HT_RSTR		dest,
+/*@in@*/
+/*@notnull@*/
+	const struct aimevalconf * const HT_RSTR	src,
+	const unsigned short				blen
+	)
+/*@modifies * dest@*/
+;
+/*@=protoparamname@*/
+
+/*@-protoparamname@*/
+extern
+void
+aimevalconf_free (
+/*@notnull@*/
+	struct aimevalconf * const HT_RSTR	conf
+	)
+/*@modifies conf->psq@*/
+/*@releases conf->psq@*/
+;
+/*@=protoparamname@*/
+
+#endif
+
+#endif
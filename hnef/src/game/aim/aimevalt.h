@@ -0,0 +1,108 @@
+/* Copyright 2013 Alexander Söderlund.
+ *
+ * This file is part of HNEFATAFL.
+ *
+ * HNEFATAFL is free software: you can distribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * HNEFATAFL is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HT_AI_MINIMAX
+
+#ifndef HT_AIMEVAL_T_H
+#define HT_AIMEVAL_T_H
+
+/*
+ * Index of an evaluation term in aimevalconf->weights.
+ *
+ * Every term is worth its weight to the player that owns the piece it's
+ * about, and the negated weight to the opponent.
+ */
+enum HT_AIM_EVAL
+{
+
+	/*
+	 * A piece on the board.
+	 */
+	HT_AIM_EVAL_PIECE		= 0,
+
+	/*
+	 * A possible move by a piece with escape ("king").
+	 */
+	HT_AIM_EVAL_MOVE_KING,
+
+	/*
+	 * Multiplies aiminimax->board_escval for the square of a king.
+	 */
+	HT_AIM_EVAL_ESCVAL_KING,
+
+	/*
+	 * Multiplies aiminimax->board_escval for the square of any
+	 * other piece.
+	 */
+	HT_AIM_EVAL_ESCVAL_NORM,
+
+	/*
+	 * Every step from a king to the closest escape square, counted
+	 * orthogonally and ignoring pieces in the way.
+	 */
+	HT_AIM_EVAL_KING_ESCDIST,
+
+	/*
+	 * Every opponent's piece next to a king.
+	 */
+	HT_AIM_EVAL_KING_ATTACKERS,
+
+	/*
+	 * A piece that isn't a king on the edge of the board.
+	 */
+	HT_AIM_EVAL_EDGE,
+
+	/*
+	 * A piece that isn't a king next to a corner of the board.
+	 */
+	HT_AIM_EVAL_CORNER,
+
+	/*
+	 * Amount of terms. Not a term.
+	 */
+	HT_AIM_EVAL_TERMC
+
+};
+
+/*
+ * Evaluation weights for a ruleset, read from its weights file.
+ */
+/*@exposed@*/
+struct aimevalconf
+{
+
+	/*
+	 * Weight of every term, indexed by HT_AIM_EVAL.
+	 */
+	int		weights[HT_AIM_EVAL_TERMC];
+
+	/*
+	 * Added to the value of a piece type on a square. Length is
+	 * HT_TYPE_MAX * ruleset->opt_blen, indexed like
+	 * aiminimax->eval_psq.
+	 *
+	 * NULL if the weights file has no piece-square tables.
+	 */
+/*@null@*/
+/*@owned@*/
+	int *		psq;
+
+};
+
+#endif
+
+#endif
@@ -17,184 +17,366 @@
  */
 #ifdef HT_AI_MINIMAX_HASH
 
-#include <errno.h>	/* errno */
-#include <math.h>	/* sqrt */
+#include <limits.h>	/* UCHAR_MAX, INT_MAX */
+#include <stddef.h>	/* offsetof */
+#include <stdio.h>	/* fopen, fread, fwrite, fclose */
+#include <string.h>	/* memset, memcpy, memcmp, strncpy */
+#ifdef HT_POSIX
+#include <fcntl.h>	/* open */
+#include <sys/mman.h>	/* mmap, madvise, munmap */
+#include <unistd.h>	/* lseek, close */
+#endif
 
 #include "aimhash.h"
 #include "config.h"	/* Validate HT_AI_MINIMAX_HASH_* values. */
-#include "types.h"	/* type_index_get */
+#include "fnv.h"	/* HT_FNV_HEX_LEN */
+#include "movet.h"	/* HT_BOARDPOS_NONE */
+
+const size_t HT_ZHASH_MEM_TAB_DEF	= (size_t)HT_AI_MINIMAX_HASH_MEM_TAB;
 
+const size_t HT_ZHASH_MEM_TAB_MIN	= (size_t)1048576;
+
+/*
+ * Bytes in a MiB, which is the unit of zhashconf->mem_tab in the
+ * ruleset file and the invocation.
+ */
+/*@unchecked@*/
 static
-unsigned int
-zhash (
-/*@in@*/
+const size_t HT_ZHASH_MIB		= (size_t)1048576;
+
+#ifdef HT_AI_MINIMAX_HASH_HUGE
+/*
+ * Size of a huge page. zhashtable->arr is rounded up to a multiple of
+ * this when it's mapped, and aligned to it for transparent huge pages.
+ */
+/*@unchecked@*/
+static
+const size_t HT_ZHASH_HUGE_PAGE		= (size_t)2097152;
+#endif
+
+/*
+ * Returns mem advanced to the next multiple of align (mem itself if it
+ * already is one).
+ */
+static
+void *
+zhash_align (
+	void * const	mem,
+	const size_t	align
+	)
+/*@modifies nothing@*/
+{
+	const size_t misalign = (size_t)mem % align;
+	return	(char *)mem + (0 == misalign ? (size_t)0 : align - misalign);
+}
+
+/*
+ * Header of a snapshot file (see zhashtable_save), which is followed by
+ * the table (zhashtable->arr).
+ *
+ * The file is written in the machine's own byte order and struct
+ * layout, so it can only be loaded by the same build on the same kind
+ * of machine. bucket_size and the magic number catch most mismatches.
+ */
+struct zhashsnap
+{
+
+	/*
+	 * HT_ZHASH_SNAP_MAGIC.
+	 */
+	char		magic[8];
+
+	/*
+	 * zhashtable->zobrist_seed.
+	 */
+	HT_U64		zobrist_seed;
+
+	/*
+	 * zhashtable->arrc.
+	 */
+	HT_U64		arrc;
+
+	/*
+	 * zhashtable->z_j.
+	 */
+	HT_U64		z_j;
+
+	/*
+	 * sizeof(struct zhashbucket).
+	 */
+	HT_U64		bucket_size;
+
+	/*
+	 * ruleset->hash of the ruleset that the table was built for.
+	 */
+	char		rules_hash[HT_FNV_HEX_LEN + 1];
+
+	/*
+	 * zhashtable->age.
+	 */
+	unsigned char	age;
+
+};
+
+/*@unchecked@*/
+/*@observer@*/
+static
+const char HT_ZHASH_SNAP_MAGIC[8]	=
+	{ 'H', 'T', 'Z', 'H', 'A', 'S', 'H', '2' };
+
+/*
+ * Sets snap to describe ht for the ruleset with fingerprint rules_hash.
+ */
+static
+void
+zhashsnap_init (
+/*@out@*/
 /*@notnull@*/
-	const struct zhashtable * const HT_RSTR	ht,
+	struct zhashsnap * const HT_RSTR	snap,
 /*@in@*/
 /*@notnull@*/
-	unsigned int * * const HT_RSTR		zob,
+	const struct zhashtable * const HT_RSTR	ht,
 /*@in@*/
 /*@notnull@*/
-	const struct board * const HT_RSTR	b
+	const char * const HT_RSTR		rules_hash
+	)
+/*@modifies * snap@*/
+{
+	/*
+	 * Also clears the padding, so that it's not written as garbage.
+	 */
+	(void) memset(snap, 0, sizeof(* snap));
+	(void) memcpy(snap->magic, HT_ZHASH_SNAP_MAGIC, sizeof(snap->magic));
+	snap->zobrist_seed	= (HT_U64)ht->zobrist_seed;
+	snap->arrc		= (HT_U64)ht->arrc;
+	snap->z_j		= (HT_U64)ht->z_j;
+	snap->bucket_size	= (HT_U64)sizeof(struct zhashbucket);
+	(void) strncpy(snap->rules_hash, rules_hash, (size_t)HT_FNV_HEX_LEN);
+	snap->age		= ht->age;
+}
+
+/*
+ * Converts mib MiB to bytes in mem.
+ *
+ * Returns false if the result would be less than HT_ZHASH_MEM_TAB_MIN
+ * or too large for size_t, in which case mem is not changed.
+ */
+HT_BOOL
+zhash_mem_mib (
+	const unsigned long		mib,
+	size_t * const HT_RSTR		mem
 	)
-/*@modifies nothing@*/
 {
-	unsigned int	key	= 0;
-	unsigned short	i, j;
-	for (i = (unsigned short)0; i < ht->z_i; i++)
+	if (mib < 1ul
+	|| mib > (unsigned long)(((size_t)-1) / HT_ZHASH_MIB)
+	|| (size_t)mib * HT_ZHASH_MIB < HT_ZHASH_MEM_TAB_MIN)
 	{
-		for (j = (unsigned short)0; j < ht->z_j; j++)
-		{
-			if (HT_BIT_U8_EMPTY != b->pieces[j])
-			{
-				key ^= zob[type_index_get
-					(b->pieces[j])][j];
-			}
-		}
+		return	HT_FALSE;
 	}
-	return	key;
+	* mem	= (size_t)mib * HT_ZHASH_MIB;
+	return	HT_TRUE;
 }
 
-unsigned int
-zhashkey (
-	const struct zhashtable * const HT_RSTR	ht,
-	const struct board * const HT_RSTR	b
+/*
+ * Name of pages in the output of -b, the engine and the server.
+ */
+const char *
+zhash_pages_name (
+	const enum HT_ZHASH_PAGES	pages
 	)
 {
-	return	zhash(ht, ht->zobrist_key, b);
+	switch (pages)
+	{
+		case HT_ZHASH_PAGES_HUGETLB:
+			return	"hugetlb";
+		case HT_ZHASH_PAGES_THP:
+			return	"thp";
+		case HT_ZHASH_PAGES_MMAP:
+			return	"mmap";
+		case HT_ZHASH_PAGES_HEAP:
+		case HT_ZHASH_PAGESC:
+		default:
+			return	"heap";
+	}
 }
 
-unsigned int
-zhashlock (
-	const struct zhashtable * const HT_RSTR	ht,
-	const struct board * const HT_RSTR	b
+/*
+ * Returns the amount of buckets that fit in mem_tab bytes, rounded down
+ * to a power of two, or 0 if not even one fits.
+ */
+static
+size_t
+zhashtable_arrc (
+	const size_t	mem_tab
 	)
+/*@modifies nothing@*/
 {
-	return	zhash(ht, ht->zobrist_lock, b);
+	const size_t	arrc_max = mem_tab / sizeof(struct zhashbucket);
+	size_t		arrc;
+	if (arrc_max < (size_t)1)
+	{
+		return	(size_t)0;
+	}
+	for (arrc = (size_t)1; arrc <= arrc_max / (size_t)2;
+		arrc *= (size_t)2)
+	{
+	}
+	return	arrc;
 }
 
+/*
+ * The index is the low bits of key, and zhashnode->hashlock is the
+ * high bits.
+ */
 static
 size_t
 zhashindex (
 /*@in@*/
 /*@notnull@*/
 	const struct zhashtable * const HT_RSTR	ht,
-	unsigned int				key
+	const HT_U64				key
 	)
 /*@modifies nothing@*/
 {
-	/*
-	 * `key & (ht->arrc - 1)` gives more collisions.
-	 */
-	return	(size_t)key % (size_t)ht->arrc;
+	return	(size_t)key & ht->arr_mask;
+}
+
+static
+unsigned int
+zhashlock (
+	const HT_U64	key
+	)
+/*@modifies nothing@*/
+{
+	return	(unsigned int)(key >> 32);
 }
 
-/*
- * node->used is set to false.
- */
 static
 void
 zhashnode_set (
 /*@in@*/
 /*@notnull@*/
 	struct zhashnode * const HT_RSTR	node,
-	const unsigned int			hashkey,
 	const unsigned int			hashlock,
 	const int				value,
 	const enum ZVALUE_TYPE			value_type,
-	unsigned short				p_turn,
-	unsigned short				depthleft
+	const unsigned short			p_turn,
+	const unsigned short			depthleft,
+	const unsigned char			age
 	)
 /*@modifies * node@*/
 {
-	node->hashkey		= hashkey;
 	node->hashlock		= hashlock;
 	node->value		= value;
-	node->value_type	= value_type;
-	node->p_turn		= p_turn;
-	node->depthleft		= depthleft;
-	node->used		= HT_FALSE;
+	node->value_type	= (unsigned char)value_type;
+	node->p_turn		= (unsigned char)p_turn;
+	node->depthleft		= depthleft > (unsigned short)UCHAR_MAX
+				? (unsigned char)UCHAR_MAX
+				: (unsigned char)depthleft;
+	node->age		= age;
 }
 
 /*
- * Checks if node may be overwritten with the given new values.
+ * When choosing which entry in a full bucket to replace, an entry's
+ * depthleft is reduced by this much for every age that it has not been
+ * used. Thus an entry from the previous search is replaced before one
+ * from the current search that was searched less than this much deeper.
  *
- * Positive:	node may be overwritten by new values.
- * 0:		node may not be overwritten.
- * Negative:	new values can be discarded.
+ * The age difference is counted modulo 256 (unsigned char), so an entry
+ * that has not been used in 256 searches looks new again. That only
+ * makes it a little harder to replace.
  */
+/*@unchecked@*/
 static
-int
+const int HT_ZHASH_AGE_WEIGHT	= 4;
+
+/*
+ * Checks if node, which is the same position as the new values, may be
+ * overwritten with them.
+ *
+ * Returns true if node may be overwritten by new values, or false if
+ * the new values should be discarded.
+ *
+ * A node that has not been used in the current search is always
+ * overwritten. Otherwise it's overwritten if the new value is more
+ * exact, or if it's searched at least as deep.
+ */
+static
+HT_BOOL
 zhashnode_action (
 /*@in@*/
 /*@notnull@*/
 	const struct zhashnode * const HT_RSTR	node,
-/*@in@*/
-/*@notnull@*/
-	const struct board * const HT_RSTR	b,
-	const unsigned int			key,
-	const unsigned int			lock,
 	const enum ZVALUE_TYPE			value_type,
-	unsigned short				depthleft
+	const unsigned short			depthleft,
+	const unsigned char			age
 	)
 /*@modifies nothing@*/
 {
-	if (HT_AIM_ZHT_VACANT == node->value_type)
+	if (age != node->age
+	|| (HT_AIM_ZHT_EXACT == value_type
+	&& HT_AIM_ZHT_EXACT != (enum ZVALUE_TYPE)node->value_type))
 	{
-		return	1;
+		return	HT_TRUE;
 	}
 	else
 	{
-		if (key == node->hashkey && lock == node->hashlock
-			&& b->turn == node->p_turn)
+		return	depthleft >= (unsigned short)node->depthleft;
+	}
+}
+
+/*
+ * Returns the entry in bucket that's least valuable to keep: the first
+ * vacant one, or else the one with the lowest depthleft after reducing
+ * it by HT_ZHASH_AGE_WEIGHT per age since it was used.
+ */
+/*@dependent@*/
+/*@notnull@*/
+static
+struct zhashnode *
+zhashbucket_victim (
+/*@in@*/
+/*@notnull@*/
+/*@returned@*/
+	struct zhashbucket * const HT_RSTR	bucket,
+	const unsigned char			age
+	)
+/*@modifies nothing@*/
+{
+	struct zhashnode * HT_RSTR	victim	= & bucket->nodes[0];
+	int				vscore	= INT_MAX;
+	size_t				i;
+	for (i = (size_t)0; i < (size_t)HT_ZHASH_BUCKET_LEN; i++)
+	{
+		struct zhashnode * const HT_RSTR node = & bucket->nodes[i];
+		int score;
+		if (HT_AIM_ZHT_VACANT == (enum ZVALUE_TYPE)node->value_type)
 		{
-			/*
-			 * Same board. Candidate for overwriting.
-			 */
-			if (HT_AIM_ZHT_EXACT == value_type
-			&& (HT_AIM_ZHT_ALPHA == node->value_type
-				|| HT_AIM_ZHT_BETA == node->value_type))
-			{
-				/*
-				 * New value is more exact.
-				 */
-				return	1;
-			}
-			else if (value_type == node->value_type)
-			{
-				/*
-				 * Same value type.
-				 */
-				return depthleft > node->depthleft ?
-					1 : -1;
-			}
-			else
-			{
-				/*
-				 * Different value type -- never allowed
-				 * to overwrite.
-				 */
-				return	0;
-			}
+			return	node;
 		}
-		else
+		score	= (int)node->depthleft - HT_ZHASH_AGE_WEIGHT
+			* (int)(unsigned char)(age - node->age);
+		if (score < vscore)
 		{
-			/*
-			 * Not the same board -- may never overwrite.
-			 */
-			return	0;
+			victim	= node;
+			vscore	= score;
 		}
 	}
+	return	victim;
 }
 
 /*
- * Sets b as a new hash in ht with value, value_type and depthleft.
+ * Sets the position with key and p_turn as a new hash in ht with value,
+ * value_type, depthleft and the best move (move_pos, move_dest), which
+ * may be HT_BOARDPOS_NONE if not known.
  *
- * This may overwrite an existing node, if the value of the new one is
- * more exactly known and they are the same board position.
+ * If the position is already in its bucket, then that entry is
+ * overwritten if zhashnode_action allows it, and otherwise the new
+ * values are discarded. The old best move is kept unless a new one is
+ * given.
  *
- * NOTE:	If there is no more space in zhashcols->memchunk, then
- *		the node is not added, with no indication of failure.
+ * If the position is not in its bucket, then it's always stored, by
+ * replacing zhashbucket_victim if the bucket is full.
  *
  * NOTE:	If value_type is HT_AIM_ZHT_VACANT, then the node is not
  *		added, with no indication of failure.
@@ -202,16 +384,20 @@ zhashnode_action (
 void
 zhashtable_put (
 	struct zhashtable * const HT_RSTR	ht,
-	const struct board * const HT_RSTR	b,
+	const HT_U64				key,
+	const unsigned short			p_turn,
 	const int				value,
 	const enum ZVALUE_TYPE			value_type,
-	unsigned short				depthleft
+	const unsigned short			depthleft,
+	const unsigned short			move_pos,
+	const unsigned short			move_dest
 	)
 {
-	unsigned int			key	= zhashkey	(ht, b);
-	unsigned int			lock	= zhashlock	(ht, b);
-	size_t				index	= zhashindex(ht, key);
-	struct zhashnode * HT_RSTR	node	= & ht->arr[index];
+	const unsigned int		lock	= zhashlock(key);
+	struct zhashbucket * HT_RSTR	bucket	=
+		& ht->arr[zhashindex(ht, key)];
+	struct zhashnode * HT_RSTR	node	= NULL;
+	size_t				i;
 
 #ifndef HT_AI_MINIMAX_UNSAFE
 	if (HT_AIM_ZHT_VACANT == value_type)
@@ -220,648 +406,410 @@ zhashtable_put (
 	}
 #endif
 
-	for (;;)
+	for (i = (size_t)0; i < (size_t)HT_ZHASH_BUCKET_LEN; i++)
 	{
-		const int act = zhashnode_action(node, b, key, lock,
-			value_type, depthleft);
-		if (act > 0)
-		{
-			/*
-			 * Overwrite existing node with new values.
-			 */
-			zhashnode_set(node, key, lock, value,
-				value_type, b->turn, depthleft);
-			return;
-		}
-/* splint incomplete logic */ /*@i1@*/\
-		else if (act < 0)
+		node	= & bucket->nodes[i];
+		if (HT_AIM_ZHT_VACANT != (enum ZVALUE_TYPE)node->value_type
+		&& lock == node->hashlock && p_turn == node->p_turn)
 		{
-			/*
-			 * Discard new values.
-			 */
+			if (!zhashnode_action(node, value_type, depthleft,
+				ht->age))
+			{
+				return;
+			}
+			if (HT_BOARDPOS_NONE != move_pos)
+			{
+				node->move_pos	= move_pos;
+				node->move_dest	= move_dest;
+			}
+			zhashnode_set(node, lock, value, value_type, p_turn,
+				depthleft, ht->age);
 			return;
 		}
-		/*
-		 * Node may not be overwritten, nor discarded. Check
-		 * next node.
-		 */
-
-		if (NULL != node->next)
-		{
-			node	= node->next;
-		}
-		else
-		{
-			break;
-		}
 	}
 
-	/*
-	 * No existing node could be overwritten, so see if there's room
-	 * in memchunk for another one.
-	 */
-	if (ht->cols->elemc < ht->cols->capc)
-	{
-		node->next = & ht->cols->memchunk[ht->cols->elemc++];
-		zhashnode_set(node->next, key, lock, value, value_type,
-			b->turn, depthleft);
-		/*
-		 * NOTE:	We don't need to set node->next->next
-		 *		to NULL since it should have been done
-		 *		when clearing old nodes.
-		 */
-	}
-	/*
-	 * NOTE:	else: memchunk (collision list space) is
-	 *		depleted, so we can't add any more nodes.
-	 *		Increasing HT_AI_MINIMAX_HASH_MEM_COL would
-	 *		help if this happens.
-	 */
+	node		= zhashbucket_victim(bucket, ht->age);
+	node->move_pos	= move_pos;
+	node->move_dest	= move_dest;
+	zhashnode_set(node, lock, value, value_type, p_turn, depthleft,
+		ht->age);
 }
 
+/*
+ * Returns the node for the position with key and p_turn, or NULL if
+ * it's not in ht.
+ *
+ * The caller should set the returned node's age to ht->age if it uses
+ * the node, so that it's kept on the next move.
+ */
 struct zhashnode *
 zhashtable_get (
 	const struct zhashtable * const HT_RSTR	ht,
-	const unsigned int			key,
-	const unsigned int			lock,
+	const HT_U64				key,
 	const unsigned short			p_turn
 	)
 {
-	struct zhashnode * HT_RSTR node =
+	const unsigned int		lock	= zhashlock(key);
+	struct zhashbucket * HT_RSTR	bucket	=
 		& ht->arr[zhashindex(ht, key)];
-	if (HT_AIM_ZHT_VACANT == node->value_type)
-	{
-		return	NULL;
-	}
-	do
-	{
-		if (key == node->hashkey && lock == node->hashlock
-		&& p_turn == node->p_turn)
+	size_t				i;
+	for (i = (size_t)0; i < (size_t)HT_ZHASH_BUCKET_LEN; i++)
+	{
+		struct zhashnode * const HT_RSTR node = & bucket->nodes[i];
+		if (lock == node->hashlock
+		&& p_turn == (unsigned short)node->p_turn
+		&& HT_AIM_ZHT_VACANT
+			!= (enum ZVALUE_TYPE)node->value_type)
 		{
-			break;
+			return	node;
 		}
-	} while (NULL != (node = node->next));
-	return	node;
+	}
+	return	NULL;
 }
 
-static
+/*
+ * Starts a new search by increasing ht->age.
+ *
+ * Nodes from earlier searches are not removed: they are still valid,
+ * and zhashtable_put replaces them before nodes of the current age
+ * (see zhashbucket_victim). Thus there's no need to sweep the table.
+ */
 void
-zhashnode_copy (
-/*@in@*/
-/*@notnull@*/
-	const struct zhashnode * const HT_RSTR	src,
-/*@in@*/
-/*@notnull@*/
-	struct zhashnode * const HT_RSTR	dest
+zhashtable_age (
+	struct zhashtable * const HT_RSTR	ht
 	)
-/*@modifies * dest@*/
 {
-	/*
-	 * Note that src->next points to a zhashnode that's either in
-	 * zhashtable->arr, or zhashtable->cols->memchunk. Even though
-	 * the pointer is lost, it doesn't matter because it will all be
-	 * freed.
-	 */
-	dest->next		= src->next;
-	dest->value_type	= src->value_type;
-	dest->used		= src->used;
-	dest->hashkey		= src->hashkey;
-	dest->hashlock		= src->hashlock;
-	dest->value		= src->value;
-	dest->p_turn		= src->p_turn;
-	dest->depthleft		= src->depthleft;
+	ht->age++;
 }
 
 /*
- * zhashtable_clearunused uses the following method to remove unused
- * nodes:
- *
- * 1.	Swap the node to be removed (R) with the last used node in
- *	memchunk (L). This is done by simply copying L -> R, and setting
- *	R->next to NULL.
- *
- * 2.	When the nodes have been "swapped", the problem is that L is
- *	still pointed to by some zhashnode->next, since the node is in
- *	use. This is always the case, unless L == R (which happens
- *	rarely). If it is the case, then we have to find the node which
- *	points to L, and make it point to R instead, since L is replaced
- *	by R.
- *
- *	If it's not the case, then we can simply remove L and R since
- *	they are the same (and they are both the last node in memchunk),
- *	and we don't have to update stray nodes.
- *
- * 3.	The node which points to L is in the collision lists in bucket
- *	zhashindex(ht, L->hashkey), since only colliding nodes point to
- *	each other by zhashnode->next, and the node we're looking for
- *	points to L. Thus they are in the same bucket and that bucket's
- *	index is the zhashindex of L->hashkey. So all we have to do is
- *	go through that collision list and when we find the pointer to
- *	L (zstray_old), then make it point to R (zstray_new) instead.
- *
- * This gives O(1) removal of unused nodes, without having to make the
- * collision lists doubly linked, and without having to sacrifice O(1)
- * insertion.
+ * Empties ht, as if it had just been allocated, for a new game that
+ * shouldn't be searched with the entries of the last one.
  */
-static
-enum HT_FR
-zhashnode_update_stray (
-/*@in@*/
-/*@notnull@*/
-	struct zhashtable * const HT_RSTR	ht,
-/*@in@*/
-/*@notnull@*/
-	const struct zhashnode * const HT_RSTR	zstray_old,
-/*@dependent@*/
-/*@in@*/
-/*@notnull@*/
-	struct zhashnode * const HT_RSTR	zstray_new
+void
+zhashtable_clear (
+	struct zhashtable * const HT_RSTR	ht
 	)
-/*@modifies * ht@*/
 {
-	const size_t zstray_ind	= zhashindex(ht, zstray_old->hashkey);
-	struct zhashnode * HT_RSTR zstray_list = & ht->arr[zstray_ind];
-
-	if (zstray_old == zstray_new)
-	{
-		return	HT_FR_FAIL_ILL_STATE;
-	}
+	(void) memset(ht->arr, 0, sizeof(* ht->arr) * ht->arrc);
+	ht->age	= (unsigned char)0;
+}
 
-	while (NULL != zstray_list)
-	{
-		if (zstray_list->next == zstray_old)
-		{
-			zstray_list->next = zstray_new;
-			return	HT_FR_SUCCESS;
-		}
-		zstray_list = zstray_list->next;
-	}
-	/*
-	 * Not found!
-	 */
-	return	HT_FR_FAIL_ILL_STATE;
+/*
+ * Checks if ht can be used for g instead of allocating a new table: it
+ * has the size given by g->hash_conf.mem_tab, and its keys were made
+ * from Zobrist numbers of the same seed for the same board length.
+ */
+HT_BOOL
+zhashtable_reusable (
+	const struct zhashtable * const HT_RSTR	ht,
+	const struct game * const HT_RSTR	g
+	)
+{
+	return	ht->arrc		== zhashtable_arrc(g->hash_conf.mem_tab)
+		&& ht->zobrist_seed	== g->hash_conf.zobrist_seed
+		&& ht->z_j		== g->rules->opt_blen;
 }
 
 /*
- * Removes noden (node->next) from node's collision list, and sets
- * node->next to noden->next (node->next->next).
- *
- * This is done by swapping noden with the last node from memchunk,
- * removing the last node from memchunk, and updating the stray pointer,
- * if any.
- *
- * *	noden should be node->next.
+ * Allocates ht->arr with ht->arrc 0-initialized buckets, and sets
+ * ht->arr_mem, ht->arr_mem_len and ht->pages.
  *
- * *	Therefore noden should be in node's collision list, following
- *	node.
+ * If HT_AI_MINIMAX_HASH_HUGE, it first tries reserved huge pages
+ * (MAP_HUGETLB), then transparent huge pages (MADV_HUGEPAGE), then
+ * normal mapped pages, and falls back to malloc if mmap fails. Mapped
+ * memory is already 0-initialized.
  *
- * This shrinks memchunk.
+ * Returns false if all failed.
  */
 static
-enum HT_FR
-zhashnode_remove_next (
-/*@in@*/
-/*@notnull@*/
-	struct zhashtable * const		ht,
-/*@in@*/
-/*@notnull@*/
-	struct zhashnode * const HT_RSTR	node,
-/*@dependent@*/
+HT_BOOL
+zhashtable_arr_alloc (
 /*@in@*/
 /*@notnull@*/
-	struct zhashnode * const		noden
+	struct zhashtable * const HT_RSTR	ht
 	)
-/*@modifies * ht, * node, * noden@*/
+/*@modifies * ht@*/
 {
-	struct zhashnode *	last	= NULL;
-	if (NULL == noden)
-	{
-		return	HT_FR_FAIL_NULLPTR;
-	}
-	node->next	= noden->next;
-
-	if (ht->cols->elemc < (size_t)1)
-	{
-		return	HT_FR_FAIL_ILL_STATE;
+	const size_t	len	= ht->arrc * sizeof(* ht->arr);
+#ifdef HT_AI_MINIMAX_HASH_HUGE
+	const size_t	len_huge = (len + HT_ZHASH_HUGE_PAGE - (size_t)1)
+			/ HT_ZHASH_HUGE_PAGE * HT_ZHASH_HUGE_PAGE;
+	void *		mem;
+
+#ifdef MAP_HUGETLB
+	mem	= mmap(NULL, len_huge, PROT_READ | PROT_WRITE,
+		MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+	if (MAP_FAILED != mem)
+	{
+		ht->arr_mem	= mem;
+		ht->arr_mem_len	= len_huge;
+		ht->arr		= (struct zhashbucket *)mem;
+		ht->pages	= HT_ZHASH_PAGES_HUGETLB;
+		return		HT_TRUE;
 	}
-	last		= & ht->cols->memchunk[--ht->cols->elemc];
+#endif
 
 	/*
-	 * "Swap" last and noden, by copying last into noden and then
-	 * reducing elemc.
+	 * One more huge page so that arr can be aligned to one.
 	 */
-	if (last != noden)
-	{
-		zhashnode_copy	(last, noden);
-		last->next	= NULL;
-		return		zhashnode_update_stray(ht, last, noden);
+	mem	= mmap(NULL, len_huge + HT_ZHASH_HUGE_PAGE,
+		PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (MAP_FAILED != mem)
+	{
+		ht->arr_mem	= mem;
+		ht->arr_mem_len	= len_huge + HT_ZHASH_HUGE_PAGE;
+		ht->arr		= (struct zhashbucket *)
+				zhash_align(mem, HT_ZHASH_HUGE_PAGE);
+		ht->pages	= HT_ZHASH_PAGES_MMAP;
+#ifdef MADV_HUGEPAGE
+		if (0 == madvise(ht->arr, len_huge, MADV_HUGEPAGE))
+		{
+			ht->pages	= HT_ZHASH_PAGES_THP;
+		}
+#endif
+		return	HT_TRUE;
 	}
-	else
+#endif /* HT_AI_MINIMAX_HASH_HUGE */
+
+	ht->arr_mem	= malloc(len + (size_t)HT_ZHASH_BUCKET_ALIGN);
+	if (NULL == ht->arr_mem)
 	{
-		/*
-		 * noden and last are the same node. Just remove its
-		 * reference (which we saved into node->next) and it can
-		 * be considered deleted.
-		 */
-		last->next	= NULL;
-		return		HT_FR_SUCCESS;
+		return	HT_FALSE;
 	}
+	ht->arr_mem_len	= len + (size_t)HT_ZHASH_BUCKET_ALIGN;
+	ht->arr		= (struct zhashbucket *)zhash_align(ht->arr_mem,
+			(size_t)HT_ZHASH_BUCKET_ALIGN);
+	ht->pages	= HT_ZHASH_PAGES_HEAP;
+
+	/*
+	 * NOTE:	We depend on memset to set zhashnode->value_type
+	 *		to HT_AIM_ZHT_VACANT by 0-initializing.
+	 */
+	(void) memset(ht->arr, 0, len);
+	return	HT_TRUE;
 }
 
 /*
- * Clears all unused nodes in ht. Then sets all used nodes to unused, so
- * that they will be cleared the next time this function is called.
- *
- * For details on exactly how this is done, see the descriptions of
- * zhashnode_remove_next and zhashnode_update_stray.
+ * Frees ht->arr_mem.
  */
-enum HT_FR
-zhashtable_clearunused (
-	struct zhashtable * const	ht
+static
+void
+zhashtable_arr_free (
+/*@in@*/
+/*@notnull@*/
+	struct zhashtable * const HT_RSTR	ht
 	)
+/*@modifies ht->arr_mem@*/
 {
-	size_t i;
-	for (i = (size_t)0; i < ht->arrc; i++)
+#ifdef HT_AI_MINIMAX_HASH_HUGE
+	if (HT_ZHASH_PAGES_HEAP != ht->pages)
 	{
-		struct zhashnode *	node	= & ht->arr[i];
-		struct zhashnode *	noden	= node->next;
-		if (HT_AIM_ZHT_VACANT == node->value_type)
-		{
-			continue;
-		}
-
-		/*
-		 * First check all nodes that follow the first (id est
-		 * all collisions).
-		 */
-		while (NULL != noden)
-		{
-			if (noden->used)
-			{
-				noden->used	= HT_FALSE;
-				node		= noden;
-				noden		= node->next;
-			}
-			else
-			{
-/* splint thinks noden can be NULL */
-				const enum HT_FR fr =
-					zhashnode_remove_next(ht, node,
-/*@i1@*/				noden);
-				if (HT_FR_SUCCESS != fr)
-				{
-					return	fr;
-				}
-				noden		= node->next;
-			}
-		}
-
-		/*
-		 * All collisions have been checked. Check first node.
-		 */
-		node	= & ht->arr[i];
-		if (node->used)
-		{
-			node->used	= HT_FALSE;
-		}
-		else
-		{
-			noden	= node->next;
-			if (NULL == noden)
-			{
-				/*
-				 * There are no collisions: just set
-				 * this one to unused and we're done.
-				 */
-				node->value_type = HT_AIM_ZHT_VACANT;
-			}
-			else
-			{
-				enum HT_FR	fr	= HT_FR_NONE;
-				/*
-				 * "Remove" this node by replacing it
-				 * with its next node, and then removing
-				 * the next node.
-				 */
-				zhashnode_copy	(noden, node);
-				fr = zhashnode_remove_next(ht, node,
-					noden);
-				if (HT_FR_SUCCESS != fr)
-				{
-					return	fr;
-				}
-			}
-		}
+		(void) munmap(ht->arr_mem, ht->arr_mem_len);
+		return;
 	}
-	return	HT_FR_SUCCESS;
+#endif
+	free	(ht->arr_mem);
 }
 
 /*
- * This is used for initializing zhashtable->zobrist_key and
- * zobrist_lock.
+ * 0 size is not allowed (returns NULL).
+ *
+ * All variables in ht->arr are 0-initialized.
+ *
+ * zhashtable->arr takes at most g->hash_conf.mem_tab bytes, since
+ * arrc is rounded down to a power of two. (ht->arr_mem is larger, so
+ * that arr can be aligned; see zhashtable_arr_alloc.)
+ *
+ * The keys are board->key, so the table only records which seed
+ * (g->hash_conf.zobrist_seed) and board length they were made with.
  *
- * z_i and z_j are the desired lengths of the arrays.
+ * If g->hash_conf.file is given, the table is loaded from it if it's a
+ * matching snapshot (see zhashtable_load).
  */
-/*@null@*/
-/*@only@*/
-static
-unsigned int * *
-alloc_zobrist_init (
-	const unsigned short	z_i,
-	const unsigned short	z_j
+struct zhashtable *
+alloc_zhashtable_init (
+	const struct game * const HT_RSTR	g
 	)
-/*@globals internalState@*/
-/*@modifies internalState@*/
 {
-	/*
-	 * zobrist and zobrist_lock may be NULL.
-	 */
-	unsigned short i;
-	unsigned int * * zobrist = malloc(sizeof(* zobrist) * z_i);
-	if (NULL == zobrist)
+	struct zhashtable * const ht	= malloc(sizeof(* ht));
+	if (NULL == ht)
 	{
 		return	NULL;
 	}
-	for (i = (unsigned short)0; i < z_i; i++)
-	{
-		unsigned short j;
-		zobrist[i] = malloc(sizeof(* zobrist[i]) * z_j);
-		if (NULL == zobrist[i])
-		{
-			unsigned short k;
-			for (k = (unsigned short)0; k < i; k++)
-			{
-				free	(zobrist[k]);
-			}
-			free		(zobrist);
-			return		NULL;
-		}
 
-		for (j = (unsigned short)0; j < z_j; j++)
-		{
-			zobrist[i][j] = (unsigned int)rand();
-			zobrist[i][j] ^= (unsigned int)rand() << 15;
-			zobrist[i][j] ^= (unsigned int)rand() << 30;
-		}
-	}
-	return	zobrist;
-}
-
-/*
- * Allocates a zhashcols struct with capc HT_AI_MINIMAX_HASH_MEM_COL.
- */
-/*@null@*/
-/*@only@*/
-static
-struct zhashcols *
-alloc_zhashcols_init (void)
-/*@modifies nothing@*/
-{
-	struct zhashcols *	cols	= malloc(sizeof(* cols));
-	if (NULL == cols)
+	ht->arrc	= zhashtable_arrc(g->hash_conf.mem_tab);
+	if (ht->arrc < (size_t)1)
 	{
+		free	(ht);
 		return	NULL;
 	}
+	ht->arr_mask	= ht->arrc - (size_t)1;
+	ht->age		= (unsigned char)0;
 
-	cols->elemc	= (size_t)0;
-/* splint safer to use pointer in sizeof */
-	cols->capc	= (size_t)
-/*@i1@*/	(HT_AI_MINIMAX_HASH_MEM_COL / sizeof(struct zhashnode));
-	if (cols->capc < (size_t)1)
+	if (!zhashtable_arr_alloc(ht))
 	{
-		free	(cols);
+		free	(ht);
 		return	NULL;
 	}
 
-	/*
-	 * NOTE:	We depend on calloc to set zhashnode->next to
-	 *		NULL by 0-initializing.
-	 */
-	cols->memchunk = calloc(cols->capc, sizeof(* cols->memchunk));
-	if (NULL == cols->memchunk)
+	ht->z_j		= g->rules->opt_blen;
+	ht->zobrist_seed	= g->hash_conf.zobrist_seed;
+
+	if (NULL != g->hash_conf.file && NULL != g->rules->hash)
 	{
-		free	(cols);
-		return	NULL;
+		/*
+		 * Starts empty if there's no matching snapshot.
+		 */
+		(void) zhashtable_load(ht, g->hash_conf.file,
+			g->rules->hash);
 	}
 
-	return	cols;
+	return	ht;
 }
 
-/*
- * Checks if num is a prime.
- *
- * Returns false if num is < 2 (or can't be square-rooted due to being
- * negative).
- *
- * NOTE:	May be more approriate in num.c, but is here since it's
- *		only used for one thing.
- */
-static
-HT_BOOL
-is_prime (
-	const size_t	num
+void
+free_zhashtable (
+	struct zhashtable * const ht
 	)
-/*@globals errno@*/
-/*@modifies errno@*/
 {
-	size_t	divid;
-	if (num < (size_t)2)
-	{
-		return	HT_FALSE;
-	}
-	{
-		int		errno_old	= errno;
-		double		tmp;
-				errno		= 0;
-				tmp		= sqrt((double)num);
-		if (0 != errno)
-		{
-			/*
-			 * Only happens if num is negative, which it
-			 * can't be, being a size_t.
-			 */
-			return	HT_FALSE;
-		}
-		errno		= errno_old;
-		divid		= (size_t)(tmp + 0.0001);
-	}
-	do
-	{
-		if (0 == num % divid)
-		{
-			return	HT_FALSE;
-		}
-	} while (--divid > (size_t)1);
-	return	HT_TRUE;
+	zhashtable_arr_free	(ht);
+	free	(ht);
 }
 
 /*
- * Finds next prime number >= num.
+ * Saves ht to file, together with its Zobrist seed and the fingerprint
+ * (ruleset->hash) of the ruleset it was built for, so that
+ * zhashtable_load can restore it in another process.
  *
- * NOTE:	May be more approriate in num.c, but is here since it's
- *		only used for one thing.
+ * Returns HT_FR_FAIL_IO_FILE_W if the file can't be written.
  */
-static
-size_t
-next_prime_ge (
-	size_t	num
+enum HT_FR
+zhashtable_save (
+	const struct zhashtable * const HT_RSTR	ht,
+	const char * const HT_RSTR		file,
+	const char * const HT_RSTR		rules_hash
 	)
-/*@globals errno@*/
-/*@modifies errno@*/
 {
-	while (!is_prime(num))
+	struct zhashsnap	snap;
+	FILE *			out	= NULL;
+	HT_BOOL			ok;
+
+#ifndef HT_UNSAFE
+	if (NULL == ht || NULL == file || NULL == rules_hash)
 	{
-		num++;
+		return	HT_FR_FAIL_NULLPTR;
 	}
-	return	num;
-}
+#endif
 
-/*
- * Finds next prime number < num.
- *
- * NOTE:	May be more approriate in num.c, but is here since it's
- *		only used for one thing.
- */
-static
-size_t
-next_prime_lt (
-	size_t	num
-	)
-/*@globals errno@*/
-/*@modifies errno@*/
-{
-	while (!is_prime(--num))
+	zhashsnap_init(& snap, ht, rules_hash);
+
+	out	= fopen(file, "wb");
+	if (NULL == out)
+	{
+		return	HT_FR_FAIL_IO_FILE_W;
+	}
+	ok	= (size_t)1 == fwrite(& snap, sizeof(snap), (size_t)1, out)
+		&& ht->arrc == fwrite(ht->arr, sizeof(* ht->arr), ht->arrc,
+			out);
+	if (0 != fclose(out))
 	{
+		ok	= HT_FALSE;
 	}
-	return	num;
+	return	ok ? HT_FR_SUCCESS : HT_FR_FAIL_IO_FILE_W;
 }
 
 /*
- * 0 size is not allowed (returns NULL).
- *
- * All variables in ht->arr are 0-initialized by calloc.
+ * Loads a table that was saved by zhashtable_save into ht.
  *
- * zhashtable->arr takes at most HT_AI_MINIMAX_HASH_MEM_TAB bytes
- * (plus/minus however much it takes to get zhashtable->arrc to the
- * nearest prime).
+ * Returns false, and leaves ht unchanged, if file can't be read or if
+ * it was saved from a table with another size, Zobrist seed, board
+ * length or ruleset fingerprint (rules_hash) than ht. This is not an
+ * error: the table simply starts empty.
  *
- * zhashtable->cols takes at most HT_AI_MINIMAX_HASH_MEM_COL bytes.
+ * If HT_POSIX, the file is mapped with mmap rather than read.
  */
-struct zhashtable *
-alloc_zhashtable_init (
-	const struct game * const HT_RSTR	g
+HT_BOOL
+zhashtable_load (
+	struct zhashtable * const HT_RSTR	ht,
+	const char * const HT_RSTR		file,
+	const char * const HT_RSTR		rules_hash
 	)
 {
-	struct zhashtable *	ht	= NULL;
-	ht	= malloc(sizeof(* ht));
-	if (NULL == ht)
-	{
-		return	NULL;
-	}
+	struct zhashsnap	snap;
+	const size_t		len_arr	= ht->arrc * sizeof(* ht->arr);
+#ifdef HT_POSIX
+	const size_t		len	= sizeof(snap) + len_arr;
+	void *			mem	= NULL;
+	int			fd;
+#else
+	FILE *			in	= NULL;
+	HT_BOOL			ok;
+#endif
 
-/* splint safer to use pointer in sizeof */
-	ht->arrc = (size_t)
-/*@i1@*/	(HT_AI_MINIMAX_HASH_MEM_TAB / sizeof(struct zhashnode));
-	if (ht->arrc < (size_t)1)
-	{
-		free	(ht);
-		return	NULL;
-	}
+	zhashsnap_init(& snap, ht, rules_hash);
 
+#ifdef HT_POSIX
+	fd	= open(file, O_RDONLY);
+	if (fd < 0)
 	{
-		size_t	p_ge	= next_prime_ge(ht->arrc);
-		size_t	p_lt	= next_prime_lt(ht->arrc);
-		size_t	d_p_ge	= p_ge		- ht->arrc;
-		size_t	d_p_lt	= ht->arrc	- p_lt;
-		ht->arrc	= d_p_ge < d_p_lt ? p_ge : p_lt;
+		return	HT_FALSE;
 	}
-
 	/*
-	 * NOTE:	We depend on calloc to set zhashnode->next to
-	 *		NULL and zhashnode->value_type to
-	 *		HT_AIM_ZHT_VACANT by 0-initializing.
+	 * The size is taken with lseek rather than fstat, since a
+	 * struct stat is too big for the stack limit in CFLAGS_WARN.
 	 */
-	ht->arr		= calloc(ht->arrc, sizeof(* ht->arr));
-	if (NULL == ht->arr)
+	if ((off_t)len != lseek(fd, 0, SEEK_END))
 	{
-		free	(ht);
-		return	NULL;
+		(void) close	(fd);
+		return		HT_FALSE;
 	}
-
-	/*
-	 * Set to NULL for free_zhashtable and alloc_zobrist_init.
-	 */
-	ht->zobrist_key	= ht->zobrist_lock	= NULL;
-
-	ht->cols	= alloc_zhashcols_init();
-	if (NULL == ht->cols)
+	mem	= mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+	(void) close	(fd);
+	if (MAP_FAILED == mem)
 	{
-		free_zhashtable	(ht);
-		return		NULL;
+		return	HT_FALSE;
 	}
-
-	ht->z_i	= g->rules->type_piecec;
-	ht->z_j	= g->rules->opt_blen;
-
-	ht->zobrist_key = alloc_zobrist_init(ht->z_i, ht->z_j);
-	if (NULL == ht->zobrist_key)
+	if (0 != memcmp(mem, & snap, offsetof(struct zhashsnap, age)))
 	{
-		free_zhashtable	(ht);
-		return		NULL;
+		(void) munmap	(mem, len);
+		return		HT_FALSE;
 	}
-
-	ht->zobrist_lock = alloc_zobrist_init(ht->z_i, ht->z_j);
-	if (NULL == ht->zobrist_lock)
+	ht->age	= ((const struct zhashsnap *)mem)->age;
+	(void) memcpy(ht->arr, (const char *)mem + sizeof(snap), len_arr);
+	(void) munmap	(mem, len);
+	return		HT_TRUE;
+#else
 	{
-		free_zhashtable	(ht);
-		return		NULL;
-	}
-
-	return	ht;
-}
-
-/*
- * Frees ht and all collision lists.
- */
-void
-free_zhashtable (
-	struct zhashtable * const ht
-	)
-{
-	if (NULL != ht->cols)
-	{
-		free	(ht->cols->memchunk);
-		free	(ht->cols);
-	}
-
-	if (NULL != ht->zobrist_key)
-	{
-		unsigned short i;
-		for (i = (unsigned short)0; i < ht->z_i; i++)
+		struct zhashsnap	snap_in;
+		in	= fopen(file, "rb");
+		if (NULL == in)
 		{
-/* splint doesn't understand pointer to pointer */ /*@i2@*/\
-			free	(ht->zobrist_key[i]);
+			return	HT_FALSE;
 		}
-		free		(ht->zobrist_key);
-	}
-
-	if (NULL != ht->zobrist_lock)
-	{
-		unsigned short i;
-		for (i = (unsigned short)0; i < ht->z_i; i++)
+		if ((size_t)1 != fread(& snap_in, sizeof(snap_in),
+			(size_t)1, in)
+		|| 0 != memcmp(& snap_in, & snap,
+			offsetof(struct zhashsnap, age)))
 		{
-/* splint doesn't understand pointer to pointer */ /*@i2@*/\
-			free	(ht->zobrist_lock[i]);
+			(void) fclose	(in);
+			return		HT_FALSE;
 		}
-		free		(ht->zobrist_lock);
-	}
-
-	if (NULL != ht->arr)
-	{
-		free	(ht->arr);
+		ok	= ht->arrc == fread(ht->arr, sizeof(* ht->arr),
+			ht->arrc, in);
+		(void) fclose	(in);
+		if (!ok)
+		{
+			/*
+			 * Partly read: clear it again.
+			 */
+			(void) memset(ht->arr, 0, len_arr);
+			return	HT_FALSE;
+		}
+		ht->age	= snap_in.age;
+		return	HT_TRUE;
 	}
-	free	(ht);
+#endif
 }
 
 #endif
-
@@ -25,31 +25,57 @@
 #include "funct.h"	/* HT_FR */
 #include "gamet.h"	/* game */
 
+/*
+ * Starts loading the bucket of key in ht into the cache, so that a
+ * zhashtable_get or zhashtable_put shortly after doesn't have to wait
+ * for memory. This is a macro since a function call would cost about
+ * as much as the prefetch saves. Does nothing if the compiler has no
+ * prefetch.
+ */
+#ifdef __GNUC__
+#define HT_ZHASH_PREFETCH(ht, key) \
+	__builtin_prefetch(& (ht)->arr[(size_t)(key) & (ht)->arr_mask])
+#else
+#define HT_ZHASH_PREFETCH(ht, key)
+#endif
+
+/*
+ * Default value for zhashconf->mem_tab.
+ */
+/*@unchecked@*/
 extern
-unsigned int
-zhashkey (
-/*@in@*/
-/*@notnull@*/
-	const struct zhashtable * const HT_RSTR,
-/*@in@*/
+const size_t HT_ZHASH_MEM_TAB_DEF;
+
+/*
+ * Minimum value for zhashconf->mem_tab.
+ */
+/*@unchecked@*/
+extern
+const size_t HT_ZHASH_MEM_TAB_MIN;
+
+/*@-protoparamname@*/
+extern
+HT_BOOL
+zhash_mem_mib (
+	const unsigned long		mib,
+/*@out@*/
 /*@notnull@*/
-	const struct board * const HT_RSTR
+	size_t * const HT_RSTR		mem
 	)
-/*@modifies nothing@*/
+/*@modifies * mem@*/
 ;
+/*@=protoparamname@*/
 
+/*@-protoparamname@*/
+/*@observer@*/
 extern
-unsigned int
-zhashlock (
-/*@in@*/
-/*@notnull@*/
-	const struct zhashtable * const,
-/*@in@*/
-/*@notnull@*/
-	const struct board * const
+const char *
+zhash_pages_name (
+	const enum HT_ZHASH_PAGES	pages
 	)
 /*@modifies nothing@*/
 ;
+/*@=protoparamname@*/
 
 /*@-protoparamname@*/
 extern
@@ -58,12 +84,13 @@ zhashtable_put (
 /*@in@*/
 /*@notnull@*/
 	struct zhashtable * const HT_RSTR	ht,
-/*@in@*/
-/*@notnull@*/
-	const struct board * const HT_RSTR	b,
+	const HT_U64				key,
+	const unsigned short			p_turn,
 	const int				value,
 	const enum ZVALUE_TYPE			value_type,
-	unsigned short				depthleft
+	const unsigned short			depthleft,
+	const unsigned short			move_pos,
+	const unsigned short			move_dest
 	)
 /*@modifies * ht@*/
 ;
@@ -79,8 +106,7 @@ zhashtable_get (
 /*@notnull@*/
 /*@returned@*/
 	const struct zhashtable * const HT_RSTR,
-	const unsigned int,
-	const unsigned int,
+	const HT_U64,
 	const unsigned short
 	)
 /*@modifies nothing@*/
@@ -88,16 +114,81 @@ zhashtable_get (
 
 /*@-protoparamname@*/
 extern
-enum HT_FR
-zhashtable_clearunused (
+void
+zhashtable_age (
+/*@in@*/
+/*@notnull@*/
+	struct zhashtable * const HT_RSTR	ht
+	)
+/*@modifies * ht@*/
+;
+/*@=protoparamname@*/
+
+/*@-protoparamname@*/
+extern
+void
+zhashtable_clear (
 /*@in@*/
 /*@notnull@*/
-	struct zhashtable * const	ht
+	struct zhashtable * const HT_RSTR	ht
 	)
 /*@modifies * ht@*/
 ;
 /*@=protoparamname@*/
 
+/*@-protoparamname@*/
+extern
+HT_BOOL
+zhashtable_reusable (
+/*@in@*/
+/*@notnull@*/
+	const struct zhashtable * const HT_RSTR	ht,
+/*@in@*/
+/*@notnull@*/
+	const struct game * const HT_RSTR	g
+	)
+/*@modifies nothing@*/
+;
+/*@=protoparamname@*/
+
+/*@-protoparamname@*/
+extern
+enum HT_FR
+zhashtable_save (
+/*@in@*/
+/*@notnull@*/
+	const struct zhashtable * const HT_RSTR	ht,
+/*@in@*/
+/*@notnull@*/
+	const char * const HT_RSTR		file,
+/*@in@*/
+/*@notnull@*/
+	const char * const HT_RSTR		rules_hash
+	)
+/*@globals fileSystem, errno@*/
+/*@modifies fileSystem, errno@*/
+;
+/*@=protoparamname@*/
+
+/*@-protoparamname@*/
+extern
+HT_BOOL
+zhashtable_load (
+/*@in@*/
+/*@notnull@*/
+	struct zhashtable * const HT_RSTR	ht,
+/*@in@*/
+/*@notnull@*/
+	const char * const HT_RSTR		file,
+/*@in@*/
+/*@notnull@*/
+	const char * const HT_RSTR		rules_hash
+	)
+/*@globals fileSystem, errno@*/
+/*@modifies fileSystem, errno, * ht@*/
+;
+/*@=protoparamname@*/
+
 /*@null@*/
 /*@only@*/
 extern
@@ -22,7 +22,7 @@
 
 #include <stdlib.h>	/* size_t */
 
-#include "boolt.h"	/* HT_BOOL */
+#include "rngt.h"	/* HT_U64 */
 
 enum ZVALUE_TYPE
 {
@@ -51,224 +51,246 @@ enum ZVALUE_TYPE
 };
 
 /*
- * The uninitialized values of every variable in this struct is 0 or
- * NULL (by calloc).
+ * What kind of memory zhashtable->arr is in.
  *
- * NOTE:	The elements are arranged to minimize padding, assuming
- *		the sizes of the types are:
- *
- * 			pointer > enum / HT_BOOL > int > short
- *
- *		Note that pointer >= int, and (probably) enum == int.
- *		If pointer == enum == int == 4 byte and short == 2 byte,
- *		then the total size is:
- *		4 + 4 * 2 + 4 * 3 + 2 * 2 = 28 byte.
- *
- *		That gives, for the following sizes of zhashtable->arr:
- *
- *		8 MB:	  285 714.29	(Very high load in Tablut.)
- *		16 MB:	  571 428.57
- *		32 MB:	1 142 857.1	(Usually < 0.7 load in Tablut.)
- *		64 MB:	2 285 714.3
+ * Only HT_ZHASH_PAGES_HEAP is used unless HT_AI_MINIMAX_HASH_HUGE. Else
+ * the others are tried in reverse order, and the first one that the
+ * system allows is used.
  */
-/*@exposed@*/
-struct zhashnode
+enum HT_ZHASH_PAGES
 {
 
 	/*
-	 * Singly linked list for collissions. (We never need to
-	 * traverse this list backwards.)
+	 * malloc.
 	 */
-/*@dependent@*/
-/*@null@*/
-	struct zhashnode *	next;
+	HT_ZHASH_PAGES_HEAP,
 
 	/*
-	 * Exactness of value.
+	 * mmap with normal pages (madvise failed).
 	 */
-	enum ZVALUE_TYPE	value_type;
+	HT_ZHASH_PAGES_MMAP,
 
 	/*
-	 * Whether this positions was used during the calculation of
-	 * theprevious move.
-	 *
-	 * Upon being used (to retrieve a value), a position is set to
-	 * true.
-	 *
-	 * On every new move, all hashnodes that are unused are removed,
-	 * and all nodes that are used are flagged as unused. This
-	 * ensures that only relevant nodes will be kept.
-	 *
-	 * The initial (uninitialized) value is HT_FALSE.
+	 * mmap with transparent huge pages (madvise with MADV_HUGEPAGE).
+	 * The kernel may still use normal pages for some of the table.
 	 */
-	HT_BOOL			used;
+	HT_ZHASH_PAGES_THP,
 
 	/*
-	 * Zobrist hash (zobrist_key).
+	 * mmap with MAP_HUGETLB: reserved huge pages.
 	 */
-	unsigned int		hashkey;
+	HT_ZHASH_PAGES_HUGETLB,
 
 	/*
-	 * Second Zobrist hash (zobrist_lock).
+	 * Amount of kinds of pages. Not a kind.
 	 */
-	unsigned int		hashlock;
+	HT_ZHASH_PAGESC
+
+};
+
+/*
+ * Transposition table settings, which are kept in the game struct
+ * (game->hash_conf) since they are read before any table is allocated.
+ */
+struct zhashconf
+{
 
 	/*
-	 * Value of this position.
+	 * Seed for the Zobrist numbers of ruleset->opt_zobrist (see
+	 * game_zobrist_seed). The same seed gives the same keys on
+	 * every platform.
+	 *
+	 * Default is HT_ZOBRIST_SEED_DEF.
 	 */
-	int			value;
+	unsigned long		zobrist_seed;
 
 	/*
-	 * Player turn for the given board.
+	 * Memory for zhashtable->arr in bytes. The table is rounded
+	 * down to a power of two buckets (see alloc_zhashtable_init).
+	 *
+	 * Default is HT_ZHASH_MEM_TAB_DEF, and it's never less than
+	 * HT_ZHASH_MEM_TAB_MIN.
 	 */
-	unsigned short		p_turn;
+	size_t			mem_tab;
 
 	/*
-	 * Depth left to search.
+	 * Snapshot file that new tables are loaded from, and that
+	 * game_hash_save saves to (see zhashtable_load). NULL for none,
+	 * which is default.
 	 */
-	unsigned short		depthleft;
+/*@null@*/
+/*@observer@*/
+	const char *		file;
 
 };
 
 /*
- * zhashtable->arr is the hash table array. This takes (up to, due to
- * rounding) HT_AI_MINIMAX_MEM_INIT bytes.
- *
- * zhashtable->cols->memchunk is space for the collision lists. This
- * takes up to (due to growing) HT_AI_MINIMAX_MEM_COL_MAX bytes.
- *
- * The table can not grow (arrc can not increase post-allocation).
- * Therefore it's useless to keep track of load factor.
+ * Amount of zhashnodes in a zhashbucket.
+ */
+#define HT_ZHASH_BUCKET_LEN	4
+
+/*
+ * Size in bytes of a zhashbucket, which zhashtable->arr is aligned to.
+ */
+#define HT_ZHASH_BUCKET_ALIGN	64
+
+/*
+ * A transposition table entry. The uninitialized values of every
+ * variable in this struct is 0 (by memset), which makes it vacant.
  *
- * Both zhashtable->arr and zhashcols->memchunk store zhashnodes in a
- * continuous block of memory. That means that all zhashnodes will be
- * aligned to structure padding. A zhashnode with 32 bit pointers is 28
- * bytes (making some assumptions about data types), and with 64 bit
- * pointers 32 bytes. Thus no space is wasted when putting zhashnodes in
- * arrays.
+ * The entry is packed to 16 bytes, assuming that int is 4 bytes and
+ * short is 2 bytes, so that a zhashbucket fits in a 64 byte cache line.
+ * This is why value_type and p_turn are stored as unsigned char rather
+ * than as enum ZVALUE_TYPE and unsigned short, and why the hash table
+ * does not use collision lists (a next pointer alone would take half
+ * of the entry).
  *
- * By contrast, if we had just naively used malloc every time we need to
- * add a new collision, we would allocate 32 bytes per zhashnode, since
- * malloc aligns to 16 bytes, thus wasting 4 bytes (16 * 2 - 28) per
- * zhashnode, in addition to causing heap fragmentation (though it
- * should be insignificant unless free immediately returns memory to the
- * operating system, which it doesn't on Linux at least).
+ * That gives the following amount of entries for these sizes of
+ * zhashtable->arr:
  *
- * The benefit of collision lists is fast retrieval and deletion, but
- * zhashtable_clearunused achieves nearly equally fast deletion, and the
- * use of a single non-growable array for colliding nodes means no heap
- * fragmentation since they don't have to be allocated all the time.
- * Insertion is as fast.
+ *		16 MiB:	1 048 576
+ *		32 MiB:	2 097 152
+ *		64 MiB:	4 194 304
  */
 /*@exposed@*/
-struct zhashtable
+struct zhashnode
 {
 
 	/*
-	 * The table. An array of hashnode pointers. Length = arrc.
-	 *
-	 * Unused ("empty") nodes have value_type HT_AIM_ZHT_VACANT and
-	 * can be overwritten when something needs to be added.
+	 * High 32 bits of the Zobrist key. The low bits are used for
+	 * the index into zhashtable->arr, so together they verify
+	 * that the entry is for the position that's looked up.
 	 */
-/*@notnull@*/
-/*@owned@*/
-	struct zhashnode *	arr;
+	unsigned int		hashlock;
 
 	/*
-	 * Capacity of arr.
+	 * Value of this position.
 	 */
-	size_t			arrc;
+	int			value;
 
 	/*
-	 * Memory for collisions lists.
+	 * Best move found in this position, or HT_BOARDPOS_NONE if it's
+	 * not known (such as in leaf nodes).
 	 */
-	struct zhashcols *	cols;
+	unsigned short		move_pos;
+
+	unsigned short		move_dest;
 
 	/*
-	 * Numbers used to generate the zobrist keys.
-	 *
-	 * Length is zobrist[z_i][z_j].
-	 *
-	 * First dimension (i) is piece type's index from 0 to 7
-	 * converted from its bit value (HT_BIT_U8), which is
-	 * 1, 2, 4...128.
-	 *
-	 * Second dimension (j) is board position.
+	 * Depth left to search. Depths greater than UCHAR_MAX are
+	 * stored as UCHAR_MAX, which only means that the entry is
+	 * trusted less than it could be.
 	 */
-/*@notnull@*/
-/*@owned@*/
-	unsigned int * *	zobrist_key;
+	unsigned char		depthleft;
 
 	/*
-	 * Works exactly like zobrist_key but is generated from
-	 * different random numbers.
+	 * Exactness of value (enum ZVALUE_TYPE).
 	 */
-/*@notnull@*/
-/*@owned@*/
-	unsigned int * *	zobrist_lock;
+	unsigned char		value_type;
 
 	/*
-	 * Length of the first array in zobrist_key. This is equal to
-	 * ruleset->type_piecec.
+	 * Player turn for the given board.
 	 */
-	unsigned short		z_i;
+	unsigned char		p_turn;
 
 	/*
-	 * Length of the second array in zobrist_key. This is equal to
-	 * the board length (ruleset->pieces, or bwidth * bheight).
+	 * zhashtable->age when this entry was last stored or retrieved.
+	 *
+	 * The age is increased once per search (zhashtable_age), and
+	 * entries that were not used in the current search are the
+	 * first to be replaced. This ensures that only relevant entries
+	 * will be kept, without ever sweeping the table.
 	 */
-	unsigned short		z_j;
+	unsigned char		age;
 
 };
 
 /*
- * Memory for collision lists in zhashtable.
+ * HT_ZHASH_BUCKET_LEN entries that share an index in zhashtable->arr.
  *
- * When a new node is added to memchunk, it's always appended last.
- *
- * When a move is removed from memchunk, the last node's (at index
- * memchunk[elemc - 1]) values are copied into the removed node, and
- * then elemc reduces by 1. This works because the nodes in memchunk are
- * randomly ordered, and only referred to from linked collision lists
- * (zhashnode->next).
+ * A position may be stored in any entry in its bucket, so a lookup
+ * reads one cache line (if arr is aligned), and when the bucket is full
+ * the least valuable entry is replaced (see zhashbucket_victim).
+ */
+/*@exposed@*/
+struct zhashbucket
+{
+
+	struct zhashnode	nodes[HT_ZHASH_BUCKET_LEN];
+
+};
+
+/*
+ * zhashtable->arr is the hash table array. This takes (up to, due to
+ * rounding down to a power of two) HT_AI_MINIMAX_HASH_MEM_TAB bytes.
  *
- * NOTE:	This has one weakness: it depends on zhashnode pointers
- *		(reached from zhashtable->arr[x].zhashnode->next)
- *		pointing to memory in zhashcols->memchunk. Thus you can
- *		never re-alloc memchunk, since that will invalidate all
- *		old pointers. You could probably re-generate them, but
- *		it's far easier to require the user to set fixed sizes
- *		for the hash table and collision lists.
+ * The table can not grow (arrc can not increase post-allocation). A new
+ * position always replaces some entry in its bucket, so the table never
+ * stops storing positions when it's full.
  */
-struct zhashcols
+/*@exposed@*/
+struct zhashtable
 {
 
 	/*
-	 * Memory for colliding zhashnodes (zhashnode->next) that are
-	 * not stored in zhashtable->arr.
+	 * The table, aligned to HT_ZHASH_BUCKET_ALIGN. Length = arrc.
 	 *
-	 * Note that nodes in memchunk are not flagged with value_type
-	 * HT_AIM_ZHT_VACANT. It's not necessary since all nodes in
-	 * memchunk up to `elemc - 1` will be non-vacant, and all nodes
-	 * from `elemc` and onwards will be vacant.
+	 * Unused ("empty") nodes have value_type HT_AIM_ZHT_VACANT and
+	 * can be overwritten when something needs to be added.
+	 */
+/*@notnull@*/
+/*@dependent@*/
+	struct zhashbucket *	arr;
+
+	/*
+	 * The memory that arr is in. This is what's freed (or unmapped,
+	 * unless pages is HT_ZHASH_PAGES_HEAP).
 	 */
 /*@notnull@*/
 /*@owned@*/
-	struct zhashnode *	memchunk;
+	void *			arr_mem;
+
+	/*
+	 * Length of arr_mem in bytes.
+	 */
+	size_t			arr_mem_len;
+
+	/*
+	 * What kind of memory arr_mem is.
+	 */
+	enum HT_ZHASH_PAGES	pages;
 
 	/*
-	 * Amount of used zhashnodes in memchunk. elemc <= capc.
+	 * Amount of buckets in arr. This is a power of two, so that the
+	 * index of a key is its low bits (key & arr_mask).
 	 */
-	size_t			elemc;
+	size_t			arrc;
 
 	/*
-	 * Length of memchunk.
+	 * arrc - 1.
 	 */
-	size_t			capc;
+	size_t			arr_mask;
+
+	/*
+	 * Board length (ruleset->opt_blen) of the keys. The keys are
+	 * board->key, made from ruleset->opt_zobrist.
+	 */
+	unsigned short		z_j;
+
+	/*
+	 * zhashconf->zobrist_seed of ruleset->opt_zobrist when the keys
+	 * were made.
+	 */
+	unsigned long		zobrist_seed;
+
+	/*
+	 * Current age, or generation (see zhashnode->age). Increased
+	 * before every search by zhashtable_age.
+	 */
+	unsigned char		age;
 
 };
 
 #endif
 
 #endif
-
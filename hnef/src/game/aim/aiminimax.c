@@ -23,10 +23,11 @@
 #include "aimhash.h"	/* alloc_zhashtable, free_zhashtable, ... */
 #endif
 #include "aiminimax.h"
-#include "board.h"	/* alloc_board, free_board */
 #include "listm.h"	/* alloc_listm, free_listm */
 #include "listmh.h"	/* alloc_listmh, free_listmh */
+#include "num.h"		/* min */
 #include "player.h"	/* player_index_valid */
+#include "types.h"	/* HT_TYPE_MAX */
 
 /*
  * Default listm capacity for moves when allocating.
@@ -70,73 +71,69 @@ aiminimax_depth_max_valid (
 	&& depth_max <= HT_AIM_DEPTHMAX_MAX ? HT_TRUE : HT_FALSE;
 }
 
-/*@null@*/
-/*@only@*/
-/*@partial@*/
+/*
+ * Allocates the search arena of aim, which must have opt_buf_len set,
+ * and points aim->opt_buf_moves, aim->opt_buf_board and
+ * aim->opt_buf_inc into it.
+ *
+ * The arena is one block that holds, in order: the listm structs, the
+ * board structs, the board_inc structs, the moves of every listm and
+ * the pieces of every board. Every listm has room for
+ * g->rules->opt_movec_max moves, which board_moves_get never exceeds,
+ * so they are never reallocated. The struct arrays come first so that
+ * every part is aligned.
+ *
+ * Returns HT_FALSE if out of memory, in which case nothing is
+ * allocated.
+ */
 static
-struct listm * *
-alloc_opt_buf_moves (
-	const unsigned short opt_buf_len
+HT_BOOL
+alloc_opt_arena (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const HT_RSTR	g,
+/*@in@*/
+/*@notnull@*/
+	struct aiminimax * const HT_RSTR	aim
 	)
-/*@modifies nothing@*/
+/*@modifies * aim@*/
 {
-	unsigned short	i;
-	struct listm * * opt_buf_moves = malloc(sizeof(* opt_buf_moves)
-		* opt_buf_len);
-	if (NULL == opt_buf_moves)
+	const size_t	len	= (size_t)aim->opt_buf_len;
+	const size_t	capc	= g->rules->opt_movec_max > 0
+				? g->rules->opt_movec_max : (size_t)1;
+	const size_t	blen	= (size_t)g->rules->opt_blen;
+	struct move *	moves;
+	HT_BIT_U8 *	pieces;
+	size_t		i;
+	char * const	arena	= malloc(len * (sizeof(struct listm)
+				+ sizeof(struct board)
+				+ sizeof(struct board_inc)
+				+ sizeof(struct move) * capc
+				+ sizeof(HT_BIT_U8) * blen));
+	if (NULL == arena)
 	{
-		return		NULL;
-	}
-	for (i = (unsigned short)0; i < opt_buf_len; i++)
-	{
-		opt_buf_moves[i] = alloc_listm(HT_AIM_OPT_LIST_CAP_DEF);
-		if (NULL == opt_buf_moves[i])
-		{
-			unsigned short j;
-			for (j = (unsigned short)0; j < i; j++)
-			{
-				free_listm(opt_buf_moves[j]);
-			}
-			free	(opt_buf_moves);
-			return	NULL;
-		}
+		return	HT_FALSE;
 	}
-	return	opt_buf_moves;
-}
 
-/*@null@*/
-/*@only@*/
-/*@partial@*/
-static
-struct board * *
-alloc_opt_buf_board (
-	const unsigned short	opt_buf_len,
-	const unsigned short	blen
-	)
-/*@modifies nothing@*/
-{
-	unsigned short	i;
-	struct board * * opt_buf_board = malloc(sizeof(* opt_buf_board)
-		* opt_buf_len);
-	if (NULL == opt_buf_board)
-	{
-		return	NULL;
-	}
-	for (i = (unsigned short)0; i < opt_buf_len; i++)
+	aim->opt_arena		= arena;
+	aim->opt_buf_moves	= (struct listm *)arena;
+	aim->opt_buf_board	= (struct board *)
+				(aim->opt_buf_moves + len);
+	aim->opt_buf_inc	= (struct board_inc *)
+				(aim->opt_buf_board + len);
+	moves			= (struct move *)
+				(aim->opt_buf_inc + len);
+	pieces			= (HT_BIT_U8 *)(moves + len * capc);
+
+	for (i = (size_t)0; i < len; i++)
 	{
-		opt_buf_board[i] = alloc_board(blen);
-		if (NULL == opt_buf_board[i])
-		{
-			unsigned short j;
-			for (j = (unsigned short)0; j < i; j++)
-			{
-				free_board(opt_buf_board[j]);
-			}
-			free	(opt_buf_board);
-			return	NULL;
-		}
+		aim->opt_buf_moves[i].elems	= moves + i * capc;
+		aim->opt_buf_moves[i].elemc	= 0;
+		aim->opt_buf_moves[i].capc	= capc;
+		aim->opt_buf_board[i].pieces	= pieces + i * blen;
+		aim->opt_buf_board[i].turn	= (unsigned short)0;
 	}
-	return	opt_buf_board;
+	return	HT_TRUE;
 }
 
 /*
@@ -196,17 +193,16 @@ escval_walk (
 		value + HT_AIM_ESCDIST_MOD);
 }
 
-static
+/*
+ * Fills board_escval (which has the length ruleset->opt_blen and must
+ * be zeroed) with the value of every square depending on its proximity
+ * to escape squares.
+ */
 enum HT_FR
 aiminimax_board_escval_init (
-/*@in@*/
-/*@notnull@*/
 	const struct game * const HT_RSTR	g,
-/*@in@*/
-/*@notnull@*/
 	int * const HT_RSTR			board_escval
 	)
-/*@modifies * board_escval@*/
 {
 	unsigned short	pos;
 
@@ -236,6 +232,192 @@ aiminimax_board_escval_init (
 	return	HT_FR_SUCCESS;
 }
 
+/*
+ * Returns the amount of orthogonal steps from pos to the closest escape
+ * square, ignoring pieces, or 0 if there are no escape squares.
+ */
+static
+int
+aiminimax_escdist (
+/*@in@*/
+/*@notnull@*/
+	const struct ruleset * const HT_RSTR	r,
+	const unsigned short			pos
+	)
+/*@modifies nothing@*/
+{
+	const int	x	= (int)(pos % r->bwidth);
+	const int	y	= (int)(pos / r->bwidth);
+	int		dist	= -1;
+	unsigned short	esc;
+	for (esc = (unsigned short)0; esc < r->opt_blen; esc++)
+	{
+		const HT_BIT_U8 sbit	= r->squares[esc];
+		if (((unsigned int)sbit
+			& (unsigned int)r->opt_ts_escape)
+			== (unsigned int)sbit)
+		{
+			const int dx	= x - (int)(esc % r->bwidth);
+			const int dy	= y - (int)(esc / r->bwidth);
+			const int d	= (dx < 0 ? -dx : dx)
+					+ (dy < 0 ? -dy : dy);
+			if (dist < 0 || d < dist)
+			{
+				dist	= d;
+			}
+		}
+	}
+	return	dist < 0 ? 0 : dist;
+}
+
+/*
+ * Adds the amount of every term in aimevalconf->weights for a king (if
+ * king) or other piece at pos to features, from its owner's point of
+ * view, without g->eval_conf.psq. The value of the piece is the sum of
+ * every term times its weight. See aiminimax_eval_psq_init.
+ */
+void
+aiminimax_psq_features (
+	const struct game * const HT_RSTR	g,
+	const int * const HT_RSTR		board_escval,
+	const HT_BOOL				king,
+	const unsigned short			pos,
+	const int				sign,
+	int * const HT_RSTR			features
+	)
+{
+	const struct ruleset * const HT_RSTR r	= g->rules;
+	const unsigned short x	= (unsigned short)(pos % r->bwidth);
+	const unsigned short y	= (unsigned short)(pos / r->bwidth);
+	const unsigned short dx	= min(x,
+		(unsigned short)(r->bwidth - 1 - x));
+	const unsigned short dy	= min(y,
+		(unsigned short)(r->bheight - 1 - y));
+
+	features[HT_AIM_EVAL_PIECE]	+= sign;
+	if (king)
+	{
+		features[HT_AIM_EVAL_ESCVAL_KING]
+			+= board_escval[pos] * sign;
+		features[HT_AIM_EVAL_KING_ESCDIST]
+			+= aiminimax_escdist(r, pos) * sign;
+		return;
+	}
+
+	features[HT_AIM_EVAL_ESCVAL_NORM]	+=
+		board_escval[pos] * sign;
+	if (0 == dx || 0 == dy)
+	{
+		features[HT_AIM_EVAL_EDGE]	+= sign;
+	}
+	if (1 == dx + dy)
+	{
+		features[HT_AIM_EVAL_CORNER]	+= sign;
+	}
+}
+
+/*
+ * Returns the value of a king (if king) or other piece at pos for its
+ * owner, without g->eval_conf.psq.
+ */
+static
+int
+aiminimax_psq_value (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const HT_RSTR	g,
+/*@in@*/
+/*@notnull@*/
+	const int * const HT_RSTR		board_escval,
+	const HT_BOOL				king,
+	const unsigned short			pos
+	)
+/*@modifies nothing@*/
+{
+	int		features[HT_AIM_EVAL_TERMC];
+	int		value	= 0;
+	int		i;
+
+	for (i = 0; i < (int)HT_AIM_EVAL_TERMC; i++)
+	{
+		features[i]	= 0;
+	}
+	aiminimax_psq_features(g, board_escval, king, pos, 1, features);
+	for (i = 0; i < (int)HT_AIM_EVAL_TERMC; i++)
+	{
+		value	+= features[i] * g->eval_conf.weights[i];
+	}
+	return	value;
+}
+
+/*
+ * Fills eval_psq with the value of every piece type on every square,
+ * from the point of view of p_index, using the weights in g->eval_conf.
+ * These are all the terms that only depend on a piece and its square:
+ *
+ * *	A piece on the board is worth HT_AIM_EVAL_PIECE.
+ *
+ * *	In addition, it's worth whatever the value of board_escval is
+ *	for that position. For "king" pieces (with escape), it's
+ *	multiplied by HT_AIM_EVAL_ESCVAL_KING, and for ordinary pieces
+ *	by HT_AIM_EVAL_ESCVAL_NORM. This makes the computer player a
+ *	little more eager to defend escape squares as well as move the
+ *	king to them.
+ *
+ * *	A king is worth HT_AIM_EVAL_KING_ESCDIST for every step to the
+ *	closest escape square.
+ *
+ * *	Other pieces are worth HT_AIM_EVAL_EDGE on the edge, and
+ *	HT_AIM_EVAL_CORNER next to a corner.
+ *
+ * *	g->eval_conf.psq is added, if the weights file has it.
+ *
+ * Pieces that p_index doesn't own are worth the negated value.
+ */
+static
+void
+aiminimax_eval_psq_init (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const HT_RSTR	g,
+	const unsigned short			p_index,
+/*@in@*/
+/*@notnull@*/
+	const int * const HT_RSTR		board_escval,
+/*@in@*/
+/*@notnull@*/
+	int * const HT_RSTR			eval_psq
+	)
+/*@modifies * eval_psq@*/
+{
+	const struct ruleset * const HT_RSTR r	= g->rules;
+	const HT_BIT_U8	p_owned = g->players[p_index]->opt_owned;
+	unsigned short	i, pos;
+
+	for (i = (unsigned short)0; i < HT_TYPE_MAX; i++)
+	{
+		const HT_BIT_U8 pbit	= (HT_BIT_U8)(1U << i);
+		const HT_BOOL owned = ((unsigned int)pbit
+			& (unsigned int)p_owned)
+			== (unsigned int)pbit;
+		const HT_BOOL king = ((unsigned int)pbit
+			& (unsigned int)r->opt_tp_escape)
+			== (unsigned int)pbit;
+		const size_t	row	= (size_t)i * r->opt_blen;
+
+		for (pos = (unsigned short)0; pos < r->opt_blen; pos++)
+		{
+			int value = aiminimax_psq_value(g, board_escval,
+				king, pos);
+			if (NULL != g->eval_conf.psq)
+			{
+				value += g->eval_conf.psq[row + pos];
+			}
+			eval_psq[row + pos] = owned ? value : -value;
+		}
+	}
+}
+
 /*
  * Allocates all variables and initializes everything.
  *
@@ -247,7 +429,9 @@ aiminimax_board_escval_init (
  * HT_FR_SUCCESS means all parameters were valid and everything worked.
  *
  * old_tab can be given to transfer an old hash table, so that it
- * doesn't have to be allocated again. If it's given (non-NULL), then it
+ * doesn't have to be allocated again. It's only used if
+ * zhashtable_reusable; else (if g->hash_conf has changed) a new table
+ * is allocated and old_tab is freed. If it's given (non-NULL), then it
  * will be preserved (not released!) if the AI fails to allocate.
  */
 struct aiminimax *
@@ -296,9 +480,12 @@ alloc_aiminimax_init (
 	 * Set to NULL here for free_aiminimax.
 	 */
 	aim->board_escval	= NULL;
+	aim->eval_psq		= NULL;
 	aim->opt_moves		= NULL;
+	aim->opt_arena		= NULL;
 	aim->opt_buf_moves	= NULL;
 	aim->opt_buf_board	= NULL;
+	aim->opt_buf_inc	= NULL;
 	aim->opt_movehist	= NULL;
 
 #ifdef HT_AI_MINIMAX_HASH
@@ -307,6 +494,11 @@ alloc_aiminimax_init (
 	aim->p_index		= p_index;
 	aim->depth_max		= depth_max;
 	aim->opt_buf_len	= (unsigned short)(aim->depth_max + 1);
+	aim->nodes		= 0;
+	aim->value		= 0;
+	aim->halt		= NULL;
+	aim->time_start		= aim->time_max	= 0ul;
+	aim->halted		= HT_FALSE;
 
 	aim->opt_moves		= alloc_listm(HT_AIM_OPT_LIST_CAP_DEF);
 	if (NULL == aim->opt_moves)
@@ -324,17 +516,7 @@ alloc_aiminimax_init (
 		return		NULL;
 	}
 
-	aim->opt_buf_moves	= alloc_opt_buf_moves(aim->opt_buf_len);
-	if (NULL == aim->opt_buf_moves)
-	{
-		free_aiminimax	(aim);
-		* fr		= HT_FR_FAIL_ALLOC;
-		return		NULL;
-	}
-
-	aim->opt_buf_board	= alloc_opt_buf_board(aim->opt_buf_len,
-		g->rules->opt_blen);
-	if (NULL == aim->opt_buf_board)
+	if (!alloc_opt_arena(g, aim))
 	{
 		free_aiminimax	(aim);
 		* fr		= HT_FR_FAIL_ALLOC;
@@ -356,8 +538,19 @@ alloc_aiminimax_init (
 		return		NULL;
 	}
 
+	aim->eval_psq	= malloc(sizeof(* aim->eval_psq) * HT_TYPE_MAX
+				* g->rules->opt_blen);
+	if (NULL == aim->eval_psq)
+	{
+		free_aiminimax	(aim);
+		* fr		= HT_FR_FAIL_ALLOC;
+		return		NULL;
+	}
+	aiminimax_eval_psq_init(g, p_index, aim->board_escval,
+		aim->eval_psq);
+
 #ifdef HT_AI_MINIMAX_HASH
-	if (NULL == old_tab)
+	if (NULL == old_tab || !zhashtable_reusable(old_tab, g))
 	{
 /*
  * splint complains about a possible memory leak here. The problem is
@@ -381,6 +574,14 @@ alloc_aiminimax_init (
 			* fr		= HT_FR_FAIL_ALLOC;
 			return		NULL;
 		}
+		if (NULL != old_tab)
+		{
+			/*
+			 * Old table has the wrong size or Zobrist
+			 * numbers: replaced.
+			 */
+			free_zhashtable	(old_tab);
+		}
 	}
 	else
 	{
@@ -395,6 +596,34 @@ alloc_aiminimax_init (
 	return aim;
 }
 
+/*
+ * Makes aim play for p_index instead, so that it can be used again in
+ * a new game where it's the other player. g must have the same
+ * ruleset and weights as the game that aim was made for.
+ *
+ * Returns HT_FR_FAIL_ILL_ARG, and leaves aim alone, if p_index is
+ * invalid.
+ */
+enum HT_FR
+aiminimax_player_set (
+	const struct game * const	g,
+	struct aiminimax * const	aim,
+	const unsigned short		p_index
+	)
+{
+	if (!player_index_valid(p_index))
+	{
+		return	HT_FR_FAIL_ILL_ARG;
+	}
+	if (p_index != aim->p_index)
+	{
+		aim->p_index	= p_index;
+		aiminimax_eval_psq_init(g, p_index, aim->board_escval,
+			aim->eval_psq);
+	}
+	return	HT_FR_SUCCESS;
+}
+
 void
 free_aiminimax (
 	struct aiminimax * const aim
@@ -405,6 +634,11 @@ free_aiminimax (
 		free	(aim->board_escval);
 	}
 
+	if (NULL != aim->eval_psq)
+	{
+		free	(aim->eval_psq);
+	}
+
 #ifdef HT_AI_MINIMAX_HASH
 	if (NULL != aim->tp_tab)
 	{
@@ -419,26 +653,9 @@ free_aiminimax (
 	}
 #endif
 
-	if (NULL != aim->opt_buf_board)
+	if (NULL != aim->opt_arena)
 	{
-		unsigned short i;
-		for (i = (unsigned short)0;
-		i < (unsigned short)(aim->depth_max + 1); i++)
-		{
-			free_board	(aim->opt_buf_board[i]);
-		}
-		free	(aim->opt_buf_board);
-	}
-
-	if (NULL != aim->opt_buf_moves)
-	{
-		unsigned short i;
-		for (i = (unsigned short)0;
-		i < (unsigned short)(aim->depth_max + 1); i++)
-		{
-			free_listm	(aim->opt_buf_moves[i]);
-		}
-		free	(aim->opt_buf_moves);
+		free	(aim->opt_arena);
 	}
 
 	if (NULL != aim->opt_moves)
@@ -69,6 +69,58 @@ alloc_aiminimax_init (
 ;
 /*@=protoparamname@*/
 
+/*@-protoparamname@*/
+extern
+enum HT_FR
+aiminimax_player_set (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const	g,
+/*@in@*/
+/*@notnull@*/
+	struct aiminimax * const	aim,
+	const unsigned short		p_index
+	)
+/*@modifies * aim@*/
+;
+/*@=protoparamname@*/
+
+/*@-protoparamname@*/
+extern
+enum HT_FR
+aiminimax_board_escval_init (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const HT_RSTR	g,
+/*@in@*/
+/*@notnull@*/
+	int * const HT_RSTR			board_escval
+	)
+/*@modifies * board_escval@*/
+;
+/*@=protoparamname@*/
+
+/*@-protoparamname@*/
+extern
+void
+aiminimax_psq_features (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const HT_RSTR	g,
+/*@in@*/
+/*@notnull@*/
+	const int * const HT_RSTR		board_escval,
+	const HT_BOOL				king,
+	const unsigned short			pos,
+	const int				sign,
+/*@in@*/
+/*@notnull@*/
+	int * const HT_RSTR			features
+	)
+/*@modifies * features@*/
+;
+/*@=protoparamname@*/
+
 /*@-protoparamname@*/
 extern
 void
@@ -23,6 +23,7 @@
 #ifdef HT_AI_MINIMAX_HASH
 #include "aimhasht.h"	/* zhashtable */
 #endif
+#include "boolt.h"	/* HT_BOOL */
 
 /*
  * Maximum value for aiminimax->depth_max.
@@ -75,6 +76,20 @@ struct aiminimax
 /*@owned@*/
 	int * 			board_escval;
 
+	/*
+	 * Material value of every piece type on every square, from
+	 * p_index's point of view, derived from board_escval. Length is
+	 * HT_TYPE_MAX * ruleset->opt_blen, indexed by
+	 * type_index_get(piece) * ruleset->opt_blen + position.
+	 *
+	 * board_move_unsafe keeps board_inc->material up to date with
+	 * it.
+	 */
+/*@in@*/
+/*@notnull@*/
+/*@owned@*/
+	int *			eval_psq;
+
 	/*
 	 * Optimization.
 	 *
@@ -90,7 +105,9 @@ struct aiminimax
 	/*
 	 * Optimization.
 	 *
-	 * Move history.
+	 * Move history since the last irreversible move of the game's
+	 * move history (see listmh_copy_rev), and the moves made in the
+	 * search after it.
 	 */
 /*@in@*/
 /*@owned@*/
@@ -100,8 +117,21 @@ struct aiminimax
 	/*
 	 * Optimization.
 	 *
-	 * Pointer to a list of listm structs. The amount of listm
-	 * structs is depth_max + 1.
+	 * Search arena: a single block that holds opt_buf_moves,
+	 * opt_buf_board, opt_buf_inc and all of their moves and pieces.
+	 * See alloc_opt_arena.
+	 */
+/*@in@*/
+/*@owned@*/
+/*@notnull@*/
+	void *			opt_arena;
+
+	/*
+	 * Optimization.
+	 *
+	 * Array of listm structs in opt_arena. The amount of listm
+	 * structs is depth_max + 1, and every one has room for
+	 * ruleset->opt_movec_max moves, so they never grow.
 	 *
 	 * In the aiminimax_min() and aiminimax_max() functions, these
 	 * lists are used (specifically: opt_buf_moves[depth_cur]) so
@@ -110,14 +140,14 @@ struct aiminimax
 	 * aiminimax_min() in aiminimax_command().
 	 */
 /*@in@*/
-/*@owned@*/
+/*@dependent@*/
 /*@notnull@*/
-	struct listm * *	opt_buf_moves;
+	struct listm *		opt_buf_moves;
 
 	/*
 	 * Optimization.
 	 *
-	 * Pointer to a list of board structs. The amount of board
+	 * Array of board structs in opt_arena. The amount of board
 	 * structs is depth_max + 1.
 	 *
 	 * In the aiminimax_min() and aiminimax_max() functions, these
@@ -127,15 +157,61 @@ struct aiminimax
 	 * aiminimax_min() in aiminimax_command().
 	 */
 /*@in@*/
-/*@owned@*/
+/*@dependent@*/
+/*@notnull@*/
+	struct board *		opt_buf_board;
+
+	/*
+	 * Optimization.
+	 *
+	 * Array of board_inc structs in opt_arena, one for every board
+	 * in opt_buf_board, so that aiminimax_min() and aiminimax_max()
+	 * don't keep a copy on the stack.
+	 */
+/*@in@*/
+/*@dependent@*/
 /*@notnull@*/
-	struct board * *	opt_buf_board;
+	struct board_inc *	opt_buf_inc;
 
 	/*
-	 * Length of opt_buf_moves and opt_buf_board.
+	 * Length of opt_buf_moves, opt_buf_board and opt_buf_inc.
 	 */
 	unsigned short		opt_buf_len;
 
+	/*
+	 * Amount of positions visited by aiminimax_min and
+	 * aiminimax_max during the last call to aiminimax_command.
+	 */
+	unsigned long		nodes;
+
+	/*
+	 * Value of the best move from p_index's point of view, found by
+	 * the deepest search that was completed during the last call to
+	 * aiminimax_command. 0 if there was only one move to make.
+	 */
+	int			value;
+
+	/*
+	 * If halt is not NULL, the search stops at once when it's set
+	 * to true, which another thread may do. If time_max is not 0,
+	 * the search stops at once when time_max milliseconds have
+	 * passed since time_start (see ht_timer_ms). They're looked at
+	 * every few thousand positions, so a search that is stopped
+	 * this way doesn't wait for the move at the root to be done,
+	 * like ui_ai_stop does.
+	 *
+	 * halted is set when the search was stopped this way.
+	 */
+/*@dependent@*/
+/*@null@*/
+	const volatile HT_BOOL *	halt;
+
+	unsigned long		time_start;
+
+	unsigned long		time_max;
+
+	HT_BOOL			halted;
+
 };
 
 #endif
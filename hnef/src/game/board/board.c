@@ -16,17 +16,18 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 #include <stdlib.h>	/* malloc, free */
-#include <string.h>	/* memset */
+#include <string.h>	/* memcpy, memset */
 
-#ifdef HT_AI_MINIMAX
-#include "types.h"		/* type_index_get */
+#ifdef HT_AI_MINIMAX_HASH
+#include "aimhash.h"		/* HT_ZHASH_PREFETCH */
 #endif
 #include "board.h"
-#include "listm.h"		/* listm_add */
+#include "listm.h"		/* listm_reserve */
 #include "listmh.h"		/* listmh_add */
 #include "num.h"		/* min, max */
 #include "type_piece.h"		/* type_piece_get */
 #include "type_square.h"	/* type_square_get */
+#include "types.h"		/* type_index_get */
 
 #ifdef HT_AI_MINIMAX
 
@@ -45,6 +46,7 @@ board_copy (
 {
 	memcpy(dest->pieces, src->pieces, (size_t)blen);
 	dest->turn	= src->turn;
+	dest->key	= src->key;
 }
 
 #endif /* HT_AI_MINIMAX */
@@ -72,33 +74,78 @@ board_turn_adv (
 	}
 }
 
-#ifdef HT_AI_MINIMAX_HASH
-
 /*
- * Flags a piece in hashkey and hashlock as captured.
+ * Puts or removes piece pbit at pos in b->key.
  */
 static
 void
-board_hash_xor (
+board_key_piece (
 /*@in@*/
 /*@notnull@*/
-	const struct zhashtable * const HT_RSTR	hashtable,
+	const struct game * const HT_RSTR	g,
 /*@in@*/
 /*@notnull@*/
-	unsigned int * const HT_RSTR		hashkey,
+	struct board * const HT_RSTR		b,
+	const HT_BIT_U8				pbit,
+	const unsigned short			pos
+	)
+/*@modifies b->key@*/
+{
+	b->key	^= g->rules->opt_zobrist[type_index_get(pbit)
+		* g->rules->opt_blen + pos];
+}
+
+/*
+ * Returns the Zobrist key of the pieces in b and b->turn, which is
+ * what board->key should be. See ruleset->opt_zobrist.
+ */
+HT_U64
+board_key_get (
+	const struct game * const HT_RSTR	g,
+	const struct board * const HT_RSTR	b
+	)
+{
+	HT_U64		key	= 0;
+	unsigned short	pos;
+	for (pos = (unsigned short)0; pos < g->rules->opt_blen; pos++)
+	{
+		const HT_BIT_U8 pbit	= b->pieces[pos];
+		if (HT_BIT_U8_EMPTY != pbit)
+		{
+			key ^= g->rules->opt_zobrist[type_index_get(pbit)
+				* g->rules->opt_blen + pos];
+		}
+	}
+	if ((unsigned short)1 == b->turn)
+	{
+		key ^= g->rules->opt_zobrist_turn;
+	}
+	return	key;
+}
+
+#ifdef HT_AI_MINIMAX
+
+/*
+ * Puts (sign 1) or removes (sign -1) piece pbit at pos in inc.
+ */
+static
+void
+board_inc_piece (
 /*@in@*/
 /*@notnull@*/
-	unsigned int * const HT_RSTR		hashlock,
-	const unsigned short			piece_index,
-	const unsigned short			pos
+	struct board_inc * const HT_RSTR	inc,
+	const unsigned short			blen,
+	const HT_BIT_U8				pbit,
+	const unsigned short			pos,
+	const int				sign
 	)
-/*@modifies * hashkey, * hashlock@*/
+/*@modifies * inc@*/
 {
-	* hashkey ^= hashtable->zobrist_key	[piece_index][pos];
-	* hashlock ^= hashtable->zobrist_lock	[piece_index][pos];
+	inc->material	+= inc->psq[type_index_get(pbit) * blen + pos]
+			* sign;
 }
 
-#endif /* HT_AI_MINIMAX_HASH */
+#endif /* HT_AI_MINIMAX */
 
 /*
  * Checks if pt_adj (at b->pieces[adj]) is captured by an enemy piece
@@ -147,6 +194,11 @@ board_hash_xor (
  * distinguish between -100 and -1 -- they are both treated as -1. Thus
  * you can only "hop" over one piece using skipx / skipy.)
  *
+ * vacated is a square that's taken to be empty whatever is on it: the
+ * square that the moving piece left, when the move has not been made
+ * on b (see board_move_captures). It's g->rules->opt_blen (no square)
+ * when it has.
+ *
  * If a non-empty piece or square type that is on the board is not
  * defined in ruleset, then it always returns HT_FALSE, without giving
  * an indication of failure.
@@ -161,6 +213,7 @@ board_is_capt (
 /*@notnull@*/
 	const struct board * const HT_RSTR	b,
 	const unsigned short			dest,
+	const unsigned short			vacated,
 /*@in@*/
 /*@notnull@*/
 	const struct type_piece * const HT_RSTR	pt_adj,
@@ -312,7 +365,8 @@ board_is_capt (
 		adjadj		= (unsigned short)
 			(adjadjy * g->rules->bwidth + adjadjx);
 		sb_adjadj	= g->rules->squares	[adjadj];
-		pb_adjadj	= b->pieces		[adjadj];
+		pb_adjadj	= vacated == adjadj ? HT_BIT_U8_EMPTY
+				: b->pieces[adjadj];
 		if (HT_BIT_U8_EMPTY == sb_adjadj)
 		{
 			switch (axisx)
@@ -496,39 +550,33 @@ board_is_capt (
  * parameters) and double trap settings may override capt_sides and
  * custodial.
  *
- * Returns HT_TRUE if adj is captured in double trap; false if not.
+ * vacated is as in board_is_capt.
+ *
+ * Returns HT_TRUE if adj is trapped together with the piece at
+ * adjadj (which is then set), in which case either or both of them are
+ * captured (see type_piece->dbl_trap_capt); false if not. b is not
+ * changed.
  */
 static
 HT_BOOL
-board_do_dtrap (
+board_is_dtrap (
 /*@in@*/
 /*@notnull@*/
 	const struct game * const HT_RSTR	g,
 /*@in@*/
 /*@notnull@*/
-	struct board * const			b,
+	const struct board * const HT_RSTR	b,
 	const unsigned short			dest,
+	const unsigned short			vacated,
 /*@in@*/
 /*@notnull@*/
 	const struct type_piece * const HT_RSTR	pt_adj,
-	const unsigned short			adj
-#ifdef HT_AI_MINIMAX_HASH
-	,
-/*@in@*/
-/*@null@*/
-	const struct zhashtable * const HT_RSTR	hashtable,
-/*@in@*/
-/*@null@*/
-	unsigned int * const			hashkey,
-/*@in@*/
-/*@null@*/
-	unsigned int * const			hashlock
-#endif
+	const unsigned short			adj,
+/*@out@*/
+/*@notnull@*/
+	unsigned short * const HT_RSTR		adjadj_out
 	)
-/*@modifies * b@*/
-#ifdef HT_AI_MINIMAX_HASH
-/*@modifies * hashkey, * hashlock@*/
-#endif
+/*@modifies * adjadj_out@*/
 {
 	/*
 	 * Assumes that dest and adj are within bounds (this is
@@ -594,7 +642,8 @@ board_do_dtrap (
 		adjadj		= (unsigned short)
 			(adjadjy * g->rules->bwidth + adjadjx);
 		sb_adjadj	= g->rules->squares	[adjadj];
-		pb_adjadj	= b->pieces		[adjadj];
+		pb_adjadj	= vacated == adjadj ? HT_BIT_U8_EMPTY
+				: b->pieces[adjadj];
 		if (HT_BIT_U8_EMPTY == sb_adjadj)
 		{
 			continue;
@@ -634,108 +683,117 @@ board_do_dtrap (
 			continue;
 		}
 
+		if (board_is_capt(g, b, dest, vacated, pt_adj, adj,
+			skipx, skipy)
+		&& board_is_capt(g, b, dest, vacated,
+			type_piece_get(g->rules, pb_adjadj), adjadj,
+			-skipx, -skipy))
 		{
-			const struct type_piece * const HT_RSTR
-				pt_adjadj =
-				type_piece_get(g->rules, pb_adjadj);
-
-			if (board_is_capt(g, b, dest, pt_adj, adj,
-				skipx, skipy)
-			&& board_is_capt(g, b, dest,
-				pt_adjadj, adjadj, -skipx, -skipy))
-			{
-#ifdef HT_AI_MINIMAX_HASH
-				if (NULL != hashkey
-#if !defined(HT_UNSAFE) && !defined(HT_AI_MINIMAX_UNSAFE)
-				&& NULL != hashlock && NULL != hashtable
-#endif
-				)
-				{
-					if (pt_adj->dbl_trap_capt)
-					{
-						board_hash_xor(
-						hashtable, hashkey,
-						hashlock, type_index_get
-						(pb_adj), adj);
-					}
-					if (pt_adjadj->dbl_trap_capt)
-					{
-						board_hash_xor(
-						hashtable, hashkey,
-						hashlock, type_index_get
-						(pb_adjadj), adjadj);
-					}
-				}
-#endif /* HT_AI_MINIMAX */
-				if (pt_adj->dbl_trap_capt)
-				{
-					b->pieces[adj] =
-						HT_BIT_U8_EMPTY;
-				}
-				if (pt_adjadj->dbl_trap_capt)
-				{
-					b->pieces[adjadj] =
-						HT_BIT_U8_EMPTY;
-				}
-				return	HT_TRUE;
-			}
+			* adjadj_out	= adjadj;
+			return		HT_TRUE;
 		}
 	}
 	return	HT_FALSE;
 }
 
 /*
- * Checks if the piece at adj is captured (either normally or by double
- * trap) by pt_mov moving to dest, and if so, removes it from the board.
- *
- * Returns true if any piece was captured.
- *
- * hashtable may be NULL if hashkey also is NULL, as in
- * board_do_captures.
- *
- * Returns false if any parameter is invalid, with no other indication
- * of failure.
- *
- * NOTE:	Checking for double trap takes precedence over checking
- *		for ordinary captures. If a double trap triggers (and
- *		pt_adj is not captured, even though pt_adj triggers the
- *		double trap), then it doesn't even check if pt_adj is
- *		captured according to normal capturing rules.
+ * Checks if pt_adj (at b->pieces[adj]) is captured by an enemy piece
+ * moving to dest according to double trap capturing rules, as in
+ * board_is_dtrap, and if so, removes the captured pieces from b. inc
+ * may be NULL, as in board_do_captures.
  *
- *		It's up to the ruleset writer to make sure that this
- *		doesn't cause strange behavior in the game.
+ * Returns HT_TRUE if pieces were captured in double trap.
  */
 static
 HT_BOOL
-board_do_capture (
+board_do_dtrap (
 /*@in@*/
 /*@notnull@*/
 	const struct game * const HT_RSTR	g,
 /*@in@*/
 /*@notnull@*/
 	struct board * const			b,
+	const unsigned short			dest,
 /*@in@*/
 /*@notnull@*/
-	const struct type_piece * const HT_RSTR	pt_mov,
-	const unsigned short			dest,
+	const struct type_piece * const HT_RSTR	pt_adj,
 	const unsigned short			adj
-#ifdef HT_AI_MINIMAX_HASH
+#ifdef HT_AI_MINIMAX
 	,
 /*@in@*/
 /*@null@*/
-	const struct zhashtable * const HT_RSTR	hashtable,
-/*@in@*/
-/*@null@*/
-	unsigned int * const			hashkey,
-/*@in@*/
-/*@null@*/
-	unsigned int * const			hashlock
+	struct board_inc * const		inc
 #endif
 	)
 /*@modifies * b@*/
-#ifdef HT_AI_MINIMAX_HASH
-/*@modifies * hashkey, * hashlock@*/
+#ifdef HT_AI_MINIMAX
+/*@modifies * inc@*/
 #endif
+{
+	const HT_BIT_U8				pb_adj	= b->pieces[adj];
+	HT_BIT_U8				pb_adjadj;
+	const struct type_piece * HT_RSTR	pt_adjadj;
+	unsigned short				adjadj;
+
+	if (!board_is_dtrap(g, b, dest, g->rules->opt_blen, pt_adj, adj,
+		& adjadj))
+	{
+		return	HT_FALSE;
+	}
+	pb_adjadj	= b->pieces[adjadj];
+	pt_adjadj	= type_piece_get(g->rules, pb_adjadj);
+
+#ifdef HT_AI_MINIMAX
+	if (NULL != inc)
+	{
+		if (pt_adj->dbl_trap_capt)
+		{
+			board_inc_piece(inc, g->rules->opt_blen,
+				pb_adj, adj, -1);
+		}
+		if (pt_adjadj->dbl_trap_capt)
+		{
+			board_inc_piece(inc, g->rules->opt_blen,
+				pb_adjadj, adjadj, -1);
+		}
+	}
+#endif /* HT_AI_MINIMAX */
+	if (pt_adj->dbl_trap_capt)
+	{
+		board_key_piece(g, b, pb_adj, adj);
+		b->pieces[adj]		= HT_BIT_U8_EMPTY;
+	}
+	if (pt_adjadj->dbl_trap_capt)
+	{
+		board_key_piece(g, b, pb_adjadj, adjadj);
+		b->pieces[adjadj]	= HT_BIT_U8_EMPTY;
+	}
+	return	HT_TRUE;
+}
+
+/*
+ * Returns the type of the piece at adj if pt_mov, moving to dest, can
+ * capture it; else NULL (also if there's no piece at adj, or if any
+ * parameter is invalid).
+ */
+/*@null@*/
+/*@observer@*/
+static
+const struct type_piece *
+board_capt_adj (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const HT_RSTR	g,
+/*@in@*/
+/*@notnull@*/
+	const struct board * const HT_RSTR	b,
+/*@in@*/
+/*@notnull@*/
+	const struct type_piece * const HT_RSTR	pt_mov,
+	const unsigned short			dest,
+	const unsigned short			adj
+	)
+/*@modifies nothing@*/
 {
 	HT_BIT_U8				pb_adj;
 	const struct type_piece * HT_RSTR	pt_adj	= NULL;
@@ -751,16 +809,18 @@ board_do_capture (
 			/*
 			 * Illegal argument(s).
 			 */
-			return	HT_FALSE;
+			return	NULL;
 		}
 	}
+#else
+	(void) dest;
 #endif
 
 	pb_adj	= b->pieces[adj];
 	if (HT_BIT_U8_EMPTY == pb_adj
 	|| !type_piece_can_hammer(pt_mov, pb_adj))
 	{
-		return	HT_FALSE;
+		return	NULL;
 	}
 
 	pt_adj	= type_piece_get(g->rules, pb_adj);
@@ -770,37 +830,92 @@ board_do_capture (
 		/*
 		 * Illegal game state: all pieces must be defined.
 		 */
-		return	HT_FALSE;
+		return	NULL;
 	}
 #endif
+	return	pt_adj;
+}
+
+/*
+ * Checks if the piece at adj is captured (either normally or by double
+ * trap) by pt_mov moving to dest, and if so, removes it from the board.
+ *
+ * Returns true if any piece was captured.
+ *
+ * inc may be NULL, as in board_do_captures.
+ *
+ * Returns false if any parameter is invalid, with no other indication
+ * of failure.
+ *
+ * NOTE:	Checking for double trap takes precedence over checking
+ *		for ordinary captures. If a double trap triggers (and
+ *		pt_adj is not captured, even though pt_adj triggers the
+ *		double trap), then it doesn't even check if pt_adj is
+ *		captured according to normal capturing rules.
+ *
+ *		It's up to the ruleset writer to make sure that this
+ *		doesn't cause strange behavior in the game.
+ */
+static
+HT_BOOL
+board_do_capture (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const HT_RSTR	g,
+/*@in@*/
+/*@notnull@*/
+	struct board * const			b,
+/*@in@*/
+/*@notnull@*/
+	const struct type_piece * const HT_RSTR	pt_mov,
+	const unsigned short			dest,
+	const unsigned short			adj
+#ifdef HT_AI_MINIMAX
+	,
+/*@in@*/
+/*@null@*/
+	struct board_inc * const		inc
+#endif
+	)
+/*@modifies * b@*/
+#ifdef HT_AI_MINIMAX
+/*@modifies * inc@*/
+#endif
+{
+	const struct type_piece * const HT_RSTR	pt_adj	=
+		board_capt_adj(g, b, pt_mov, dest, adj);
+	HT_BIT_U8				pb_adj;
 
 	/*
 	 * If pt_mov can't capture pb_adj, then don't check double trap
 	 * or ordinary capture.
 	 */
+	if (NULL == pt_adj)
+	{
+		return	HT_FALSE;
+	}
 
 	if (board_do_dtrap(g, b, dest, pt_adj, adj
-#ifdef HT_AI_MINIMAX_HASH
-		, hashtable, hashkey, hashlock
+#ifdef HT_AI_MINIMAX
+		, inc
 #endif
 		))
 	{
 		return	HT_TRUE;
 	}
 
-	if (board_is_capt(g, b, dest, pt_adj, adj, 0, 0))
+	pb_adj	= b->pieces[adj];
+	if (board_is_capt(g, b, dest, g->rules->opt_blen, pt_adj, adj,
+		0, 0))
 	{
-#ifdef HT_AI_MINIMAX_HASH
-		if (NULL != hashkey
-#if !defined(HT_UNSAFE) && !defined(HT_AI_MINIMAX_UNSAFE)
-		&& NULL != hashlock && NULL != hashtable
-#endif
-		)
+#ifdef HT_AI_MINIMAX
+		if (NULL != inc)
 		{
-			board_hash_xor(hashtable, hashkey,
-				hashlock, type_index_get(pb_adj), adj);
+			board_inc_piece(inc, g->rules->opt_blen,
+				pb_adj, adj, -1);
 		}
 #endif
+		board_key_piece	(g, b, pb_adj, adj);
 		b->pieces[adj]	= HT_BIT_U8_EMPTY;
 		return		HT_TRUE;
 	}
@@ -823,8 +938,7 @@ board_do_capture (
  * about that since we need to cover all possible cases based on ruleset
  * options.
  *
- * hashtable may be NULL if hashkey is also NULL, like in
- * board_move_unsafe.
+ * inc may be NULL, like in board_move_unsafe.
  *
  * opt_pt_mov is the moving piece. It's given as a parameter as an
  * optimization because move_unsafe() has to retrieve it anyway, which
@@ -848,22 +962,16 @@ board_do_captures (
 /*@notnull@*/
 	const struct type_piece * const HT_RSTR	opt_pt_mov,
 	const unsigned short			dest
-#ifdef HT_AI_MINIMAX_HASH
+#ifdef HT_AI_MINIMAX
 	,
 /*@in@*/
 /*@null@*/
-	const struct zhashtable * const HT_RSTR	hashtable,
-/*@in@*/
-/*@null@*/
-	unsigned int * const			hashkey,
-/*@in@*/
-/*@null@*/
-	unsigned int * const			hashlock
+	struct board_inc * const		inc
 #endif
 	)
 /*@modifies * b@*/
-#ifdef HT_AI_MINIMAX_HASH
-/*@modifies * hashkey, * hashlock@*/
+#ifdef HT_AI_MINIMAX
+/*@modifies * inc@*/
 #endif
 {
 	HT_BOOL		captured = HT_FALSE;
@@ -916,8 +1024,8 @@ board_do_captures (
 		adj = (unsigned short)(adjy * g->rules->bwidth + adjx);
 
 		captured = board_do_capture(g, b, opt_pt_mov, dest, adj
-#ifdef HT_AI_MINIMAX_HASH
-			, hashtable, hashkey, hashlock
+#ifdef HT_AI_MINIMAX
+			, inc
 #endif
 			) || captured;
 	}
@@ -925,71 +1033,91 @@ board_do_captures (
 }
 
 /*
- * Checks if pos to dest constitutes repetition, considering the given
- * move history.
- *
- * MOVE	POS		DEST	REP?	TYPE		CHECK
- * 1	A	->	B	No	threat		. -> B
- * 2	X	->	Y	No	defense			. -> Y
- * 3	B	->	C	No	revert-threat	B -> C
- * 4	Y	->	Z	No	revert-defense		Y -> .
- * 5	C	->	B	Yes	repeat-threat	C -> B
- *
- * (Note that MOVE 5 is pos / dest. Also note that we don't need to know
- * if pos / dest is a reversible move, because we know that if it moves
- * from C to B, and previously moved from ? -> B and then B -> C and
- * MOVE 1 and 3 are reversible, then MOVE 5 must also be reversible.)
- *
- * *	If any of the moves 1-4 is irreversible, then it's not
- *	repetition.
- *
- * *	A does not have to (but may) equal C. We already know it is the
- *	same piece.
- *	Thus move 3 is not necessarily strictly a reversion from C to A.
- *
- * *	X does not have to (but may) equal Z. We already know it is the
- *	same piece.
- *	Thus move 4 is not necessarily strictly a reversion from Y to X.
- *
- * *	A, X and Z are completely irrelevant since they don't have
- *	anything to do with the threat-defense exchange; for example, a
- *	piece could move from random square A to threat-square B, then
- *	to random square C (A != C) and back to threat-square B, and it
- *	would still be repetition. X and Z do not matter since the piece
- *	that moves to / from Y is assumed to defend, and the purpose of
- *	the rule is to forbit perpetual threats (you can usually choose
- *	to stop threatening without immediate loss, but that's typically
- *	not the case when defending -- thus the attacker is expected to
- *	alternate).
- *
- * NOTE:	Note that a piece moving from pos to dest, where dest is
- *		an escape square for the piece, causes the game to be
- *		over (won). Then no more moves will be made.
- *		moveh are only added by two functions: board_move_safe()
- *		and board_move_unsafe(). moveh structs are never
- *		retrieved from board_moves_get().
- *		Putting these facts together, it follows that an
- *		escaping move will never be the last move in a listmh
- *		when this function is called. The move to be evaluated
- *		is pos / dest, and if this function returns true, then
- *		it's implied that pos / dest does not constitute an
- *		escaping move.
- *		Therefore (in board_move_(un)safe()) we never check if a
- *		move is escaping when determining moveh->irrev. It will
- *		not affect the behavior of this function in any possible
- *		situation.
- *
- *		Also, if you moved from B to C, and are now moving back
- *		from C (pos) to B (dest), then C can not be a noreturn
- *		square for that piece while B is not -- then the move
- *		from B to C would've been illegal. Therefore we don't
- *		have to check for that in this function -- but we do
- *		need to check for it in board_move_unsafe() (which we
- *		also do).
- *
- * NOTE:	There may be odd situations where this gives false
- *		positives; and there may be odd situations where this
- *		doesn't properly trigger repetition.
+ * Returns true if pt_mov, moving from pos to dest in b, would capture
+ * any piece, without making the move: pos is taken to be empty (see
+ * board_is_capt). This is board_do_captures for a move that is not
+ * made, so the same assumptions hold.
+ */
+static
+HT_BOOL
+board_move_captures (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const HT_RSTR	g,
+/*@in@*/
+/*@notnull@*/
+	const struct board * const HT_RSTR	b,
+/*@in@*/
+/*@notnull@*/
+	const struct type_piece * const HT_RSTR	pt_mov,
+	const unsigned short			pos,
+	const unsigned short			dest
+	)
+/*@modifies nothing@*/
+{
+	const unsigned short	destx	= dest % g->rules->bwidth;
+	const unsigned short	desty	= dest / g->rules->bwidth;
+	int			i;
+
+	for (i = 0; i < 4; i++)
+	{
+		const struct type_piece * HT_RSTR	pt_adj;
+		unsigned short	adjx	= destx;
+		unsigned short	adjy	= desty;
+		unsigned short	adj,	adjadj;
+
+		switch (i)
+		{
+			case 0:
+				adjx++;
+/* splint break */ /*@i1@*/	break;
+			case 1:
+				adjx--;
+/* splint break */ /*@i1@*/	break;
+			case 2:
+				adjy++;
+/* splint break */ /*@i1@*/	break;
+			default:
+				adjy--;
+/* splint break */ /*@i1@*/	break;
+		}
+
+		if (adjx >= g->rules->bwidth
+		|| adjy >= g->rules->bheight)
+		{
+			continue;
+		}
+		adj = (unsigned short)(adjy * g->rules->bwidth + adjx);
+		if (pos == adj)
+		{
+			continue;
+		}
+
+		pt_adj	= board_capt_adj(g, b, pt_mov, dest, adj);
+		if (NULL != pt_adj
+		&& (board_is_dtrap(g, b, dest, pos, pt_adj, adj, & adjadj)
+		|| board_is_capt(g, b, dest, pos, pt_adj, adj, 0, 0)))
+		{
+			return	HT_TRUE;
+		}
+	}
+	return	HT_FALSE;
+}
+
+/*
+ * Returns true if moving from pos to dest in b repeats a position that
+ * has been on the board since the last irreversible move in movehist.
+ *
+ * The key of the new position is b->key with the piece moved and the
+ * turn passed, and it's compared to the key before every move back to
+ * the last irreversible one (moveh->key), so any cycle is found and
+ * only positions that can still come back are looked at.
+ *
+ * The key doesn't include captures, since most moves don't capture.
+ * Every position since the last irreversible move has all the pieces
+ * that b has, so a move that captures never repeats one; but its key
+ * without the capture might. Therefore, if a key matches, the move is
+ * checked for captures with board_move_captures.
  */
 static
 HT_BOOL
@@ -997,80 +1125,51 @@ board_is_repeat (
 /*@in@*/
 /*@notnull@*/
 	const struct game * const HT_RSTR	g,
+/*@in@*/
+/*@notnull@*/
+	const struct board * const HT_RSTR	b,
+/*@in@*/
+/*@notnull@*/
+	const struct type_piece * const HT_RSTR	opt_pt_mov,
 	const unsigned short			pos,
 	const unsigned short			dest,
 /*@in@*/
-/*@notnull@*/
+/*@null@*/
 	const struct listmh * const HT_RSTR	movehist
 	)
 /*@modifies nothing@*/
 {
-	unsigned short	pos_b,	pos_c,	pos_y;
-	size_t		i;
-	if (!g->rules->forbid_repeat || movehist->elemc < (size_t)4)
+	const HT_U64 * const	zobrist	= g->rules->opt_zobrist;
+	const unsigned short	pb_ind	= type_index_get(b->pieces[pos]);
+	const HT_U64		key	= b->key
+		^ zobrist[pb_ind * g->rules->opt_blen + pos]
+		^ zobrist[pb_ind * g->rules->opt_blen + dest]
+		^ g->rules->opt_zobrist_turn;
+	size_t			i;
+
+	if (!g->rules->forbid_repeat || NULL == movehist)
 	{
-		/*
-		 * Repetition not forbidden, or too few moves.
-		 */
 		return	HT_FALSE;
 	}
-	pos_b	= pos_c	= pos_y	= HT_BOARDPOS_NONE;
 
-	/*
-	 * The last move in the move history that we are considering, is
-	 * the move that we are about to make, id est the pos / dest
-	 * parameters.
-	 */
-	pos_b	= dest;
-	pos_c	= pos;
-
-	/*
-	 * Go from last move and check backwards. i = 1 is last move.
-	 */
-	for (i = (size_t)1; i <= (size_t)4; i++)
+	for (i = movehist->elemc; i > 0; i--)
 	{
 		const struct moveh * const HT_RSTR mh =
-			& movehist->elems[movehist->elemc - i];
+			& movehist->elems[i - 1];
 		if (mh->irrev)
 		{
 			/*
-			 * Game end is irreversible, and the last move
-			 * should not trigger repetition if it causes
-			 * win or loss (which is impossible because then
-			 * the win should have happened several moves
-			 * ago, but still).
+			 * The position before mh can't come back.
 			 */
 			return	HT_FALSE;
 		}
-
-		switch (i)
+		if (key == mh->key)
 		{
-			case 1:
-				pos_y	= mh->pos;
-/*@i1@*/			break;
-			case 2:
-				if (mh->pos != pos_b
-				|| mh->dest != pos_c)
-				{
-					return	HT_FALSE;
-				}
-/*@i1@*/			break;
-			case 3:
-				if (mh->dest != pos_y)
-				{
-					return	HT_FALSE;
-				}
-/*@i1@*/			break;
-			/* case 4: */
-			default:
-				if (mh->dest != pos_b)
-				{
-					return	HT_FALSE;
-				}
-/*@i1@*/			break;
+			break;
 		}
 	}
-	return	HT_TRUE;
+	return	i > (size_t)0 && !board_move_captures(g, b, opt_pt_mov,
+		pos, dest);
 }
 
 /*
@@ -1130,7 +1229,7 @@ board_move_legal (
 /*@notnull@*/
 	const struct board * const HT_RSTR	b,
 /*@in@*/
-/*@notnull@*/
+/*@null@*/
 	const struct listmh * const HT_RSTR	movehist,
 	const unsigned short			index,
 	const unsigned short			pos,
@@ -1268,7 +1367,7 @@ board_move_legal (
 
 	// unimpede, this square is only unreachable because of repetition rules!
 	* impeded = HT_FALSE;
-	if (board_is_repeat(g, pos, dest, movehist))
+	if (board_is_repeat(g, b, opt_pt_mov, pos, dest, movehist))
 	{
 		return	HT_FALSE;
 	}
@@ -1291,10 +1390,8 @@ board_move_legal (
  * and so may write past the end of allocated memory if you give it bad
  * coordinates.
  *
- * The hashkey is allowed to be NULL. If so it will be ignored, and
- * hashtable will also be expected to be NULL (but you are allowed to
- * pass a non-NULL hashtable anyway). If the hashkey is non-NULL, then
- * the hashtable must also be a valid non-NULL hashtable.
+ * inc is allowed to be NULL. If so it will be ignored. Else its
+ * material is updated for the moved and captured pieces.
  */
 enum HT_FR
 board_move_unsafe (
@@ -1303,16 +1400,15 @@ board_move_unsafe (
 	struct listmh * const			movehist,
 	const unsigned short			pos,
 	const unsigned short			dest
-#ifdef HT_AI_MINIMAX_HASH
+#ifdef HT_AI_MINIMAX
 	,
-	const struct zhashtable * const HT_RSTR	hashtable,
-	unsigned int * const			hashkey,
-	unsigned int * const			hashlock
+	struct board_inc * const		inc
 #endif
 	)
 {
 	const struct type_piece * HT_RSTR	pt_mov	= NULL;
 	HT_BOOL					irrev	= HT_FALSE;
+	const HT_U64				key	= b->key;
 #if !defined(HT_UNSAFE) && !defined(HT_AI_MINIMAX_UNSAFE)
 	if (NULL == g || NULL == b)
 	{
@@ -1329,28 +1425,24 @@ board_move_unsafe (
 #endif
 
 	/*
-	 * Set the hashkey at dest and unset it at pos.
+	 * Put the piece at dest and remove it from pos in inc.
 	 *
 	 * NOTE:	This assumes that dest was empty before the
 	 *		move, id est that pieces can not move to
 	 *		non-empty squares.
 	 */
-#ifdef HT_AI_MINIMAX_HASH
-	if (NULL != hashkey
-#if !defined(HT_UNSAFE) && !defined(HT_AI_MINIMAX_UNSAFE)
-	&& NULL != hashlock && NULL != hashtable
-#endif
-	)
+#ifdef HT_AI_MINIMAX
+	if (NULL != inc)
 	{
-		const unsigned short pb_ind =
-			type_index_get(b->pieces[pos]);
-		board_hash_xor(hashtable, hashkey,
-			hashlock, pb_ind, dest);
-		board_hash_xor(hashtable, hashkey,
-			hashlock, pb_ind, pos);
+		board_inc_piece(inc, g->rules->opt_blen,
+			b->pieces[pos], dest, 1);
+		board_inc_piece(inc, g->rules->opt_blen,
+			b->pieces[pos], pos, -1);
 	}
 #endif
 
+	board_key_piece	(g, b, b->pieces[pos], dest);
+	board_key_piece	(g, b, b->pieces[pos], pos);
 	b->pieces[dest]	= b->pieces[pos];
 	b->pieces[pos]	= HT_BIT_U8_EMPTY;
 
@@ -1360,8 +1452,8 @@ board_move_unsafe (
 	 * move is not reversible.
 	 */
 	irrev	= board_do_captures(g, b, pt_mov, dest
-#ifdef HT_AI_MINIMAX_HASH
-		, hashtable, hashkey, hashlock
+#ifdef HT_AI_MINIMAX
+		, inc
 #endif
 		)
 		|| (((unsigned int)pt_mov->noreturn &
@@ -1371,16 +1463,32 @@ board_move_unsafe (
 			(unsigned int)g->rules->squares[dest])
 			!= (unsigned int)pt_mov->noreturn);
 
+	/*
+	 * There are two players, as in board_turn_adv.
+	 */
 	board_turn_adv(b);
+	b->key	^= g->rules->opt_zobrist_turn;
 
-	return	listmh_add(movehist, pos, dest, irrev);
+#ifdef HT_AI_MINIMAX_HASH
+	/*
+	 * b->key is final. The child node probes the table with it
+	 * first thing, so start loading its bucket now to overlap the
+	 * cache miss with the rest of the move.
+	 */
+	if (NULL != inc)
+	{
+		HT_ZHASH_PREFETCH(inc->hashtable, b->key);
+	}
+#endif
+
+	return	listmh_add(movehist, pos, dest, irrev, key);
 }
 
 /*
  * Makes a move on b from pos to dest, if it's legal. If so, sets legal
  * to true. Else sets legal to false and doesn't make the move.
  *
- * NOTE:	This function does not set hashkeys.
+ * NOTE:	This function does not update any board_inc.
  */
 static
 enum HT_FR
@@ -1440,8 +1548,8 @@ board_move_safe (
 	}
 
 	return	board_move_unsafe(g, b, movehist, pos, dest
-#ifdef HT_AI_MINIMAX_HASH
-		, NULL, NULL, NULL
+#ifdef HT_AI_MINIMAX
+		, NULL
 #endif
 		);
 }
@@ -1466,7 +1574,9 @@ game_move (
  * Adds all moves that are possible for the current player to move in b
  * (according to b->turn) to list.
  *
- * Does not clear moves before adding.
+ * Does not clear moves before adding. list is grown once, up front, to
+ * hold g->rules->opt_movec_max more moves, so that no move has to check
+ * its capacity; a list that already has room is never reallocated.
  *
  * NOTE:	This function assumes that pieces can only move
  *		orthogonally, and will not work if you add ability to
@@ -1512,6 +1622,21 @@ board_moves_get (
 #endif
 	opt_p_owned	= g->players[b->turn]->opt_owned;
 
+#ifdef HT_AI_MINIMAX_UNSAFE
+	if (HT_FR_SUCCESS != listm_reserve(list,
+		list->elemc + g->rules->opt_movec_max))
+	{
+		return HT_FR_FAIL_ALLOC;
+	}
+#else
+	fr	= listm_reserve(list,
+		list->elemc + g->rules->opt_movec_max);
+	if (HT_FR_SUCCESS != fr)
+	{
+		return	fr;
+	}
+#endif
+
 	for (pos = (unsigned short)0; pos < g->rules->opt_blen; pos++)
 	{
 		p_pos				= b->pieces[pos];
@@ -1577,22 +1702,11 @@ board_moves_get (
 				if (board_move_legal(g, b, movehist,
 					b->turn, pos, dest, opt_pt_mov, & impediment))
 				{
-#ifdef HT_AI_MINIMAX_UNSAFE
-					if (HT_FR_SUCCESS !=
-					listm_add(list, pos, dest))
-					{
-						return HT_FR_FAIL_ALLOC;
-					}
-#else
-					fr = listm_add(list, pos, dest);
-					if (HT_FR_SUCCESS != fr)
-					{
-						return	fr;
-					}
-#ifndef HT_UNSAFE
-					fr	= HT_FR_NONE;
-#endif
-#endif /* HT_AI_MINIMAX_UNSAFE */
+					list->elems[list->elemc].pos
+						= pos;
+					list->elems[list->elemc].dest
+						= dest;
+					list->elemc++;
 				}
 				else /* Stop checking this direction. */
 				{
@@ -1616,6 +1730,9 @@ board_moves_get (
  *
  * piecemask is the bitmask of pieces to get move count for.
  *
+ * movehist may be NULL, in which case moves that repeat a position are
+ * counted as well, so the count only depends on b.
+ *
  * Negative return value is a failure.
  *
  * NOTE:	Any changes to this function must be reflected by
@@ -1887,7 +2004,7 @@ game_over (
 
 /*
  * Sets turn to 0 (player 0 always starts) and all pieces to
- * HT_BIT_U8_EMPTY.
+ * HT_BIT_U8_EMPTY, and key to that of the empty board.
  */
 void
 board_init (
@@ -1897,6 +2014,7 @@ board_init (
 {
 	memset	(b->pieces, (int)HT_BIT_U8_EMPTY, (size_t)blen);
 	b->turn	= (unsigned short)0;
+	b->key	= 0;
 }
 
 struct board *
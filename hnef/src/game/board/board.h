@@ -18,10 +18,7 @@
 #ifndef HT_BOARD_H
 #define HT_BOARD_H
 
-#ifdef HT_AI_MINIMAX
-#include "aimhasht.h"	/* zhashtable */
-#endif
-#include "boardt.h"	/* board */
+#include "boardt.h"	/* board, board_inc */
 #include "config.h"	/* HT_RSTR */
 #include "funct.h"	/* HT_FR */
 #include "gamet.h"	/* game */
@@ -61,22 +58,16 @@ board_move_unsafe (
 	struct listmh * const			movehist,
 	const unsigned short			pos,
 	const unsigned short			dest
-#ifdef HT_AI_MINIMAX_HASH
+#ifdef HT_AI_MINIMAX
 	,
 /*@in@*/
 /*@null@*/
-	const struct zhashtable * const HT_RSTR	hashtable,
-/*@in@*/
-/*@null@*/
-	unsigned int * const			hashkey,
-/*@in@*/
-/*@null@*/
-	unsigned int * const			hashlock
+	struct board_inc * const		inc
 #endif
 	)
 /*@modifies * b, * movehist@*/
 #ifdef HT_AI_MINIMAX
-/*@modifies * hashkey, * hashlock@*/
+/*@modifies * inc@*/
 #endif
 ;
 /*@=protoparamname@*/
@@ -133,7 +124,7 @@ board_movec_get (
 /*@notnull@*/
 	const struct board * const HT_RSTR,
 /*@in@*/
-/*@notnull@*/
+/*@null@*/
 	const struct listmh * const HT_RSTR,
 	const HT_BIT_U8
 	)
@@ -174,6 +165,21 @@ game_over (
 ;
 /*@=protoparamname@*/
 
+/*@-protoparamname@*/
+extern
+HT_U64
+board_key_get (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const HT_RSTR	g,
+/*@in@*/
+/*@notnull@*/
+	const struct board * const HT_RSTR	b
+	)
+/*@modifies nothing@*/
+;
+/*@=protoparamname@*/
+
 /*@-protoparamname@*/
 extern
 void
@@ -18,6 +18,11 @@
 #ifndef HT_BOARD_T_H
 #define HT_BOARD_T_H
 
+#ifdef HT_AI_MINIMAX_HASH
+#include "aimhasht.h"	/* zhashtable */
+#endif
+#include "rngt.h"	/* HT_U64 */
+
 /*
  * 8 bit integer data types for single bits or bitmasks.
  *
@@ -55,7 +60,53 @@ struct board
 	 */
 	unsigned short	turn;
 
+	/*
+	 * Zobrist key of pieces and turn, from ruleset->opt_zobrist.
+	 * Kept up to date by board_move_unsafe; set by board_key_get
+	 * when the pieces are set some other way.
+	 */
+	HT_U64		key;
+
+};
+
+#ifdef HT_AI_MINIMAX
+
+/*
+ * State that the minimax player keeps up to date as moves are made by
+ * board_move_unsafe, so that it doesn't have to be recomputed from the
+ * whole board in every node.
+ */
+/*@exposed@*/
+struct board_inc
+{
+
+#ifdef HT_AI_MINIMAX_HASH
+	/*
+	 * Transposition table whose bucket for board->key is prefetched
+	 * after every move. The key itself is board->key.
+	 */
+/*@dependent@*/
+/*@notnull@*/
+	const struct zhashtable *	hashtable;
+#endif
+
+	/*
+	 * Value of every piece on a square, indexed by
+	 * type_index_get(piece) * ruleset->opt_blen + position. This is
+	 * aiminimax->eval_psq.
+	 */
+/*@dependent@*/
+/*@notnull@*/
+	const int *			psq;
+
+	/*
+	 * Sum of psq for every piece on the board.
+	 */
+	int				material;
+
 };
 
+#endif /* HT_AI_MINIMAX */
+
 #endif
 
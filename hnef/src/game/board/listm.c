@@ -15,7 +15,7 @@
  * You should have received a copy of the GNU General Public License
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
-#include <stdlib.h>	/* malloc, free */
+#include <stdlib.h>	/* malloc, realloc, free */
 
 #include "listm.h"
 
@@ -120,6 +120,37 @@ listm_grow (
 	return HT_FR_SUCCESS;
 }
 
+/*
+ * Grows l, if needed, so that it has room for at least capc moves.
+ *
+ * Upon HT_FR_FAIL_ALLOC, l is unchanged.
+ */
+enum HT_FR
+listm_reserve (
+	struct listm * const	l,
+	const size_t		capc
+	)
+{
+	struct move * elems_new	= NULL;
+
+	if (capc <= l->capc)
+	{
+		return HT_FR_SUCCESS;
+	}
+
+	elems_new = realloc(l->elems, sizeof(* l->elems) * capc);
+	if (NULL == elems_new)
+	{
+/* splint realloc */ /*@i2@*/\
+		return HT_FR_FAIL_ALLOC;
+	}
+	l->elems	= elems_new;
+	l->capc		= capc;
+
+/* splint realloc */ /*@i1@*/\
+	return HT_FR_SUCCESS;
+}
+
 /*
  * Grows if needed.
  */
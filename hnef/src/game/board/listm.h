@@ -47,6 +47,19 @@ free_listm (
 ;
 /*@=protoparamname@*/
 
+/*@-protoparamname@*/
+extern
+enum HT_FR
+listm_reserve (
+/*@notnull@*/
+/*@partial@*/
+	struct listm * const l,
+	const size_t
+	)
+/*@modifies * l@*/
+;
+/*@=protoparamname@*/
+
 /*@-protoparamname@*/
 extern
 enum HT_FR
@@ -16,6 +16,7 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 #include <stdlib.h>	/* malloc, free */
+#include <string.h>	/* memcpy */
 
 #include "listmh.h"
 
@@ -119,6 +120,20 @@ listmh_grow (
 	return HT_FR_SUCCESS;
 }
 
+/*
+ * Grows l, if needed, so that it has room for at least capc moves.
+ *
+ * Upon HT_FR_FAIL_ALLOC, l is unchanged.
+ */
+enum HT_FR
+listmh_reserve (
+	struct listmh * const	l,
+	const size_t		capc
+	)
+{
+	return capc <= l->capc ? HT_FR_SUCCESS : listmh_grow(l, capc);
+}
+
 /*
  * Grows if needed.
  */
@@ -127,7 +142,8 @@ listmh_add (
 	struct listmh * const	l,
 	const unsigned short	pos,
 	const unsigned short	dest,
-	const HT_BOOL		irrev
+	const HT_BOOL		irrev,
+	const HT_U64		key
 	)
 {
 #ifndef HT_UNSAFE
@@ -148,6 +164,7 @@ listmh_add (
 	l->elems[l->elemc].irrev	= irrev;
 	l->elems[l->elemc].pos		= pos;
 	l->elems[l->elemc].dest		= dest;
+	l->elems[l->elemc].key		= key;
 	l->elemc++;
 	return HT_FR_SUCCESS;
 }
@@ -180,7 +197,47 @@ listmh_copy (
 		dest->elems[i].pos	= src->elems[i].pos;
 		dest->elems[i].dest	= src->elems[i].dest;
 		dest->elems[i].irrev	= src->elems[i].irrev;
+		dest->elems[i].key	= src->elems[i].key;
 	}
 	return	HT_FR_SUCCESS;
 }
 
+/*
+ * Copies the moves in src after the last irreversible one into dest,
+ * possibly growing dest. These are all the moves that
+ * board_move_legal looks at (see board_is_repeat), so dest works just
+ * like a full copy of src for making and checking moves.
+ *
+ * This takes time in proportion to the moves since the last
+ * irreversible one, not to the length of src.
+ */
+enum HT_FR
+listmh_copy_rev (
+	const	struct listmh * const	src,
+		struct listmh * const	dest
+	)
+{
+	size_t	start	= src->elemc;
+	size_t	len;
+	while (start > 0 && !src->elems[start - 1].irrev)
+	{
+		start--;
+	}
+	len	= src->elemc - start;
+
+	if (len > dest->capc)
+	{
+		const enum HT_FR fr	= listmh_grow(dest, len);
+		if (HT_FR_SUCCESS != fr)
+		{
+			return	fr;
+		}
+	}
+	dest->elemc	= len;
+	if (len > 0)
+	{
+		memcpy	(dest->elems, & src->elems[start],
+			sizeof(* dest->elems) * len);
+	}
+	return	HT_FR_SUCCESS;
+}
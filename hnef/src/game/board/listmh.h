@@ -47,6 +47,19 @@ free_listmh (
 ;
 /*@=protoparamname@*/
 
+/*@-protoparamname@*/
+extern
+enum HT_FR
+listmh_reserve (
+/*@notnull@*/
+/*@partial@*/
+	struct listmh * const l,
+	const size_t
+	)
+/*@modifies * l@*/
+;
+/*@=protoparamname@*/
+
 /*@-protoparamname@*/
 extern
 enum HT_FR
@@ -56,7 +69,8 @@ listmh_add (
 	struct listmh * const l,
 	const unsigned short,
 	const unsigned short,
-	const HT_BOOL
+	const HT_BOOL,
+	const HT_U64
 	)
 /*@modifies * l@*/
 ;
@@ -77,5 +91,20 @@ listmh_copy (
 ;
 /*@=protoparamname@*/
 
+/*@-protoparamname@*/
+extern
+enum HT_FR
+listmh_copy_rev (
+/*@in@*/
+/*@notnull@*/
+	const	struct listmh * const	src,
+/*@in@*/
+/*@notnull@*/
+		struct listmh * const	dest
+	)
+/*@modifies * dest@*/
+;
+/*@=protoparamname@*/
+
 #endif
 
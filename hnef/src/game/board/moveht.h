@@ -19,6 +19,7 @@
 #define HT_MOVEH_T_H
 
 #include "boolt.h"	/* HT_BOOL */
+#include "rngt.h"	/* HT_U64 */
 
 /*
  * A move from pos to dest.
@@ -34,6 +35,13 @@ struct moveh
 
 	unsigned short	pos, dest;
 
+	/*
+	 * board->key before the move. The keys of the moves after the
+	 * last irreversible one are the positions that may not be
+	 * repeated.
+	 */
+	HT_U64		key;
+
 };
 
 #endif
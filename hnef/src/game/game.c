@@ -19,15 +19,23 @@
 #include <string.h>	/* memcpy */
 
 #include "game.h"
-#include "board.h"	/* alloc_board, free_board */
+#ifdef HT_AI_MINIMAX
+#include "aimeval.h"	/* aimevalconf_init, aimevalconf_copy, ... */
+#endif
+#ifdef HT_AI_MINIMAX_HASH
+#include "aimhash.h"	/* HT_ZHASH_MEM_TAB_DEF, zhashtable_save */
+#endif
+#include "board.h"	/* alloc_board, free_board, board_key_get */
 #include "listmh.h"	/* alloc_listmh, free_listmh */
 #include "player.h"	/* alloc_player, free_player, ... */
-#include "ruleset.h"	/* alloc_ruleset, free_ruleset */
+#include "ruleset.h"	/* alloc_ruleset, ruleset_ref, ... */
 
 /*
  * Resets the board struct (g->b) based on the ruleset.
  *
- * This is equivalent to "starting a new game". The function can't fail.
+ * This is equivalent to "starting a new game". It can only fail if a
+ * minimax player's hash table has to be reallocated with a new size,
+ * and there is not enough memory (see player_reset).
  */
 enum HT_FR
 game_board_reset (
@@ -38,13 +46,14 @@ game_board_reset (
 
 	memcpy	(g->b->pieces, r->pieces, (size_t)g->rules->opt_blen);
 	g->b->turn	= (unsigned short)0;
+	g->b->key	= board_key_get(g, g->b);
 
 	{
 		unsigned short	i;
 		for (i = (unsigned short)0; i < g->playerc; i++)
 		{
 			const enum HT_FR fr =
-				player_reset(g->players[i]);
+				player_reset(g, g->players[i]);
 			if (HT_FR_SUCCESS != fr)
 			{
 				return	fr;
@@ -92,45 +101,93 @@ game_init (
 {
 	board_init	(g->b, g->rules->opt_blen);
 	ruleset_init	(g->rules);
+#ifdef HT_AI_MINIMAX_HASH
+	g->hash_conf.zobrist_seed	= HT_ZOBRIST_SEED_DEF;
+	g->hash_conf.mem_tab		= HT_ZHASH_MEM_TAB_DEF;
+	g->hash_conf.file		= NULL;
+#endif
+#ifdef HT_AI_MINIMAX
+	aimevalconf_init(& g->eval_conf);
+#endif
 }
 
+#ifdef HT_AI_MINIMAX_HASH
+
 /*
- * Returns NULL if failing to allocate.
- *
- * If successful, then game->playerc is set to HT_PLAYERS_MAX. The
- * players are allocated and initialized according to player_init.
- *
- * You must still initialize the rest of the game after calling this
- * function (the players are only initialized because their player
- * indices correspond to the array in struct game, and then we may as
- * well fully initialize them).
- *
- * These variables are fully allocated, but not initialized:
+ * Sets g->hash_conf.zobrist_seed to seed, and makes the Zobrist
+ * numbers of g->rules (which are also the transposition table's) from
+ * it. g->b->key is then wrong until game_board_reset.
  *
- * *	game->rules
+ * Returns HT_FR_FAIL_ILL_STATE, and changes nothing, if g->rules is
+ * shared with another game.
+ */
+enum HT_FR
+game_zobrist_seed (
+	struct game * const	g,
+	const unsigned long	seed
+	)
+{
+	if (g->rules->refc > 1ul)
+	{
+		return	HT_FR_FAIL_ILL_STATE;
+	}
+	g->hash_conf.zobrist_seed	= seed;
+	ruleset_zobrist_init(g->rules, seed);
+	return	HT_FR_SUCCESS;
+}
+
+/*
+ * Saves the transposition table of the first computer player to
+ * g->hash_conf.file, so that it's loaded by the next table that is
+ * allocated for the same ruleset (see zhashtable_load).
  *
- * *	game->b
+ * Does nothing if there's no file or no computer player.
  */
-struct game *
-alloc_game (
-	const unsigned short	bwidth,
-	const unsigned short	bheight
+enum HT_FR
+game_hash_save (
+	const struct game * const g
 	)
 {
-	unsigned short		i;
-	const unsigned short blen = (unsigned short)(bwidth * bheight);
-	struct game * const	g	= malloc(sizeof(* g));
-	if (NULL == g)
+	unsigned short i;
+
+	if (NULL == g->hash_conf.file || NULL == g->rules->hash)
 	{
-		return	NULL;
+		return	HT_FR_SUCCESS;
 	}
 
-	g->rules	= alloc_ruleset(bwidth, bheight);
-	if (NULL == g->rules)
+	for (i = (unsigned short)0; i < g->playerc; i++)
 	{
-		free	(g);
-		return	NULL;
+		const struct player * const p = g->players[i];
+		if (HT_AIT_MINIMAX == p->contr && NULL != p->ai.minimax
+		&& NULL != p->ai.minimax->tp_tab)
+		{
+			return	zhashtable_save(p->ai.minimax->tp_tab,
+				g->hash_conf.file, g->rules->hash);
+		}
 	}
+	return	HT_FR_SUCCESS;
+}
+
+#endif /* HT_AI_MINIMAX_HASH */
+
+/*
+ * Allocates g->b (for a board of blen squares), g->movehist and
+ * g->players, which are initialized according to player_init.
+ *
+ * Returns false if failing to allocate, in which case none of them are
+ * allocated. g->rules is left as it is either way.
+ */
+static
+HT_BOOL
+alloc_game_parts (
+/*@notnull@*/
+/*@partial@*/
+	struct game * const	g,
+	const unsigned short	blen
+	)
+/*@modifies * g@*/
+{
+	unsigned short i;
 
 	/*
 	 * This is set later and uses ruleset information.
@@ -138,18 +195,14 @@ alloc_game (
 	g->b	= alloc_board(blen);
 	if (NULL == g->b)
 	{
-		free_ruleset	(g->rules);
-		free		(g);
-		return		NULL;
+		return	HT_FALSE;
 	}
 
 	g->movehist	= alloc_listmh(HT_LISTMH_CAP_DEF);
 	if (NULL == g->movehist)
 	{
 		free_board	(g->b);
-		free_ruleset	(g->rules);
-		free		(g);
-		return		NULL;
+		return		HT_FALSE;
 	}
 
 	g->playerc = HT_PLAYERS_MAX;
@@ -158,9 +211,7 @@ alloc_game (
 	{
 		free_listmh	(g->movehist);
 		free_board	(g->b);
-		free_ruleset	(g->rules);
-		free		(g);
-		return		NULL;
+		return		HT_FALSE;
 	}
 	for (i = (unsigned short)0; i < g->playerc; i++)
 	{
@@ -182,15 +233,127 @@ alloc_game (
 			free		(g->players);
 			free_listmh	(g->movehist);
 			free_board	(g->b);
-			free_ruleset	(g->rules);
-			free		(g);
-			return		NULL;
+			return		HT_FALSE;
 		}
 	}
+	return	HT_TRUE;
+}
+
+/*
+ * Returns NULL if failing to allocate.
+ *
+ * If successful, then game->playerc is set to HT_PLAYERS_MAX. The
+ * players are allocated and initialized according to player_init.
+ *
+ * You must still initialize the rest of the game after calling this
+ * function (the players are only initialized because their player
+ * indices correspond to the array in struct game, and then we may as
+ * well fully initialize them).
+ *
+ * These variables are fully allocated, but not initialized:
+ *
+ * *	game->rules
+ *
+ * *	game->b
+ */
+struct game *
+alloc_game (
+	const unsigned short	bwidth,
+	const unsigned short	bheight
+	)
+{
+	const unsigned short blen = (unsigned short)(bwidth * bheight);
+	struct game * const	g	= malloc(sizeof(* g));
+	if (NULL == g)
+	{
+		return	NULL;
+	}
+
+	g->rules	= alloc_ruleset(bwidth, bheight);
+	if (NULL == g->rules)
+	{
+		free	(g);
+		return	NULL;
+	}
+
+	if (!alloc_game_parts(g, blen))
+	{
+		free_ruleset	(g->rules);
+		free		(g);
+		return		NULL;
+	}
 
 	return	g;
 }
 
+/*
+ * Returns a new game that plays by g's rules, at the initial position,
+ * or NULL if failing to allocate.
+ *
+ * The ruleset is not copied: the new game takes a reference to
+ * g->rules (ruleset_ref), so the games can be freed in any order, and
+ * in any thread with HT_POSIX. The ruleset must not change after this.
+ * The players, transposition table settings and evaluation weights are
+ * copied. g must have been initialized (game_initopt), and neither game
+ * may be initialized again.
+ *
+ * Games made this way only take a board and a move history each, and
+ * are meant for running many games (or searches) of one ruleset at the
+ * same time.
+ */
+struct game *
+alloc_game_share (
+	const struct game * const	g
+	)
+{
+	struct game *	gs;
+	unsigned short	i;
+
+#ifndef HT_UNSAFE
+	if (NULL == g)
+	{
+		return	NULL;
+	}
+#endif
+
+	gs	= malloc(sizeof(* gs));
+	if (NULL == gs)
+	{
+		return	NULL;
+	}
+	if (!alloc_game_parts(gs, g->rules->opt_blen))
+	{
+		free	(gs);
+		return	NULL;
+	}
+	gs->rules	= ruleset_ref(g->rules);
+
+	board_init	(gs->b, gs->rules->opt_blen);
+#ifdef HT_AI_MINIMAX_HASH
+	gs->hash_conf	= g->hash_conf;
+#endif
+#ifdef HT_AI_MINIMAX
+	aimevalconf_init(& gs->eval_conf);
+	if (HT_FR_SUCCESS != aimevalconf_copy(& gs->eval_conf,
+		& g->eval_conf, g->rules->opt_blen))
+	{
+		free_game	(gs);
+		return		NULL;
+	}
+#endif
+	for (i = (unsigned short)0; i < gs->playerc; i++)
+	{
+		player_initopt	(gs, gs->players[i]);
+	}
+
+	if (HT_FR_SUCCESS != game_board_reset(gs))
+	{
+		free_game	(gs);
+		return		NULL;
+	}
+	return	gs;
+}
+
 void
 free_game (
 	struct game * const g
@@ -211,6 +374,10 @@ free_game (
 		free_listmh	(g->movehist);
 	}
 
+#ifdef HT_AI_MINIMAX
+	aimevalconf_free	(& g->eval_conf);
+#endif
+
 	if (NULL != g->players)
 	{
 		unsigned short i;
@@ -29,7 +29,8 @@ game_board_reset (
 /*@notnull@*/
 	struct game * const g
 	)
-/*@modifies * g@*/
+/*@globals errno, internalState@*/
+/*@modifies errno, internalState, * g@*/
 ;
 /*@=protoparamname@*/
 
@@ -57,6 +58,34 @@ game_init (
 ;
 /*@=protoparamname@*/
 
+#ifdef HT_AI_MINIMAX_HASH
+/*@-protoparamname@*/
+extern
+enum HT_FR
+game_zobrist_seed (
+/*@in@*/
+/*@notnull@*/
+	struct game * const	g,
+	const unsigned long	seed
+	)
+/*@modifies * g@*/
+;
+/*@=protoparamname@*/
+
+/*@-protoparamname@*/
+extern
+enum HT_FR
+game_hash_save (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const g
+	)
+/*@globals fileSystem, errno@*/
+/*@modifies fileSystem, errno@*/
+;
+/*@=protoparamname@*/
+#endif
+
 /*@null@*/
 /*@only@*/
 /*@partial@*/
@@ -69,6 +98,20 @@ alloc_game (
 /*@modifies nothing@*/
 ;
 
+/*@-protoparamname@*/
+/*@null@*/
+/*@only@*/
+extern
+struct game *
+alloc_game_share (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const	g
+	)
+/*@modifies g->rules->refc@*/
+;
+/*@=protoparamname@*/
+
 /*@-protoparamname@*/
 extern
 void
@@ -18,6 +18,12 @@
 #ifndef HT_GAME_T_H
 #define HT_GAME_T_H
 
+#ifdef HT_AI_MINIMAX
+#include "aimevalt.h"	/* aimevalconf */
+#endif
+#ifdef HT_AI_MINIMAX_HASH
+#include "aimhasht.h"	/* zhashconf */
+#endif
 #include "listmht.h"	/* listmh */
 #include "rulesett.h"	/* ruleset */
 
@@ -47,6 +53,10 @@
 struct game
 {
 
+	/*
+	 * The ruleset, which other games may share (alloc_game_share).
+	 * The game holds a reference to it, which free_game releases.
+	 */
 /*@notnull@*/
 /*@owned@*/
 	struct ruleset *	rules;
@@ -80,14 +90,30 @@ struct game
 	/*
 	 * A move history list.
 	 *
-	 * NOTE:	This list (and the corresponding list in the
-	 *		aiminimax struct: aiminimax->opt_movehist) can
-	 *		grow indefinitely. This can consume infinite
-	 *		memory, but will of course only consume 8 bytes
-	 *		per move (or however large a moveh is).
+	 * NOTE:	This list grows with every move of the game, so
+	 *		that the whole game is kept. It only takes
+	 *		sizeof(struct moveh) per move. The computer
+	 *		player only copies the moves since the last
+	 *		irreversible one into aiminimax->opt_movehist,
+	 *		so its cost doesn't grow with the game.
 	 */
 	struct listmh *		movehist;
 
+#ifdef HT_AI_MINIMAX_HASH
+	/*
+	 * Settings for the transposition tables of computer players.
+	 */
+	struct zhashconf	hash_conf;
+#endif
+
+#ifdef HT_AI_MINIMAX
+	/*
+	 * Evaluation weights of computer players, from the ruleset's
+	 * weights file.
+	 */
+	struct aimevalconf	eval_conf;
+#endif
+
 };
 
 #endif
@@ -0,0 +1,659 @@
+/* Copyright 2013 Alexander Söderlund.
+ *
+ * This file is part of HNEFATAFL.
+ *
+ * HNEFATAFL is free software: you can distribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * HNEFATAFL is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>	/* fopen, fprintf, fwrite, fclose */
+#include <stdlib.h>	/* malloc, free */
+#include <string.h>	/* memcmp, memcpy, strcmp, strlen */
+
+#include "grecord.h"
+#include "board.h"		/* board_move_unsafe, game_move, ... */
+#include "fnv.h"		/* ht_fnv, HT_FNV_INIT */
+#include "game.h"		/* game_board_reset */
+#include "iotextparse.h"	/* alloc_ht_text, ht_line_readtext */
+#include "listm.h"		/* alloc_listm, listm_add, ... */
+#include "listmh.h"		/* listmh_reserve */
+#include "num.h"		/* texttoushort */
+#include "playert.h"		/* HT_PLAYER_UNINIT */
+
+/*
+ * A game record is the moves that were played in a game, from the
+ * initial position, and the ruleset that they were played in. The
+ * ruleset is identified by its id, or by its hash if it has no id.
+ *
+ * The text encoding is a line with HT_GRECORD_TEXT_RULESET and the
+ * ruleset, followed by a line for every move with x and y of the piece
+ * and x and y of the destination, as in the command line interface and
+ * a tuning corpus. Empty lines and comments are allowed, as in a
+ * ruleset file.
+ *
+ * The binary encoding is:
+ *
+ * 1.	HT_GRECORD_MAGIC.
+ *
+ * 2.	The length of the ruleset, in 2 bytes.
+ *
+ * 3.	The ruleset, without '\0'.
+ *
+ * 4.	The amount of moves, in 4 bytes.
+ *
+ * 5.	ht_fnv of 3 and 6, in 8 bytes.
+ *
+ * 6.	pos and dest of every move, in 2 bytes each.
+ *
+ * All numbers are little-endian, so unlike a compiled ruleset, a
+ * record can be loaded on any kind of machine.
+ */
+
+/*@unchecked@*/
+/*@observer@*/
+static
+const char * const HT_GRECORD_TEXT_RULESET	= "ruleset";
+
+/*@unchecked@*/
+/*@observer@*/
+static
+const char HT_GRECORD_MAGIC[8]	=
+	{ 'H', 'T', 'G', 'R', 'E', 'C', '1', '\0' };
+
+/*
+ * Length of 1, 2, 4 and 5 in the binary encoding.
+ */
+#define HT_GRECORD_HEAD_LEN	((size_t)22)
+
+/*
+ * Length of a move in the binary encoding.
+ */
+#define HT_GRECORD_MOVE_LEN	((size_t)4)
+
+/*
+ * Returns what identifies g's ruleset in a record.
+ */
+/*@observer@*/
+static
+const char *
+grecord_rules (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const HT_RSTR	g
+	)
+/*@modifies nothing@*/
+{
+	if (NULL != g->rules->id)
+	{
+		return	g->rules->id;
+	}
+	return	NULL == g->rules->hash ? "" : g->rules->hash;
+}
+
+/*
+ * Appends the len low bytes of n at * pos, least significant first.
+ */
+static
+void
+grecord_put (
+/*@in@*/
+/*@notnull@*/
+	char * * const HT_RSTR	pos,
+	HT_U64			n,
+	size_t			len
+	)
+/*@modifies * pos, * * pos@*/
+{
+	for (; len > (size_t)0; len--)
+	{
+		* (* pos)++	= (char)(unsigned char)(n & 0xFFu);
+		n		>>= 8;
+	}
+}
+
+/*
+ * Returns the len bytes at * pos, least significant first, and moves
+ * pos past them.
+ */
+static
+HT_U64
+grecord_get (
+/*@in@*/
+/*@notnull@*/
+	const char * * const HT_RSTR	pos,
+	const size_t			len
+	)
+/*@modifies * pos@*/
+{
+	HT_U64	n	= 0;
+	size_t	i;
+	for (i = len; i > (size_t)0; i--)
+	{
+		n	= (n << 8)
+			| (HT_U64)(unsigned char)(* pos)[i - 1];
+	}
+	* pos	+= len;
+	return	n;
+}
+
+/*
+ * Writes g's record in the text encoding to out.
+ */
+static
+enum HT_FR
+grecord_save_text (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const HT_RSTR	g,
+/*@in@*/
+/*@notnull@*/
+	FILE * const HT_RSTR			out
+	)
+/*@globals fileSystem@*/
+/*@modifies fileSystem, * out@*/
+{
+	const unsigned short	bw	= g->rules->bwidth;
+	size_t			i;
+
+	if (fprintf(out, "%s\t%s\n", HT_GRECORD_TEXT_RULESET,
+		grecord_rules(g)) < 0)
+	{
+		return	HT_FR_FAIL_IO_FILE_W;
+	}
+	for (i = 0; i < g->movehist->elemc; i++)
+	{
+		const struct moveh * const HT_RSTR m =
+			& g->movehist->elems[i];
+		if (fprintf(out, "%hu %hu %hu %hu\n",
+			(unsigned short)(m->pos % bw),
+			(unsigned short)(m->pos / bw),
+			(unsigned short)(m->dest % bw),
+			(unsigned short)(m->dest / bw)) < 0)
+		{
+			return	HT_FR_FAIL_IO_FILE_W;
+		}
+	}
+	return	HT_FR_SUCCESS;
+}
+
+/*
+ * Writes g's record in the binary encoding to out, all at once.
+ */
+static
+enum HT_FR
+grecord_save_bin (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const HT_RSTR	g,
+/*@in@*/
+/*@notnull@*/
+	FILE * const HT_RSTR			out
+	)
+/*@globals fileSystem@*/
+/*@modifies fileSystem, * out@*/
+{
+	const char * const	rules	= grecord_rules(g);
+	const size_t		len_r	= strlen(rules);
+	const size_t		movec	= g->movehist->elemc;
+	const size_t		len_m	= HT_GRECORD_MOVE_LEN * movec;
+	size_t			len;
+	char *			mem;
+	char *			pos;
+	size_t			i;
+	HT_BOOL			ok;
+
+	if (len_r > (size_t)0xFFFFu
+	|| (HT_U64)movec > (HT_U64)0xFFFFFFFFul)
+	{
+		return	HT_FR_FAIL_ILL_ARG;
+	}
+	len	= HT_GRECORD_HEAD_LEN + len_r + len_m;
+	mem	= malloc(len);
+	if (NULL == mem)
+	{
+		return	HT_FR_FAIL_ALLOC;
+	}
+
+	memcpy	(mem, HT_GRECORD_MAGIC, sizeof(HT_GRECORD_MAGIC));
+	pos	= mem + sizeof(HT_GRECORD_MAGIC);
+	grecord_put(& pos, (HT_U64)len_r, (size_t)2);
+	memcpy	(pos, rules, len_r);
+	pos	+= len_r;
+	grecord_put(& pos, (HT_U64)movec, (size_t)4);
+	/*
+	 * The sum is written last, when the moves are.
+	 */
+	pos	+= 8;
+	for (i = 0; i < movec; i++)
+	{
+		grecord_put(& pos, (HT_U64)g->movehist->elems[i].pos,
+			(size_t)2);
+		grecord_put(& pos, (HT_U64)g->movehist->elems[i].dest,
+			(size_t)2);
+	}
+	pos	= mem + len - len_m - 8;
+	grecord_put(& pos, ht_fnv(ht_fnv(HT_FNV_INIT, rules, len_r),
+		mem + len - len_m, len_m), (size_t)8);
+
+	ok	= (size_t)1 == fwrite(mem, len, (size_t)1, out);
+	free	(mem);
+	return	ok ? HT_FR_SUCCESS : HT_FR_FAIL_IO_FILE_W;
+}
+
+/*
+ * Saves the moves played in g to file, in the binary encoding if bin,
+ * else in the text encoding.
+ *
+ * Returns HT_FR_FAIL_IO_FILE_W if file can't be written.
+ */
+enum HT_FR
+grecord_save (
+	const struct game * const	g,
+	const char * const		file,
+	const HT_BOOL			bin
+	)
+{
+	enum HT_FR	fr;
+	FILE * const	out	= fopen(file, bin ? "wb" : "w");
+
+	if (NULL == out)
+	{
+		return	HT_FR_FAIL_IO_FILE_W;
+	}
+	fr	= bin ? grecord_save_bin(g, out)
+		: grecord_save_text(g, out);
+	if (0 != fclose(out) && HT_FR_SUCCESS == fr)
+	{
+		fr	= HT_FR_FAIL_IO_FILE_W;
+	}
+	return	fr;
+}
+
+/*
+ * Decodes the binary record in the len chars at mem (after the magic
+ * number) into moves, and sets valid if it's a record for g.
+ */
+static
+enum HT_FR
+grecord_read_bin (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const HT_RSTR	g,
+/*@in@*/
+/*@notnull@*/
+	const char *				mem,
+	const size_t				len,
+/*@in@*/
+/*@notnull@*/
+	struct listm * const HT_RSTR		moves,
+/*@in@*/
+/*@notnull@*/
+	HT_BOOL * const HT_RSTR			valid
+	)
+/*@modifies * moves, * valid@*/
+{
+	const char * const	rules	= grecord_rules(g);
+	const char * const	end	= mem + len;
+	const char *		rules_r;
+	size_t			len_r, movec, i;
+	HT_U64			sum;
+	enum HT_FR		fr;
+
+	if (len < HT_GRECORD_HEAD_LEN - sizeof(HT_GRECORD_MAGIC))
+	{
+		return	HT_FR_SUCCESS;
+	}
+	len_r	= (size_t)grecord_get(& mem, (size_t)2);
+	if ((size_t)(end - mem) < len_r + (size_t)12)
+	{
+		return	HT_FR_SUCCESS;
+	}
+	rules_r	= mem;
+	mem	+= len_r;
+	movec	= (size_t)grecord_get(& mem, (size_t)4);
+	sum	= grecord_get(& mem, (size_t)8);
+
+	if ((size_t)(end - mem) % HT_GRECORD_MOVE_LEN != 0
+	|| (size_t)(end - mem) / HT_GRECORD_MOVE_LEN != movec
+	|| strlen(rules) != len_r
+	|| 0 != memcmp(rules, rules_r, len_r)
+	|| sum != ht_fnv(ht_fnv(HT_FNV_INIT, rules_r, len_r), mem,
+		(size_t)(end - mem)))
+	{
+		return	HT_FR_SUCCESS;
+	}
+
+	fr	= listm_reserve(moves, movec);
+	if (HT_FR_SUCCESS != fr)
+	{
+		return	fr;
+	}
+	for (i = 0; i < movec; i++)
+	{
+		struct move * const HT_RSTR m	= & moves->elems[i];
+		m->pos	= (unsigned short)grecord_get(& mem, (size_t)2);
+		m->dest	= (unsigned short)grecord_get(& mem, (size_t)2);
+		if (m->pos >= g->rules->opt_blen
+		|| m->dest >= g->rules->opt_blen)
+		{
+			return	HT_FR_SUCCESS;
+		}
+	}
+	moves->elemc	= movec;
+	* valid		= HT_TRUE;
+	return		HT_FR_SUCCESS;
+}
+
+/*
+ * Reads the text record in text into moves, and sets valid if it's a
+ * record for g.
+ */
+static
+enum HT_FR
+grecord_read_text (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const HT_RSTR	g,
+/*@in@*/
+/*@notnull@*/
+	struct ht_text * const HT_RSTR		text,
+/*@in@*/
+/*@notnull@*/
+	struct listm * const HT_RSTR		moves,
+/*@in@*/
+/*@notnull@*/
+	HT_BOOL * const HT_RSTR			valid
+	)
+/*@globals errno@*/
+/*@modifies errno, * text, * moves, * valid@*/
+{
+	enum HT_FR		fr	= HT_FR_SUCCESS;
+	HT_BOOL			head	= HT_FALSE;
+	HT_BOOL			ok	= HT_TRUE;
+	const unsigned short	bw	= g->rules->bwidth;
+	const unsigned short	bh	= g->rules->bheight;
+	struct ht_line * const	line	= alloc_ht_line((size_t)4,
+						(size_t)1);
+
+	if (NULL == line)
+	{
+		return	HT_FR_FAIL_ALLOC;
+	}
+
+	while (ok && HT_FR_SUCCESS == fr && !ht_text_eof(text))
+	{
+		size_t		wordc;
+		size_t		k;
+		unsigned short	coord[4];
+
+		fr	= ht_line_readtext(text, line);
+		if (HT_FR_SUCCESS != fr || ht_line_empty(line))
+		{
+			continue;
+		}
+		/*
+		 * Blanks at the end of the line leave an empty word.
+		 */
+		wordc	= line->wordc;
+		if ('\0' == line->words[wordc - 1].chars[0])
+		{
+			wordc--;
+		}
+
+		if (!head)
+		{
+			ok	= (size_t)2 == wordc
+				&& 0 == strcmp(line->words[0].chars,
+					HT_GRECORD_TEXT_RULESET)
+				&& 0 == strcmp(line->words[1].chars,
+					grecord_rules(g));
+			head	= HT_TRUE;
+			continue;
+		}
+		if ((size_t)4 != wordc)
+		{
+			ok	= HT_FALSE;
+			continue;
+		}
+		for (k = (size_t)0; ok && k < (size_t)4; k++)
+		{
+			ok	= texttoushort(line->words[k].chars,
+					& coord[k])
+				&& coord[k] < (k % 2 == 0 ? bw : bh);
+		}
+		if (ok)
+		{
+			fr	= listm_add(moves,
+				(unsigned short)(coord[1] * bw + coord[0]),
+				(unsigned short)(coord[3] * bw + coord[2]));
+		}
+	}
+
+	free_ht_line	(line);
+	* valid		= ok && head && HT_FR_SUCCESS == fr;
+	return		fr;
+}
+
+/*
+ * Reads the record in file, in either encoding, into moves (which are
+ * cleared first).
+ *
+ * valid is set to true if the record is for g's ruleset, and every
+ * move is on the board. Else moves are garbage. Whether the moves are
+ * legal is not checked (see grecord_replay). The sum of a binary
+ * record only catches damage, not a record that was edited or made
+ * for another ruleset file with the same id, so the moves must be
+ * replayed with trusted false.
+ *
+ * Returns HT_FR_FAIL_IO_FILE_R if file can't be read.
+ */
+enum HT_FR
+grecord_read (
+	const struct game * const	g,
+	const char * const		file,
+	struct listm * const		moves,
+	HT_BOOL * const			valid
+	)
+{
+	enum HT_FR		fr	= HT_FR_SUCCESS;
+	struct ht_text *	text	= NULL;
+	FILE * const		in	= fopen(file, "rb");
+
+	* valid		= HT_FALSE;
+	listm_clear	(moves);
+
+	if (NULL == in)
+	{
+		return	HT_FR_FAIL_IO_FILE_R;
+	}
+	text	= alloc_ht_text(in, & fr);
+	if (0 != fclose(in) && HT_FR_SUCCESS == fr)
+	{
+		fr	= HT_FR_FAIL_IO_FILE_R;
+	}
+	if (HT_FR_SUCCESS != fr || NULL == text)
+	{
+		if (NULL != text)
+		{
+			free_ht_text	(text);
+		}
+		return	fr;
+	}
+
+	if (text->len >= sizeof(HT_GRECORD_MAGIC)
+	&& 0 == memcmp(text->chars, HT_GRECORD_MAGIC,
+		sizeof(HT_GRECORD_MAGIC)))
+	{
+		fr	= grecord_read_bin(g,
+			text->chars + sizeof(HT_GRECORD_MAGIC),
+			text->len - sizeof(HT_GRECORD_MAGIC),
+			moves, valid);
+	}
+	else
+	{
+		fr	= grecord_read_text(g, text, moves, valid);
+	}
+
+	free_ht_text	(text);
+	return		fr;
+}
+
+/*
+ * Resets g's board and plays moves in it.
+ *
+ * If trusted, the moves are played with board_move_unsafe, which only
+ * has to update the board: this is only for moves that this process
+ * has already played with every move checked (such as a game it's
+ * playing, or a record it has replayed untrusted), never for moves
+ * read from a file. Every move must be on the board, but only moves of
+ * empty squares are caught.
+ *
+ * Else every move is played with game_move, and the record is invalid
+ * if a move is illegal or the game is over before it.
+ *
+ * valid is set to true if every move was played. Else g is left in the
+ * position before the first move that couldn't be played.
+ */
+enum HT_FR
+grecord_replay (
+	struct game * const		g,
+	const struct listm * const	moves,
+	const HT_BOOL			trusted,
+	HT_BOOL * const			valid
+	)
+{
+	enum HT_FR	fr;
+	size_t		i;
+
+	* valid	= HT_FALSE;
+
+	fr	= game_board_reset(g);
+	if (HT_FR_SUCCESS != fr)
+	{
+		return	fr;
+	}
+	fr	= listmh_reserve(g->movehist, moves->elemc);
+	if (HT_FR_SUCCESS != fr)
+	{
+		return	fr;
+	}
+
+	if (trusted)
+	{
+		for (i = 0; i < moves->elemc; i++)
+		{
+			const struct move * const HT_RSTR m =
+				& moves->elems[i];
+			if (HT_BIT_U8_EMPTY == g->b->pieces[m->pos])
+			{
+				return	HT_FR_SUCCESS;
+			}
+			fr = board_move_unsafe(g, g->b, g->movehist,
+				m->pos, m->dest
+#ifdef HT_AI_MINIMAX
+				, NULL
+#endif
+				);
+			if (HT_FR_SUCCESS != fr)
+			{
+				return	fr;
+			}
+		}
+	}
+	else
+	{
+		for (i = 0; i < moves->elemc; i++)
+		{
+			const struct move * const HT_RSTR m =
+				& moves->elems[i];
+			unsigned short	winner	= HT_PLAYER_UNINIT;
+			HT_BOOL		legal	= HT_FALSE;
+
+			if (game_over(g, & winner))
+			{
+				return	HT_FR_SUCCESS;
+			}
+			fr = game_move(g, m->pos, m->dest, & legal);
+			if (HT_FR_SUCCESS != fr || !legal)
+			{
+				return	fr;
+			}
+		}
+	}
+
+	* valid	= HT_TRUE;
+	return	HT_FR_SUCCESS;
+}
+
+/*
+ * Replaces the game played in g by the record in file.
+ *
+ * valid is set to true if file is a valid record for g's ruleset (see
+ * grecord_read), and every move in it was legal. Else, or if file can't
+ * be read, the game in g is played again as it was.
+ */
+enum HT_FR
+grecord_load (
+	struct game * const	g,
+	const char * const	file,
+	HT_BOOL * const		valid
+	)
+{
+	enum HT_FR		fr;
+	struct listm * const	moves	= alloc_listm((size_t)64);
+	struct listm *		prev	= NULL;
+	size_t			i;
+
+	* valid	= HT_FALSE;
+	if (NULL == moves)
+	{
+		return	HT_FR_FAIL_ALLOC;
+	}
+
+	fr	= grecord_read(g, file, moves, valid);
+	if (HT_FR_SUCCESS != fr || !(* valid))
+	{
+		free_listm	(moves);
+		return		HT_FR_FAIL_IO_FILE_R == fr ?
+				HT_FR_SUCCESS : fr;
+	}
+
+	/*
+	 * The moves of the game that is replaced, in case the record
+	 * has an illegal move.
+	 */
+	prev	= alloc_listm(g->movehist->elemc + (size_t)1);
+	if (NULL == prev)
+	{
+		free_listm	(moves);
+		* valid		= HT_FALSE;
+		return		HT_FR_FAIL_ALLOC;
+	}
+	for (i = 0; i < g->movehist->elemc; i++)
+	{
+		prev->elems[i].pos	= g->movehist->elems[i].pos;
+		prev->elems[i].dest	= g->movehist->elems[i].dest;
+	}
+	prev->elemc	= g->movehist->elemc;
+
+	fr	= grecord_replay(g, moves, HT_FALSE, valid);
+	if (HT_FR_SUCCESS == fr && !(* valid))
+	{
+		HT_BOOL	restored;
+		fr	= grecord_replay(g, prev, HT_TRUE, & restored);
+	}
+
+	free_listm	(prev);
+	free_listm	(moves);
+	return		fr;
+}
+
@@ -0,0 +1,104 @@
+/* Copyright 2013 Alexander Söderlund.
+ *
+ * This file is part of HNEFATAFL.
+ *
+ * HNEFATAFL is free software: you can distribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * HNEFATAFL is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef HT_GRECORD_H
+#define HT_GRECORD_H
+
+#include "boolt.h"	/* HT_BOOL */
+#include "funct.h"	/* HT_FR */
+#include "gamet.h"	/* game */
+#include "listmt.h"	/* listm */
+
+/*@-protoparamname@*/
+extern
+enum HT_FR
+grecord_save (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const	g,
+/*@in@*/
+/*@notnull@*/
+	const char * const		file,
+	const HT_BOOL			bin
+	)
+/*@globals fileSystem, errno@*/
+/*@modifies fileSystem, errno@*/
+;
+/*@=protoparamname@*/
+
+/*@-protoparamname@*/
+extern
+enum HT_FR
+grecord_read (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const	g,
+/*@in@*/
+/*@notnull@*/
+	const char * const		file,
+/*@in@*/
+/*@notnull@*/
+	struct listm * const		moves,
+/*@out@*/
+/*@notnull@*/
+	HT_BOOL * const			valid
+	)
+/*@globals fileSystem, errno@*/
+/*@modifies fileSystem, errno, * moves, * valid@*/
+;
+/*@=protoparamname@*/
+
+/*@-protoparamname@*/
+extern
+enum HT_FR
+grecord_replay (
+/*@in@*/
+/*@notnull@*/
+	struct game * const		g,
+/*@in@*/
+/*@notnull@*/
+	const struct listm * const	moves,
+	const HT_BOOL			trusted,
+/*@out@*/
+/*@notnull@*/
+	HT_BOOL * const			valid
+	)
+/*@modifies * g, * valid@*/
+;
+/*@=protoparamname@*/
+
+/*@-protoparamname@*/
+extern
+enum HT_FR
+grecord_load (
+/*@in@*/
+/*@notnull@*/
+	struct game * const		g,
+/*@in@*/
+/*@notnull@*/
+	const char * const		file,
+/*@out@*/
+/*@notnull@*/
+	HT_BOOL * const			valid
+	)
+/*@globals fileSystem, errno@*/
+/*@modifies fileSystem, errno, * g, * valid@*/
+;
+/*@=protoparamname@*/
+
+#endif
+
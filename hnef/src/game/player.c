@@ -18,7 +18,7 @@
 #include <stdlib.h>	/* malloc, free */
 
 #ifdef HT_AI_MINIMAX_HASH
-#include "aimhash.h"	/* zhashtable_clearunused */
+#include "aimhash.h"	/* zhashtable_age, zhashtable_reusable */
 #endif
 #ifdef HT_AI_MINIMAX
 #include "aiminimax.h"	/* free_aiminimax */
@@ -26,35 +26,51 @@
 #include "player.h"
 
 /*
- * This clears unused nodes in the minimax players' hash tables, setting
- * all used nodes to unused. Since this is also called every time when
- * aiminimax_command is called, it will remove all unused nodes that
- * were flagged in this function, and we don't need a new function in
- * aimhash.c for clearing moves regardless if they are used or not (it
- * would still entail the functions being called twice, thus no gain).
+ * This ages the minimax players' hash tables, so that the nodes from
+ * the previous game are replaced before the nodes of the next one.
+ * They are not removed, since they are still valid for the ruleset.
+ *
+ * If g->hash_conf.mem_tab has been changed since the table was
+ * allocated, the table is instead reallocated with the new size. The
+ * old table is freed first, so that both are never held at once. If
+ * the new one can't be allocated, tp_tab is left NULL and
+ * HT_FR_FAIL_ALLOC is returned.
  */
 enum HT_FR
 player_reset (
-	struct player * const	p
+	const struct game * const HT_RSTR	g,
+	struct player * const HT_RSTR		p
 	)
 {
 #ifdef HT_AI_MINIMAX_HASH
 	if (HT_AIT_MINIMAX == p->contr)
 	{
-		enum HT_FR	fr	= HT_FR_NONE;
+		struct aiminimax * const HT_RSTR aim = p->ai.minimax;
 #ifndef HT_UNSAFE
-		if (NULL == p->ai.minimax)
+		if (NULL == aim || NULL == aim->tp_tab)
 		{
 			return	HT_FR_FAIL_NULLPTR;
 		}
 #endif
 
-		fr = zhashtable_clearunused(p->ai.minimax->tp_tab);
-		if (HT_FR_SUCCESS != fr)
+		if (zhashtable_reusable(aim->tp_tab, g))
 		{
-			return	fr;
+			zhashtable_age(aim->tp_tab);
+		}
+		else
+		{
+			free_zhashtable	(aim->tp_tab);
+/*@i1@*/\
+			aim->tp_tab	= alloc_zhashtable_init(g);
+			if (NULL == aim->tp_tab)
+			{
+				return	HT_FR_FAIL_ALLOC;
+			}
 		}
 	}
+#else
+	(void) g;
+	(void) p;
 #endif
 	return	HT_FR_SUCCESS;
 }
@@ -20,6 +20,7 @@
 
 #include "boolt.h"	/* HT_BOOL */
 #include "config.h"	/* HT_RSTR */
+#include "funct.h"	/* HT_FR */
 #include "gamet.h"	/* game */
 #include "playert.h"	/* player */
 
@@ -29,9 +30,13 @@ enum HT_FR
 player_reset (
 /*@in@*/
 /*@notnull@*/
-	struct player * const	p
+	const struct game * const HT_RSTR	g,
+/*@in@*/
+/*@notnull@*/
+	struct player * const HT_RSTR		p
 	)
-/*@modifies * p@*/
+/*@globals errno, internalState@*/
+/*@modifies errno, internalState, * p@*/
 ;
 /*@=protoparamname@*/
 
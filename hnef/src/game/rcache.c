@@ -0,0 +1,923 @@
+/* Copyright 2013 Alexander Söderlund.
+ *
+ * This file is part of HNEFATAFL.
+ *
+ * HNEFATAFL is free software: you can distribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * HNEFATAFL is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>	/* fopen, fread, fwrite, fclose, rename */
+#include <stdlib.h>	/* malloc, free */
+#include <string.h>	/* memset, memcpy, memcmp, strlen */
+#ifdef HT_POSIX
+#include <fcntl.h>	/* open */
+#include <sys/mman.h>	/* mmap, munmap */
+#include <unistd.h>	/* lseek, close, getpid */
+#endif
+
+#include "rcache.h"
+#ifdef HT_AI_MINIMAX
+#include "aimeval.h"	/* HT_AIM_EVAL_FILE_SUFFIX */
+#endif
+#include "config.h"	/* HT_RSTR, HT_POSIX */
+#include "fnv.h"	/* ht_fnv, HT_FNV_* */
+#include "game.h"	/* alloc_game, game_init, game_initopt, ... */
+#include "player.h"	/* player_initopt */
+#include "rreader.h"	/* alloc_game_read, fopen_file_rc */
+#include "rvalid.h"	/* ruleset_valid */
+#include "types.h"	/* HT_TYPE_MAX */
+
+/*
+ * Header of a compiled ruleset file (see rcache_save), which is
+ * followed by:
+ *
+ * 1.	The ruleset struct, with its pointers cleared.
+ *
+ * 2.	ruleset->opt_zobrist, ruleset->pieces and ruleset->squares.
+ *
+ * 3.	If HT_AI_MINIMAX: game->eval_conf.weights, and
+ *	game->eval_conf.psq if psq.
+ *
+ * 4.	ruleset->path, ruleset->id and ruleset->name, each with its
+ *	'\0'.
+ *
+ * Like a transposition table snapshot, the file is written in the
+ * machine's own byte order and struct layout, so it can only be loaded
+ * by the same build on the same kind of machine. size_ruleset, build
+ * and the magic number catch most mismatches.
+ */
+struct rcachehead
+{
+
+	/*
+	 * HT_RCACHE_MAGIC.
+	 */
+	char		magic[8];
+
+	/*
+	 * rcache_key of the ruleset file and weights file.
+	 */
+	HT_U64		key;
+
+	/*
+	 * Length of the whole file.
+	 */
+	HT_U64		size;
+
+	/*
+	 * ht_fnv of everything after the header, which catches a
+	 * damaged file.
+	 */
+	HT_U64		sum;
+
+	/*
+	 * sizeof(struct ruleset).
+	 */
+	HT_U64		size_ruleset;
+
+	/*
+	 * rcache_build.
+	 */
+	HT_U64		build;
+
+	/*
+	 * strlen + 1 of ruleset->path, id and name, or 0 if NULL.
+	 */
+	HT_U64		len_path,
+			len_id,
+			len_name;
+
+	/*
+	 * 1 if game->eval_conf.psq is saved, else 0.
+	 */
+	HT_U64		psq;
+
+	/*
+	 * game->hash_conf.zobrist_seed and mem_tab, or 0 if not
+	 * HT_AI_MINIMAX_HASH.
+	 */
+	HT_U64		zobrist_seed,
+			mem_tab;
+
+	unsigned short	bwidth,
+			bheight;
+
+	/*
+	 * ruleset->hash.
+	 */
+	char		rules_hash[HT_FNV_HEX_LEN + 1];
+
+};
+
+/*@unchecked@*/
+/*@observer@*/
+static
+const char HT_RCACHE_MAGIC[8]	=
+	{ 'H', 'T', 'R', 'C', 'A', 'C', 'H', '1' };
+
+/*
+ * A header and a ruleset, which a file image is built from. They're
+ * too big for the stack, so they're allocated together.
+ */
+struct rcachebuf
+{
+
+	struct rcachehead	head;
+
+	struct ruleset		img;
+
+};
+
+/*
+ * Bytes that rcache_fnv_file reads at a time.
+ */
+/*@unchecked@*/
+static
+const size_t HT_RCACHE_READ_LEN	= (size_t)4096;
+
+/*
+ * Tells apart builds whose games are not laid out alike, although
+ * struct ruleset is.
+ */
+static
+HT_U64
+rcache_build (void)
+/*@modifies nothing@*/
+{
+	HT_U64	build	= (HT_U64)HT_TYPE_MAX;
+#ifdef HT_AI_MINIMAX
+	build	|= (HT_U64)HT_AIM_EVAL_TERMC << 16;
+#endif
+#ifdef HT_AI_MINIMAX_HASH
+	build	|= (HT_U64)1 << 32;
+#endif
+	return	build;
+}
+
+/*
+ * Returns the length of a file with head, for a ruleset with blen
+ * squares.
+ */
+static
+size_t
+rcache_size (
+/*@in@*/
+/*@notnull@*/
+	const struct rcachehead * const HT_RSTR	head,
+	const size_t				blen
+	)
+/*@modifies nothing@*/
+{
+	size_t	size	= sizeof(* head) + sizeof(struct ruleset)
+			+ sizeof(HT_U64) * (size_t)HT_TYPE_MAX * blen
+			+ sizeof(HT_BIT_U8) * (size_t)2 * blen
+			+ (size_t)(head->len_path + head->len_id
+			+ head->len_name);
+#ifdef HT_AI_MINIMAX
+	size	+= sizeof(int) * (size_t)HT_AIM_EVAL_TERMC;
+	if (0 != head->psq)
+	{
+		size	+= sizeof(int) * (size_t)HT_TYPE_MAX * blen;
+	}
+#endif
+	return	size;
+}
+
+/*
+ * Adds the bytes of file to h.
+ *
+ * Returns false if the file can't be read, or if there's no memory to
+ * read it with.
+ */
+static
+HT_BOOL
+rcache_fnv_file (
+/*@in@*/
+/*@notnull@*/
+	FILE * const HT_RSTR	file,
+/*@in@*/
+/*@notnull@*/
+	HT_U64 * const HT_RSTR	h
+	)
+/*@globals fileSystem@*/
+/*@modifies fileSystem, file, * h@*/
+{
+	char * const	buf	= malloc(HT_RCACHE_READ_LEN);
+	size_t		len;
+	HT_BOOL		ok;
+	if (NULL == buf)
+	{
+		return	HT_FALSE;
+	}
+	while ((len = fread(buf, (size_t)1, HT_RCACHE_READ_LEN, file))
+		> 0)
+	{
+		* h	= ht_fnv(* h, buf, len);
+	}
+	ok	= 0 == ferror(file);
+	free	(buf);
+	return	ok;
+}
+
+/*
+ * Sets key to a fingerprint of the bytes of the ruleset file that
+ * alloc_game_read reads for file_rc, and of its weights file (if
+ * HT_AI_MINIMAX).
+ *
+ * This doesn't parse anything, so it's much faster than reading the
+ * ruleset, but any change to the files (even to a comment) changes
+ * key.
+ *
+ * Returns false if the ruleset file can't be read.
+ */
+static
+HT_BOOL
+rcache_key (
+/*@in@*/
+/*@notnull@*/
+	const char * const HT_RSTR	file_rc,
+/*@out@*/
+/*@notnull@*/
+	HT_U64 * const HT_RSTR		key
+	)
+/*@globals fileSystem, errno@*/
+/*@modifies fileSystem, errno, * key@*/
+{
+	enum HT_FR	fr	= HT_FR_NONE;
+	FILE *		file	= fopen_file_rc(file_rc, & fr);
+	HT_U64		h	= HT_FNV_INIT;
+	HT_BOOL		ok;
+
+	if (HT_FR_SUCCESS != fr || NULL == file)
+	{
+		if (NULL != file)
+		{
+			(void) fclose	(file);
+		}
+		return	HT_FALSE;
+	}
+	ok	= rcache_fnv_file(file, & h);
+	(void) fclose	(file);
+	if (!ok)
+	{
+		return	HT_FALSE;
+	}
+
+#ifdef HT_AI_MINIMAX
+	/*
+	 * Same file as rread_weights.
+	 */
+	if (strlen(file_rc) > (size_t)0)
+	{
+		const size_t	len_rc	= strlen(file_rc);
+		const size_t	len_suf	=
+			strlen(HT_AIM_EVAL_FILE_SUFFIX);
+		char * const	file_weights	=
+			malloc(len_rc + len_suf + (size_t)1);
+		if (NULL == file_weights)
+		{
+			return	HT_FALSE;
+		}
+		memcpy	(file_weights, file_rc, len_rc);
+		memcpy	(file_weights + len_rc, HT_AIM_EVAL_FILE_SUFFIX,
+			len_suf + (size_t)1);
+		file	= fopen(file_weights, "r");
+		free	(file_weights);
+		if (NULL != file)
+		{
+			/*
+			 * Keeps "a" + "" apart from "" + "a".
+			 */
+			h	= ht_fnv(h, "", (size_t)1);
+			ok	= rcache_fnv_file(file, & h);
+			(void) fclose	(file);
+			if (!ok)
+			{
+				return	HT_FALSE;
+			}
+		}
+	}
+#endif
+
+	* key	= h;
+	return	HT_TRUE;
+}
+
+/*
+ * Returns a copy of the len bytes at mem, which must end with '\0', or
+ * NULL if len is 0.
+ *
+ * Sets ok to false if the string is invalid or can't be allocated.
+ */
+/*@null@*/
+/*@only@*/
+static
+char *
+rcache_str (
+/*@in@*/
+/*@notnull@*/
+	const char * const HT_RSTR	mem,
+	const size_t			len,
+/*@in@*/
+/*@notnull@*/
+	HT_BOOL * const HT_RSTR		ok
+	)
+/*@modifies * ok@*/
+{
+	char * str;
+	if (len < (size_t)1)
+	{
+		return	NULL;
+	}
+	if ('\0' != mem[len - 1] || NULL == (str = malloc(len)))
+	{
+		* ok	= HT_FALSE;
+		return	NULL;
+	}
+	memcpy	(str, mem, len);
+	return	str;
+}
+
+/*
+ * Returns the game in the len bytes at mem, which were saved by
+ * rcache_save with key, or NULL if they weren't (or if the game can't
+ * be allocated). Its ruleset was valid when it was saved, and the game
+ * is ready for game_board_reset; game_initopt has already been
+ * called.
+ *
+ * The header is read where it is, so mem must be aligned like memory
+ * from malloc or mmap. img is where the ruleset is copied to.
+ */
+/*@null@*/
+/*@only@*/
+static
+struct game *
+rcache_game_buf (
+/*@in@*/
+/*@notnull@*/
+	const void * const HT_RSTR	mem,
+	const size_t			len,
+	const HT_U64			key,
+/*@out@*/
+/*@notnull@*/
+	struct ruleset * const HT_RSTR	img
+	)
+/*@modifies * img@*/
+{
+	const struct rcachehead * const HT_RSTR	head	= mem;
+	struct game *		g;
+	struct ruleset *	r;
+	const char *		pos	= mem;
+	size_t			blen;
+	size_t			len_zob;
+	HT_BOOL			ok	= HT_TRUE;
+	unsigned short		i;
+
+	if (len < sizeof(* head))
+	{
+		return	NULL;
+	}
+	pos	+= sizeof(* head);
+	if (0 != memcmp(head->magic, HT_RCACHE_MAGIC,
+		sizeof(head->magic))
+	|| key != head->key
+	|| (HT_U64)len != head->size
+	|| (HT_U64)sizeof(struct ruleset) != head->size_ruleset
+	|| rcache_build() != head->build
+	|| head->len_path > head->size
+	|| head->len_id > head->size
+	|| head->len_name > head->size
+	|| '\0' != head->rules_hash[HT_FNV_HEX_LEN]
+	|| ht_fnv(HT_FNV_INIT, pos, len - sizeof(* head)) != head->sum)
+	{
+		return	NULL;
+	}
+
+	/*
+	 * Checks bwidth and bheight.
+	 */
+	g	= alloc_game(head->bwidth, head->bheight);
+	if (NULL == g)
+	{
+		return	NULL;
+	}
+	game_init(g);
+	r	= g->rules;
+	blen	= (size_t)r->opt_blen;
+	len_zob	= (size_t)HT_TYPE_MAX * blen;
+	if (len != rcache_size(head, blen))
+	{
+		free_game	(g);
+		return		NULL;
+	}
+	memcpy	(img, pos, sizeof(* img));
+	pos	+= sizeof(* img);
+	if (img->bwidth != r->bwidth || img->bheight != r->bheight)
+	{
+		free_game	(g);
+		return		NULL;
+	}
+
+	/*
+	 * r keeps the arrays that alloc_game allocated.
+	 */
+	img->pieces		= r->pieces;
+	img->squares		= r->squares;
+	img->opt_zobrist	= r->opt_zobrist;
+	img->path		= NULL;
+	img->id			= NULL;
+	img->name		= NULL;
+	img->hash		= NULL;
+	* r			= * img;
+
+	/*
+	 * refc counts this process's games, not the ones that wrote
+	 * the file. g is the only one.
+	 */
+	r->refc			= 1ul;
+
+	memcpy	(r->opt_zobrist, pos,
+		sizeof(* r->opt_zobrist) * len_zob);
+	pos	+= sizeof(* r->opt_zobrist) * len_zob;
+	memcpy	(r->pieces, pos, sizeof(* r->pieces) * blen);
+	pos	+= sizeof(* r->pieces) * blen;
+	memcpy	(r->squares, pos, sizeof(* r->squares) * blen);
+	pos	+= sizeof(* r->squares) * blen;
+
+#ifdef HT_AI_MINIMAX
+	memcpy	(g->eval_conf.weights, pos,
+		sizeof(g->eval_conf.weights));
+	pos	+= sizeof(g->eval_conf.weights);
+	if (0 != head->psq)
+	{
+		const size_t len_psq	= sizeof(* g->eval_conf.psq)
+					* (size_t)HT_TYPE_MAX * blen;
+		g->eval_conf.psq	= malloc(len_psq);
+		if (NULL == g->eval_conf.psq)
+		{
+			free_game	(g);
+			return		NULL;
+		}
+		memcpy	(g->eval_conf.psq, pos, len_psq);
+		pos	+= len_psq;
+	}
+#endif
+#ifdef HT_AI_MINIMAX_HASH
+	g->hash_conf.zobrist_seed = (unsigned long)head->zobrist_seed;
+	g->hash_conf.mem_tab	= (size_t)head->mem_tab;
+#endif
+
+	r->path	= rcache_str(pos, (size_t)head->len_path, & ok);
+	pos	+= (size_t)head->len_path;
+	r->id	= rcache_str(pos, (size_t)head->len_id, & ok);
+	pos	+= (size_t)head->len_id;
+	r->name	= rcache_str(pos, (size_t)head->len_name, & ok);
+	r->hash	= malloc((size_t)HT_FNV_HEX_LEN + (size_t)1);
+	if (!ok || NULL == r->path || NULL == r->hash)
+	{
+		free_game	(g);
+		return		NULL;
+	}
+	memcpy	(r->hash, head->rules_hash, sizeof(head->rules_hash));
+
+	/*
+	 * The ruleset's opt_ values are saved, but not the players'.
+	 */
+	for (i = (unsigned short)0; i < g->playerc; i++)
+	{
+		player_initopt	(g, g->players[i]);
+	}
+	return	g;
+}
+
+/*
+ * rcache_game_buf, with the ruleset copy on the heap.
+ */
+/*@null@*/
+/*@only@*/
+static
+struct game *
+rcache_game (
+/*@in@*/
+/*@notnull@*/
+	const void * const HT_RSTR	mem,
+	const size_t			len,
+	const HT_U64			key
+	)
+/*@modifies nothing@*/
+{
+	struct game *		g;
+	struct ruleset * const	img	= malloc(sizeof(* img));
+	if (NULL == img)
+	{
+		return	NULL;
+	}
+	g	= rcache_game_buf(mem, len, key, img);
+	free	(img);
+	return	g;
+}
+
+/*
+ * Returns the game in file if it was saved by rcache_save with key, or
+ * NULL if it wasn't (which is not an error: the ruleset is then read
+ * as usual).
+ *
+ * If HT_POSIX, the file is mapped with mmap rather than read.
+ */
+/*@null@*/
+/*@only@*/
+static
+struct game *
+rcache_load (
+/*@in@*/
+/*@notnull@*/
+	const char * const HT_RSTR	file,
+	const HT_U64			key
+	)
+/*@globals fileSystem@*/
+/*@modifies fileSystem@*/
+{
+	struct game *	g	= NULL;
+#ifdef HT_POSIX
+	void *		mem	= NULL;
+	off_t		len;
+	const int	fd	= open(file, O_RDONLY);
+
+	if (fd < 0)
+	{
+		return	NULL;
+	}
+	/*
+	 * lseek rather than fstat, whose struct stat is 144 bytes.
+	 */
+	len	= lseek(fd, 0, SEEK_END);
+	if (len < (off_t)sizeof(struct rcachehead))
+	{
+		(void) close	(fd);
+		return		NULL;
+	}
+	mem	= mmap(NULL, (size_t)len, PROT_READ, MAP_PRIVATE, fd,
+		0);
+	(void) close	(fd);
+	if (MAP_FAILED == mem)
+	{
+		return	NULL;
+	}
+	g	= rcache_game(mem, (size_t)len, key);
+	(void) munmap	(mem, (size_t)len);
+#else
+	char *		mem	= NULL;
+	long		len;
+	FILE * const	in	= fopen(file, "rb");
+
+	if (NULL == in)
+	{
+		return	NULL;
+	}
+	if (0 != fseek(in, 0l, SEEK_END)
+	|| (len = ftell(in)) < (long)sizeof(struct rcachehead)
+	|| 0 != fseek(in, 0l, SEEK_SET)
+	|| NULL == (mem = malloc((size_t)len)))
+	{
+		(void) fclose	(in);
+		return		NULL;
+	}
+	if ((size_t)len == fread(mem, (size_t)1, (size_t)len, in))
+	{
+		g	= rcache_game(mem, (size_t)len, key);
+	}
+	(void) fclose	(in);
+	free		(mem);
+#endif
+	return	g;
+}
+
+/*
+ * Returns strlen(str) + 1, or 0 if str is NULL.
+ */
+static
+size_t
+rcache_strlen (
+/*@in@*/
+/*@null@*/
+	const char * const HT_RSTR	str
+	)
+/*@modifies nothing@*/
+{
+	return	NULL == str ? (size_t)0 : strlen(str) + (size_t)1;
+}
+
+/*
+ * Appends the len bytes at mem to the file image at * pos.
+ */
+static
+void
+rcache_put (
+/*@in@*/
+/*@notnull@*/
+	char * * const HT_RSTR		pos,
+/*@in@*/
+/*@null@*/
+	const void * const HT_RSTR	mem,
+	const size_t			len
+	)
+/*@modifies * pos, * * pos@*/
+{
+	if (len > (size_t)0 && NULL != mem)
+	{
+		memcpy	(* pos, mem, len);
+		* pos	+= len;
+	}
+}
+
+/*
+ * Returns the file that rcache_game loads g from for key, and sets len
+ * to its length, or returns NULL if it can't be allocated.
+ *
+ * head and img are where the header and the ruleset are built.
+ */
+/*@null@*/
+/*@only@*/
+static
+char *
+alloc_rcache_image_buf (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const HT_RSTR	g,
+	const HT_U64				key,
+/*@out@*/
+/*@notnull@*/
+	size_t * const HT_RSTR			len,
+/*@out@*/
+/*@notnull@*/
+	struct rcachehead * const HT_RSTR	head,
+/*@out@*/
+/*@notnull@*/
+	struct ruleset * const HT_RSTR		img
+	)
+/*@modifies * len, * head, * img@*/
+{
+	const struct ruleset * const HT_RSTR	r	= g->rules;
+	const size_t		blen	= (size_t)r->opt_blen;
+	char *			mem;
+	char *			pos;
+
+	/*
+	 * Also clears the padding, so that it's not written as garbage.
+	 */
+	(void) memset(head, 0, sizeof(* head));
+	memcpy	(head->magic, HT_RCACHE_MAGIC, sizeof(head->magic));
+	head->key		= key;
+	head->size_ruleset	= (HT_U64)sizeof(* img);
+	head->build		= rcache_build();
+	head->len_path		= (HT_U64)rcache_strlen(r->path);
+	head->len_id		= (HT_U64)rcache_strlen(r->id);
+	head->len_name		= (HT_U64)rcache_strlen(r->name);
+#ifdef HT_AI_MINIMAX
+	head->psq		= NULL == g->eval_conf.psq ? 0 : 1;
+#endif
+#ifdef HT_AI_MINIMAX_HASH
+	head->zobrist_seed	= (HT_U64)g->hash_conf.zobrist_seed;
+	head->mem_tab		= (HT_U64)g->hash_conf.mem_tab;
+#endif
+	head->bwidth		= r->bwidth;
+	head->bheight		= r->bheight;
+	if (NULL != r->hash)
+	{
+		memcpy	(head->rules_hash, r->hash,
+			(size_t)HT_FNV_HEX_LEN);
+	}
+	* len			= rcache_size(head, blen);
+	head->size		= (HT_U64)* len;
+
+	(void) memset(img, 0, sizeof(* img));
+	* img			= * r;
+	img->pieces		= NULL;
+	img->squares		= NULL;
+	img->opt_zobrist	= NULL;
+	img->path		= NULL;
+	img->id			= NULL;
+	img->name		= NULL;
+	img->hash		= NULL;
+	img->refc		= 0ul;
+
+	mem	= malloc(* len);
+	if (NULL == mem)
+	{
+		return	NULL;
+	}
+	pos	= mem + sizeof(* head);
+	rcache_put(& pos, img, sizeof(* img));
+	rcache_put(& pos, r->opt_zobrist,
+		sizeof(* r->opt_zobrist) * (size_t)HT_TYPE_MAX * blen);
+	rcache_put(& pos, r->pieces, sizeof(* r->pieces) * blen);
+	rcache_put(& pos, r->squares, sizeof(* r->squares) * blen);
+#ifdef HT_AI_MINIMAX
+	rcache_put(& pos, g->eval_conf.weights,
+		sizeof(g->eval_conf.weights));
+	rcache_put(& pos, g->eval_conf.psq, sizeof(* g->eval_conf.psq)
+		* (size_t)HT_TYPE_MAX * blen);
+#endif
+	rcache_put(& pos, r->path, (size_t)head->len_path);
+	rcache_put(& pos, r->id, (size_t)head->len_id);
+	rcache_put(& pos, r->name, (size_t)head->len_name);
+
+	head->sum	= ht_fnv(HT_FNV_INIT, mem + sizeof(* head),
+			* len - sizeof(* head));
+	memcpy	(mem, head, sizeof(* head));
+	return	mem;
+}
+
+/*
+ * alloc_rcache_image_buf, with the header and ruleset copies on the
+ * heap.
+ */
+/*@null@*/
+/*@only@*/
+static
+char *
+alloc_rcache_image (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const HT_RSTR	g,
+	const HT_U64				key,
+/*@out@*/
+/*@notnull@*/
+	size_t * const HT_RSTR			len
+	)
+/*@modifies * len@*/
+{
+	char *			mem;
+	struct rcachebuf * const buf	= malloc(sizeof(* buf));
+	if (NULL == buf)
+	{
+		return	NULL;
+	}
+	mem	= alloc_rcache_image_buf(g, key, len, & buf->head,
+		& buf->img);
+	free	(buf);
+	return	mem;
+}
+
+/*
+ * Saves g, which must be valid and initialized with game_initopt, to
+ * file, so that rcache_load can load it for key. The file is written
+ * all at once.
+ *
+ * If HT_POSIX, the file is written under another name and then renamed,
+ * so that processes that start at the same time never see half of it.
+ */
+static
+enum HT_FR
+rcache_save (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const HT_RSTR	g,
+/*@in@*/
+/*@notnull@*/
+	const char * const HT_RSTR		file,
+	const HT_U64				key
+	)
+/*@globals fileSystem@*/
+/*@modifies fileSystem@*/
+{
+	FILE *	out	= NULL;
+	HT_BOOL	ok;
+	size_t	len	= 0;
+	char *	mem	= alloc_rcache_image(g, key, & len);
+#ifdef HT_POSIX
+	char *	file_tmp;
+#else
+	const char * const file_tmp = file;
+#endif
+
+	if (NULL == mem)
+	{
+		return	HT_FR_FAIL_ALLOC;
+	}
+#ifdef HT_POSIX
+	file_tmp	= malloc(strlen(file) + (size_t)24);
+	if (NULL == file_tmp)
+	{
+		free	(mem);
+		return	HT_FR_FAIL_ALLOC;
+	}
+	if (sprintf(file_tmp, "%s.%lu", file, (unsigned long)getpid())
+		< 0)
+	{
+		free	(file_tmp);
+		free	(mem);
+		return	HT_FR_FAIL_IO_PRINT;
+	}
+#endif
+
+	out	= fopen(file_tmp, "wb");
+	ok	= NULL != out
+		&& (size_t)1 == fwrite(mem, len, (size_t)1, out);
+	if (NULL != out && 0 != fclose(out))
+	{
+		ok	= HT_FALSE;
+	}
+#ifdef HT_POSIX
+	if (ok && 0 != rename(file_tmp, file))
+	{
+		ok	= HT_FALSE;
+	}
+	if (!ok)
+	{
+		(void) remove	(file_tmp);
+	}
+	free	(file_tmp);
+#endif
+	free	(mem);
+	return	ok ? HT_FR_SUCCESS : HT_FR_FAIL_IO_FILE_W;
+}
+
+/*
+ * Like alloc_game_read, but the game is also initialized with
+ * game_initopt, and loaded from the compiled ruleset in file_rcache
+ * instead if it was saved from the same ruleset file (and weights
+ * file). Else the ruleset file is read, and saved to file_rcache if
+ * it's valid. file_rcache is not used if it's NULL.
+ *
+ * valid is set to true if the ruleset is known to be valid (see
+ * ruleset_valid), in which case it doesn't have to be checked again.
+ * Else it may or may not be valid.
+ *
+ * Failing to save file_rcache is not an error, since it only makes the
+ * next start slower.
+ */
+struct game *
+alloc_game_rcache (
+	const char *			file_rc,
+	const char *			file_rcache,
+	struct ht_line * const		line,
+	enum HT_FR * const		fr,
+	enum HT_FAIL_RREADER * const	fail_read,
+	HT_BOOL * const			valid
+	)
+{
+	struct game *	g	= NULL;
+	HT_U64		key	= 0;
+	HT_BOOL		keyed	= HT_FALSE;
+
+#ifndef HT_UNSAFE
+	if (NULL == valid)
+	{
+		* fr	= HT_FR_FAIL_NULLPTR;
+		return	NULL;
+	}
+#endif
+	* valid	= HT_FALSE;
+
+	if (NULL != file_rcache)
+	{
+		keyed	= rcache_key(file_rc, & key);
+		if (keyed)
+		{
+			g	= rcache_load(file_rcache, key);
+			if (NULL != g)
+			{
+				* fr	= HT_FR_SUCCESS;
+				* valid	= HT_TRUE;
+				return	g;
+			}
+		}
+	}
+
+	g	= alloc_game_read(file_rc, line, fr, fail_read);
+	if (HT_FR_SUCCESS != * fr || NULL == g)
+	{
+		return	g;
+	}
+	game_initopt(g);
+
+	if (keyed && NULL != file_rcache)
+	{
+		/*
+		 * ruleset_valid looks at g->b.
+		 */
+		* fr	= game_board_reset(g);
+		if (HT_FR_SUCCESS != * fr)
+		{
+			free_game	(g);
+			return		NULL;
+		}
+		if (NULL == ruleset_valid(g))
+		{
+			* valid	= HT_TRUE;
+			(void) rcache_save(g, file_rcache, key);
+		}
+	}
+	return	g;
+}
+
@@ -16,20 +16,28 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 #include <limits.h>		/* *_MAX */
-#include <string.h>		/* strlen */
+#include <stdio.h>		/* fopen, fclose */
+#include <string.h>		/* strlen, memcpy */
 
 #ifdef HT_POSIX
 #include <errno.h>		/* errno */
 #include <unistd.h>		/* symlink */
 #endif /* HT_POSIX */
 
+#ifdef HT_AI_MINIMAX
+#include "aimeval.h"		/* HT_AIM_EVAL_* */
+#endif
+#ifdef HT_AI_MINIMAX_HASH
+#include "aimhash.h"		/* zhash_mem_mib */
+#endif
 #include "config.h"		/* HT_RSTR, HT_POSIX */
+#include "fnv.h"		/* ht_fnv, ht_fnv_hex */
 #include "game.h"		/* alloc_game, free_game, ... */
 #include "info.h"		/* HT_FILE_RC_DEF */
-#include "iotextparse.h"	/* ht_line_readline */
+#include "iotextparse.h"	/* ht_line_readtext, alloc_ht_text */
 #include "lang.h"		/* HT_L_* */
 #include "movet.h"		/* HT_BOARDPOS_NONE */
-#include "num.h"		/* texttoushort */
+#include "num.h"		/* texttoushort, texttoint */
 #include "rreader.h"
 #include "rreadert.h"		/* rread_info */
 #include "ruleset.h"		/* valid_size */
@@ -678,6 +686,99 @@ parse_strarg (
 	return	HT_FR_SUCCESS;
 }
 
+#ifdef HT_AI_MINIMAX_HASH
+
+/*
+ * Reads "zobrist_seed" into g->hash_conf.zobrist_seed, and makes the
+ * Zobrist numbers of g->rules from it (see game_zobrist_seed).
+ */
+static
+enum HT_FR
+parse_zseed (
+/*@in@*/
+/*@notnull@*/
+	const struct ht_line * const HT_RSTR	line,
+/*@in@*/
+/*@notnull@*/
+	struct game * const HT_RSTR		g,
+/*@in@*/
+/*@notnull@*/
+	enum HT_FAIL_RREADER * const HT_RSTR	fail_read
+	)
+/*@globals errno@*/
+/*@modifies errno, * g, * fail_read@*/
+{
+	unsigned long	seed;
+
+	if (line->wordc			< (size_t)2
+	|| strlen(line->words[1].chars)	< (size_t)1)
+	{
+		* fail_read	= HT_FAIL_RREADER_ARG_MISS;
+		return		HT_FR_FAIL_RREADER;
+	}
+	else if (line->wordc > (size_t)2)
+	{
+		* fail_read	= HT_FAIL_RREADER_ARG_EXCESS;
+		return		HT_FR_FAIL_RREADER;
+	}
+
+	if (!texttoulong(line->words[1].chars, & seed))
+	{
+		* fail_read	= HT_FAIL_RREADER_STRTOL;
+		return		HT_FR_FAIL_RREADER;
+	}
+	return	game_zobrist_seed(g, seed);
+}
+
+/*
+ * Reads "hash_mem" (in MiB) into g->hash_conf.mem_tab (in bytes).
+ */
+static
+enum HT_FR
+parse_hashmem (
+/*@in@*/
+/*@notnull@*/
+	const struct ht_line * const HT_RSTR	line,
+/*@in@*/
+/*@notnull@*/
+	struct game * const HT_RSTR		g,
+/*@in@*/
+/*@notnull@*/
+	enum HT_FAIL_RREADER * const HT_RSTR	fail_read
+	)
+/*@globals errno@*/
+/*@modifies errno, * g, * fail_read@*/
+{
+	unsigned long mib;
+
+	if (line->wordc			< (size_t)2
+	|| strlen(line->words[1].chars)	< (size_t)1)
+	{
+		* fail_read	= HT_FAIL_RREADER_ARG_MISS;
+		return		HT_FR_FAIL_RREADER;
+	}
+	else if (line->wordc > (size_t)2)
+	{
+		* fail_read	= HT_FAIL_RREADER_ARG_EXCESS;
+		return		HT_FR_FAIL_RREADER;
+	}
+
+	if (!texttoulong(line->words[1].chars, & mib))
+	{
+		* fail_read	= HT_FAIL_RREADER_STRTOL;
+		return		HT_FR_FAIL_RREADER;
+	}
+	if (!zhash_mem_mib(mib, & g->hash_conf.mem_tab))
+	{
+		g->hash_conf.mem_tab	= HT_ZHASH_MEM_TAB_DEF;
+		* fail_read		= HT_FAIL_RREADER_NOOB;
+		return			HT_FR_FAIL_RREADER;
+	}
+	return	HT_FR_SUCCESS;
+}
+
+#endif /* HT_AI_MINIMAX_HASH */
+
 /*
  * Parses a line in the ruleset file.
  *
@@ -784,6 +885,16 @@ parseline (
 		g->rules->forbid_repeat	= HT_TRUE;
 		return			HT_FR_SUCCESS;
 	}
+#ifdef HT_AI_MINIMAX_HASH
+	else if	(0 == strcmp(arg0, HT_L_RREADER_CMD_ZSEED))
+	{
+		return	parse_zseed(line, g, fail_read);
+	}
+	else if	(0 == strcmp(arg0, HT_L_RREADER_CMD_HASHMEM))
+	{
+		return	parse_hashmem(line, g, fail_read);
+	}
+#endif
 /*
  * NOTE:	Additional arguments go here.
  *		"<arg0>"
@@ -841,6 +952,393 @@ free_rread_info (
 	free	(info);
 }
 
+/*
+ * Returns fingerprint updated with the words in line. Every word is
+ * hashed with its '\0', so that the fingerprint only depends on the
+ * commands and their arguments (not on whitespace or comments).
+ */
+static
+HT_U64
+rread_fingerprint (
+	const HT_U64				fingerprint,
+/*@in@*/
+/*@notnull@*/
+	const struct ht_line * const HT_RSTR	line
+	)
+/*@modifies nothing@*/
+{
+	HT_U64	h	= fingerprint;
+	size_t	i;
+	for (i = (size_t)0; i < line->wordc; i++)
+	{
+		h	= ht_fnv(h, line->words[i].chars,
+			strlen(line->words[i].chars) + (size_t)1);
+	}
+	return	ht_fnv(h, "\n", (size_t)1);
+}
+
+#ifdef HT_AI_MINIMAX
+
+/*
+ * Returns the term that arg0 names in a weights file, or
+ * HT_AIM_EVAL_TERMC if it names none.
+ */
+static
+enum HT_AIM_EVAL
+rread_weights_term (
+/*@in@*/
+/*@notnull@*/
+	const char * const HT_RSTR	arg0
+	)
+/*@modifies nothing@*/
+{
+	unsigned short term;
+	for (term = (unsigned short)0;
+		term < (unsigned short)HT_AIM_EVAL_TERMC; term++)
+	{
+		if (0 == strcmp(arg0,
+			aimeval_term_name((enum HT_AIM_EVAL)term)))
+		{
+			return	(enum HT_AIM_EVAL)term;
+		}
+	}
+	return	HT_AIM_EVAL_TERMC;
+}
+
+/*
+ * Reads a weight into weight, which must be within
+ * HT_AIM_EVAL_WEIGHT_MAX.
+ */
+static
+enum HT_FR
+parse_weight (
+/*@in@*/
+/*@notnull@*/
+	const char * const HT_RSTR		arg,
+/*@out@*/
+/*@notnull@*/
+	int * const HT_RSTR			weight,
+/*@in@*/
+/*@notnull@*/
+	enum HT_FAIL_RREADER * const HT_RSTR	fail_read
+	)
+/*@globals errno@*/
+/*@modifies errno, * weight, * fail_read@*/
+{
+	if (!texttoint(arg, weight))
+	{
+		* fail_read	= HT_FAIL_RREADER_STRTOL;
+		return		HT_FR_FAIL_RREADER;
+	}
+	if (* weight > HT_AIM_EVAL_WEIGHT_MAX
+	|| * weight < -HT_AIM_EVAL_WEIGHT_MAX)
+	{
+		* fail_read	= HT_FAIL_RREADER_NOOB;
+		return		HT_FR_FAIL_RREADER;
+	}
+	return	HT_FR_SUCCESS;
+}
+
+/*
+ * Reads "psq <piece bit> <value> ..." (one value per square) into
+ * g->eval_conf.psq, which is allocated by the first "psq".
+ */
+static
+enum HT_FR
+parse_psq (
+/*@in@*/
+/*@notnull@*/
+	const struct ht_line * const HT_RSTR	line,
+/*@in@*/
+/*@notnull@*/
+	struct game * const HT_RSTR		g,
+/*@in@*/
+/*@notnull@*/
+	enum HT_FAIL_RREADER * const HT_RSTR	fail_read
+	)
+/*@globals errno@*/
+/*@modifies errno, * g, * fail_read@*/
+{
+	const unsigned short	blen	= g->rules->opt_blen;
+	unsigned short		bit;
+	size_t			i;
+	int * HT_RSTR		row;
+
+	if (line->wordc < (size_t)2 + (size_t)blen)
+	{
+		* fail_read	= HT_FAIL_RREADER_ARG_MISS;
+		return		HT_FR_FAIL_RREADER;
+	}
+	else if (line->wordc > (size_t)2 + (size_t)blen)
+	{
+		* fail_read	= HT_FAIL_RREADER_ARG_EXCESS;
+		return		HT_FR_FAIL_RREADER;
+	}
+
+	if (!texttoushort(line->words[1].chars, & bit))
+	{
+		* fail_read	= HT_FAIL_RREADER_STRTOL;
+		return		HT_FR_FAIL_RREADER;
+	}
+	else if (bit > (unsigned short)128
+	|| !single_bit((unsigned int)bit))
+	{
+		* fail_read	= HT_FAIL_RREADER_BIT_SINGLE;
+		return		HT_FR_FAIL_RREADER;
+	}
+
+	if (NULL == g->eval_conf.psq)
+	{
+		g->eval_conf.psq = calloc((size_t)HT_TYPE_MAX * blen,
+			sizeof(* g->eval_conf.psq));
+		if (NULL == g->eval_conf.psq)
+		{
+			return	HT_FR_FAIL_ALLOC;
+		}
+	}
+	row	= g->eval_conf.psq
+		+ (size_t)type_index_get((HT_BIT_U8)bit) * blen;
+
+	for (i = (size_t)0; i < (size_t)blen; i++)
+	{
+		const enum HT_FR fr = parse_weight(
+			line->words[i + 2].chars, & row[i], fail_read);
+		if (HT_FR_SUCCESS != fr)
+		{
+			return	fr;
+		}
+	}
+	return	HT_FR_SUCCESS;
+}
+
+/*
+ * Parses a line in the weights file: "<term> <weight>" or "psq".
+ */
+static
+enum HT_FR
+parseline_weights (
+/*@in@*/
+/*@notnull@*/
+	const struct ht_line * const HT_RSTR	line,
+/*@in@*/
+/*@notnull@*/
+	struct game * const HT_RSTR		g,
+/*@in@*/
+/*@notnull@*/
+	enum HT_FAIL_RREADER * const HT_RSTR	fail_read
+	)
+/*@globals errno@*/
+/*@modifies errno, * g, * fail_read@*/
+{
+	enum HT_AIM_EVAL	term;
+	const char * const	arg0	= line->words[0].chars;
+
+	if (0 == strcmp(arg0, HT_L_AIMEVAL_CMD_PSQ))
+	{
+		return	parse_psq(line, g, fail_read);
+	}
+
+	term	= rread_weights_term(arg0);
+	if (HT_AIM_EVAL_TERMC == term)
+	{
+		* fail_read	= HT_FAIL_RREADER_ARG_UNK;
+		return		HT_FR_FAIL_RREADER;
+	}
+	if (line->wordc			< (size_t)2
+	|| strlen(line->words[1].chars)	< (size_t)1)
+	{
+		* fail_read	= HT_FAIL_RREADER_ARG_MISS;
+		return		HT_FR_FAIL_RREADER;
+	}
+	else if (line->wordc > (size_t)2)
+	{
+		* fail_read	= HT_FAIL_RREADER_ARG_EXCESS;
+		return		HT_FR_FAIL_RREADER;
+	}
+	return	parse_weight(line->words[1].chars,
+		& g->eval_conf.weights[term], fail_read);
+}
+
+/*
+ * Reads the weights in file into g->eval_conf. Every line is added to
+ * fingerprint. file is closed.
+ */
+static
+enum HT_FR
+rread_weights_file (
+/*@notnull@*/
+/*@owned@*/
+	FILE * const				file,
+/*@in@*/
+/*@notnull@*/
+	struct ht_line * const HT_RSTR		line,
+/*@in@*/
+/*@notnull@*/
+	struct game * const HT_RSTR		g,
+/*@in@*/
+/*@notnull@*/
+	HT_U64 * const HT_RSTR			fingerprint,
+/*@in@*/
+/*@notnull@*/
+	enum HT_FAIL_RREADER * const HT_RSTR	fail_read
+	)
+/*@globals fileSystem, errno@*/
+/*@modifies fileSystem, errno, file, * line, * g, * fingerprint@*/
+/*@modifies * fail_read@*/
+/*@releases file@*/
+{
+	enum HT_FR		fr	= HT_FR_SUCCESS;
+	struct ht_text *	text	= alloc_ht_text(file, & fr);
+
+	if (0 != fclose(file) && HT_FR_SUCCESS == fr)
+	{
+		fr	= HT_FR_FAIL_IO_FILE_R;
+	}
+	if (HT_FR_SUCCESS != fr || NULL == text)
+	{
+		if (NULL != text)
+		{
+			free_ht_text	(text);
+		}
+		return	fr;
+	}
+
+	while (HT_FR_SUCCESS == fr && !ht_text_eof(text))
+	{
+		fr	= ht_line_readtext(text, line);
+		if (HT_FR_SUCCESS != fr)
+		{
+			break;
+		}
+		if (ht_line_empty(line))
+		{
+			continue;
+		}
+		* fingerprint = rread_fingerprint(* fingerprint, line);
+		fr	= parseline_weights(line, g, fail_read);
+	}
+
+	/*
+	 * line is printed if fr is a failure.
+	 */
+	(void) ht_line_keep	(line);
+	free_ht_text		(text);
+	return			fr;
+}
+
+/*
+ * Reads the weights file of the ruleset file file_rc, which is
+ * file_rc followed by HT_AIM_EVAL_FILE_SUFFIX, into g->eval_conf. Every
+ * line is added to fingerprint.
+ *
+ * It's not an error if there is no weights file: then g->eval_conf
+ * keeps the default weights.
+ */
+static
+enum HT_FR
+rread_weights (
+/*@in@*/
+/*@notnull@*/
+	const char * const HT_RSTR		file_rc,
+/*@in@*/
+/*@notnull@*/
+	struct ht_line * const HT_RSTR		line,
+/*@in@*/
+/*@notnull@*/
+	struct game * const HT_RSTR		g,
+/*@in@*/
+/*@notnull@*/
+	HT_U64 * const HT_RSTR			fingerprint,
+/*@in@*/
+/*@notnull@*/
+	enum HT_FAIL_RREADER * const HT_RSTR	fail_read
+	)
+/*@globals fileSystem, errno@*/
+/*@modifies fileSystem, errno, * line, * g, * fingerprint@*/
+/*@modifies * fail_read@*/
+{
+	const size_t	len_rc	= strlen(file_rc);
+	const size_t	len_suf	= strlen(HT_AIM_EVAL_FILE_SUFFIX);
+	char *		file_weights;
+	FILE *		file;
+
+	if (len_rc < (size_t)1)
+	{
+		return	HT_FR_SUCCESS;
+	}
+
+	file_weights	= malloc(len_rc + len_suf + (size_t)1);
+	if (NULL == file_weights)
+	{
+		return	HT_FR_FAIL_ALLOC;
+	}
+	memcpy	(file_weights, file_rc, len_rc);
+	memcpy	(file_weights + len_rc, HT_AIM_EVAL_FILE_SUFFIX,
+		len_suf + (size_t)1);
+
+	file	= fopen(file_weights, "r");
+	free	(file_weights);
+	if (NULL == file)
+	{
+		return	HT_FR_SUCCESS;
+	}
+	return	rread_weights_file(file, line, g, fingerprint,
+		fail_read);
+}
+
+/*
+ * Replaces g->eval_conf with the default weights and then the weights
+ * in file_weights, which must exist.
+ *
+ * g->rules->hash is not changed, so a transposition table that's saved
+ * with these weights is not told apart from one with the ruleset's
+ * own weights.
+ */
+enum HT_FR
+game_weights_read (
+	const char * const		file_weights,
+	struct ht_line * const		line,
+	struct game * const		g,
+	enum HT_FAIL_RREADER * const	fail_read
+	)
+{
+	HT_U64		fingerprint	= 0;
+	FILE * const	file		= fopen(file_weights, "r");
+
+	if (NULL == file)
+	{
+		return	HT_FR_FAIL_IO_FILE_R;
+	}
+	aimevalconf_free	(& g->eval_conf);
+	aimevalconf_init	(& g->eval_conf);
+	return	rread_weights_file(file, line, g, & fingerprint,
+		fail_read);
+}
+
+#endif /* HT_AI_MINIMAX */
+
+/*
+ * Sets rules->hash to fingerprint in hexadecimal.
+ */
+static
+enum HT_FR
+rread_hash_set (
+/*@in@*/
+/*@notnull@*/
+	struct ruleset * const HT_RSTR	rules,
+	const HT_U64			fingerprint
+	)
+/*@modifies rules->hash@*/
+{
+	rules->hash	= malloc((size_t)HT_FNV_HEX_LEN + (size_t)1);
+	if (NULL == rules->hash)
+	{
+		return	HT_FR_FAIL_ALLOC;
+	}
+	ht_fnv_hex(fingerprint, rules->hash);
+	return	HT_FR_SUCCESS;
+}
+
 /*
  * Returns default RC file (in $HOME).
  *
@@ -949,7 +1447,7 @@ file_rc_def_checkcreate (
 #endif /* HT_POSIX */
 
 /*
- * Helper for alloc_game_read. Opens file_rc or the default rc file.
+ * Opens file_rc or the default rc file, like alloc_game_read.
  *
  * If fr is success, then returns non-NULL. If fr is fail, then returns
  * NULL.
@@ -962,7 +1460,6 @@ file_rc_def_checkcreate (
  */
 /*@null@*/
 /*@dependent@*/
-static
 FILE *
 fopen_file_rc (
 /*@in@*/
@@ -1064,8 +1561,10 @@ alloc_game_read (
 	)
 {
 	FILE *			file	= NULL;
+	struct ht_text *	text	= NULL;
 	struct rread_info *	info	= NULL;
 	struct game *		g	= NULL;
+	HT_U64			fingerprint	= HT_FNV_INIT;
 
 #ifndef HT_UNSAFE
 	* fail_read	= HT_FAIL_RREADER_NONE;	/* Should already be. */
@@ -1088,21 +1587,38 @@ alloc_game_read (
 		return	NULL;
 	}
 
+	/*
+	 * The whole file is read at once, and split into lines in place.
+	 */
+	text	= alloc_ht_text(file, fr);
+	if (0 != fclose(file) && HT_FR_SUCCESS == * fr)
+	{
+		* fr	= HT_FR_FAIL_IO_FILE_R;
+	}
+	if (HT_FR_SUCCESS != * fr || NULL == text)
+	{
+		if (NULL != text)
+		{
+			free_ht_text	(text);
+		}
+		return	NULL;
+	}
+
 	info	= alloc_rread_info();
 	if (NULL == info)
 	{
-		(void) fclose	(file);
+		free_ht_text	(text);
 		* fr		= HT_FR_FAIL_ALLOC;
 		return		NULL;
 	}
 	rread_info_init(info);
 
-	while (0 == feof(file))
+	while (!ht_text_eof(text))
 	{
-		* fr	= ht_line_readline(file, line);
+		* fr	= ht_line_readtext(text, line);
 		if (HT_FR_SUCCESS != * fr)
 		{
-			(void) fclose	(file);
+			free_ht_text	(text);
 			free_rread_info	(info);
 			if (NULL != g)
 			{
@@ -1114,28 +1630,21 @@ alloc_game_read (
 		* fr	= HT_FR_NONE;
 #endif
 
-		if (0 != ferror(file))
-		{
-			* fr	= HT_FR_FAIL_IO_FILE_R;
-			(void) fclose	(file);
-			free_rread_info	(info);
-			if (NULL != g)
-			{
-				free_game	(g);
-			}
-			return	NULL;
-		}
-
 		if (ht_line_empty(line))
 		{
 			continue;
 		}
+		fingerprint	= rread_fingerprint(fingerprint, line);
 
 		* fr	= parseline(line, info, g, fail_read);
 		if (HT_FR_SUCCESS != * fr)
 		{
-			(void) fclose	(file);
-			free_rread_info	(info);
+			/*
+			 * line is printed by the caller.
+			 */
+			(void) ht_line_keep	(line);
+			free_ht_text		(text);
+			free_rread_info		(info);
 			if (NULL != g)
 			{
 				free_game	(g);
@@ -1145,7 +1654,6 @@ alloc_game_read (
 #ifndef HT_UNSAFE
 		* fr	= HT_FR_NONE;
 #endif
-
 		if	(NULL == g
 		//&&	(NULL			!= info->id) || (NULL != info->hash)
 		&&	NULL			!= info->name
@@ -1157,7 +1665,7 @@ alloc_game_read (
 			if (NULL == g)
 			{
 				* fr		= HT_FR_FAIL_ALLOC;
-				(void) fclose	(file);
+				free_ht_text	(text);
 				free_rread_info	(info);
 				return		NULL;
 			}
@@ -1167,8 +1675,6 @@ alloc_game_read (
 			 * and id.
 			 */
 			g->rules->id	= info->id;
-			// TODO fill g->rules->hash (compute hash function
-			// from contents of entire file)
 			g->rules->name	= info->name;
 			g->rules->path	= info->path;
 			info->id	= NULL;
@@ -1189,23 +1695,34 @@ alloc_game_read (
 		}
 		else
 		{
-			* fr		= HT_FR_SUCCESS;
+			* fr	= HT_FR_SUCCESS;
+#ifdef HT_AI_MINIMAX
+			* fr	= rread_weights(file_rc, line, g,
+				& fingerprint, fail_read);
+#endif
+			/*
+			 * g->rules->hash is a fingerprint of the whole
+			 * file, and of the weights file (which changes
+			 * the values that computer players store).
+			 */
+			if (HT_FR_SUCCESS == * fr)
+			{
+				* fr	= rread_hash_set(g->rules,
+					fingerprint);
+			}
+			if (HT_FR_SUCCESS != * fr)
+			{
+				free_game	(g);
+				g		= NULL;
+			}
 		}
 	}
 
-	if (0 != fclose(file))
+	if (NULL == g)
 	{
-		/*
-		 * Don't overwrite a previous fail value.
-		 */
-		* fr	= HT_FR_SUCCESS != * fr ?
-			* fr : HT_FR_FAIL_IO_FILE_R;
-		if (NULL != g)
-		{
-			free_game	(g);
-			g		= NULL;
-		}
+		(void) ht_line_keep(line);
 	}
+	free_ht_text	(text);
 	free_rread_info	(info);
 	return		g;
 }
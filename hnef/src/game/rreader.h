@@ -18,6 +18,8 @@
 #ifndef HT_RREADER_H
 #define HT_RREADER_H
 
+#include <stdio.h>		/* FILE */
+
 #include "funct.h"		/* HT_FR, HT_FAIL_RREADER */
 #include "gamet.h"		/* game */
 #include "iotextparset.h"	/* ht_line */
@@ -48,5 +50,56 @@ alloc_game_read (
 ;
 /*@=protoparamname@*/
 
+/*@-protoparamname@*/
+/*@null@*/
+/*@dependent@*/
+extern
+FILE *
+fopen_file_rc (
+/*@in@*/
+/*@notnull@*/
+	const char * const	file_rc,
+/*@in@*/
+/*@notnull@*/
+	enum HT_FR * const	fr
+	)
+#ifdef HT_POSIX
+/*@globals fileSystem, errno@*/
+#else
+/*@globals fileSystem@*/
+#endif
+/*@modifies fileSystem, * fr@*/
+#ifdef HT_POSIX
+/*@modifies errno@*/
+#endif
+;
+/*@=protoparamname@*/
+
+#ifdef HT_AI_MINIMAX
+
+/*@-protoparamname@*/
+extern
+enum HT_FR
+game_weights_read (
+/*@in@*/
+/*@notnull@*/
+	const char * const		file_weights,
+/*@in@*/
+/*@notnull@*/
+	struct ht_line * const		line,
+/*@in@*/
+/*@notnull@*/
+	struct game * const		g,
+/*@in@*/
+/*@notnull@*/
+	enum HT_FAIL_RREADER * const	fail_read
+	)
+/*@globals fileSystem, errno@*/
+/*@modifies fileSystem, errno, * line, * g, * fail_read@*/
+;
+/*@=protoparamname@*/
+
+#endif
+
 #endif
 
@@ -17,6 +17,11 @@
  */
 #include <stdlib.h>	/* malloc */
 
+#if defined(HT_POSIX) && !defined(__GNUC__)
+#include <pthread.h>	/* pthread_mutex_* */
+#endif
+
+#include "rng.h"		/* ht_rng_seed, ht_rng_next */
 #include "ruleset.h"
 #include "type_piece.h"		/* type_piece_init */
 #include "type_square.h"	/* type_square_init */
@@ -36,6 +41,17 @@ const unsigned short SIZE_BOARD_MAX = (unsigned short)31;
 static
 const unsigned short SIZE_BOARD_MIN = (unsigned short)1;
 
+const unsigned long HT_ZOBRIST_SEED_DEF	= 1ul;
+
+#if defined(HT_POSIX) && !defined(__GNUC__)
+/*
+ * Guards ruleset->refc when the compiler has no atomic builtins.
+ */
+/*@unchecked@*/
+static
+pthread_mutex_t ht_ruleset_refc_mutex	= PTHREAD_MUTEX_INITIALIZER;
+#endif
+
 /*
  * Returns HT_TRUE if board size (which may be width or height) is
  * allowed; false otherwise.
@@ -60,6 +76,16 @@ ruleset_initopt (
 
 	r->opt_blen	= (unsigned short)(r->bwidth * r->bheight);
 
+	r->opt_movec_max	= 0;
+	for (i = (unsigned short)0; i < r->opt_blen; i++)
+	{
+		if (HT_BIT_U8_EMPTY != r->pieces[i])
+		{
+			r->opt_movec_max += (size_t)(r->bwidth - 1)
+				+ (size_t)(r->bheight - 1);
+		}
+	}
+
 	r->opt_tp_dbl_trap = r->opt_tp_dbl_trap_capt =
 		r->opt_tp_dbl_trap_compl = r->opt_ts_capt_sides =
 		HT_BIT_U8_EMPTY;
@@ -146,6 +172,29 @@ ruleset_init (
 	r->opt_tp_dbl_trap_compl	= HT_BIT_U8_EMPTY;
 	r->opt_tp_escape		= HT_BIT_U8_EMPTY;
 	r->opt_ts_escape		= HT_BIT_U8_EMPTY;
+	r->opt_movec_max		= 0;
+}
+
+/*
+ * Generates r->opt_zobrist and r->opt_zobrist_turn from seed. Only
+ * allowed while r belongs to one game, since every board->key and
+ * moveh->key made before is wrong afterwards.
+ */
+void
+ruleset_zobrist_init (
+	struct ruleset * const HT_RSTR	r,
+	const unsigned long		seed
+	)
+{
+	const size_t	len	= (size_t)HT_TYPE_MAX * (size_t)r->opt_blen;
+	struct ht_rng	rng;
+	size_t		i;
+	ht_rng_seed(& rng, seed);
+	for (i = (size_t)0; i < len; i++)
+	{
+		r->opt_zobrist[i]	= ht_rng_next(& rng);
+	}
+	r->opt_zobrist_turn	= ht_rng_next(& rng);
 }
 
 /*
@@ -175,6 +224,10 @@ alloc_ruleset (
 	r->bheight	= bheight;
 	r->opt_blen	= blen;
 	r->path		= NULL;
+	r->id		= NULL;
+	r->name		= NULL;
+	r->hash		= NULL;
+	r->refc		= 1ul;
 
 	r->pieces	= malloc(sizeof(* r->pieces) * r->opt_blen);
 	if (NULL == r->pieces)
@@ -189,6 +242,16 @@ alloc_ruleset (
 		free	(r);
 		return NULL;
 	}
+	r->opt_zobrist	= malloc(sizeof(* r->opt_zobrist)
+			* HT_TYPE_MAX * r->opt_blen);
+	if (NULL == r->opt_zobrist)
+	{
+		free	(r->squares);
+		free	(r->pieces);
+		free	(r);
+		return NULL;
+	}
+	ruleset_zobrist_init(r, HT_ZOBRIST_SEED_DEF);
 
 	r->type_piecec	= 0;
 	r->type_squarec	= 0;
@@ -196,11 +259,51 @@ alloc_ruleset (
 	return r;
 }
 
+/*
+ * Adds a reference to r, for another game that plays by it, and
+ * returns r. With HT_POSIX, this may be done in any thread.
+ */
+struct ruleset *
+ruleset_ref (
+	struct ruleset * const r
+	)
+{
+#if defined(HT_POSIX) && defined(__GNUC__)
+	(void) __sync_add_and_fetch(& r->refc, 1ul);
+#elif defined(HT_POSIX)
+	(void) pthread_mutex_lock	(& ht_ruleset_refc_mutex);
+	r->refc++;
+	(void) pthread_mutex_unlock	(& ht_ruleset_refc_mutex);
+#else
+	r->refc++;
+#endif
+	return	r;
+}
+
+/*
+ * Removes a reference to r, and frees it if it was the last one.
+ */
 void
 free_ruleset (
 	struct ruleset * const r
 	)
 {
+	unsigned long refc;
+
+#if defined(HT_POSIX) && defined(__GNUC__)
+	refc	= __sync_sub_and_fetch(& r->refc, 1ul);
+#elif defined(HT_POSIX)
+	(void) pthread_mutex_lock	(& ht_ruleset_refc_mutex);
+	refc	= --r->refc;
+	(void) pthread_mutex_unlock	(& ht_ruleset_refc_mutex);
+#else
+	refc	= --r->refc;
+#endif
+	if (refc > 0ul)
+	{
+		return;
+	}
+
 	if (NULL != r->squares)
 	{
 		free	(r->squares);
@@ -209,10 +312,26 @@ free_ruleset (
 	{
 		free	(r->pieces);
 	}
+	if (NULL != r->opt_zobrist)
+	{
+		free	(r->opt_zobrist);
+	}
 	if (NULL != r->path)
 	{
 		free	(r->path);
 	}
+	if (NULL != r->id)
+	{
+		free	(r->id);
+	}
+	if (NULL != r->name)
+	{
+		free	(r->name);
+	}
+	if (NULL != r->hash)
+	{
+		free	(r->hash);
+	}
 	free	(r);
 }
 
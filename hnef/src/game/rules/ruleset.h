@@ -22,6 +22,14 @@
 #include "config.h"	/* HT_RSTR */
 #include "rulesett.h"	/* ruleset */
 
+/*
+ * Default seed of ruleset->opt_zobrist, and of
+ * zhashconf->zobrist_seed.
+ */
+/*@unchecked@*/
+extern
+const unsigned long HT_ZOBRIST_SEED_DEF;
+
 extern
 HT_BOOL
 valid_size (
@@ -66,6 +74,32 @@ alloc_ruleset (
 /*@modifies nothing@*/
 ;
 
+/*@-protoparamname@*/
+extern
+void
+ruleset_zobrist_init (
+/*@in@*/
+/*@notnull@*/
+	struct ruleset * const HT_RSTR	r,
+	const unsigned long		seed
+	)
+/*@modifies * r@*/
+;
+/*@=protoparamname@*/
+
+/*@-protoparamname@*/
+extern
+struct ruleset *
+ruleset_ref (
+/*@in@*/
+/*@notnull@*/
+/*@returned@*/
+	struct ruleset * const r
+	)
+/*@modifies r->refc@*/
+;
+/*@=protoparamname@*/
+
 /*@-protoparamname@*/
 extern
 void
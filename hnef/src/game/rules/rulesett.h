@@ -19,6 +19,7 @@
 #define HT_RULESET_T_H
 
 #include "boardt.h"		/* HT_BIT_U8 */
+#include "rngt.h"		/* HT_U64 */
 #include "type_piecet.h"	/* type_piece */
 #include "type_squaret.h"	/* type_square */
 #include "types.h"		/* HT_TYPE_MAX */
@@ -27,6 +28,11 @@
  * The length of the pieces and squares arrays is, in both cases,
  * bwidth * bheight. This is also the length of the pieces array in
  * board.
+ *
+ * A ruleset is read once, and may then be shared by any number of
+ * games (see alloc_game_share), also in other threads. Once it's
+ * shared, nothing in it but refc may change, so it's read without
+ * locking.
  */
 /*@exposed@*/
 struct ruleset
@@ -39,8 +45,15 @@ struct ruleset
 /*@owned@*/
 	char *		path,
 	* id,
-	* name,
-	* hash;
+	* name;
+
+	/*
+	 * Fingerprint of the ruleset file's contents, in HT_FNV_HEX_LEN
+	 * hexadecimal digits. NULL until the file has been read.
+	 */
+/*@null@*/
+/*@owned@*/
+	char *		hash;
 
 	/*
 	 * true if repetition is forbidden.
@@ -183,6 +196,40 @@ struct ruleset
 	 */
 	HT_BIT_U8		opt_ts_escape;
 
+	/*
+	 * Optimization.
+	 *
+	 * Most moves that a player can ever have: every piece on the
+	 * initial board, moving to every other square on its row and
+	 * column. Pieces are never added, so no position has more.
+	 */
+	size_t			opt_movec_max;
+
+	/*
+	 * Zobrist numbers of board->key, indexed by
+	 * type_index_get(piece) * opt_blen + position. The length is
+	 * HT_TYPE_MAX * opt_blen.
+	 *
+	 * They're generated from zhashconf->zobrist_seed (see
+	 * ruleset_zobrist_init), since board->key is also the key of
+	 * the transposition table, which may be saved.
+	 */
+/*@notnull@*/
+/*@owned@*/
+	HT_U64 *		opt_zobrist;
+
+	/*
+	 * Zobrist number of board->key for player 1 to move.
+	 */
+	HT_U64			opt_zobrist_turn;
+
+	/*
+	 * Amount of games that play by the ruleset. It's freed when the
+	 * last one frees it (free_ruleset). Only changed by ruleset_ref
+	 * and free_ruleset.
+	 */
+	unsigned long		refc;
+
 };
 
 #endif
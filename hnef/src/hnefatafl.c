@@ -0,0 +1,400 @@
+/* Copyright 2013 Alexander Söderlund.
+ *
+ * This file is part of HNEFATAFL.
+ *
+ * HNEFATAFL is free software: you can distribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * HNEFATAFL is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef HT_UI_MSQU
+
+/*
+ * Native entry point. HT_UI_MSQU builds are started by the browser
+ * instead (see ppapi_main.c).
+ */
+
+#include <stdio.h>	/* fputs, fputc, stderr */
+#include <stdlib.h>	/* EXIT_*, malloc, free */
+
+#ifdef HT_AI_MINIMAX
+#include "batch.h"		/* batch_run */
+#include "bench.h"		/* bench_run */
+#endif
+#include "func.h"		/* HT_FR */
+#include "game.h"		/* game_board_reset, free_game */
+#include "invoc.h"		/* invoc_read */
+#include "iogen.h"		/* print_err_*, print_inv* */
+#include "iotextparse.h"	/* alloc_ht_line, free_ht_line */
+#include "rcache.h"		/* alloc_game_rcache */
+#include "rvalid.h"		/* ruleset_valid */
+#ifdef HT_AI_MINIMAX
+#include "serve.h"		/* serve_run */
+#include "tourn.h"		/* tourn_run */
+#include "tune.h"		/* tune_run */
+#endif
+#ifdef HT_UI_CLI
+#include "uic.h"		/* uic_* */
+#endif
+#ifdef HT_UI_ENGINE
+#include "uie.h"		/* uie_* */
+#endif
+#ifdef HT_UI_XLIB
+#include "uix.h"		/* uix_* */
+#endif
+
+#ifdef HT_UI_CLI
+
+static
+enum HT_FR
+play_uic (
+/*@in@*/
+/*@notnull@*/
+	struct game * const	g
+	)
+/*@globals internalState, fileSystem, errno, stdout, stdin@*/
+/*@modifies internalState, fileSystem, errno, stdout, stdin, * g@*/
+{
+	enum HT_FR		fr	= HT_FR_NONE;
+	HT_BOOL			again	= HT_FALSE;
+	struct ui		interf;
+	interf.type			= HT_UIT_CLI;
+	interf.data.ui_c		= alloc_uic(g);
+	if (NULL == interf.data.ui_c)
+	{
+		return	HT_FR_FAIL_ALLOC;
+	}
+
+	fr	= uic_init(g, interf.data.ui_c);
+	if (HT_FR_SUCCESS != fr)
+	{
+		free_uic	(interf.data.ui_c);
+		return		fr;
+	}
+
+	do
+	{
+		fr	= uic_play_new(g, & interf);
+		if (HT_FR_SUCCESS != fr)
+		{
+			free_uic	(interf.data.ui_c);
+			return		fr;
+		}
+		fr	= uic_play_again(g, interf.data.ui_c, & again);
+		if (HT_FR_SUCCESS != fr)
+		{
+			free_uic	(interf.data.ui_c);
+			return		fr;
+		}
+	} while (again);
+
+	free_uic	(interf.data.ui_c);
+	return		HT_FR_SUCCESS;
+}
+
+#endif /* HT_UI_CLI */
+
+#ifdef HT_UI_ENGINE
+
+static
+enum HT_FR
+play_uie (
+/*@in@*/
+/*@notnull@*/
+	struct game * const	g
+	)
+/*@globals internalState, fileSystem, errno, stdout, stdin@*/
+/*@modifies internalState, fileSystem, errno, stdout, stdin, * g@*/
+{
+	enum HT_FR		fr	= HT_FR_NONE;
+	HT_BOOL			again	= HT_FALSE;
+	struct ui		interf;
+	interf.type			= HT_UIT_ENGINE;
+	interf.data.ui_e		= alloc_uie(g);
+	if (NULL == interf.data.ui_e)
+	{
+		return	HT_FR_FAIL_ALLOC;
+	}
+
+	fr	= uie_init(g, interf.data.ui_e);
+	if (HT_FR_SUCCESS != fr)
+	{
+		free_uie	(interf.data.ui_e);
+		return		fr;
+	}
+
+	do
+	{
+		fr	= uie_play_new(g, & interf);
+		if (HT_FR_SUCCESS != fr)
+		{
+			free_uie	(interf.data.ui_e);
+			return		fr;
+		}
+		fr	= uie_play_again(g, interf.data.ui_e, & again);
+		if (HT_FR_SUCCESS != fr)
+		{
+			free_uie	(interf.data.ui_e);
+			return		fr;
+		}
+	} while (again);
+
+	free_uie	(interf.data.ui_e);
+	return		HT_FR_SUCCESS;
+}
+
+#endif /* HT_UI_ENGINE */
+
+#ifdef HT_UI_XLIB
+
+static
+enum HT_FR
+play_uix (
+/*@in@*/
+/*@notnull@*/
+	struct game * const	g
+	)
+/*@globals internalState, fileSystem, errno, stdout@*/
+/*@modifies internalState, fileSystem, errno, stdout, * g@*/
+{
+	enum HT_FR		fr	= HT_FR_NONE;
+	HT_BOOL			again	= HT_FALSE;
+	struct ui		interf;
+	interf.type			= HT_UIT_XLIB;
+	interf.data.ui_x		= alloc_uix(g);
+	if (NULL == interf.data.ui_x)
+	{
+		return	HT_FR_FAIL_ALLOC;
+	}
+
+	fr	= uix_init(g, interf.data.ui_x);
+	if (HT_FR_SUCCESS != fr)
+	{
+		free_uix	(interf.data.ui_x);
+		return		fr;
+	}
+
+	do
+	{
+		fr	= uix_play_new(g, & interf);
+		if (HT_FR_SUCCESS != fr)
+		{
+			free_uix	(interf.data.ui_x);
+			return		fr;
+		}
+		fr	= uix_play_again(g, interf.data.ui_x, & again);
+		if (HT_FR_SUCCESS != fr)
+		{
+			free_uix	(interf.data.ui_x);
+			return		fr;
+		}
+	} while (again);
+
+	free_uix	(interf.data.ui_x);
+	return		HT_FR_SUCCESS;
+}
+
+#endif /* HT_UI_XLIB */
+
+/*
+ * Reads the RC file given by inv and plays with the interface given by
+ * inv, until the user quits.
+ */
+static
+enum HT_FR
+play (
+/*@in@*/
+/*@notnull@*/
+	const struct invoc * const	inv
+	)
+/*@globals internalState, fileSystem, errno, stdout, stderr, stdin@*/
+/*@modifies internalState, fileSystem, errno, stdout, stderr, stdin@*/
+{
+	enum HT_FR		fr		= HT_FR_NONE;
+	enum HT_FAIL_RREADER	fail_read	= HT_FAIL_RREADER_NONE;
+	struct game *		g		= NULL;
+	struct ht_line *	line		= NULL;
+	HT_BOOL			valid		= HT_FALSE;
+
+	line	= alloc_ht_line((size_t)3, (size_t)18);
+	if (NULL == line)
+	{
+		return	HT_FR_FAIL_ALLOC;
+	}
+
+	/*
+	 * Also calls game_initopt.
+	 */
+	g	= alloc_game_rcache(inv->file_rc, inv->file_rcache,
+		line, & fr, & fail_read, & valid);
+	if (HT_FR_SUCCESS != fr || NULL == g)
+	{
+		(void) print_err_fr_rreader(stderr, fr, fail_read,
+			line);
+		if (NULL != g)
+		{
+			free_game	(g);
+		}
+		free_ht_line	(line);
+		/*
+		 * Already printed.
+		 */
+		return		HT_FR_FAIL_RREADER;
+	}
+	free_ht_line	(line);
+
+	fr	= HT_FR_SUCCESS;
+#ifdef HT_AI_MINIMAX_HASH
+	if (inv->zobrist_seed_set)
+	{
+		fr	= game_zobrist_seed(g, inv->zobrist_seed);
+	}
+	if (inv->hash_mem_set)
+	{
+		g->hash_conf.mem_tab		= inv->hash_mem;
+	}
+	g->hash_conf.file	= inv->hash_file;
+#endif
+
+	if (HT_FR_SUCCESS == fr)
+	{
+		fr	= game_board_reset(g);
+	}
+	if (HT_FR_SUCCESS != fr)
+	{
+		free_game	(g);
+		return		fr;
+	}
+
+	if (!valid)
+	{
+		const char * const rvalid_why	= ruleset_valid(g);
+		if (NULL != rvalid_why)
+		{
+			(void) fputs	(rvalid_why,	stderr);
+			(void) fputc	('\n',		stderr);
+			free_game	(g);
+			return		HT_FR_FAIL_RREADER;
+		}
+	}
+
+#ifdef HT_UI_CLI
+	if (HT_UIT_CLI == inv->info.play_ui)
+	{
+		fr	= play_uic(g);
+	}
+	else
+#endif
+#ifdef HT_UI_XLIB
+	if (HT_UIT_XLIB == inv->info.play_ui)
+	{
+		fr	= play_uix(g);
+	}
+	else
+#endif
+#ifdef HT_UI_ENGINE
+	if (HT_UIT_ENGINE == inv->info.play_ui)
+	{
+		fr	= play_uie(g);
+	}
+	else
+#endif
+	{
+		fr	= HT_FR_FAIL_UI_NONE;
+	}
+
+#ifdef HT_AI_MINIMAX_HASH
+	if (HT_FR_SUCCESS == fr)
+	{
+		fr	= game_hash_save(g);
+	}
+#endif
+
+	free_game	(g);
+	return		fr;
+}
+
+int
+main (
+	int	argc,
+	char *	argv[]
+	)
+{
+	enum HT_FR		fr		= HT_FR_NONE;
+	enum HT_FAIL_INVOC	fail_invoc	= HT_FAIL_INVOC_NONE;
+	struct invoc * const	inv		= malloc(sizeof(* inv));
+
+	if (NULL == inv)
+	{
+		(void) print_err_fr	(stderr, HT_FR_FAIL_ALLOC);
+		return			EXIT_FAILURE;
+	}
+
+	fr	= invoc_read((size_t)argc, (const char * const *)argv,
+		inv, & fail_invoc);
+	if (HT_FR_SUCCESS != fr)
+	{
+		free				(inv);
+		(void) print_err_fr_invoc	(fr, fail_invoc);
+		(void) print_inv_help		(HT_TRUE);
+		return				EXIT_FAILURE;
+	}
+
+	if (!inv->play)
+	{
+#ifdef HT_AI_MINIMAX
+		if (HT_INV_PRINT_BENCH == inv->info.nplay_print)
+		{
+			fr	= bench_run(inv);
+		}
+		else if (HT_INV_PRINT_TUNE == inv->info.nplay_print)
+		{
+			fr	= tune_run(inv);
+		}
+		else if (HT_INV_PRINT_TOURN == inv->info.nplay_print)
+		{
+			fr	= tourn_run(inv);
+		}
+		else if (HT_INV_PRINT_BATCH == inv->info.nplay_print)
+		{
+			fr	= batch_run(inv);
+		}
+		else if (HT_INV_PRINT_SERVE == inv->info.nplay_print)
+		{
+			fr	= serve_run(inv);
+		}
+		else
+#endif
+		{
+			fr	= print_inv(inv->info.nplay_print);
+		}
+	}
+	else
+	{
+		fr	= play(inv);
+	}
+	free	(inv);
+
+	if (HT_FR_SUCCESS != fr)
+	{
+		/*
+		 * HT_FR_FAIL_RREADER has already been printed.
+		 */
+		if (HT_FR_FAIL_RREADER != fr)
+		{
+			(void) print_err_fr	(stderr, fr);
+		}
+		return	EXIT_FAILURE;
+	}
+	return	EXIT_SUCCESS;
+}
+
+#endif /* HT_UI_MSQU */
@@ -21,8 +21,24 @@
 #include "config.h"	/* HT_RSTR */
 #include "lang.h"	/* HT_L_* */
 #include "invoc.h"
+#ifdef HT_AI_MINIMAX_HASH
+#include "aimhash.h"	/* zhash_mem_mib */
+#endif
+#ifdef HT_AI_MINIMAX
+#include "num.h"	/* texttoushort, texttoulong */
+#endif
 #include "ui.h"		/* ui_def */
 
+#ifdef HT_AI_MINIMAX
+/*
+ * Default value for invoc.dir_bench.
+ */
+/*@observer@*/
+/*@unchecked@*/
+static
+const char * const HT_BENCH_DIR_DEF	= "rules";
+#endif
+
 /*
  * Helper for invoc_read to read inv->info.ui argument. i is the
  * position in argv where the next argument is expected to be, but i may
@@ -38,7 +54,7 @@ invoc_read_ui (
 /*@in@*/
 /*@notnull@*/
 /*@observer@*/
-	const char * *				argv,
+	const char * const *			argv,
 /*@in@*/
 /*@notnull@*/
 	struct invoc * const HT_RSTR		inv,
@@ -95,6 +111,13 @@ invoc_read_ui (
 			inv->info.play_ui	= HT_UIT_MSQU;
 		}
 		else
+#endif
+#ifdef HT_UI_ENGINE
+		if (HT_L_INV_S_UI_ENGINE == uisym)
+		{
+			inv->info.play_ui	= HT_UIT_ENGINE;
+		}
+		else
 #endif
 		{
 			* invfail		= HT_FAIL_INVOC_UI_UNK;
@@ -123,7 +146,7 @@ invoc_read_rc (
 /*@in@*/
 /*@notnull@*/
 /*@observer@*/
-	const char * *				argv,
+	const char * const *			argv,
 /*@in@*/
 /*@notnull@*/
 	struct invoc * const HT_RSTR		inv,
@@ -169,6 +192,374 @@ invoc_read_rc (
 	}
 }
 
+/*
+ * Helper for invoc_read to read inv->file_rcache argument. i is the
+ * position in argv where the next argument is expected to be, but i may
+ * be out of bounds (exceed argc).
+ *
+ * inv->file_rcache is non-NULL upon success, or NULL upon failure.
+ */
+static
+enum HT_FR
+invoc_read_rcache (
+	const size_t				argc,
+/*@in@*/
+/*@notnull@*/
+/*@observer@*/
+	const char * const *			argv,
+/*@in@*/
+/*@notnull@*/
+	struct invoc * const HT_RSTR		inv,
+	const size_t				i,
+/*@in@*/
+/*@notnull@*/
+	enum HT_FAIL_INVOC * const HT_RSTR	invfail
+	)
+/*@modifies inv->file_rcache, * invfail@*/
+{
+	inv->file_rcache	= NULL;
+
+	if (i < argc && strlen(argv[i]) > (size_t)0)
+	{
+		inv->file_rcache	= argv[i];
+		return			HT_FR_SUCCESS;
+	}
+	else
+	{
+		* invfail	= HT_FAIL_INVOC_RCACHE;
+		return		HT_FR_FAIL_INVOC;
+	}
+}
+
+#ifdef HT_AI_MINIMAX_HASH
+
+/*
+ * Helper for invoc_read to read inv->zobrist_seed argument. i is the
+ * position in argv where the next argument is expected to be, but i may
+ * be out of bounds (exceed argc).
+ *
+ * inv->zobrist_seed_set is true upon success, or false upon failure.
+ */
+static
+enum HT_FR
+invoc_read_seed (
+	const size_t				argc,
+/*@in@*/
+/*@notnull@*/
+/*@observer@*/
+	const char * const *			argv,
+/*@in@*/
+/*@notnull@*/
+	struct invoc * const HT_RSTR		inv,
+	const size_t				i,
+/*@in@*/
+/*@notnull@*/
+	enum HT_FAIL_INVOC * const HT_RSTR	invfail
+	)
+/*@globals errno@*/
+/*@modifies errno, inv->zobrist_seed, inv->zobrist_seed_set@*/
+/*@modifies * invfail@*/
+{
+	inv->zobrist_seed_set	= HT_FALSE;
+
+	if (i < argc && texttoulong(argv[i], & inv->zobrist_seed))
+	{
+		inv->zobrist_seed_set	= HT_TRUE;
+		return			HT_FR_SUCCESS;
+	}
+	else
+	{
+		* invfail	= HT_FAIL_INVOC_SEED;
+		return		HT_FR_FAIL_INVOC;
+	}
+}
+
+/*
+ * Helper for invoc_read to read inv->hash_mem argument, which is given
+ * in MiB. i is the position in argv where the next argument is expected
+ * to be, but i may be out of bounds (exceed argc).
+ *
+ * inv->hash_mem_set is true upon success, or false upon failure.
+ */
+static
+enum HT_FR
+invoc_read_hashmem (
+	const size_t				argc,
+/*@in@*/
+/*@notnull@*/
+/*@observer@*/
+	const char * const *			argv,
+/*@in@*/
+/*@notnull@*/
+	struct invoc * const HT_RSTR		inv,
+	const size_t				i,
+/*@in@*/
+/*@notnull@*/
+	enum HT_FAIL_INVOC * const HT_RSTR	invfail
+	)
+/*@globals errno@*/
+/*@modifies errno, inv->hash_mem, inv->hash_mem_set, * invfail@*/
+{
+	unsigned long mib;
+
+	inv->hash_mem_set	= HT_FALSE;
+
+	if (i < argc && texttoulong(argv[i], & mib)
+	&& zhash_mem_mib(mib, & inv->hash_mem))
+	{
+		inv->hash_mem_set	= HT_TRUE;
+		return			HT_FR_SUCCESS;
+	}
+	else
+	{
+		* invfail	= HT_FAIL_INVOC_HASHMEM;
+		return		HT_FR_FAIL_INVOC;
+	}
+}
+
+/*
+ * Helper for invoc_read to read inv->hash_file argument. i is the
+ * position in argv where the next argument is expected to be, but i may
+ * be out of bounds (exceed argc).
+ *
+ * inv->hash_file is non-NULL upon success, or NULL upon failure.
+ */
+static
+enum HT_FR
+invoc_read_hashfile (
+	const size_t				argc,
+/*@in@*/
+/*@notnull@*/
+/*@observer@*/
+	const char * const *			argv,
+/*@in@*/
+/*@notnull@*/
+	struct invoc * const HT_RSTR		inv,
+	const size_t				i,
+/*@in@*/
+/*@notnull@*/
+	enum HT_FAIL_INVOC * const HT_RSTR	invfail
+	)
+/*@modifies inv->hash_file, * invfail@*/
+{
+	inv->hash_file	= NULL;
+
+	if (i < argc && strlen(argv[i]) > (size_t)0)
+	{
+		inv->hash_file	= argv[i];
+		return		HT_FR_SUCCESS;
+	}
+	else
+	{
+		* invfail	= HT_FAIL_INVOC_HASHFILE;
+		return		HT_FR_FAIL_INVOC;
+	}
+}
+
+#endif /* HT_AI_MINIMAX_HASH */
+
+#ifdef HT_AI_MINIMAX
+
+/*
+ * Helper for invoc_read to read the optional inv->dir_bench argument.
+ * i is the position in argv where the next argument may be, but i may
+ * be out of bounds (exceed argc).
+ *
+ * The argument is only consumed (and i advanced) if it does not look
+ * like another invocation switch. Else inv->dir_bench is left as
+ * HT_BENCH_DIR_DEF.
+ */
+static
+void
+invoc_read_bench (
+	const size_t				argc,
+/*@in@*/
+/*@notnull@*/
+/*@observer@*/
+	const char * const *			argv,
+/*@in@*/
+/*@notnull@*/
+	struct invoc * const HT_RSTR		inv,
+/*@notnull@*/
+	size_t * const HT_RSTR			i
+	)
+/*@modifies inv->dir_bench, * i@*/
+{
+	inv->dir_bench	= HT_BENCH_DIR_DEF;
+
+	if (* i + 1 < argc)
+	{
+		const char * const argn	= argv[* i + 1];
+		if (strlen(argn) > (size_t)0 && '-' != argn[0])
+		{
+			inv->dir_bench	= argn;
+			(* i)++;
+		}
+	}
+}
+
+/*
+ * Helper for invoc_read to read inv->file_tune argument. i is the
+ * position in argv where the next argument is expected to be, but i may
+ * be out of bounds (exceed argc).
+ *
+ * inv->file_tune is non-NULL upon success, or NULL upon failure.
+ */
+static
+enum HT_FR
+invoc_read_tune (
+	const size_t				argc,
+/*@in@*/
+/*@notnull@*/
+/*@observer@*/
+	const char * const *			argv,
+/*@in@*/
+/*@notnull@*/
+	struct invoc * const HT_RSTR		inv,
+	const size_t				i,
+/*@in@*/
+/*@notnull@*/
+	enum HT_FAIL_INVOC * const HT_RSTR	invfail
+	)
+/*@modifies inv->file_tune, * invfail@*/
+{
+	inv->file_tune	= NULL;
+
+	if (i < argc && strlen(argv[i]) > (size_t)0)
+	{
+		inv->file_tune	= argv[i];
+		return		HT_FR_SUCCESS;
+	}
+	else
+	{
+		* invfail	= HT_FAIL_INVOC_TUNE;
+		return		HT_FR_FAIL_INVOC;
+	}
+}
+
+/*
+ * Helper for invoc_read to read inv->file_tourn argument. i is the
+ * position in argv where the next argument is expected to be, but i may
+ * be out of bounds (exceed argc).
+ *
+ * inv->file_tourn is non-NULL upon success, or NULL upon failure.
+ */
+static
+enum HT_FR
+invoc_read_tourn (
+	const size_t				argc,
+/*@in@*/
+/*@notnull@*/
+/*@observer@*/
+	const char * const *			argv,
+/*@in@*/
+/*@notnull@*/
+	struct invoc * const HT_RSTR		inv,
+	const size_t				i,
+/*@in@*/
+/*@notnull@*/
+	enum HT_FAIL_INVOC * const HT_RSTR	invfail
+	)
+/*@modifies inv->file_tourn, * invfail@*/
+{
+	inv->file_tourn	= NULL;
+
+	if (i < argc && strlen(argv[i]) > (size_t)0)
+	{
+		inv->file_tourn	= argv[i];
+		return		HT_FR_SUCCESS;
+	}
+	else
+	{
+		* invfail	= HT_FAIL_INVOC_TOURN;
+		return		HT_FR_FAIL_INVOC;
+	}
+}
+
+/*
+ * Helper for invoc_read to read inv->file_batch argument. i is the
+ * position in argv where the next argument is expected to be, but i may
+ * be out of bounds (exceed argc).
+ *
+ * inv->file_batch is non-NULL upon success, or NULL upon failure.
+ */
+static
+enum HT_FR
+invoc_read_batch (
+	const size_t				argc,
+/*@in@*/
+/*@notnull@*/
+/*@observer@*/
+	const char * const *			argv,
+/*@in@*/
+/*@notnull@*/
+	struct invoc * const HT_RSTR		inv,
+	const size_t				i,
+/*@in@*/
+/*@notnull@*/
+	enum HT_FAIL_INVOC * const HT_RSTR	invfail
+	)
+/*@modifies inv->file_batch, * invfail@*/
+{
+	inv->file_batch	= NULL;
+
+	if (i < argc && strlen(argv[i]) > (size_t)0)
+	{
+		inv->file_batch	= argv[i];
+		return		HT_FR_SUCCESS;
+	}
+	else
+	{
+		* invfail	= HT_FAIL_INVOC_BATCH;
+		return		HT_FR_FAIL_INVOC;
+	}
+}
+
+/*
+ * Helper for invoc_read to read the optional inv->serve_threads
+ * argument. If the next argument (argv[* i + 1]) exists and doesn't
+ * start with '-', it's the amount of threads, and i is advanced past
+ * it. Else inv->serve_threads is left as 0.
+ */
+static
+enum HT_FR
+invoc_read_serve (
+	const size_t				argc,
+/*@in@*/
+/*@notnull@*/
+/*@observer@*/
+	const char * const *			argv,
+/*@in@*/
+/*@notnull@*/
+	struct invoc * const HT_RSTR		inv,
+/*@notnull@*/
+	size_t * const HT_RSTR			i,
+/*@in@*/
+/*@notnull@*/
+	enum HT_FAIL_INVOC * const HT_RSTR	invfail
+	)
+/*@modifies inv->serve_threads, * i, * invfail@*/
+{
+	inv->serve_threads	= (unsigned short)0;
+
+	if (* i + 1 < argc)
+	{
+		const char * const argn	= argv[* i + 1];
+		if (strlen(argn) > (size_t)0 && '-' != argn[0])
+		{
+			if (!texttoushort(argn, & inv->serve_threads))
+			{
+				* invfail	= HT_FAIL_INVOC_SERVE;
+				return		HT_FR_FAIL_INVOC;
+			}
+			(* i)++;
+		}
+	}
+	return	HT_FR_SUCCESS;
+}
+
+#endif /* HT_AI_MINIMAX */
+
 /*
  * Helper for invoc_read. Reads a switch (argv[i]).
  *
@@ -185,7 +576,7 @@ invoc_read_arg (
 /*@in@*/
 /*@notnull@*/
 /*@observer@*/
-	const char * *			argv,
+	const char * const *		argv,
 /*@in@*/
 /*@notnull@*/
 	struct invoc * const		inv,
@@ -229,6 +620,70 @@ invoc_read_arg (
 		inv->info.nplay_print	= HT_INV_PRINT_VERSION;
 		inv->play		= HT_FALSE;
 	}
+#ifdef HT_AI_MINIMAX
+	else if (HT_L_INV_S_BENCH == argsw)
+	{
+		inv->info.nplay_print	= HT_INV_PRINT_BENCH;
+		inv->play		= HT_FALSE;
+		invoc_read_bench(argc, argv, inv, i);
+	}
+	else if (HT_L_INV_S_TUNE == argsw)
+	{
+		const enum HT_FR fr = invoc_read_tune(argc, argv, inv,
+			++(* i), invfail);
+		if (HT_FR_SUCCESS != fr)
+		{
+			/*
+			 * invfail is set.
+			 */
+			return fr;
+		}
+		inv->info.nplay_print	= HT_INV_PRINT_TUNE;
+		inv->play		= HT_FALSE;
+	}
+	else if (HT_L_INV_S_TOURN == argsw)
+	{
+		const enum HT_FR fr = invoc_read_tourn(argc, argv, inv,
+			++(* i), invfail);
+		if (HT_FR_SUCCESS != fr)
+		{
+			/*
+			 * invfail is set.
+			 */
+			return fr;
+		}
+		inv->info.nplay_print	= HT_INV_PRINT_TOURN;
+		inv->play		= HT_FALSE;
+	}
+	else if (HT_L_INV_S_BATCH == argsw)
+	{
+		const enum HT_FR fr = invoc_read_batch(argc, argv, inv,
+			++(* i), invfail);
+		if (HT_FR_SUCCESS != fr)
+		{
+			/*
+			 * invfail is set.
+			 */
+			return fr;
+		}
+		inv->info.nplay_print	= HT_INV_PRINT_BATCH;
+		inv->play		= HT_FALSE;
+	}
+	else if (HT_L_INV_S_SERVE == argsw)
+	{
+		const enum HT_FR fr = invoc_read_serve(argc, argv, inv,
+			i, invfail);
+		if (HT_FR_SUCCESS != fr)
+		{
+			/*
+			 * invfail is set.
+			 */
+			return fr;
+		}
+		inv->info.nplay_print	= HT_INV_PRINT_SERVE;
+		inv->play		= HT_FALSE;
+	}
+#endif
 	else if (HT_L_INV_S_UI == argsw)
 	{
 		/*
@@ -244,6 +699,44 @@ invoc_read_arg (
 			return fr;
 		}
 	}
+#ifdef HT_AI_MINIMAX_HASH
+	else if (HT_L_INV_S_SEED == argsw)
+	{
+		const enum HT_FR fr = invoc_read_seed(argc, argv, inv,
+			++(* i), invfail);
+		if (HT_FR_SUCCESS != fr)
+		{
+			/*
+			 * invfail is set.
+			 */
+			return fr;
+		}
+	}
+	else if (HT_L_INV_S_HASHMEM == argsw)
+	{
+		const enum HT_FR fr = invoc_read_hashmem(argc, argv, inv,
+			++(* i), invfail);
+		if (HT_FR_SUCCESS != fr)
+		{
+			/*
+			 * invfail is set.
+			 */
+			return fr;
+		}
+	}
+	else if (HT_L_INV_S_HASHFILE == argsw)
+	{
+		const enum HT_FR fr = invoc_read_hashfile(argc, argv, inv,
+			++(* i), invfail);
+		if (HT_FR_SUCCESS != fr)
+		{
+			/*
+			 * invfail is set.
+			 */
+			return fr;
+		}
+	}
+#endif
 	else if (HT_L_INV_S_RUNCOM == argsw)
 	{
 		/*
@@ -259,6 +752,18 @@ invoc_read_arg (
 			return fr;
 		}
 	}
+	else if (HT_L_INV_S_RCACHE == argsw)
+	{
+		const enum HT_FR fr = invoc_read_rcache(argc, argv, inv,
+			++(* i), invfail);
+		if (HT_FR_SUCCESS != fr)
+		{
+			/*
+			 * invfail is set.
+			 */
+			return fr;
+		}
+	}
 	else
 	{
 		* invfail	= HT_FAIL_INVOC_UNK;
@@ -293,7 +798,7 @@ invoc_read_arg (
 enum HT_FR
 invoc_read (
 	const size_t			argc,
-	const char * *			argv,
+	const char * const *		argv,
 	struct invoc * const		inv,
 	enum HT_FAIL_INVOC * const	invfail
 	)
@@ -308,6 +813,19 @@ invoc_read (
 		{
 			inv->info.nplay_print	= HT_INV_PRINT_HELP;
 			inv->file_rc		= "";
+			inv->file_rcache	= NULL;
+#ifdef HT_AI_MINIMAX
+			inv->dir_bench		= HT_BENCH_DIR_DEF;
+			inv->file_tune		= NULL;
+			inv->file_tourn		= NULL;
+			inv->file_batch		= NULL;
+			inv->serve_threads	= (unsigned short)0;
+#endif
+#ifdef HT_AI_MINIMAX_HASH
+			inv->zobrist_seed_set	= HT_FALSE;
+			inv->hash_mem_set	= HT_FALSE;
+			inv->hash_file		= NULL;
+#endif
 			inv->play		= HT_FALSE;
 		}
 		return HT_FR_FAIL_NULLPTR;
@@ -321,6 +839,21 @@ invoc_read (
 	* invfail		= HT_FAIL_INVOC_NONE;
 	inv->info.nplay_print	= HT_INV_PRINT_HELP;
 	inv->file_rc		= "";
+	inv->file_rcache	= NULL;
+#ifdef HT_AI_MINIMAX
+	inv->dir_bench		= HT_BENCH_DIR_DEF;
+	inv->file_tune		= NULL;
+	inv->file_tourn		= NULL;
+	inv->file_batch		= NULL;
+	inv->serve_threads	= (unsigned short)0;
+#endif
+#ifdef HT_AI_MINIMAX_HASH
+	inv->zobrist_seed	= 0;
+	inv->zobrist_seed_set	= HT_FALSE;
+	inv->hash_mem		= HT_ZHASH_MEM_TAB_DEF;
+	inv->hash_mem_set	= HT_FALSE;
+	inv->hash_file		= NULL;
+#endif
 	inv->play		= HT_TRUE;
 
 	for (i = (size_t)1; i < argc && inv->play; i++)
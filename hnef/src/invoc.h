@@ -29,7 +29,7 @@ invoc_read (
 /*@in@*/
 /*@notnull@*/
 /*@observer@*/
-	const char * *,
+	const char * const *,
 /*@notnull@*/
 /*@partial@*/
 	struct invoc * const		inv,
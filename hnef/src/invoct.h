@@ -42,6 +42,39 @@ enum HT_INV_PRINT
 	 */
 	HT_INV_PRINT_VERSION
 
+#ifdef HT_AI_MINIMAX
+	,
+	/*
+	 * Run the search benchmark and print its results.
+	 * HT_L_INV_S_BENCH
+	 */
+	HT_INV_PRINT_BENCH,
+
+	/*
+	 * Tune the evaluation weights and print them.
+	 * HT_L_INV_S_TUNE
+	 */
+	HT_INV_PRINT_TUNE,
+
+	/*
+	 * Play a tournament between two computer players and print its
+	 * results. HT_L_INV_S_TOURN
+	 */
+	HT_INV_PRINT_TOURN,
+
+	/*
+	 * Analyze the positions in game records and print the best
+	 * moves. HT_L_INV_S_BATCH
+	 */
+	HT_INV_PRINT_BATCH,
+
+	/*
+	 * Host games for clients on stdin and stdout, with a pool of
+	 * threads for the computer players. HT_L_INV_S_SERVE
+	 */
+	HT_INV_PRINT_SERVE
+#endif
+
 };
 
 /*
@@ -78,6 +111,83 @@ struct invoc
 /*@notnull@*/
 /*@exposed@*/
 	const char *	file_rc;
+	/*
+	 * Pointer to one of the argv strings in main, or NULL. File with
+	 * the compiled ruleset, which is loaded instead of reading
+	 * file_rc if it was saved from the same file (see
+	 * alloc_game_rcache).
+	 */
+/*@null@*/
+/*@exposed@*/
+	const char *	file_rcache;
+
+#ifdef HT_AI_MINIMAX
+	/*
+	 * Pointer to one of the argv strings in main, or to
+	 * HT_BENCH_DIR_DEF. Directory containing the ruleset files that
+	 * are used by HT_INV_PRINT_BENCH.
+	 *
+	 * This is never NULL.
+	 */
+/*@notnull@*/
+/*@exposed@*/
+	const char *	dir_bench;
+
+	/*
+	 * Pointer to one of the argv strings in main, or NULL. File with
+	 * the games that HT_INV_PRINT_TUNE tunes the weights to.
+	 */
+/*@null@*/
+/*@exposed@*/
+	const char *	file_tune;
+
+	/*
+	 * Pointer to one of the argv strings in main, or NULL. File with
+	 * the settings of the tournament that HT_INV_PRINT_TOURN plays.
+	 */
+/*@null@*/
+/*@exposed@*/
+	const char *	file_tourn;
+
+	/*
+	 * Pointer to one of the argv strings in main, or NULL. File with
+	 * the settings and game records that HT_INV_PRINT_BATCH
+	 * analyzes.
+	 */
+/*@null@*/
+/*@exposed@*/
+	const char *	file_batch;
+
+	/*
+	 * Amount of threads that HT_INV_PRINT_SERVE searches computer
+	 * moves in, or 0 for one per processor.
+	 */
+	unsigned short	serve_threads;
+#endif
+
+#ifdef HT_AI_MINIMAX_HASH
+	/*
+	 * Overrides game->hash_conf.zobrist_seed if zobrist_seed_set.
+	 */
+	unsigned long	zobrist_seed;
+
+	HT_BOOL		zobrist_seed_set;
+
+	/*
+	 * Overrides game->hash_conf.mem_tab (in bytes) if hash_mem_set.
+	 */
+	size_t		hash_mem;
+
+	HT_BOOL		hash_mem_set;
+
+	/*
+	 * Pointer to one of the argv strings in main, or NULL. Sets
+	 * game->hash_conf.file if non-NULL.
+	 */
+/*@null@*/
+/*@exposed@*/
+	const char *	hash_file;
+#endif
 
 	/*
 	 * Whether to start the game (HT_TRUE) or print some information
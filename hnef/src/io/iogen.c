@@ -62,6 +62,55 @@ print_inv_help (
 	rv = rv < 0 ? rv : fputs(HT_L_INV_HELP_S_RUNCOM,	stdstr);
 	rv = rv < 0 ? rv : fputc('\n',				stdstr);
 
+	rv = rv < 0 ? rv : fputc(HT_L_INV_S_RCACHE,		stdstr);
+	rv = rv < 0 ? rv : fputc('\t',				stdstr);
+	rv = rv < 0 ? rv : fputs(HT_L_INV_HELP_S_RCACHE,	stdstr);
+	rv = rv < 0 ? rv : fputc('\n',				stdstr);
+
+#ifdef HT_AI_MINIMAX
+	rv = rv < 0 ? rv : fputc(HT_L_INV_S_BENCH,		stdstr);
+	rv = rv < 0 ? rv : fputc('\t',				stdstr);
+	rv = rv < 0 ? rv : fputs(HT_L_INV_HELP_S_BENCH,		stdstr);
+	rv = rv < 0 ? rv : fputc('\n',				stdstr);
+
+	rv = rv < 0 ? rv : fputc(HT_L_INV_S_TUNE,		stdstr);
+	rv = rv < 0 ? rv : fputc('\t',				stdstr);
+	rv = rv < 0 ? rv : fputs(HT_L_INV_HELP_S_TUNE,		stdstr);
+	rv = rv < 0 ? rv : fputc('\n',				stdstr);
+
+	rv = rv < 0 ? rv : fputc(HT_L_INV_S_TOURN,		stdstr);
+	rv = rv < 0 ? rv : fputc('\t',				stdstr);
+	rv = rv < 0 ? rv : fputs(HT_L_INV_HELP_S_TOURN,		stdstr);
+	rv = rv < 0 ? rv : fputc('\n',				stdstr);
+
+	rv = rv < 0 ? rv : fputc(HT_L_INV_S_BATCH,		stdstr);
+	rv = rv < 0 ? rv : fputc('\t',				stdstr);
+	rv = rv < 0 ? rv : fputs(HT_L_INV_HELP_S_BATCH,		stdstr);
+	rv = rv < 0 ? rv : fputc('\n',				stdstr);
+
+	rv = rv < 0 ? rv : fputc(HT_L_INV_S_SERVE,		stdstr);
+	rv = rv < 0 ? rv : fputc('\t',				stdstr);
+	rv = rv < 0 ? rv : fputs(HT_L_INV_HELP_S_SERVE,		stdstr);
+	rv = rv < 0 ? rv : fputc('\n',				stdstr);
+#endif
+
+#ifdef HT_AI_MINIMAX_HASH
+	rv = rv < 0 ? rv : fputc(HT_L_INV_S_SEED,		stdstr);
+	rv = rv < 0 ? rv : fputc('\t',				stdstr);
+	rv = rv < 0 ? rv : fputs(HT_L_INV_HELP_S_SEED,		stdstr);
+	rv = rv < 0 ? rv : fputc('\n',				stdstr);
+
+	rv = rv < 0 ? rv : fputc(HT_L_INV_S_HASHMEM,		stdstr);
+	rv = rv < 0 ? rv : fputc('\t',				stdstr);
+	rv = rv < 0 ? rv : fputs(HT_L_INV_HELP_S_HASHMEM,	stdstr);
+	rv = rv < 0 ? rv : fputc('\n',				stdstr);
+
+	rv = rv < 0 ? rv : fputc(HT_L_INV_S_HASHFILE,		stdstr);
+	rv = rv < 0 ? rv : fputc('\t',				stdstr);
+	rv = rv < 0 ? rv : fputs(HT_L_INV_HELP_S_HASHFILE,	stdstr);
+	rv = rv < 0 ? rv : fputc('\n',				stdstr);
+#endif
+
 	rv = rv < 0 ? rv : fputc(HT_L_INV_S_UI,			stdstr);
 	rv = rv < 0 ? rv : fputc('\t',				stdstr);
 	rv = rv < 0 ? rv : fputs(HT_L_INV_HELP_S_UI,		stdstr);
@@ -103,6 +152,18 @@ print_inv_help (
 	rv = rv < 0 ? rv : fputc('\n',				stdstr);
 #endif
 
+#ifdef HT_UI_ENGINE
+	rv = rv < 0 ? rv : fputc('\t',				stdstr);
+	rv = rv < 0 ? rv : fputc(HT_L_INV_S_UI_ENGINE,		stdstr);
+	rv = rv < 0 ? rv : fputc('\t',				stdstr);
+	rv = rv < 0 ? rv : fputs(HT_L_INV_HELP_S_UI_ENGINE,	stdstr);
+	if (HT_UIT_ENGINE == ui_d)
+	{
+		rv = rv < 0 ? rv : fputs(HT_L_INV_HELP_S_UI_DEF,stdstr);
+	}
+	rv = rv < 0 ? rv : fputc('\n',				stdstr);
+#endif
+
 	return rv < 0 ? HT_FR_FAIL_IO_PRINT : HT_FR_SUCCESS;
 }
 
@@ -431,6 +492,33 @@ print_inv (
 			return print_inv_nine();
 		case HT_INV_PRINT_VERSION:
 			return print_inv_version();
+#ifdef HT_AI_MINIMAX
+		case HT_INV_PRINT_BENCH:
+			/*
+			 * Not printed by itself: see bench_run.
+			 */
+			return HT_FR_FAIL_ILL_ARG;
+		case HT_INV_PRINT_TUNE:
+			/*
+			 * Not printed by itself: see tune_run.
+			 */
+			return HT_FR_FAIL_ILL_ARG;
+		case HT_INV_PRINT_TOURN:
+			/*
+			 * Not printed by itself: see tourn_run.
+			 */
+			return HT_FR_FAIL_ILL_ARG;
+		case HT_INV_PRINT_BATCH:
+			/*
+			 * Not printed by itself: see batch_run.
+			 */
+			return HT_FR_FAIL_ILL_ARG;
+		case HT_INV_PRINT_SERVE:
+			/*
+			 * Not printed by itself: see serve_run.
+			 */
+			return HT_FR_FAIL_ILL_ARG;
+#endif
 		default:
 			return HT_FR_FAIL_ENUM_UNK;
 	}
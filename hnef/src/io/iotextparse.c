@@ -15,7 +15,7 @@
  * You should have received a copy of the GNU General Public License
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
-#include <string.h>		/* strlen, memset */
+#include <string.h>		/* strlen, memmove */
 
 #include "boolt.h"		/* HT_BOOL */
 #include "config.h"		/* HT_RSTR */
@@ -36,26 +36,11 @@ static
 const char HT_LINE_CH_COMMENT = '#';
 
 /*
- * Initial capacity for ht_str (ht_str->capc).
- *
- * This value is 3 excluding '\0', which is tuned for reading ruleset
- * files where there will be a large array (board width * board height
- * long) consisting of up to three chars (the unsigned 8 bit value
- * "128", which is the maximum value of HT_BIT_U8). Otherwise there will
- * be a lot of unnecessary calls to realloc ht_str->chars (as
- * ht_str->capc needs to grow from 1 -> 2 -> 3 -> 4, if HT_STR_MEMC_DEF
- * would start on 1).
- */
-/*@unchecked@*/
-static
-const size_t HT_STR_MEMC_DEF = (size_t)4;
-
-/*
- * Grow factor for realloc when ht_str->capc needs to grow.
+ * Grow factor for realloc when ht_line->buf needs to grow.
  */
 /*@unchecked@*/
 static
-const float HT_STR_MEMC_GROWF = 1.5f;
+const float HT_LINE_BUF_GROWF = 2.0f;
 
 /*
  * Grow factor for realloc when ht_line->capc needs to grow.
@@ -65,66 +50,12 @@ static
 const float HT_LINE_MEMC_GROWF = 1.5f;
 
 /*
- * Clears s->chars, without de-allocating anything.
- * This will make strlen return 0 for s->chars.
- */
-static
-void
-ht_str_clear (
-/*@notnull@*/
-/*@partial@*/
-	struct ht_str * const s
-	)
-/*@modifies s->chars@*/
-{
-#ifndef HT_UNSAFE
-	memset(s->chars, (int)'\0', s->capc);
-#else
-	s->chars[0]	= '\0';
-#endif
-}
-
-/*
- * Allocates ht_str->chars in l->words[it] to l->words[l->capc] to cap
- * characters.
- *
- * Upon returning failure, everything that was allocated by this
- * function is de-allocated and set to NULL.
+ * Chars read at a time by alloc_ht_text, if the length of the file
+ * can't be known beforehand.
  */
+/*@unchecked@*/
 static
-enum HT_FR
-alloc_ht_str_chars (
-/*@notnull@*/
-/*@partial@*/
-	struct ht_line * const	l,
-	const size_t		cap,
-	const size_t		it
-	)
-/*@modifies l->words@*/
-{
-	size_t i = it;
-	for (; i < l->capc; i++)
-	{
-		struct ht_str * const s	= & l->words[i];
-		s->capc			= cap;
-		s->chars = malloc(sizeof(* s->chars) * s->capc);
-		if (NULL == s->chars)
-		{
-			size_t	j;
-			for (j = it; j < i; j++)
-			{
-				free		(l->words[j].chars);
-				l->words[j].chars	= NULL;
-			}
-			return	HT_FR_FAIL_ALLOC;
-		}
-		/*
-		 * Set '\0' as first character.
-		 */
-		ht_str_clear(s);
-	}
-	return	HT_FR_SUCCESS;
-}
+const size_t HT_TEXT_CHUNK = (size_t)4096;
 
 /*
  * Allocates a ht_line with:
@@ -133,36 +64,27 @@ alloc_ht_str_chars (
  *
  * *	ht_line->wordc 0.
  *
- * *	Each ht_str pointed to by ht_line->words is initialized to:
+ * *	ht_line->bufc ht_buf_capc.
  *
- *	*	ht_str->chars[0] = L'\0'.
- *
- *	*	ht_str->capc ht_str_capc.
- *
- * When a ht_str is added to ht_line->words because of automatic growth
- * in ht_line_readline, it will get ht_str->capc = HT_STR_MEMC_DEF --
- * not ht_str_capc!
- *
- * Both capacities must be at least 1, or NULL will be returned.
+ * Both capacities must be at least 1, or NULL will be returned. They
+ * grow as needed (the buffer by doubling), so they only need to be
+ * large enough for most lines.
  *
  * When you are going to read ruleset files, you are recommended to give
- * ht_line_capc = 3 and ht_str_capc = 18 (at least), because the first
+ * ht_line_capc = 3 and ht_buf_capc = 18 (at least), because the first
  * three words will likely be up to 17 characters in length (consider
  * that the ruleset arguments in lang.c may be translated and thus even
- * longer). As ht_line->capc later grows, the ht_str->capc of every word
- * will be HT_STR_MEMC_DEF (4), which is suitable for reading pieces and
- * squares HT_BIT_U8 arrays (and whatever bitmasks and size_t indices
- * that are used for other arguments).
+ * longer).
  */
 struct ht_line *
 alloc_ht_line (
 	const size_t	ht_line_capc,
-	const size_t	ht_str_capc
+	const size_t	ht_buf_capc
 	)
 {
 	struct ht_line * l;
 
-	if (ht_line_capc < (size_t)1 || ht_str_capc < (size_t)1)
+	if (ht_line_capc < (size_t)1 || ht_buf_capc < (size_t)1)
 	{
 		return NULL;
 	}
@@ -182,11 +104,15 @@ alloc_ht_line (
 		return	NULL;
 	}
 
-	if (HT_FR_SUCCESS != alloc_ht_str_chars(l, ht_str_capc, 0))
+	l->bufc		= ht_buf_capc;
+	l->buf		= malloc(sizeof(* l->buf) * l->bufc);
+	if (NULL == l->buf)
 	{
-		free_ht_line	(l);
-		return		NULL;
+		free	(l->words);
+		free	(l);
+		return	NULL;
 	}
+	l->buf[0]	= '\0';
 
 	return l;
 }
@@ -206,18 +132,6 @@ ht_isblank (
 	return ' ' == ch || '\t' == ch;
 }
 
-/* Clears l->words, without de-allocating anything. */
-static
-void
-ht_line_clear (
-/*@notnull@*/
-	struct ht_line * const HT_RSTR l
-	)
-/*@modifies l->wordc@*/
-{
-	l->wordc	= (size_t)0;
-}
-
 /*
  * Grows l by HT_LINE_MEMC_GROWF, or leaves it intact upon failing.
  */
@@ -225,7 +139,6 @@ static
 enum HT_FR
 ht_line_grow (
 /*@notnull@*/
-/*@partial@*/
 	struct ht_line * const l
 	)
 /*@modifies l->words, l->capc@*/
@@ -248,243 +161,452 @@ ht_line_grow (
 	l->words	= words_new;
 	l->capc		= capc_new;
 
-	return alloc_ht_str_chars(l, HT_STR_MEMC_DEF, capc_old);
+	return HT_FR_SUCCESS;
 }
 
+/*
+ * Splits the line that starts at s into the words of l, in place, and
+ * returns the amount of chars of s that the line took (including the
+ * '\n' that ended it, if any). The line ends at the first '\n' that
+ * isn't escaped, or at end (which must be writable, and may be '\0').
+ *
+ * *	A blank (space or tab) ends a word.
+ *
+ * *	HT_LINE_CH_COMMENT ends the line, and everything up to the next
+ *	'\n' is ignored.
+ *
+ * *	HT_LINE_CH_ESCAPE makes the next char a part of the word, even
+ *	if it's a blank, HT_LINE_CH_COMMENT or HT_LINE_CH_ESCAPE. An
+ *	escaped '\n' continues the line.
+ *
+ * The words are moved towards s as escapes are removed, and are ended
+ * with '\0'. A word never ends after the char that ended it, so the
+ * line is never overwritten before it's read.
+ *
+ * The first word is always there, even if it's empty (see
+ * ht_line_empty), and so is the last if the line ends with blanks.
+ */
 static
 enum HT_FR
-ht_str_grow (
+ht_line_split (
+/*@notnull@*/
+	struct ht_line * const HT_RSTR	l,
+/*@notnull@*/
+	char * const			s,
 /*@notnull@*/
-	struct ht_str *	s,
-	const size_t	capc_req
+	const char * const		end,
+/*@out@*/
+/*@notnull@*/
+	size_t * const HT_RSTR		len
 	)
-/*@modifies s->chars, s->capc@*/
+/*@modifies * l, * s, * len@*/
 {
-	const size_t	capc_old = s->capc;
-	char *		chars_new;
-	size_t capc_new = (size_t)((float)capc_old
-		* HT_STR_MEMC_GROWF);
-	if (capc_new <= capc_req)
-	{
-		capc_new = capc_req + 1;
-	}
+	const char *	in	= s;
+	char *		out	= s;
+	size_t		charc	= 0;
+	HT_BOOL		escape	= HT_FALSE;
 
-	chars_new = realloc(s->chars, sizeof(* s->chars) * capc_new);
-	if (NULL == chars_new)
-	{
-/* splint realloc */ /*@i2@*/\
-		return HT_FR_FAIL_ALLOC;
-	}
-	s->chars	= chars_new;
-	s->capc		= capc_new;
+	l->wordc		= (size_t)1;
+	l->words[0].chars	= out;
 
-#ifndef HT_UNSAFE
+	while (in < end)
 	{
-		size_t	i;
-		for (i = capc_old; i < capc_new; i++)
+		const char ch	= * in++;
+		if (!escape)
+		{
+			if (HT_LINE_CH_ESCAPE == ch)
+			{
+				escape	= HT_TRUE;
+				continue;
+			}
+			else if ('\n' == ch)
+			{
+				break;
+			}
+			else if (HT_LINE_CH_COMMENT == ch)
+			{
+				while (in < end && '\n' != * in++)
+				{
+					/*
+					 * Ignore every char until '\n'.
+					 */
+				}
+				break;
+			}
+/* splint incomplete logic */ /*@i1@*/\
+			else if (ht_isblank(ch))
+			{
+				if (charc > 0)
+				{
+					if (l->wordc + 1 >= l->capc)
+					{
+						const enum HT_FR fr =
+							ht_line_grow(l);
+						if (HT_FR_SUCCESS != fr)
+						{
+							return fr;
+						}
+					}
+					* out++	= '\0';
+					l->words[l->wordc++].chars = out;
+					charc	= 0;
+				}
+				continue;
+			}
+		}
+		else	/* escape */
 		{
-			s->chars[i]	= '\0';
+			escape	= HT_FALSE;
+			if ('\n' == ch)
+			{
+				continue;
+			}
 		}
+		* out++	= ch;
+		charc++;
 	}
-#endif
-/* splint realloc */ /*@i1@*/\
-	return HT_FR_SUCCESS;
+
+	* out	= '\0';
+	* len	= (size_t)(in - s);
+	return	HT_FR_SUCCESS;
 }
 
 /*
- * Adds char ch to s->chars, and appends '\0' after it. Assumes that the
- * s->chars[charc] was previously '\0'.
+ * Adds ch to l->buf at * len, growing it by HT_LINE_BUF_GROWF if
+ * needed. There's always room for a '\0' after it.
  *
- * Upon failing to grow, s is intact at its previous value.
+ * Upon failing to grow, l->buf is intact at its previous value.
  */
 static
 enum HT_FR
-ht_str_addchar (
-/*@in@*/
+ht_line_addchar (
 /*@notnull@*/
-	struct ht_str *	s,
-	const char	ch,
-/*@in@*/
+	struct ht_line * const HT_RSTR	l,
+	const char			ch,
 /*@notnull@*/
-	size_t * const	charc
+	size_t * const HT_RSTR		len
 	)
-/*@modifies s->chars, s->capc, * charc@*/
+/*@modifies l->buf, l->bufc, * len@*/
 {
-#ifndef HT_UNSAFE
-	if (* charc >= s->capc || '\0' != s->chars[* charc])
-	{
-		return HT_FR_FAIL_ILL_ARG;
-	}
-#endif
-
-	if (* charc + 1 >= s->capc)
+	if (* len + 1 >= l->bufc)
 	{
-		const enum HT_FR fr = ht_str_grow(s, * charc + 1);
-		if (HT_FR_SUCCESS != fr)
+		char *	buf_new;
+		size_t	bufc_new = (size_t)((float)l->bufc
+			* HT_LINE_BUF_GROWF);
+		if (bufc_new <= * len + 1)
 		{
-			return fr;
+			bufc_new = * len + 2;
 		}
+/* splint realloc */ /*@i1@*/\
+		buf_new	= realloc(l->buf, sizeof(* l->buf) * bufc_new);
+		if (NULL == buf_new)
+		{
+			return	HT_FR_FAIL_ALLOC;
+		}
+		l->buf	= buf_new;
+		l->bufc	= bufc_new;
 	}
-
-	s->chars[* charc]	= ch;
-	s->chars[++(* charc)]	= '\0';
+	l->buf[(* len)++]	= ch;
 	return	HT_FR_SUCCESS;
 }
 
 /*
- * Reads and ignores all characters up until "to" in f.
+ * Reads a line and stores the words in l, growing it as needed.
+ *
+ * The line is read into l->buf as it is, and then split by
+ * ht_line_split, so the words point into l->buf until the next line
+ * is read. A comment isn't read into l->buf.
+ *
+ * The file should be opened as "r" (at least).
  */
-static
 enum HT_FR
-ht_line_ignore (
-/*@notnull@*/
-	FILE * const	f,
-	const char	to
+ht_line_readline (
+	FILE * const		f,
+	struct ht_line * const	l
 	)
-/*@globals fileSystem, errno@*/
-/*@modifies fileSystem, errno, * f@*/
 {
-	int read;
-	while (EOF != (read = fgetc(f)) && to != (char)read)
+	int		ch;
+	size_t		len	= 0;
+	HT_BOOL		escape	= HT_FALSE;
+	HT_BOOL		comment	= HT_FALSE;
+
+#ifndef HT_UNSAFE
+	if (NULL == f || NULL == l)
 	{
-		/*
-		 * Ignore every char until to.
-		 */
+		return HT_FR_FAIL_NULLPTR;
 	}
-	return 0 == ferror(f) ? HT_FR_SUCCESS : HT_FR_FAIL_IO_FILE_R;
-}
+	else if (l->capc < (size_t)1 || l->bufc < (size_t)1)
+	{
+		return HT_FR_FAIL_ILL_ARG;
+	}
+#endif
 
-static
-enum HT_FR
-ht_line_parsechar (
-/*@notnull@*/
-	FILE * const		f,
-/*@notnull@*/
-	struct ht_line * const	l,
-	const char		ch,
-/*@in@*/
-/*@notnull@*/
-	size_t * const		charc, /* l->words[x].chars to '\0'. */
-/*@in@*/
-/*@notnull@*/
-	HT_BOOL * const HT_RSTR	escape,
-/*@in@*/
-/*@notnull@*/
-	HT_BOOL * const HT_RSTR	eol
-	)
-/*@globals fileSystem, errno@*/
-/*@modifies fileSystem, errno, * f, * l, * charc, * escape, * eol@*/
-{
-	if (!(* escape))
+	while (EOF != (ch = getc(f)))
 	{
-		if (HT_LINE_CH_ESCAPE == ch)
-		{
-			* escape = HT_TRUE;
-			return	HT_FR_SUCCESS;
-		}
-		else if ('\n' == ch)
+		if (comment)
 		{
-			* eol	= HT_TRUE;
-			return	HT_FR_SUCCESS;
+			if ('\n' == (char)ch)
+			{
+				break;
+			}
+			continue;
 		}
-		else if (HT_LINE_CH_COMMENT == ch)
+		else if (!escape && '\n' == (char)ch)
 		{
-			* eol	= HT_TRUE;
-			return ht_line_ignore(f, '\n');
+			break;
 		}
-/* splint incomplete logic */ /*@i1@*/\
-		else if (ht_isblank(ch))
+		else
 		{
-			if (* charc > 0)
+			const enum HT_FR fr =
+				ht_line_addchar(l, (char)ch, & len);
+			if (HT_FR_SUCCESS != fr)
 			{
-				if (l->wordc + 1 >= l->capc)
-				{
-					enum HT_FR fr = ht_line_grow(l);
-					if (HT_FR_SUCCESS != fr)
-					{
-						return fr;
-					}
-				}
-				l->wordc++;
-				ht_str_clear(& l->words[l->wordc - 1]);
-				* charc	= 0;
+				return	fr;
 			}
-			return	HT_FR_SUCCESS;
+		}
+
+		if (escape)
+		{
+			escape	= HT_FALSE;
+		}
+		else if (HT_LINE_CH_ESCAPE == (char)ch)
+		{
+			escape	= HT_TRUE;
+		}
+		else if (HT_LINE_CH_COMMENT == (char)ch)
+		{
+			comment	= HT_TRUE;
 		}
 	}
-	else	/* escape */
+	if (0 != ferror(f))
 	{
-		* escape	= HT_FALSE;
-		if ('\n' == ch)
+		return	HT_FR_FAIL_IO_FILE_R;
+	}
+
+	l->buf[len]	= '\0';
+	return	ht_line_split(l, l->buf, l->buf + len, & len);
+}
+
+/*
+ * Reads the rest of f into a new ht_text, which can then be split into
+ * lines with ht_line_readtext.
+ *
+ * If fr is success, then returns non-NULL. If fr is fail, then returns
+ * NULL.
+ *
+ * f is not closed.
+ */
+struct ht_text *
+alloc_ht_text (
+	FILE * const		f,
+	enum HT_FR * const	fr
+	)
+{
+	struct ht_text *	t;
+	size_t			capc	= HT_TEXT_CHUNK;
+	size_t			readc;
+
+#ifndef HT_UNSAFE
+	if (NULL == f || NULL == fr)
+	{
+		if (NULL != fr)
 		{
-			return	HT_FR_SUCCESS;
+			* fr	= HT_FR_FAIL_NULLPTR;
 		}
+		return	NULL;
+	}
+#endif
+
+	t	= malloc(sizeof(* t));
+	if (NULL == t)
+	{
+		* fr	= HT_FR_FAIL_ALLOC;
+		return	NULL;
 	}
-	return ht_str_addchar(& l->words[l->wordc - 1], ch, charc);
+	t->len	= 0;
+	t->pos	= 0;
+	t->chars = malloc(sizeof(* t->chars) * capc);
+	if (NULL == t->chars)
+	{
+		free	(t);
+		* fr	= HT_FR_FAIL_ALLOC;
+		return	NULL;
+	}
+
+	/*
+	 * One read for most files: capc is doubled until it's larger
+	 * than the file, always leaving room for '\0'.
+	 */
+	while ((readc = fread(t->chars + t->len, sizeof(* t->chars),
+		capc - t->len - (size_t)1, f)) > 0)
+	{
+		t->len	+= readc;
+		if (t->len + (size_t)1 >= capc)
+		{
+			char * const chars_new = realloc(t->chars,
+				sizeof(* t->chars) * capc * (size_t)2);
+			if (NULL == chars_new)
+			{
+				free_ht_text	(t);
+				* fr		= HT_FR_FAIL_ALLOC;
+				return		NULL;
+			}
+			t->chars	= chars_new;
+			capc		*= (size_t)2;
+		}
+	}
+	if (0 != ferror(f))
+	{
+		free_ht_text	(t);
+		* fr		= HT_FR_FAIL_IO_FILE_R;
+		return		NULL;
+	}
+	t->chars[t->len]	= '\0';
+
+	* fr	= HT_FR_SUCCESS;
+	return	t;
 }
 
 /*
- * Reads a line and stores the words in l, growing it as needed.
+ * Frees t. The words of the lines read from it are then invalid.
+ */
+void
+free_ht_text (
+	struct ht_text * const t
+	)
+{
+	free	(t->chars);
+	free	(t);
+}
+
+/*
+ * Returns true if every line of t has been read.
+ */
+HT_BOOL
+ht_text_eof (
+	const struct ht_text * const t
+	)
+{
+	return	t->pos >= t->len;
+}
+
+/*
+ * Reads the next line of t and stores the words in l, growing it as
+ * needed. The words point into t->chars, so they stay valid until t is
+ * freed.
  *
- * The file should be opened as "r" (at least).
+ * This works like ht_line_readline, but allocates nothing (unless l
+ * grows) and calls nothing per char.
  */
 enum HT_FR
-ht_line_readline (
-	FILE * const		f,
+ht_line_readtext (
+	struct ht_text * const	t,
 	struct ht_line * const	l
 	)
 {
-	enum HT_FR	fr	= HT_FR_NONE;
-	int		ch;
-	size_t		charc	= 0;
-	HT_BOOL	escape,	eol;
-	/*
-	 * l->words[x].chars[0] = '\0'.
-	 */
+	enum HT_FR	fr;
+	size_t		len	= 0;
 
 #ifndef HT_UNSAFE
-	if (NULL == f || NULL == l)
+	if (NULL == t || NULL == l)
 	{
 		return HT_FR_FAIL_NULLPTR;
 	}
-/* splint incomplete logic */ /*@i2@*/\
-	else if (l->capc < (size_t)1 || l->words[0].capc < (size_t)1)
+	else if (l->capc < (size_t)1)
 	{
 		return HT_FR_FAIL_ILL_ARG;
 	}
 #endif
 
-	ht_line_clear	(l);
-	l->wordc++;
-	ht_str_clear	(& l->words[0]);
-	charc		= 0;
-	escape	= eol	= HT_FALSE;
-	/*
-	 * l->wordc = 0.
-	 */
+	fr	= ht_line_split(l, t->chars + t->pos, t->chars + t->len,
+		& len);
+	t->pos	+= len;
+	return	fr;
+}
+
+/*
+ * Splits the first line of the string s into words and stores them in
+ * l, growing it as needed. s is split in place, so the words point
+ * into s and stay valid until s is freed or overwritten.
+ *
+ * This is ht_line_readtext for a single line that's already in memory,
+ * such as a message.
+ */
+enum HT_FR
+ht_line_readstr (
+	char * const		s,
+	struct ht_line * const	l
+	)
+{
+	size_t	len	= 0;
 
-	while (EOF != (ch = fgetc(f)))
-	{
-		fr = ht_line_parsechar(f, l, (char)ch, & charc,
-			& escape, & eol);
-		if (HT_FR_SUCCESS != fr)
-		{
-			return fr;
-		}
 #ifndef HT_UNSAFE
-		fr	= HT_FR_NONE;
+	if (NULL == s || NULL == l)
+	{
+		return HT_FR_FAIL_NULLPTR;
+	}
+	else if (l->capc < (size_t)1)
+	{
+		return HT_FR_FAIL_ILL_ARG;
+	}
 #endif
-		if (eol)
+
+	return	ht_line_split(l, s, s + strlen(s), & len);
+}
+
+/*
+ * Copies the words of l into l->buf, so that they stay valid after the
+ * ht_text that they were read from is freed (for example to print the
+ * line that a ruleset failed on). Words that are already in l->buf are
+ * left as they are.
+ *
+ * Upon failing to grow l->buf, l->wordc is set to 0.
+ */
+enum HT_FR
+ht_line_keep (
+	struct ht_line * const	l
+	)
+{
+	size_t	len	= 0;
+	size_t	i;
+
+	for (i = 0; i < l->wordc; i++)
+	{
+		len	+= strlen(l->words[i].chars) + (size_t)1;
+	}
+	/*
+	 * The words of a line are laid out one after the other from the
+	 * start of the buffer that it was read into, so if they're in
+	 * l->buf, they fit and every word is moved onto itself.
+	 */
+	if (len > l->bufc)
+	{
+/* splint realloc */ /*@i1@*/\
+		char * const buf_new = realloc(l->buf,
+			sizeof(* l->buf) * len);
+		if (NULL == buf_new)
 		{
-			break;
+			l->wordc	= 0;
+			return		HT_FR_FAIL_ALLOC;
 		}
+		l->buf	= buf_new;
+		l->bufc	= len;
 	}
 
-	return 0 == ferror(f) ? HT_FR_SUCCESS : HT_FR_FAIL_IO_FILE_R;
+	len	= 0;
+	for (i = 0; i < l->wordc; i++)
+	{
+		const size_t wlen =
+			strlen(l->words[i].chars) + (size_t)1;
+		(void) memmove(l->buf + len, l->words[i].chars, wlen);
+		l->words[i].chars	= l->buf + len;
+		len			+= wlen;
+	}
+	return	HT_FR_SUCCESS;
 }
 
 /*
- * Frees l and all owned ht_strs.
+ * Frees l. The words that were read into it are then invalid.
  */
 void
 free_ht_line (
@@ -493,16 +615,12 @@ free_ht_line (
 {
 	if (NULL != l->words)
 	{
-		size_t i;
-		for (i = 0; i < l->capc; i++)
-		{
-			if (NULL != l->words[i].chars)
-			{
-				free	(l->words[i].chars);
-			}
-		}
 		free	(l->words);
 	}
+	if (NULL != l->buf)
+	{
+		free	(l->buf);
+	}
 	free	(l);
 }
 
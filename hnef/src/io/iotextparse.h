@@ -48,6 +48,80 @@ ht_line_readline (
 ;
 /*@=protoparamname@*/
 
+/*@-protoparamname@*/
+/*@null@*/
+/*@only@*/
+extern
+struct ht_text *
+alloc_ht_text (
+/*@notnull@*/
+	FILE * const		f,
+/*@notnull@*/
+	enum HT_FR * const	fr
+	)
+/*@globals fileSystem, errno@*/
+/*@modifies fileSystem, errno, * f, * fr@*/
+;
+/*@=protoparamname@*/
+
+/*@-protoparamname@*/
+extern
+void
+free_ht_text (
+/*@notnull@*/
+/*@owned@*/
+/*@special@*/
+	struct ht_text * const t
+	)
+/*@modifies t->chars, t@*/
+/*@releases t->chars, t@*/
+;
+/*@=protoparamname@*/
+
+extern
+HT_BOOL
+ht_text_eof (
+/*@notnull@*/
+	const struct ht_text * const
+	)
+/*@modifies nothing@*/
+;
+
+/*@-protoparamname@*/
+extern
+enum HT_FR
+ht_line_readtext (
+	struct ht_text * const	t,
+	struct ht_line * const	l
+	)
+/*@modifies * t, * l@*/
+;
+/*@=protoparamname@*/
+
+/*@-protoparamname@*/
+extern
+enum HT_FR
+ht_line_readstr (
+/*@notnull@*/
+	char * const		s,
+/*@notnull@*/
+	struct ht_line * const	l
+	)
+/*@modifies * s, * l@*/
+;
+/*@=protoparamname@*/
+
+/*@-protoparamname@*/
+extern
+enum HT_FR
+ht_line_keep (
+/*@notnull@*/
+	struct ht_line * const	l
+	)
+/*@modifies * l@*/
+;
+/*@=protoparamname@*/
+
 /*@-protoparamname@*/
 extern
 void
@@ -57,8 +131,8 @@ free_ht_line (
 /*@special@*/
 	struct ht_line * const l
 	)
-/*@modifies l->words, l@*/
-/*@releases l->words, l@*/
+/*@modifies l->words, l->buf, l@*/
+/*@releases l->words, l->buf, l@*/
 ;
 /*@=protoparamname@*/
 
@@ -21,11 +21,12 @@
 #include <stdlib.h>	/* size_t */
 
 /*
- * A string of char.
+ * A word of a line read by ht_line_readline or ht_line_readtext.
  *
- * This is significantly easier when you need to deal with several of
- * them and keep track of their capacities, as they may grow
- * arbitrarily, and must always end with '\0'.
+ * The word doesn't own its chars: they are a slice of the buffer that
+ * the line was read into (ht_line->buf or ht_text->chars), ended with
+ * '\0' where the blank after the word was. Nothing is allocated per
+ * word.
  */
 /*@exposed@*/
 struct ht_str
@@ -34,26 +35,18 @@ struct ht_str
 	/*
 	 * The chars in the string, including '\0'.
 	 *
-	 * Chars following '\0' may be uninitialized, even if space for
-	 * them has been allocated (according to capc).
+	 * Valid until the next line is read into the same buffer.
 	 */
+/*@dependent@*/
 	char *	chars;
 
-	/*
-	 * Amount of chars that we have allocated in chars. This
-	 * includes the '\0' separator, and cap is therefore always at
-	 * least 1 (empty string).
-	 *
-	 * The chars array may be ASCII or UTF-8.
-	 */
-	size_t	capc;
-
 };
 
 /*
  * A line read by a line reader / parser.
  *
- * This is means to be used by ht_line_readline.
+ * This is meant to be used by ht_line_readline and
+ * ht_line_readtext.
  */
 /*@exposed@*/
 struct ht_line
@@ -65,10 +58,6 @@ struct ht_line
 
 	/*
 	 * Amount of ht_strs in words that are initialized.
-	 *
-	 * Words >= [wordc - 1] but < [capc - 1] are filled with either
-	 * 0-length strings or old strings (but should not contain
-	 * garbage), and should therefore not be used.
 	 */
 	size_t		wordc;
 
@@ -76,13 +65,51 @@ struct ht_line
 	 * Amount of words in words that have been allocated.
 	 *
 	 * This differs from wordc in that we can "clear" a ht_line by
-	 * setting wordc to 0 and overwrite any existing strings, rather
-	 * than free them and allocate them again later, reducing the
-	 * amount of allocations needed and minimizing heap
-	 * fragmentation.
+	 * setting wordc to 0 and reuse the array, rather than free it
+	 * and allocate it again later.
 	 */
 	size_t		capc;
 
+	/*
+	 * Buffer that ht_line_readline reads a line into, and that the
+	 * words then point into. Its capacity is bufc chars.
+	 */
+/*@notnull@*/
+/*@owned@*/
+	char *		buf;
+
+	size_t		bufc;
+
+};
+
+/*
+ * A whole text file, read at once, that ht_line_readtext splits into
+ * lines.
+ *
+ * The lines are split in place: the words of a line point into chars,
+ * so they stay valid until the ht_text is freed.
+ */
+/*@exposed@*/
+struct ht_text
+{
+
+	/*
+	 * The chars of the file, followed by '\0'.
+	 */
+/*@notnull@*/
+/*@owned@*/
+	char *		chars;
+
+	/*
+	 * Amount of chars of the file (not counting the '\0').
+	 */
+	size_t		len;
+
+	/*
+	 * Index in chars of the next line.
+	 */
+	size_t		pos;
+
 };
 
 #endif
@@ -91,6 +91,14 @@
 	extern
 	const char * HT_L_FR_FAIL_IO_FILE_R;
 
+	/*
+	 * HT_FR_FAIL_IO_FILE_W
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_FR_FAIL_IO_FILE_W;
+
 	/*
 	 * HT_FR_FAIL_IO_PRINT
 	 */
@@ -109,7 +117,8 @@
 	const char * HT_L_FR_FAIL_POSIX;
 #endif
 
-#ifdef HT_UI_CLI
+#if defined(HT_UI_CLI) || defined(HT_UI_ENGINE) \
+	|| defined(HT_AI_MINIMAX)
 	/*
 	 * HT_FR_FAIL_IO_STDIN
 	 */
@@ -221,6 +230,74 @@
 	extern
 	const char * HT_L_FAIL_INVOC_RC_NONE;
 
+	/*
+	 * HT_FR_FAIL_INVOC: HT_FAIL_INVOC_RCACHE
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_FAIL_INVOC_RCACHE;
+
+#ifdef HT_AI_MINIMAX
+	/*
+	 * HT_FR_FAIL_INVOC: HT_FAIL_INVOC_TUNE
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_FAIL_INVOC_TUNE;
+
+	/*
+	 * HT_FR_FAIL_INVOC: HT_FAIL_INVOC_TOURN
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_FAIL_INVOC_TOURN;
+
+	/*
+	 * HT_FR_FAIL_INVOC: HT_FAIL_INVOC_BATCH
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_FAIL_INVOC_BATCH;
+
+	/*
+	 * HT_FR_FAIL_INVOC: HT_FAIL_INVOC_SERVE
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_FAIL_INVOC_SERVE;
+#endif
+
+#ifdef HT_AI_MINIMAX_HASH
+	/*
+	 * HT_FR_FAIL_INVOC: HT_FAIL_INVOC_SEED
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_FAIL_INVOC_SEED;
+
+	/*
+	 * HT_FR_FAIL_INVOC: HT_FAIL_INVOC_HASHMEM
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_FAIL_INVOC_HASHMEM;
+
+	/*
+	 * HT_FR_FAIL_INVOC: HT_FAIL_INVOC_HASHFILE
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_FAIL_INVOC_HASHFILE;
+#endif
+
 	/*
 	 * invoc.info.nplay_print = HT_INV_PRINT_HELP
 	 */
@@ -242,6 +319,13 @@
 	extern
 	const char HT_L_INV_S_RUNCOM;
 
+	/*
+	 * invoc.file_rcache
+	 */
+/*@unchecked@*/
+	extern
+	const char HT_L_INV_S_RCACHE;
+
 	/*
 	 * invoc.info.play_ui
 	 */
@@ -254,257 +338,746 @@
 	 */
 /*@unchecked@*/
 	extern
-	const char HT_L_INV_S_VERSION;
+	const char HT_L_INV_S_VERSION;
+
+#ifdef HT_AI_MINIMAX
+	/*
+	 * invoc.info.nplay_print = HT_INV_PRINT_BENCH
+	 */
+/*@unchecked@*/
+	extern
+	const char HT_L_INV_S_BENCH;
+
+	/*
+	 * invoc.info.nplay_print = HT_INV_PRINT_TUNE
+	 */
+/*@unchecked@*/
+	extern
+	const char HT_L_INV_S_TUNE;
+
+	/*
+	 * invoc.info.nplay_print = HT_INV_PRINT_TOURN
+	 */
+/*@unchecked@*/
+	extern
+	const char HT_L_INV_S_TOURN;
+
+	/*
+	 * invoc.info.nplay_print = HT_INV_PRINT_BATCH
+	 */
+/*@unchecked@*/
+	extern
+	const char HT_L_INV_S_BATCH;
+
+	/*
+	 * invoc.info.nplay_print = HT_INV_PRINT_SERVE
+	 */
+/*@unchecked@*/
+	extern
+	const char HT_L_INV_S_SERVE;
+#endif
+
+#ifdef HT_AI_MINIMAX_HASH
+	/*
+	 * invoc.zobrist_seed
+	 */
+/*@unchecked@*/
+	extern
+	const char HT_L_INV_S_SEED;
+
+	/*
+	 * invoc.hash_mem
+	 */
+/*@unchecked@*/
+	extern
+	const char HT_L_INV_S_HASHMEM;
+
+	/*
+	 * invoc.hash_file
+	 */
+/*@unchecked@*/
+	extern
+	const char HT_L_INV_S_HASHFILE;
+#endif
+
+#ifdef HT_UI_CLI
+	/*
+	 * invoc.info.play_ui = HT_UIT_CLI
+	 */
+/*@unchecked@*/
+	extern
+	const char HT_L_INV_S_UI_CLI;
+#endif
+
+#ifdef HT_UI_XLIB
+	/*
+	 * invoc.info.play_ui = HT_UIT_XLIB
+	 */
+/*@unchecked@*/
+	extern
+	const char HT_L_INV_S_UI_XLIB;
+#endif
+
+#ifdef HT_UI_MSQU
+	/*
+	 * invoc.info.play_ui = HT_UIT_MSQU
+	 */
+/*@unchecked@*/
+	extern
+	const char HT_L_INV_S_UI_MSQU;
+#endif
+
+#ifdef HT_UI_ENGINE
+	/*
+	 * invoc.info.play_ui = HT_UIT_ENGINE
+	 */
+/*@unchecked@*/
+	extern
+	const char HT_L_INV_S_UI_ENGINE;
+#endif
+
+	/*
+	 * Help string for HT_L_INV_S_HELP.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_INV_HELP_S_HELP;
+
+	/*
+	 * Help string for HT_L_INV_S_VERSION.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_INV_HELP_S_VERSION;
+
+	/*
+	 * Help string for HT_L_INV_S_RUNCOM.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_INV_HELP_S_RUNCOM;
+
+	/*
+	 * Help string for HT_L_INV_S_RCACHE.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_INV_HELP_S_RCACHE;
+
+	/*
+	 * Help string for HT_L_INV_S_UI.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_INV_HELP_S_UI;
+
+	/*
+	 * String inserted in HT_L_INV_S_UI; used to mark the default
+	 * interface (which is selected based on which interfaces are
+	 * compiled in).
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_INV_HELP_S_UI_DEF;
+
+#ifdef HT_AI_MINIMAX
+	/*
+	 * Help string for HT_L_INV_S_BENCH.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_INV_HELP_S_BENCH;
+
+	/*
+	 * Help string for HT_L_INV_S_TUNE.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_INV_HELP_S_TUNE;
+
+	/*
+	 * Help string for HT_L_INV_S_TOURN.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_INV_HELP_S_TOURN;
+
+	/*
+	 * Help string for HT_L_INV_S_BATCH.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_INV_HELP_S_BATCH;
+
+	/*
+	 * Help string for HT_L_INV_S_SERVE.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_INV_HELP_S_SERVE;
+#endif
+
+#ifdef HT_AI_MINIMAX_HASH
+	/*
+	 * Help string for HT_L_INV_S_SEED.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_INV_HELP_S_SEED;
+
+	/*
+	 * Help string for HT_L_INV_S_HASHMEM.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_INV_HELP_S_HASHMEM;
+
+	/*
+	 * Help string for HT_L_INV_S_HASHFILE.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_INV_HELP_S_HASHFILE;
+#endif
+
+#ifdef HT_UI_CLI
+	/*
+	 * Help on the HT_L_INV_S_UI_CLI interface argument.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_INV_HELP_S_UI_CLI;
+#endif
+
+#ifdef HT_UI_XLIB
+	/*
+	 * Help on the HT_L_INV_S_UI_XLIB interface argument.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_INV_HELP_S_UI_XLIB;
+#endif
+
+#ifdef HT_UI_MSQU
+	/*
+	 * invoc.info.play_ui = HT_UIT_MSQU
+	 */
+/*@unchecked@*/
+	extern
+	const char * HT_L_INV_HELP_S_UI_MSQU;
+#endif
+
+#ifdef HT_UI_ENGINE
+	/*
+	 * Help on the HT_L_INV_S_UI_ENGINE interface argument.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_INV_HELP_S_UI_ENGINE;
+#endif
+
+	/*
+	 * HT_FAIL_RREADER_ARG_DUP
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_FAIL_RREADER_ARG_DUP;
+
+	/*
+	 * HT_FAIL_RREADER_ARG_MISS
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_FAIL_RREADER_ARG_MISS;
+
+	/*
+	 * HT_FAIL_RREADER_ARG_EXCESS
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_FAIL_RREADER_ARG_EXCESS;
+
+	/*
+	 * HT_FAIL_RREADER_ARG_UNK
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_FAIL_RREADER_ARG_UNK;
+
+	/*
+	 * HT_FAIL_RREADER_TYPE_DUP
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_FAIL_RREADER_TYPE_DUP;
+
+	/*
+	 * HT_FAIL_RREADER_TYPE_ORDER
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_FAIL_RREADER_TYPE_ORDER;
+
+	/*
+	 * HT_FAIL_RREADER_TYPE_OVERFLOW
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_FAIL_RREADER_TYPE_OVERFLOW;
+
+	/*
+	 * HT_FAIL_RREADER_TYPE_UNDEF
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_FAIL_RREADER_TYPE_UNDEF;
+
+	/*
+	 * HT_FAIL_RREADER_NOSIZE
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_FAIL_RREADER_NOSIZE;
+
+	/*
+	 * HT_FAIL_RREADER_INCOMP
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_FAIL_RREADER_INCOMP;
+
+	/*
+	 * Ruleset file "id" argument.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_RREADER_CMD_ID;
+
+	/*
+	 * Ruleset file "hash" argument.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_RREADER_CMD_HASH;
+
+	/*
+	 * Ruleset file "name" argument.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_RREADER_CMD_NAME;
+
+	/*
+	 * Ruleset file "path" argument.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_RREADER_CMD_PATH;
+
+	/*
+	 * Ruleset file "width" argument.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_RREADER_CMD_WIDTH;
+
+	/*
+	 * Ruleset file "height" argument.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_RREADER_CMD_HEIGHT;
+
+	/*
+	 * Ruleset file "piece" argument.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_RREADER_CMD_PIECE;
+
+	/*
+	 * Ruleset file "pieces" argument.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_RREADER_CMD_PIECES;
+
+	/*
+	 * Ruleset file "forbid_repeat" argument.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_RREADER_CMD_FREPEAT;
+
+#ifdef HT_AI_MINIMAX_HASH
+	/*
+	 * Ruleset file "zobrist_seed" argument.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_RREADER_CMD_ZSEED;
+
+	/*
+	 * Ruleset file "hash_mem" argument.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_RREADER_CMD_HASHMEM;
+#endif
+
+#ifdef HT_AI_MINIMAX
+	/*
+	 * Weights file "piece" argument.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_AIMEVAL_CMD_PIECE;
+
+	/*
+	 * Weights file "move_king" argument.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_AIMEVAL_CMD_MOVE_KING;
+
+	/*
+	 * Weights file "escval_king" argument.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_AIMEVAL_CMD_ESCVAL_KING;
+
+	/*
+	 * Weights file "escval_norm" argument.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_AIMEVAL_CMD_ESCVAL_NORM;
+
+	/*
+	 * Weights file "king_escdist" argument.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_AIMEVAL_CMD_KING_ESCDIST;
+
+	/*
+	 * Weights file "king_attackers" argument.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_AIMEVAL_CMD_KING_ATTACKERS;
+
+	/*
+	 * Weights file "edge" argument.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_AIMEVAL_CMD_EDGE;
+
+	/*
+	 * Weights file "corner" argument.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_AIMEVAL_CMD_CORNER;
+
+	/*
+	 * Weights file "psq" argument.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_AIMEVAL_CMD_PSQ;
 
-#ifdef HT_UI_CLI
 	/*
-	 * invoc.info.play_ui = HT_UIT_CLI
+	 * A game in the game records given to HT_L_INV_S_TUNE is
+	 * invalid.
 	 */
+/*@observer@*/
 /*@unchecked@*/
 	extern
-	const char HT_L_INV_S_UI_CLI;
-#endif
+	const char * HT_L_TUNE_FAIL_GAME;
 
-#ifdef HT_UI_XLIB
 	/*
-	 * invoc.info.play_ui = HT_UIT_XLIB
+	 * The game records given to HT_L_INV_S_TUNE have no positions.
 	 */
+/*@observer@*/
 /*@unchecked@*/
 	extern
-	const char HT_L_INV_S_UI_XLIB;
-#endif
+	const char * HT_L_TUNE_FAIL_EMPTY;
 
-#ifdef HT_UI_MSQU
 	/*
-	 * invoc.info.play_ui = HT_UIT_MSQU
+	 * Tournament file "games" argument.
 	 */
+/*@observer@*/
 /*@unchecked@*/
 	extern
-	const char HT_L_INV_S_UI_MSQU;
-#endif
+	const char * HT_L_TOURN_CMD_GAMES;
 
 	/*
-	 * Help string for HT_L_INV_S_HELP.
+	 * Tournament file "depth" argument.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_INV_HELP_S_HELP;
+	const char * HT_L_TOURN_CMD_DEPTH;
 
 	/*
-	 * Help string for HT_L_INV_S_VERSION.
+	 * Tournament file "time" argument.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_INV_HELP_S_VERSION;
+	const char * HT_L_TOURN_CMD_TIME;
 
 	/*
-	 * Help string for HT_L_INV_S_RUNCOM.
+	 * Tournament file "weights" argument.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_INV_HELP_S_RUNCOM;
+	const char * HT_L_TOURN_CMD_WEIGHTS;
 
 	/*
-	 * Help string for HT_L_INV_S_UI.
+	 * Tournament file "opening" argument.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_INV_HELP_S_UI;
+	const char * HT_L_TOURN_CMD_OPENING;
 
 	/*
-	 * String inserted in HT_L_INV_S_UI; used to mark the default
-	 * interface (which is selected based on which interfaces are
-	 * compiled in).
+	 * Tournament file "seed" argument.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_INV_HELP_S_UI_DEF;
+	const char * HT_L_TOURN_CMD_SEED;
 
-#ifdef HT_UI_CLI
 	/*
-	 * Help on the HT_L_INV_S_UI_CLI interface argument.
+	 * Tournament file "plies" argument.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_INV_HELP_S_UI_CLI;
-#endif
+	const char * HT_L_TOURN_CMD_PLIES;
 
-#ifdef HT_UI_XLIB
 	/*
-	 * Help on the HT_L_INV_S_UI_XLIB interface argument.
+	 * Tournament file "sprt" argument.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_INV_HELP_S_UI_XLIB;
-#endif
+	const char * HT_L_TOURN_CMD_SPRT;
 
-#ifdef HT_UI_MSQU
 	/*
-	 * invoc.info.play_ui = HT_UIT_MSQU
+	 * Tournament file "threads" argument.
 	 */
+/*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_INV_HELP_S_UI_MSQU;
-#endif
+	const char * HT_L_TOURN_CMD_THREADS;
 
 	/*
-	 * HT_FAIL_RREADER_ARG_DUP
+	 * Batch file "depth" argument.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_FAIL_RREADER_ARG_DUP;
+	const char * HT_L_BATCH_CMD_DEPTH;
 
 	/*
-	 * HT_FAIL_RREADER_ARG_MISS
+	 * Batch file "time" argument.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_FAIL_RREADER_ARG_MISS;
+	const char * HT_L_BATCH_CMD_TIME;
 
 	/*
-	 * HT_FAIL_RREADER_ARG_EXCESS
+	 * Batch file "threads" argument.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_FAIL_RREADER_ARG_EXCESS;
+	const char * HT_L_BATCH_CMD_THREADS;
 
 	/*
-	 * HT_FAIL_RREADER_ARG_UNK
+	 * Batch file "record" argument.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_FAIL_RREADER_ARG_UNK;
+	const char * HT_L_BATCH_CMD_RECORD;
 
 	/*
-	 * HT_FAIL_RREADER_TYPE_DUP
+	 * A game record given to HT_L_INV_S_BATCH is not valid, or has
+	 * no position at the given ply.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_FAIL_RREADER_TYPE_DUP;
+	const char * HT_L_BATCH_FAIL_RECORD;
 
 	/*
-	 * HT_FAIL_RREADER_TYPE_ORDER
+	 * Server "new" command.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_FAIL_RREADER_TYPE_ORDER;
+	const char * HT_L_SERVE_CMD_NEW;
 
 	/*
-	 * HT_FAIL_RREADER_TYPE_OVERFLOW
+	 * Server "move" command.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_FAIL_RREADER_TYPE_OVERFLOW;
+	const char * HT_L_SERVE_CMD_MOVE;
 
 	/*
-	 * HT_FAIL_RREADER_TYPE_UNDEF
+	 * Server "go" command.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_FAIL_RREADER_TYPE_UNDEF;
+	const char * HT_L_SERVE_CMD_GO;
 
 	/*
-	 * HT_FAIL_RREADER_NOSIZE
+	 * Server "depth" command argument.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_FAIL_RREADER_NOSIZE;
+	const char * HT_L_SERVE_CMD_DEPTH;
 
 	/*
-	 * HT_FAIL_RREADER_INCOMP
+	 * Server "time" command argument.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_FAIL_RREADER_INCOMP;
+	const char * HT_L_SERVE_CMD_TIME;
 
 	/*
-	 * Ruleset file "id" argument.
+	 * Server "free" command.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_RREADER_CMD_ID;
+	const char * HT_L_SERVE_CMD_FREE;
 
 	/*
-	 * Ruleset file "hash" argument.
+	 * Server "stats" command.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_RREADER_CMD_HASH;
+	const char * HT_L_SERVE_CMD_STATS;
 
 	/*
-	 * Ruleset file "name" argument.
+	 * Server "quit" command.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_RREADER_CMD_NAME;
+	const char * HT_L_SERVE_CMD_QUIT;
 
 	/*
-	 * Ruleset file "path" argument.
+	 * Server reply: Unknown command.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_RREADER_CMD_PATH;
+	const char * HT_L_SERVE_ERR_CMD;
 
 	/*
-	 * Ruleset file "width" argument.
+	 * Server reply: Invalid arguments to a command.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_RREADER_CMD_WIDTH;
+	const char * HT_L_SERVE_ERR_ARG;
 
 	/*
-	 * Ruleset file "height" argument.
+	 * Server reply: No game has the id.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_RREADER_CMD_HEIGHT;
+	const char * HT_L_SERVE_ERR_GAME;
 
 	/*
-	 * Ruleset file "piece" argument.
+	 * Server reply: The move is illegal, or the game is over.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_RREADER_CMD_PIECE;
+	const char * HT_L_SERVE_ERR_MOVE;
 
 	/*
-	 * Ruleset file "pieces" argument.
+	 * Server reply: The computer player is moving in the game.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_RREADER_CMD_PIECES;
+	const char * HT_L_SERVE_ERR_BUSY;
 
 	/*
-	 * Ruleset file "forbid_repeat" argument.
+	 * Server reply: The ruleset file is invalid.
 	 */
 /*@observer@*/
 /*@unchecked@*/
 	extern
-	const char * HT_L_RREADER_CMD_FREPEAT;
+	const char * HT_L_SERVE_ERR_RULES;
+#endif
 
 	/*
 	 * Ruleset file "square" argument.
@@ -774,6 +1347,42 @@
 	extern
 	const char * HT_L_UIC_ACT_CONTR_ILL;
 
+	/*
+	 * Message when a game can't be saved to the file given.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_UIC_ACT_SAVE_FAIL;
+
+	/*
+	 * Message when the file given is not a game record for the
+	 * ruleset, or can't be read.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_UIC_ACT_LOAD_FAIL;
+
+#ifdef HT_AI_MINIMAX_HASH
+	/*
+	 * Message when the hash table size has been changed. The size is
+	 * used from the next game.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_UIC_ACT_HASH_SET;
+
+	/*
+	 * Message when the hash table size given is invalid.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_UIC_ACT_HASH_ILL;
+#endif
+
 	/*
 	 * Identifier for human player.
 	 */
@@ -843,6 +1452,32 @@
 	extern
 	const char * HT_L_UIC_HELP_ARG_PRINT_BOARD;
 
+	/*
+	 * Help on HT_L_UIC_ARG_SAVE.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_UIC_HELP_ARG_SAVE;
+
+	/*
+	 * Help on HT_L_UIC_ARG_LOAD.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_UIC_HELP_ARG_LOAD;
+
+#ifdef HT_AI_MINIMAX_HASH
+	/*
+	 * Help on HT_L_UIC_ARG_HASH.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_UIC_HELP_ARG_HASH;
+#endif
+
 	/*
 	 * Help on HT_L_UIC_ARG_QUIT.
 	 */
@@ -873,6 +1508,36 @@
 	extern
 	const char HT_L_UIC_ARG_PRINT_BOARD;
 
+	/*
+	 * UI_CLI command for HT_UIC_ACT_SAVE (HT_UI_ACT_SPECIAL).
+	 */
+/*@unchecked@*/
+	extern
+	const char HT_L_UIC_ARG_SAVE;
+
+	/*
+	 * UI_CLI argument to HT_L_UIC_ARG_SAVE for HT_UIC_ACT_SAVE_BIN.
+	 */
+/*@unchecked@*/
+	extern
+	const char HT_L_UIC_ARG_SAVE_BIN;
+
+	/*
+	 * UI_CLI command for HT_UIC_ACT_LOAD (HT_UI_ACT_SPECIAL).
+	 */
+/*@unchecked@*/
+	extern
+	const char HT_L_UIC_ARG_LOAD;
+
+#ifdef HT_AI_MINIMAX_HASH
+	/*
+	 * UI_CLI command for HT_UIC_ACT_HASH (HT_UI_ACT_SPECIAL).
+	 */
+/*@unchecked@*/
+	extern
+	const char HT_L_UIC_ARG_HASH;
+#endif
+
 	/*
 	 * UI_CLI command for HT_UI_ACT_QUIT.
 	 */
@@ -984,5 +1649,159 @@
 
 #endif /* HT_UI_XLIB */
 
+#ifdef HT_UI_ENGINE
+
+	/*
+	 * Engine protocol command "hnef": identify the engine.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_UIE_CMD_HNEF;
+
+	/*
+	 * Engine protocol command "isready": answer when ready.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_UIE_CMD_ISREADY;
+
+	/*
+	 * Engine protocol command "newgame": start a new game.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_UIE_CMD_NEWGAME;
+
+	/*
+	 * Engine protocol command "position": set the position.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_UIE_CMD_POSITION;
+
+	/*
+	 * Engine protocol "position" argument for the moves from the
+	 * initial position.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_UIE_CMD_MOVES;
+
+	/*
+	 * Engine protocol "position" argument for a game record file.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_UIE_CMD_RECORD;
+
+	/*
+	 * Engine protocol command "go": search the position.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_UIE_CMD_GO;
+
+	/*
+	 * Engine protocol "go" and "setoption" argument for the search
+	 * depth.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_UIE_CMD_DEPTH;
+
+	/*
+	 * Engine protocol "go" and "setoption" argument for the search
+	 * time.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_UIE_CMD_TIME;
+
+	/*
+	 * Engine protocol command "ponder": search the position until
+	 * "stop".
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_UIE_CMD_PONDER;
+
+	/*
+	 * Engine protocol command "stop": stop the search.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_UIE_CMD_STOP;
+
+	/*
+	 * Engine protocol command "setoption": change a default.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_UIE_CMD_SETOPTION;
+
+	/*
+	 * Engine protocol "setoption" argument for the transposition
+	 * table size.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_UIE_CMD_HASH;
+
+	/*
+	 * Engine protocol command "quit": quit.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_UIE_CMD_QUIT;
+
+	/*
+	 * Engine protocol: unknown command.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_UIE_ERR_CMD;
+
+	/*
+	 * Engine protocol: invalid or missing argument.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_UIE_ERR_ARG;
+
+	/*
+	 * Engine protocol: illegal move in "position".
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_UIE_ERR_MOVE;
+
+	/*
+	 * Engine protocol: game record in "position" that can't be
+	 * loaded.
+	 */
+/*@observer@*/
+/*@unchecked@*/
+	extern
+	const char * HT_L_UIE_ERR_RECORD;
+
+#endif /* HT_UI_ENGINE */
+
 #endif
 
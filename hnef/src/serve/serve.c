@@ -0,0 +1,1798 @@
+/* Copyright 2013 Alexander Söderlund.
+ *
+ * This file is part of HNEFATAFL.
+ *
+ * HNEFATAFL is free software: you can distribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * HNEFATAFL is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HT_AI_MINIMAX
+
+#include <stdio.h>	/* printf, fputs, puts, fflush, stdout */
+#include <stdlib.h>	/* malloc, realloc, free */
+#include <string.h>	/* strcmp, strlen, strcpy */
+
+#ifdef HT_POSIX
+#include <pthread.h>	/* pthread_* */
+#include <unistd.h>	/* sysconf */
+#endif
+
+#include "aimalgo.h"	/* aiminimax_command */
+#ifdef HT_AI_MINIMAX_HASH
+#include "aimhash.h"	/* zhash_pages_name */
+#endif
+#include "aiminimax.h"	/* alloc_aiminimax_init, free_aiminimax */
+#include "board.h"	/* game_move, game_over */
+#include "game.h"	/* alloc_game_share, free_game */
+#include "grecord.h"	/* grecord_replay */
+#include "invoct.h"	/* invoc */
+#include "iogen.h"	/* print_err_fr_rreader */
+#include "iotextparse.h"	/* alloc_ht_line, ht_line_* */
+#include "lang.h"	/* HT_L_SERVE_* */
+#include "listm.h"	/* alloc_listm, free_listm, listm_add */
+#include "num.h"	/* texttoushort, texttoulong */
+#include "playert.h"	/* HT_PLAYER_UNINIT */
+#include "rcache.h"	/* alloc_game_rcache */
+#include "rvalid.h"	/* ruleset_valid */
+#include "serve.h"
+#include "timer.h"	/* ht_timer_ms */
+#include "ui.h"		/* ui_action_init */
+#include "uit.h"	/* ui, ui_action */
+
+/*
+ * NOTE:	The server protocol is line based, like the engine
+ *		protocol (see uie.c), but every command except "new",
+ *		"stats" and "quit" names the game that it's for:
+ *
+ *		new [file]		-> game id
+ *		move id x1 y1 x2 y2	-> ok id
+ *		go id [depth n] [time ms] -> bestmove id x1 y1 x2 y2
+ *		free id			-> ok id
+ *		stats			-> stats ...
+ *		quit
+ *
+ *		"go" is queued for the workers, and its reply comes when
+ *		the move has been searched and played, so replies to
+ *		other commands may come before it. The time limit of
+ *		"go" counts from when the command was read, so it
+ *		includes the time spent in the queue. After a move that
+ *		ends the game, "over id winner" follows, where winner is
+ *		"-" for a draw. Failures are replied "error id message",
+ *		where id is "-" if the command has none.
+ *
+ *		A hosted game only keeps the moves that have been played
+ *		in it. Games of the same ruleset file share one struct
+ *		game (serve_variant), in which the main thread plays the
+ *		moves of whichever game is being changed, and every
+ *		worker keeps a struct game per ruleset (sharing its
+ *		ruleset) to search in.
+ */
+
+/*
+ * Depth that the computer players are allocated for, which is also
+ * the greatest depth that can be searched.
+ */
+/*@unchecked@*/
+static
+const unsigned short HT_SERVE_DEPTH_MAX		= (unsigned short)64;
+
+/*
+ * Default search depth.
+ */
+/*@unchecked@*/
+static
+const unsigned short HT_SERVE_DEPTH_DEF		= (unsigned short)4;
+
+/*
+ * Initial capacity of the move list of a hosted game.
+ */
+/*@unchecked@*/
+static
+const size_t HT_SERVE_MOVES_CAP_DEF		= (size_t)16;
+
+/*
+ * Initial capacity of the game table, the request queue and the
+ * ruleset list.
+ */
+/*@unchecked@*/
+static
+const size_t HT_SERVE_CAP_DEF			= (size_t)16;
+
+/*
+ * Player 0 and 1, who have a computer player each in every worker
+ * game.
+ */
+#define HT_SERVE_SIDES 2
+
+struct serve_game;
+
+/*
+ * A ruleset file that games are played by, which is only read once.
+ */
+struct serve_variant
+{
+
+/*@only@*/
+/*@notnull@*/
+	char *			file;
+
+	/*
+	 * Index in serve->variants and serve_worker->games.
+	 */
+	size_t			index;
+
+	/*
+	 * The game that the ruleset was read into. Its ruleset and
+	 * settings never change after that, so workers can share them
+	 * (alloc_game_share) without locking. The main thread plays
+	 * the moves of hosted games in it to check them.
+	 */
+/*@owned@*/
+/*@notnull@*/
+	struct game *		g;
+
+	/*
+	 * The hosted game whose first loaded_plies moves have been
+	 * played in g, or NULL if g has to be replayed.
+	 */
+/*@dependent@*/
+/*@null@*/
+	const struct serve_game *	loaded;
+
+	size_t			loaded_plies;
+
+};
+
+/*
+ * A hosted game.
+ */
+struct serve_game
+{
+
+/*@dependent@*/
+/*@notnull@*/
+	struct serve_variant *	v;
+
+	/*
+	 * The moves from the initial position.
+	 */
+/*@owned@*/
+/*@notnull@*/
+	struct listm *		moves;
+
+	size_t			id;
+
+	/*
+	 * Set from "go" until the move is played. Only the worker may
+	 * change moves meanwhile.
+	 */
+	HT_BOOL			busy;
+
+	/*
+	 * Set if the game was freed while busy. It's no longer in
+	 * serve->games, and the worker frees it instead of replying.
+	 */
+	HT_BOOL			dead;
+
+	/*
+	 * Stops the search at once (aiminimax->halt).
+	 */
+	volatile HT_BOOL	stop;
+
+	/*
+	 * The "go" request: depth to search, and time limit (0 for
+	 * none) counted from time_start.
+	 */
+	unsigned short		depth;
+
+	unsigned long		time_start;
+
+	unsigned long		time_max;
+
+};
+
+/*
+ * State shared by the main thread and the workers. Guarded by mutex
+ * with HT_POSIX.
+ */
+struct serve
+{
+
+/*@dependent@*/
+/*@notnull@*/
+	const struct invoc *		inv;
+
+/*@only@*/
+/*@null@*/
+	struct serve_variant * *	variants;
+
+	size_t				variantc;
+
+	size_t				variantcap;
+
+	/*
+	 * Hosted games by id. Freed games leave NULL, and ids are used
+	 * again from the lowest one.
+	 */
+/*@only@*/
+/*@null@*/
+	struct serve_game * *		games;
+
+	size_t				gamec;
+
+	size_t				gamecap;
+
+	/*
+	 * Amount of games in games, and lowest id that may be NULL.
+	 */
+	size_t				live;
+
+	size_t				free_min;
+
+	/*
+	 * Ring of games waiting for a worker: queuec games from
+	 * queue[queue_first].
+	 */
+/*@only@*/
+/*@null@*/
+	struct serve_game * *		queue;
+
+	size_t				queue_first;
+
+	size_t				queuec;
+
+	size_t				queuecap;
+
+	/*
+	 * Moves played and positions visited by the workers, and when
+	 * the server started.
+	 */
+	unsigned long			moves;
+
+	unsigned long			nodes;
+
+	unsigned long			time_start;
+
+#ifdef HT_AI_MINIMAX_HASH
+	/*
+	 * Transposition tables that the workers have allocated, by
+	 * zhashtable->pages.
+	 */
+	unsigned long			tabs[HT_ZHASH_PAGESC];
+#endif
+
+	/*
+	 * Set when the workers are to return once the queue is empty.
+	 */
+	HT_BOOL				quit;
+
+	/*
+	 * First failure of a worker.
+	 */
+	enum HT_FR			fr;
+
+#ifdef HT_POSIX
+	pthread_mutex_t			mutex;
+
+	/*
+	 * Signaled when a game is queued, or on quit.
+	 */
+	pthread_cond_t			cond;
+#endif
+
+};
+
+/*
+ * A worker's game and computer players for a ruleset.
+ */
+struct serve_wgame
+{
+
+/*@owned@*/
+/*@null@*/
+	struct game *		g;
+
+/*@owned@*/
+/*@null@*/
+	struct aiminimax *	aim[HT_SERVE_SIDES];
+
+};
+
+/*
+ * A worker, which searches one queued game at a time.
+ */
+struct serve_worker
+{
+
+/*@dependent@*/
+/*@notnull@*/
+	struct serve *		s;
+
+	/*
+	 * By serve_variant->index, allocated as they're needed.
+	 */
+/*@only@*/
+/*@null@*/
+	struct serve_wgame *	games;
+
+	size_t			gamec;
+
+#ifdef HT_POSIX
+	pthread_t		thread;
+#endif
+
+};
+
+/*
+ * Locks s->mutex with HT_POSIX.
+ */
+static
+void
+serve_lock (
+/*@in@*/
+/*@notnull@*/
+	struct serve * const	s
+	)
+/*@modifies * s@*/
+{
+#ifdef HT_POSIX
+	(void) pthread_mutex_lock	(& s->mutex);
+#else
+	(void) s;
+#endif
+}
+
+static
+void
+serve_unlock (
+/*@in@*/
+/*@notnull@*/
+	struct serve * const	s
+	)
+/*@modifies * s@*/
+{
+#ifdef HT_POSIX
+	(void) pthread_mutex_unlock	(& s->mutex);
+#else
+	(void) s;
+#endif
+}
+
+/*
+ * Returns an error of printf and fflush on stdout as an HT_FR.
+ */
+static
+enum HT_FR
+serve_flush (
+	const int	rv
+	)
+/*@globals fileSystem, errno, stdout@*/
+/*@modifies fileSystem, errno, stdout@*/
+{
+	return	rv < 0 || 0 != fflush(stdout) ? HT_FR_FAIL_IO_PRINT
+		: HT_FR_SUCCESS;
+}
+
+/*
+ * Prints "error", id and msg.
+ */
+static
+enum HT_FR
+serve_print_error (
+/*@in@*/
+/*@notnull@*/
+	const char * const	id,
+/*@in@*/
+/*@notnull@*/
+	const char * const	msg
+	)
+/*@globals fileSystem, errno, stdout@*/
+/*@modifies fileSystem, errno, stdout@*/
+{
+	return	serve_flush(printf("error %s %s\n", id, msg));
+}
+
+/*
+ * Prints " x1 y1 x2 y2" for the move from pos to dest.
+ */
+static
+int
+serve_print_move (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const	g,
+	const unsigned short		pos,
+	const unsigned short		dest
+	)
+/*@globals fileSystem, errno, stdout@*/
+/*@modifies fileSystem, errno, stdout@*/
+{
+	const unsigned short bwidth	= g->rules->bwidth;
+	return	printf(" %hu %hu %hu %hu",
+		(unsigned short)(pos % bwidth),
+		(unsigned short)(pos / bwidth),
+		(unsigned short)(dest % bwidth),
+		(unsigned short)(dest / bwidth));
+}
+
+/*
+ * Prints "over id winner" if over.
+ */
+static
+int
+serve_print_over (
+/*@in@*/
+/*@notnull@*/
+	const struct serve_game * const	sg,
+	const HT_BOOL			over,
+	const unsigned short		winner
+	)
+/*@globals fileSystem, errno, stdout@*/
+/*@modifies fileSystem, errno, stdout@*/
+{
+	if (!over)
+	{
+		return	0;
+	}
+	else if (HT_PLAYER_UNINIT == winner)
+	{
+		return	printf("over %lu -\n", (unsigned long)sg->id);
+	}
+	else
+	{
+		return	printf("over %lu %hu\n", (unsigned long)sg->id,
+			winner);
+	}
+}
+
+/*
+ * Returns the memory that sg takes while it's idle: itself, its move
+ * list and its slot in serve->games. The ruleset and the searching
+ * games are shared by every game.
+ */
+static
+size_t
+serve_game_mem (
+/*@in@*/
+/*@notnull@*/
+	const struct serve_game * const	sg
+	)
+/*@modifies nothing@*/
+{
+	return	sizeof(* sg) + sizeof(* sg->moves)
+		+ sizeof(* sg->moves->elems) * sg->moves->capc
+		+ sizeof(sg);
+}
+
+/*
+ * Frees sg, which must not be in serve->games or serve->queue.
+ */
+static
+void
+serve_game_free (
+/*@only@*/
+/*@notnull@*/
+	struct serve_game * const	sg
+	)
+/*@modifies sg@*/
+{
+	if (sg->v->loaded == sg)
+	{
+		sg->v->loaded	= NULL;
+	}
+	free_listm	(sg->moves);
+	free		(sg);
+}
+
+/*
+ * Plays the moves of sg in sg->v->g, unless they're already played.
+ */
+static
+enum HT_FR
+serve_load (
+/*@in@*/
+/*@notnull@*/
+	const struct serve_game * const	sg
+	)
+/*@modifies * sg@*/
+{
+	struct serve_variant * const	v	= sg->v;
+	enum HT_FR			fr;
+	HT_BOOL				valid	= HT_FALSE;
+
+	if (v->loaded == sg && v->loaded_plies == sg->moves->elemc)
+	{
+		return	HT_FR_SUCCESS;
+	}
+
+	/*
+	 * Every move was played with game_move when it was made, so
+	 * they can be trusted.
+	 */
+	v->loaded	= NULL;
+	fr	= grecord_replay(v->g, sg->moves, HT_TRUE, & valid);
+	if (HT_FR_SUCCESS != fr)
+	{
+		return	fr;
+	}
+	else if (!valid)
+	{
+		return	HT_FR_FAIL_ILL_STATE;
+	}
+	v->loaded	= sg;
+	v->loaded_plies	= sg->moves->elemc;
+	return		HT_FR_SUCCESS;
+}
+
+/*
+ * Sets wg to w's game for v, which is allocated the first time.
+ *
+ * The game is made from v->g, of which only the ruleset and settings
+ * are read: they never change, so the main thread may play moves in
+ * v->g meanwhile.
+ */
+static
+enum HT_FR
+serve_worker_game (
+/*@in@*/
+/*@notnull@*/
+	struct serve_worker * const		w,
+/*@in@*/
+/*@notnull@*/
+	const struct serve_variant * const	v,
+/*@out@*/
+/*@notnull@*/
+	struct serve_wgame * * const		wg
+	)
+/*@modifies * w, * wg@*/
+{
+	if (v->index >= w->gamec)
+	{
+		struct serve_wgame *	games;
+		size_t			i;
+
+		games	= realloc(w->games, sizeof(* games)
+			* (v->index + 1));
+		if (NULL == games)
+		{
+			return	HT_FR_FAIL_ALLOC;
+		}
+		for (i = w->gamec; i <= v->index; i++)
+		{
+			games[i].g	= NULL;
+			games[i].aim[0]	= games[i].aim[1]	= NULL;
+		}
+		w->games	= games;
+		w->gamec	= v->index + 1;
+	}
+
+	* wg	= & w->games[v->index];
+	if (NULL == (* wg)->g)
+	{
+		(* wg)->g	= alloc_game_share(v->g);
+		if (NULL == (* wg)->g)
+		{
+			return	HT_FR_FAIL_ALLOC;
+		}
+	}
+	return	HT_FR_SUCCESS;
+}
+
+/*
+ * Searches the position of sg in w's game for its ruleset, and plays
+ * the best move in it. act is set to the move, or not to a move if the
+ * game is over. over and winner tell if the move ended the game.
+ */
+static
+enum HT_FR
+serve_search (
+/*@in@*/
+/*@notnull@*/
+	struct serve_worker * const	w,
+/*@in@*/
+/*@notnull@*/
+	struct serve_game * const	sg,
+/*@out@*/
+/*@notnull@*/
+	struct ui_action * const	act,
+/*@out@*/
+/*@notnull@*/
+	unsigned long * const		nodes,
+/*@out@*/
+/*@notnull@*/
+	HT_BOOL * const			over,
+/*@out@*/
+/*@notnull@*/
+	unsigned short * const		winner
+	)
+/*@globals errno, fileSystem, stdout, internalState@*/
+/*@modifies errno, fileSystem, stdout, internalState, * w, * sg@*/
+/*@modifies * w->s, * act, * nodes, * over, * winner@*/
+{
+	struct serve_wgame *	wg	= NULL;
+	struct aiminimax *	aim;
+	struct ui		interf;
+	enum HT_FR		fr	= HT_FR_NONE;
+	unsigned short		turn;
+	HT_BOOL			valid	= HT_FALSE;
+
+	interf.type	= HT_UIT_NONE;
+	ui_action_init(act);
+	* nodes		= 0ul;
+	* over		= HT_FALSE;
+	* winner	= HT_PLAYER_UNINIT;
+
+	fr	= serve_worker_game(w, sg->v, & wg);
+	if (HT_FR_SUCCESS != fr)
+	{
+		return	fr;
+	}
+	fr	= grecord_replay(wg->g, sg->moves, HT_TRUE, & valid);
+	if (HT_FR_SUCCESS != fr)
+	{
+		return	fr;
+	}
+	else if (!valid)
+	{
+		return	HT_FR_FAIL_ILL_STATE;
+	}
+	if (game_over(wg->g, winner))
+	{
+		* winner	= HT_PLAYER_UNINIT;
+		return		HT_FR_SUCCESS;
+	}
+
+	turn	= wg->g->b->turn;
+	if (NULL == wg->aim[turn])
+	{
+		wg->aim[turn]	= alloc_aiminimax_init(wg->g, turn,
+			HT_SERVE_DEPTH_MAX, & fr
+#ifdef HT_AI_MINIMAX_HASH
+			, NULL
+#endif
+			);
+		if (HT_FR_SUCCESS != fr || NULL == wg->aim[turn])
+		{
+			return	HT_FR_SUCCESS == fr ? HT_FR_FAIL_ALLOC
+				: fr;
+		}
+#ifdef HT_AI_MINIMAX_HASH
+		serve_lock	(w->s);
+		w->s->tabs[wg->aim[turn]->tp_tab->pages]++;
+		serve_unlock	(w->s);
+#endif
+	}
+	aim	= wg->aim[turn];
+
+	/*
+	 * aim has room to search HT_SERVE_DEPTH_MAX, so depth_max can
+	 * be lowered for every search.
+	 */
+	aim->depth_max	= sg->depth;
+	aim->halt	= & sg->stop;
+	aim->time_start	= sg->time_start;
+	aim->time_max	= sg->time_max;
+	fr	= aiminimax_command(wg->g, & interf, aim, act);
+	aim->halt	= NULL;
+	aim->time_max	= 0ul;
+	if (HT_FR_SUCCESS != fr)
+	{
+		return	fr;
+	}
+	* nodes	= aim->nodes;
+
+	if (HT_UI_ACT_MOVE == act->type)
+	{
+		fr	= game_move(wg->g, act->info.mov.pos,
+			act->info.mov.dest, & valid);
+		if (HT_FR_SUCCESS != fr)
+		{
+			return	fr;
+		}
+		else if (!valid)
+		{
+			return	HT_FR_FAIL_ILL_STATE;
+		}
+		* over	= game_over(wg->g, winner);
+	}
+	return	HT_FR_SUCCESS;
+}
+
+/*
+ * Adds the move that was searched for sg to it and prints it.
+ *
+ * With HT_POSIX, s->mutex must be locked.
+ */
+static
+enum HT_FR
+serve_done (
+/*@in@*/
+/*@notnull@*/
+	struct serve * const		s,
+/*@in@*/
+/*@notnull@*/
+	struct serve_game * const	sg,
+/*@in@*/
+/*@notnull@*/
+	const struct ui_action * const	act,
+	const unsigned long		nodes,
+	const HT_BOOL			over,
+	const unsigned short		winner
+	)
+/*@globals fileSystem, errno, stdout@*/
+/*@modifies fileSystem, errno, stdout, * s, * sg@*/
+{
+	int rv;
+
+	s->nodes	+= nodes;
+
+	rv	= printf("bestmove %lu", (unsigned long)sg->id);
+	if (rv >= 0 && HT_UI_ACT_MOVE == act->type)
+	{
+		const enum HT_FR fr	= listm_add(sg->moves,
+			act->info.mov.pos, act->info.mov.dest);
+		if (HT_FR_SUCCESS != fr)
+		{
+			return	fr;
+		}
+		s->moves++;
+		rv	= serve_print_move(sg->v->g, act->info.mov.pos,
+			act->info.mov.dest);
+	}
+	else if (rv >= 0)
+	{
+		rv	= fputs(" -", stdout);
+	}
+	rv	= rv < 0 ? rv : fputc('\n', stdout);
+	rv	= rv < 0 ? rv : serve_print_over(sg, over, winner);
+	return	serve_flush(rv);
+}
+
+/*
+ * Searches and plays the queued games until the queue is empty and
+ * s->quit is set, or until a worker has failed. Without HT_POSIX,
+ * returns as soon as the queue is empty.
+ */
+static
+void
+serve_work (
+/*@in@*/
+/*@notnull@*/
+	struct serve_worker * const	w
+	)
+/*@globals errno, fileSystem, stdout, internalState@*/
+/*@modifies errno, fileSystem, stdout, internalState, * w@*/
+{
+	struct serve * const s	= w->s;
+
+	for (;;)
+	{
+		struct serve_game *	sg;
+		struct ui_action	act;
+		enum HT_FR		fr;
+		unsigned long		nodes	= 0ul;
+		unsigned short		winner	= HT_PLAYER_UNINIT;
+		HT_BOOL			over	= HT_FALSE;
+
+		serve_lock	(s);
+#ifdef HT_POSIX
+		while (s->queuec < (size_t)1 && !s->quit)
+		{
+			(void) pthread_cond_wait(& s->cond, & s->mutex);
+		}
+#endif
+		if (s->queuec < (size_t)1 || HT_FR_SUCCESS != s->fr)
+		{
+			serve_unlock	(s);
+			return;
+		}
+		sg	= s->queue[s->queue_first];
+		s->queue_first	= (s->queue_first + 1) % s->queuecap;
+		s->queuec--;
+		if (sg->dead)
+		{
+			serve_game_free	(sg);
+			serve_unlock	(s);
+			continue;
+		}
+		serve_unlock	(s);
+
+		fr	= serve_search(w, sg, & act, & nodes, & over,
+			& winner);
+
+		serve_lock	(s);
+		sg->busy	= HT_FALSE;
+		if (sg->dead)
+		{
+			serve_game_free	(sg);
+		}
+		else if (HT_FR_SUCCESS == fr)
+		{
+			fr	= serve_done(s, sg, & act, nodes, over,
+				winner);
+		}
+		if (HT_FR_SUCCESS != fr && HT_FR_SUCCESS == s->fr)
+		{
+			s->fr	= fr;
+			s->quit	= HT_TRUE;
+#ifdef HT_POSIX
+			(void) pthread_cond_broadcast	(& s->cond);
+#endif
+		}
+		serve_unlock	(s);
+	}
+}
+
+#ifdef HT_POSIX
+
+/*@null@*/
+static
+void *
+serve_work_thread (
+/*@in@*/
+/*@notnull@*/
+	void * const	arg
+	)
+/*@globals errno, fileSystem, stdout, internalState@*/
+/*@modifies errno, fileSystem, stdout, internalState, arg@*/
+{
+	serve_work	(arg);
+	return		NULL;
+}
+
+#endif
+
+static
+void
+serve_worker_free (
+/*@in@*/
+/*@notnull@*/
+	struct serve_worker * const	w
+	)
+/*@modifies * w@*/
+{
+	size_t		i;
+	unsigned short	j;
+
+	for (i = (size_t)0; i < w->gamec; i++)
+	{
+		for (j = (unsigned short)0; j < HT_SERVE_SIDES; j++)
+		{
+			if (NULL != w->games[i].aim[j])
+			{
+				free_aiminimax	(w->games[i].aim[j]);
+			}
+		}
+		if (NULL != w->games[i].g)
+		{
+			free_game	(w->games[i].g);
+		}
+	}
+	free	(w->games);
+	w->games	= NULL;
+	w->gamec	= 0;
+}
+
+/*
+ * Returns the amount of words in line, not counting the empty word
+ * that blanks at the end of the line leave.
+ */
+static
+size_t
+serve_wordc (
+/*@in@*/
+/*@notnull@*/
+	const struct ht_line * const	line
+	)
+/*@modifies nothing@*/
+{
+	size_t wordc	= line->wordc;
+	if (wordc > (size_t)0
+	&& '\0' == line->words[wordc - 1].chars[0])
+	{
+		wordc--;
+	}
+	return	wordc;
+}
+
+/*
+ * Returns the game whose id is text, or NULL if there is none.
+ */
+/*@null@*/
+/*@dependent@*/
+static
+struct serve_game *
+serve_game_get (
+/*@in@*/
+/*@notnull@*/
+	const struct serve * const	s,
+/*@in@*/
+/*@notnull@*/
+	const char * const		text
+	)
+/*@modifies nothing@*/
+{
+	unsigned long id	= 0ul;
+	if (NULL == s->games || !texttoulong(text, & id)
+	|| (size_t)id >= s->gamec)
+	{
+		return	NULL;
+	}
+	return	s->games[id];
+}
+
+/*
+ * Sets v to the ruleset in file, which is read the first time. v is
+ * NULL if the ruleset is invalid, which has been printed to stderr.
+ */
+static
+enum HT_FR
+serve_variant_get (
+/*@in@*/
+/*@notnull@*/
+	struct serve * const		s,
+/*@in@*/
+/*@notnull@*/
+	struct ht_line * const		line,
+/*@in@*/
+/*@notnull@*/
+	const char * const		file,
+/*@out@*/
+/*@notnull@*/
+	struct serve_variant * * const	v
+	)
+/*@globals fileSystem, errno, stderr@*/
+/*@modifies fileSystem, errno, stderr, * s, * line, * v@*/
+{
+	const struct invoc * const inv	= s->inv;
+	enum HT_FR		fr		= HT_FR_NONE;
+	enum HT_FAIL_RREADER	fail_read	= HT_FAIL_RREADER_NONE;
+	HT_BOOL			valid		= HT_FALSE;
+	struct serve_variant *	vn;
+	size_t			i;
+
+	* v	= NULL;
+	for (i = (size_t)0; i < s->variantc; i++)
+	{
+		if (0 == strcmp(s->variants[i]->file, file))
+		{
+			* v	= s->variants[i];
+			return	HT_FR_SUCCESS;
+		}
+	}
+
+	if (s->variantc >= s->variantcap)
+	{
+		const size_t cap	= NULL == s->variants
+			? HT_SERVE_CAP_DEF : s->variantcap * 2;
+		struct serve_variant * * const variants	=
+			realloc(s->variants, sizeof(* variants) * cap);
+		if (NULL == variants)
+		{
+			return	HT_FR_FAIL_ALLOC;
+		}
+		s->variants	= variants;
+		s->variantcap	= cap;
+	}
+
+	vn	= malloc(sizeof(* vn));
+	if (NULL == vn)
+	{
+		return	HT_FR_FAIL_ALLOC;
+	}
+	vn->file	= malloc(strlen(file) + 1);
+	if (NULL == vn->file)
+	{
+		free	(vn);
+		return	HT_FR_FAIL_ALLOC;
+	}
+	(void) strcpy(vn->file, file);
+
+	/*
+	 * The compiled ruleset is only used for the ruleset of the
+	 * invocation.
+	 */
+	vn->g	= alloc_game_rcache(file, 0 == strcmp(file,
+		inv->file_rc) ? inv->file_rcache : NULL, line, & fr,
+		& fail_read, & valid);
+	if (HT_FR_SUCCESS != fr || NULL == vn->g)
+	{
+		if (NULL != vn->g)
+		{
+			free_game	(vn->g);
+		}
+		free	(vn->file);
+		free	(vn);
+		if (HT_FR_FAIL_ALLOC == fr)
+		{
+			return	fr;
+		}
+		(void) print_err_fr_rreader(stderr, fr, fail_read,
+			line);
+		return	HT_FR_SUCCESS;
+	}
+
+	fr	= HT_FR_SUCCESS;
+#ifdef HT_AI_MINIMAX_HASH
+	if (inv->zobrist_seed_set)
+	{
+		fr	= game_zobrist_seed(vn->g, inv->zobrist_seed);
+	}
+	if (inv->hash_mem_set)
+	{
+		vn->g->hash_conf.mem_tab	= inv->hash_mem;
+	}
+#endif
+	if (HT_FR_SUCCESS == fr)
+	{
+		fr	= game_board_reset(vn->g);
+	}
+	if (HT_FR_SUCCESS == fr && !valid)
+	{
+		const char * const why	= ruleset_valid(vn->g);
+		if (NULL != why)
+		{
+			(void) fputs	(why,	stderr);
+			(void) fputc	('\n',	stderr);
+			free_game	(vn->g);
+			free		(vn->file);
+			free		(vn);
+			return		HT_FR_SUCCESS;
+		}
+	}
+	if (HT_FR_SUCCESS != fr)
+	{
+		free_game	(vn->g);
+		free		(vn->file);
+		free		(vn);
+		return		fr;
+	}
+
+	vn->index	= s->variantc;
+	vn->loaded	= NULL;
+	vn->loaded_plies	= 0;
+	s->variants[s->variantc++]	= vn;
+	* v	= vn;
+	return	HT_FR_SUCCESS;
+}
+
+/*
+ * "new [file]". The ruleset is the one of the invocation if no file is
+ * given.
+ */
+static
+enum HT_FR
+serve_cmd_new (
+/*@in@*/
+/*@notnull@*/
+	struct serve * const		s,
+/*@in@*/
+/*@notnull@*/
+	struct ht_line * const		line,
+/*@in@*/
+/*@notnull@*/
+	struct ht_line * const		line_rules
+	)
+/*@globals fileSystem, errno, stdout, stderr@*/
+/*@modifies fileSystem, errno, stdout, stderr, * s, * line_rules@*/
+{
+	const size_t		wordc	= serve_wordc(line);
+	struct serve_variant *	v	= NULL;
+	struct serve_game *	sg;
+	enum HT_FR		fr;
+
+	if (wordc > (size_t)2)
+	{
+		return	serve_print_error("-", HT_L_SERVE_ERR_ARG);
+	}
+	fr	= serve_variant_get(s, line_rules, wordc > (size_t)1
+		? line->words[1].chars : s->inv->file_rc, & v);
+	if (HT_FR_SUCCESS != fr)
+	{
+		return	fr;
+	}
+	else if (NULL == v)
+	{
+		return	serve_print_error("-", HT_L_SERVE_ERR_RULES);
+	}
+
+	while (s->free_min < s->gamec && NULL != s->games[s->free_min])
+	{
+		s->free_min++;
+	}
+	if (s->free_min >= s->gamecap)
+	{
+		const size_t cap	= NULL == s->games
+			? HT_SERVE_CAP_DEF : s->gamecap * 2;
+		struct serve_game * * const games	=
+			realloc(s->games, sizeof(* games) * cap);
+		if (NULL == games)
+		{
+			return	HT_FR_FAIL_ALLOC;
+		}
+		s->games	= games;
+		s->gamecap	= cap;
+	}
+
+	sg	= malloc(sizeof(* sg));
+	if (NULL == sg)
+	{
+		return	HT_FR_FAIL_ALLOC;
+	}
+	sg->moves	= alloc_listm(HT_SERVE_MOVES_CAP_DEF);
+	if (NULL == sg->moves)
+	{
+		free	(sg);
+		return	HT_FR_FAIL_ALLOC;
+	}
+	sg->v		= v;
+	sg->id		= s->free_min;
+	sg->busy	= sg->dead	= sg->stop	= HT_FALSE;
+	sg->depth	= HT_SERVE_DEPTH_DEF;
+	sg->time_start	= sg->time_max	= 0ul;
+
+	if (sg->id >= s->gamec)
+	{
+		s->gamec	= sg->id + 1;
+	}
+	s->games[sg->id]	= sg;
+	s->live++;
+	return	serve_flush(printf("game %lu\n",
+		(unsigned long)sg->id));
+}
+
+/*
+ * Sets sg to the game in word 1 of line, and returns true. Else prints
+ * the error and returns false, with fr set to how that went.
+ */
+static
+HT_BOOL
+serve_cmd_game (
+/*@in@*/
+/*@notnull@*/
+	const struct serve * const	s,
+/*@in@*/
+/*@notnull@*/
+	const struct ht_line * const	line,
+/*@out@*/
+/*@notnull@*/
+	struct serve_game * * const	sg,
+/*@out@*/
+/*@notnull@*/
+	enum HT_FR * const		fr
+	)
+/*@globals fileSystem, errno, stdout@*/
+/*@modifies fileSystem, errno, stdout, * sg, * fr@*/
+{
+	const char * const id	= serve_wordc(line) > (size_t)1
+		? line->words[1].chars : "-";
+
+	* sg	= serve_game_get(s, id);
+	if (NULL == * sg)
+	{
+		* fr	= serve_print_error(id, HT_L_SERVE_ERR_GAME);
+		return	HT_FALSE;
+	}
+	else if ((* sg)->busy)
+	{
+		* fr	= serve_print_error(id, HT_L_SERVE_ERR_BUSY);
+		return	HT_FALSE;
+	}
+	* fr	= HT_FR_SUCCESS;
+	return	HT_TRUE;
+}
+
+/*
+ * "move id x1 y1 x2 y2".
+ */
+static
+enum HT_FR
+serve_cmd_move (
+/*@in@*/
+/*@notnull@*/
+	struct serve * const		s,
+/*@in@*/
+/*@notnull@*/
+	const struct ht_line * const	line
+	)
+/*@globals fileSystem, errno, stdout@*/
+/*@modifies fileSystem, errno, stdout, * s@*/
+{
+	struct serve_game *	sg	= NULL;
+	struct game *		g;
+	enum HT_FR		fr	= HT_FR_NONE;
+	unsigned short		c[4];
+	unsigned short		pos	= 0, dest	= 0;
+	unsigned short		winner	= HT_PLAYER_UNINIT;
+	HT_BOOL			legal	= HT_FALSE;
+	HT_BOOL			over;
+	int			rv;
+	size_t			i;
+
+	if (!serve_cmd_game(s, line, & sg, & fr) || NULL == sg)
+	{
+		return	fr;
+	}
+	else if ((size_t)6 != serve_wordc(line))
+	{
+		return	serve_print_error(line->words[1].chars,
+			HT_L_SERVE_ERR_ARG);
+	}
+
+	fr	= serve_load(sg);
+	if (HT_FR_SUCCESS != fr)
+	{
+		return	fr;
+	}
+	g	= sg->v->g;
+	for (i = 0; i < (size_t)4; i++)
+	{
+		if (!texttoushort(line->words[i + 2].chars, & c[i])
+		|| c[i] >= (0 == i % 2 ? g->rules->bwidth
+			: g->rules->bheight))
+		{
+			break;
+		}
+	}
+	if (i >= (size_t)4 && !game_over(g, & winner))
+	{
+		const unsigned short bw	= g->rules->bwidth;
+		pos	= (unsigned short)(c[1] * bw + c[0]);
+		dest	= (unsigned short)(c[3] * bw + c[2]);
+		fr	= game_move(g, pos, dest, & legal);
+		if (HT_FR_SUCCESS != fr)
+		{
+			sg->v->loaded	= NULL;
+			return		fr;
+		}
+	}
+	if (!legal)
+	{
+		return	serve_print_error(line->words[1].chars,
+			HT_L_SERVE_ERR_MOVE);
+	}
+
+	fr	= listm_add(sg->moves, pos, dest);
+	if (HT_FR_SUCCESS != fr)
+	{
+		sg->v->loaded	= NULL;
+		return		fr;
+	}
+	sg->v->loaded_plies	= sg->moves->elemc;
+	over	= game_over(g, & winner);
+	rv	= printf("ok %lu\n", (unsigned long)sg->id);
+	rv	= rv < 0 ? rv : serve_print_over(sg, over, winner);
+	return	serve_flush(rv);
+}
+
+/*
+ * "go id [depth n] [time ms]". Without limits, the default depth is
+ * searched. With limits, only those that are given apply.
+ */
+static
+enum HT_FR
+serve_cmd_go (
+/*@in@*/
+/*@notnull@*/
+	struct serve * const		s,
+/*@in@*/
+/*@notnull@*/
+	const struct ht_line * const	line,
+	const unsigned long		time_start
+	)
+/*@globals fileSystem, errno, stdout@*/
+/*@modifies fileSystem, errno, stdout, * s@*/
+{
+	const size_t		wordc	= serve_wordc(line);
+	struct serve_game *	sg	= NULL;
+	enum HT_FR		fr	= HT_FR_NONE;
+	unsigned short		depth	= HT_SERVE_DEPTH_DEF;
+	unsigned long		time	= 0ul;
+	size_t			i;
+
+	if (!serve_cmd_game(s, line, & sg, & fr) || NULL == sg)
+	{
+		return	fr;
+	}
+	if (wordc > (size_t)2)
+	{
+		depth	= HT_SERVE_DEPTH_MAX;
+	}
+	if (0 != wordc % 2)
+	{
+		return	serve_print_error(line->words[1].chars,
+			HT_L_SERVE_ERR_ARG);
+	}
+	for (i = (size_t)2; i + 1 < wordc; i += 2)
+	{
+		const char * const	arg	= line->words[i].chars;
+		const char * const	val = line->words[i + 1].chars;
+		HT_BOOL			valid	= HT_FALSE;
+
+		if (0 == strcmp(arg, HT_L_SERVE_CMD_DEPTH))
+		{
+			valid	= texttoushort(val, & depth)
+				&& aiminimax_depth_max_valid(depth)
+				&& depth <= HT_SERVE_DEPTH_MAX;
+		}
+		else if (0 == strcmp(arg, HT_L_SERVE_CMD_TIME))
+		{
+			valid	= texttoulong(val, & time);
+		}
+		if (!valid)
+		{
+			return	serve_print_error(line->words[1].chars,
+				HT_L_SERVE_ERR_ARG);
+		}
+	}
+
+	if (s->queuec >= s->queuecap)
+	{
+		const size_t cap	= NULL == s->queue
+			? HT_SERVE_CAP_DEF : s->queuecap * 2;
+		struct serve_game * * const queue	=
+			malloc(sizeof(* queue) * cap);
+		if (NULL == queue)
+		{
+			return	HT_FR_FAIL_ALLOC;
+		}
+		for (i = (size_t)0; i < s->queuec; i++)
+		{
+			queue[i]	= s->queue[(s->queue_first + i)
+				% s->queuecap];
+		}
+		free	(s->queue);
+		s->queue	= queue;
+		s->queuecap	= cap;
+		s->queue_first	= 0;
+	}
+	s->queue[(s->queue_first + s->queuec) % s->queuecap]	= sg;
+	s->queuec++;
+
+	sg->busy	= HT_TRUE;
+	sg->stop	= HT_FALSE;
+	sg->depth	= depth;
+	sg->time_start	= time_start;
+	sg->time_max	= time;
+#ifdef HT_POSIX
+	(void) pthread_cond_signal	(& s->cond);
+#endif
+	return	HT_FR_SUCCESS;
+}
+
+/*
+ * "free id". A game that a worker is searching is stopped, and freed by
+ * the worker.
+ */
+static
+enum HT_FR
+serve_cmd_free (
+/*@in@*/
+/*@notnull@*/
+	struct serve * const		s,
+/*@in@*/
+/*@notnull@*/
+	const struct ht_line * const	line
+	)
+/*@globals fileSystem, errno, stdout@*/
+/*@modifies fileSystem, errno, stdout, * s@*/
+{
+	const char * const id	= serve_wordc(line) > (size_t)1
+		? line->words[1].chars : "-";
+	struct serve_game * const sg	= serve_game_get(s, id);
+
+	if (NULL == sg || (size_t)2 != serve_wordc(line))
+	{
+		return	serve_print_error(id, NULL == sg
+			? HT_L_SERVE_ERR_GAME : HT_L_SERVE_ERR_ARG);
+	}
+
+	s->games[sg->id]	= NULL;
+	s->live--;
+	if (sg->id < s->free_min)
+	{
+		s->free_min	= sg->id;
+	}
+	if (sg->busy)
+	{
+		sg->dead	= sg->stop	= HT_TRUE;
+	}
+	else
+	{
+		serve_game_free	(sg);
+	}
+	return	serve_flush(printf("ok %s\n", id));
+}
+
+/*
+ * "stats": the amount of hosted games and rulesets, how many games are
+ * busy, the memory that an idle game takes on average, and the computer
+ * moves and positions searched since the server started. With
+ * HT_AI_MINIMAX_HASH, also how many transposition tables there are in
+ * every kind of pages.
+ */
+static
+enum HT_FR
+serve_cmd_stats (
+/*@in@*/
+/*@notnull@*/
+	const struct serve * const	s
+	)
+/*@globals fileSystem, errno, stdout, internalState@*/
+/*@modifies fileSystem, errno, stdout, internalState@*/
+{
+	const unsigned long	time	= ht_timer_ms() - s->time_start;
+	size_t			busy	= 0;
+	size_t			mem	= 0;
+	size_t			i;
+	int			rv;
+
+	for (i = (size_t)0; i < s->gamec; i++)
+	{
+		const struct serve_game * const sg	= s->games[i];
+		if (NULL == sg)
+		{
+			continue;
+		}
+		else if (sg->busy)
+		{
+			busy++;
+		}
+		else
+		{
+			mem	+= serve_game_mem(sg);
+		}
+	}
+	rv	= printf("stats games %lu busy %lu variants %lu",
+		(unsigned long)s->live, (unsigned long)busy,
+		(unsigned long)s->variantc);
+	if (rv >= 0)
+	{
+		rv	= printf(" idlemem %lu moves %lu nodes %lu",
+			(unsigned long)(s->live > busy
+				? mem / (s->live - busy) : 0),
+			s->moves, s->nodes);
+	}
+#ifdef HT_AI_MINIMAX_HASH
+	for (i = (size_t)0; rv >= 0 && i < (size_t)HT_ZHASH_PAGESC; i++)
+	{
+		rv	= printf(" %s %lu",
+			zhash_pages_name((enum HT_ZHASH_PAGES)i),
+			s->tabs[i]);
+	}
+#endif
+	if (rv >= 0)
+	{
+		rv	= printf(" time %lu mps %.1f\n", time,
+			time > 0ul ? (double)s->moves * 1000.0
+				/ (double)time : 0.0);
+	}
+	return	serve_flush(rv);
+}
+
+/*
+ * Performs the command in line, which was read at time_start. quit is
+ * set on "quit".
+ *
+ * With HT_POSIX, s->mutex must be locked.
+ */
+static
+enum HT_FR
+serve_cmd (
+/*@in@*/
+/*@notnull@*/
+	struct serve * const		s,
+/*@in@*/
+/*@notnull@*/
+	struct ht_line * const		line,
+/*@in@*/
+/*@notnull@*/
+	struct ht_line * const		line_rules,
+	const unsigned long		time_start,
+/*@in@*/
+/*@notnull@*/
+	HT_BOOL * const			quit
+	)
+/*@globals fileSystem, errno, stdout, stderr, internalState@*/
+/*@modifies fileSystem, errno, stdout, stderr, internalState@*/
+/*@modifies * s, * line_rules, * quit@*/
+{
+	const char * const cmd	= line->words[0].chars;
+
+	if (0 == strcmp(cmd, HT_L_SERVE_CMD_NEW))
+	{
+		return	serve_cmd_new(s, line, line_rules);
+	}
+	else if (0 == strcmp(cmd, HT_L_SERVE_CMD_MOVE))
+	{
+		return	serve_cmd_move(s, line);
+	}
+	else if (0 == strcmp(cmd, HT_L_SERVE_CMD_GO))
+	{
+		return	serve_cmd_go(s, line, time_start);
+	}
+	else if (0 == strcmp(cmd, HT_L_SERVE_CMD_FREE))
+	{
+		return	serve_cmd_free(s, line);
+	}
+	else if (0 == strcmp(cmd, HT_L_SERVE_CMD_STATS))
+	{
+		return	serve_cmd_stats(s);
+	}
+	else if (0 == strcmp(cmd, HT_L_SERVE_CMD_QUIT))
+	{
+		* quit	= HT_TRUE;
+		return	HT_FR_SUCCESS;
+	}
+	else
+	{
+		return	serve_print_error("-", HT_L_SERVE_ERR_CMD);
+	}
+}
+
+/*
+ * Returns the amount of workers, which is inv->serve_threads if set, or
+ * else one per processor.
+ */
+static
+size_t
+serve_workc (
+/*@in@*/
+/*@notnull@*/
+	const struct invoc * const	inv
+	)
+/*@modifies nothing@*/
+{
+	size_t workc	= (size_t)inv->serve_threads;
+#if defined(HT_POSIX) && !defined(HT_AI_MINIMAX_UNSAFE)
+	if (workc < (size_t)1)
+	{
+		const long cpus	= sysconf(_SC_NPROCESSORS_ONLN);
+		workc	= cpus < 1 ? (size_t)1 : (size_t)cpus;
+	}
+#else
+	/*
+	 * HT_AI_MINIMAX_UNSAFE has a global in aimalgo.c, so only one
+	 * game can be searched at a time. Without HT_POSIX, the worker
+	 * runs in this thread after every command.
+	 */
+	workc	= (size_t)1;
+#endif
+	return	workc;
+}
+
+/*
+ * Reads and performs commands until "quit", or until stdin ends, and
+ * then waits for the queued games to be played.
+ */
+static
+enum HT_FR
+serve_loop (
+/*@in@*/
+/*@notnull@*/
+	struct serve * const		s,
+/*@in@*/
+/*@notnull@*/
+	struct serve_worker * const	workers,
+	const size_t			workc
+	)
+/*@globals fileSystem, errno, stdin, stdout, stderr, internalState@*/
+/*@modifies fileSystem, errno, stdin, stdout, stderr, internalState@*/
+/*@modifies * s, * workers@*/
+{
+	struct ht_line *	line;
+	struct ht_line *	line_rules;
+	enum HT_FR		fr	= HT_FR_SUCCESS;
+	HT_BOOL			quit	= HT_FALSE;
+	size_t			threadc	= 0;
+	size_t			i;
+
+	line		= alloc_ht_line((size_t)3, (size_t)18);
+	line_rules	= alloc_ht_line((size_t)3, (size_t)18);
+	if (NULL == line || NULL == line_rules)
+	{
+		fr	= HT_FR_FAIL_ALLOC;
+	}
+
+#ifdef HT_POSIX
+	for (; HT_FR_SUCCESS == fr && threadc < workc; threadc++)
+	{
+		if (0 != pthread_create(& workers[threadc].thread, NULL,
+			serve_work_thread, & workers[threadc]))
+		{
+			fr	= HT_FR_FAIL_POSIX;
+			break;
+		}
+	}
+#else
+	(void) workc;
+#endif
+
+	while (HT_FR_SUCCESS == fr && !quit)
+	{
+		fr	= ht_line_readline(stdin, line);
+		if (HT_FR_SUCCESS == fr && !ht_line_empty(line))
+		{
+			const unsigned long time_start	= ht_timer_ms();
+			serve_lock	(s);
+			fr	= serve_cmd(s, line, line_rules,
+				time_start, & quit);
+			serve_unlock	(s);
+		}
+#ifndef HT_POSIX
+		serve_work	(& workers[0]);
+#endif
+		if (HT_FR_SUCCESS == fr && 0 != ferror(stdin))
+		{
+			fr	= HT_FR_FAIL_IO_STDIN;
+		}
+		else if (0 != feof(stdin))
+		{
+			break;
+		}
+		serve_lock	(s);
+		fr	= HT_FR_SUCCESS == fr ? s->fr : fr;
+		serve_unlock	(s);
+	}
+
+	serve_lock	(s);
+	s->quit	= HT_TRUE;
+#ifdef HT_POSIX
+	(void) pthread_cond_broadcast	(& s->cond);
+#endif
+	serve_unlock	(s);
+	for (i = (size_t)0; i < threadc; i++)
+	{
+#ifdef HT_POSIX
+		if (0 != pthread_join(workers[i].thread, NULL))
+		{
+			fr	= HT_FR_FAIL_POSIX;
+		}
+#endif
+	}
+
+	if (NULL != line)
+	{
+		free_ht_line	(line);
+	}
+	if (NULL != line_rules)
+	{
+		free_ht_line	(line_rules);
+	}
+	return	HT_FR_SUCCESS == fr ? s->fr : fr;
+}
+
+/*
+ * Hosts games for clients on stdin and stdout (see the note at the top
+ * of this file), until "quit" or until stdin ends.
+ *
+ * Every ruleset file is read once, and the games that are played by it
+ * share it. The computer moves are searched by a pool of workers, in
+ * their own threads with HT_POSIX, that take the games from a queue in
+ * the order that "go" was given.
+ */
+enum HT_FR
+serve_run (
+	const struct invoc * const	inv
+	)
+{
+	struct serve *		s	= NULL;
+	struct serve_worker *	workers	= NULL;
+	enum HT_FR		fr	= HT_FR_SUCCESS;
+	size_t			workc;
+	size_t			i;
+
+#ifndef HT_UNSAFE
+	if (NULL == inv)
+	{
+		return	HT_FR_FAIL_NULLPTR;
+	}
+#endif
+
+	s	= malloc(sizeof(* s));
+	if (NULL == s)
+	{
+		return	HT_FR_FAIL_ALLOC;
+	}
+	s->inv		= inv;
+	s->variants	= NULL;
+	s->variantc	= s->variantcap	= 0;
+	s->games	= NULL;
+	s->gamec	= s->gamecap	= 0;
+	s->live		= s->free_min	= 0;
+	s->queue	= NULL;
+	s->queue_first	= s->queuec	= s->queuecap	= 0;
+	s->moves	= s->nodes	= 0ul;
+	s->time_start	= ht_timer_ms();
+#ifdef HT_AI_MINIMAX_HASH
+	for (i = (size_t)0; i < (size_t)HT_ZHASH_PAGESC; i++)
+	{
+		s->tabs[i]	= 0ul;
+	}
+#endif
+	s->quit		= HT_FALSE;
+	s->fr		= HT_FR_SUCCESS;
+
+	workc	= serve_workc(inv);
+	workers	= malloc(sizeof(* workers) * workc);
+	if (NULL == workers)
+	{
+		free	(s);
+		return	HT_FR_FAIL_ALLOC;
+	}
+	for (i = (size_t)0; i < workc; i++)
+	{
+		workers[i].s		= s;
+		workers[i].games	= NULL;
+		workers[i].gamec	= 0;
+	}
+
+#ifdef HT_POSIX
+	if (0 != pthread_mutex_init(& s->mutex, NULL))
+	{
+		fr	= HT_FR_FAIL_POSIX;
+	}
+	else if (0 != pthread_cond_init(& s->cond, NULL))
+	{
+		(void) pthread_mutex_destroy	(& s->mutex);
+		fr	= HT_FR_FAIL_POSIX;
+	}
+	else
+	{
+		fr	= serve_loop(s, workers, workc);
+		(void) pthread_cond_destroy	(& s->cond);
+		(void) pthread_mutex_destroy	(& s->mutex);
+	}
+#else
+	fr	= serve_loop(s, workers, workc);
+#endif
+
+	for (i = (size_t)0; i < workc; i++)
+	{
+		serve_worker_free	(& workers[i]);
+	}
+	free	(workers);
+	for (i = (size_t)0; i < s->queuec; i++)
+	{
+		/*
+		 * Only left if a worker failed. Games that are also in
+		 * s->games are freed below.
+		 */
+		struct serve_game * const sg	=
+			s->queue[(s->queue_first + i) % s->queuecap];
+		if (sg->dead)
+		{
+			serve_game_free	(sg);
+		}
+	}
+	free	(s->queue);
+	for (i = (size_t)0; i < s->gamec; i++)
+	{
+		if (NULL != s->games[i])
+		{
+			serve_game_free	(s->games[i]);
+		}
+	}
+	free	(s->games);
+	for (i = (size_t)0; i < s->variantc; i++)
+	{
+		free_game	(s->variants[i]->g);
+		free		(s->variants[i]->file);
+		free		(s->variants[i]);
+	}
+	free	(s->variants);
+	free	(s);
+	return	fr;
+}
+
+#endif
+
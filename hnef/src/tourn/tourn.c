@@ -0,0 +1,1357 @@
+/* Copyright 2013 Alexander Söderlund.
+ *
+ * This file is part of HNEFATAFL.
+ *
+ * HNEFATAFL is free software: you can distribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * HNEFATAFL is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HT_AI_MINIMAX
+
+#include <math.h>	/* log, log10, pow, sqrt */
+#include <stdio.h>	/* fopen, fclose, printf, fprintf, stderr */
+#include <stdlib.h>	/* malloc, free */
+#include <string.h>	/* strcmp */
+
+#ifdef HT_POSIX
+#include <pthread.h>	/* pthread_* */
+#include <unistd.h>	/* sysconf */
+#endif
+
+#include "aimalgo.h"	/* aiminimax_command */
+#ifdef HT_AI_MINIMAX_HASH
+#include "aimhash.h"	/* zhashtable_clear */
+#endif
+#include "aiminimax.h"	/* alloc_aiminimax_init, free_aiminimax */
+#include "aiminimaxt.h"	/* aiminimax */
+#include "board.h"	/* board_moves_get, game_move, game_over */
+#include "func.h"	/* fail_rreader_what */
+#include "game.h"	/* alloc_game_share, game_initopt, ... */
+#include "invoct.h"	/* invoc */
+#include "iogen.h"	/* print_err_fr_rreader */
+#include "iotextparse.h"	/* alloc_ht_line, ht_line_readtext */
+#include "lang.h"	/* HT_L_* */
+#include "listm.h"	/* alloc_listm, free_listm, listm_clear */
+#include "num.h"	/* texttoushort, texttoulong, texttoint */
+#include "playert.h"	/* HT_PLAYER_UNINIT */
+#include "rng.h"	/* ht_rng_seed, ht_rng_next */
+#include "rreader.h"	/* alloc_game_read, game_weights_read */
+#include "rvalid.h"	/* ruleset_valid */
+#include "timer.h"	/* ht_timer_ms */
+#include "tourn.h"
+#include "ui.h"		/* ui_action_init */
+#include "uit.h"	/* ui, ui_action */
+
+/*
+ * Word in a tournament file that means the ruleset's own weights.
+ */
+/*@observer@*/
+/*@unchecked@*/
+static
+const char * const HT_TOURN_WEIGHTS_RULES	= "-";
+
+/*
+ * Default values of the tournament file settings.
+ */
+/*@unchecked@*/
+static
+const unsigned long HT_TOURN_GAMES_DEF		= 100ul;
+
+/*@unchecked@*/
+static
+const unsigned short HT_TOURN_OPENING_DEF	= (unsigned short)4;
+
+/*@unchecked@*/
+static
+const unsigned long HT_TOURN_SEED_DEF		= 1ul;
+
+/*@unchecked@*/
+static
+const unsigned short HT_TOURN_PLIES_DEF		= (unsigned short)500;
+
+/*
+ * Probability of accepting H1 when H0 is true (alpha), and of
+ * accepting H0 when H1 is true (beta), in the sequential probability
+ * ratio test.
+ */
+/*@unchecked@*/
+static
+const double HT_TOURN_SPRT_ALPHA	= 0.05;
+
+/*@unchecked@*/
+static
+const double HT_TOURN_SPRT_BETA		= 0.05;
+
+/*
+ * Default capacity of the move list used for the openings.
+ */
+/*@unchecked@*/
+static
+const size_t HT_TOURN_LIST_CAP_DEF	= (size_t)80;
+
+/*
+ * Computer player A (index 0) and B (index 1).
+ */
+#define HT_TOURN_SIDES 2
+
+/*
+ * Settings read from the tournament file.
+ */
+struct tourn_conf
+{
+
+	/*
+	 * Amount of games. Every opening is played twice, with A and B
+	 * taking turns to be player 0.
+	 */
+	unsigned long	games;
+
+	/*
+	 * Search depth of A and B.
+	 */
+	unsigned short	depth[HT_TOURN_SIDES];
+
+	/*
+	 * Milliseconds that A and B may search every move, or 0 to
+	 * always search to depth.
+	 */
+	unsigned long	time[HT_TOURN_SIDES];
+
+	/*
+	 * Weights files of A and B, or NULL for the ruleset's own.
+	 */
+/*@null@*/
+/*@only@*/
+	char *		weights[HT_TOURN_SIDES];
+
+	/*
+	 * Amount of random plies before the computer players start.
+	 */
+	unsigned short	opening;
+
+	/*
+	 * Seed of the random openings.
+	 */
+	unsigned long	seed;
+
+	/*
+	 * A game that isn't over after this many plies is a draw.
+	 */
+	unsigned short	plies;
+
+	/*
+	 * Elo difference of H0 and H1 in the sequential probability
+	 * ratio test, if sprt.
+	 */
+	int		elo0;
+
+	int		elo1;
+
+	HT_BOOL		sprt;
+
+	/*
+	 * Amount of games played at the same time, or 0 for one per
+	 * processor.
+	 */
+	unsigned short	threads;
+
+};
+
+/*
+ * State shared by all workers. Guarded by mutex with HT_POSIX.
+ */
+struct tourn
+{
+
+/*@dependent@*/
+/*@notnull@*/
+	const struct tourn_conf *	conf;
+
+	/*
+	 * Index of the next game to play.
+	 */
+	unsigned long			next;
+
+	/*
+	 * Games won, lost and drawn by A.
+	 */
+	unsigned long			win;
+
+	unsigned long			loss;
+
+	unsigned long			draw;
+
+	/*
+	 * Set when the SPRT has accepted a hypothesis, or when a worker
+	 * has failed. No more games are started.
+	 */
+	HT_BOOL				stop;
+
+	/*
+	 * First failure of a worker.
+	 */
+	enum HT_FR			fr;
+
+#ifdef HT_POSIX
+	pthread_mutex_t			mutex;
+#endif
+
+};
+
+/*
+ * A worker, which plays one game at a time.
+ */
+struct tourn_worker
+{
+
+/*@dependent@*/
+/*@notnull@*/
+	struct tourn *		t;
+
+	/*
+	 * The game with A's and B's weights. Both are kept at the same
+	 * position.
+	 */
+/*@owned@*/
+/*@null@*/
+	struct game *		g[HT_TOURN_SIDES];
+
+	/*
+	 * A's and B's computer players, made once for all games of the
+	 * worker.
+	 */
+/*@owned@*/
+/*@null@*/
+	struct aiminimax *	aim[HT_TOURN_SIDES];
+
+/*@owned@*/
+/*@null@*/
+	struct listm *		moves;
+
+	/*
+	 * Generator of the opening of the current game.
+	 */
+	struct ht_rng		rng;
+
+#ifdef HT_POSIX
+	pthread_t		thread;
+#endif
+
+};
+
+/*
+ * Expected score of a player that is elo stronger.
+ */
+static
+double
+tourn_elo_score (
+	const double	elo
+	)
+/*@modifies nothing@*/
+{
+	return	1.0 / (1.0 + pow(10.0, -elo / 400.0));
+}
+
+/*
+ * Elo difference that gives the expected score.
+ */
+static
+double
+tourn_score_elo (
+	const double	score
+	)
+/*@modifies nothing@*/
+{
+	const double s	= score < 1.0e-6 ? 1.0e-6
+			: score > 1.0 - 1.0e-6 ? 1.0 - 1.0e-6 : score;
+	return	400.0 * log10(s / (1.0 - s));
+}
+
+/*
+ * Sets score to A's mean score in t, and var to the variance of the
+ * score of a game.
+ */
+static
+void
+tourn_score (
+/*@in@*/
+/*@notnull@*/
+	const struct tourn * const	t,
+/*@out@*/
+/*@notnull@*/
+	double * const			score,
+/*@out@*/
+/*@notnull@*/
+	double * const			var
+	)
+/*@modifies * score, * var@*/
+{
+	const double	n	= (double)(t->win + t->loss + t->draw);
+	const double	s	= ((double)t->win
+				+ (double)t->draw / 2.0) / n;
+	* score	= s;
+	* var	= ((double)t->win * (1.0 - s) * (1.0 - s)
+		+ (double)t->loss * s * s
+		+ (double)t->draw * (0.5 - s) * (0.5 - s)) / n;
+}
+
+/*
+ * Returns the log-likelihood ratio of H1 (A is t->conf->elo1
+ * stronger) against H0 (A is t->conf->elo0 stronger), using the normal
+ * approximation of the game scores.
+ */
+static
+double
+tourn_llr (
+/*@in@*/
+/*@notnull@*/
+	const struct tourn * const	t
+	)
+/*@modifies nothing@*/
+{
+	const double	n	= (double)(t->win + t->loss + t->draw);
+	const double	s0	=
+		tourn_elo_score((double)t->conf->elo0);
+	const double	s1	=
+		tourn_elo_score((double)t->conf->elo1);
+	double		score, var;
+
+	tourn_score(t, & score, & var);
+	if (var < 1.0e-9)
+	{
+		/*
+		 * All results are the same so far.
+		 */
+		return	0.0;
+	}
+	return	n * (s1 - s0) * (2.0 * score - s0 - s1) / (2.0 * var);
+}
+
+/*
+ * Plays the opening of game with w->rng: random moves until
+ * t->conf->opening plies, or until the game is over.
+ */
+static
+enum HT_FR
+tourn_opening (
+/*@in@*/
+/*@notnull@*/
+	struct tourn_worker * const	w
+	)
+/*@modifies * w@*/
+{
+	struct game * const	g	= w->g[0];
+	enum HT_FR		fr	= HT_FR_NONE;
+	unsigned short		winner	= HT_PLAYER_UNINIT;
+
+	while (g->movehist->elemc < (size_t)w->t->conf->opening
+	&& !game_over(g, & winner))
+	{
+		const struct move *	mov;
+		unsigned short		i;
+
+		listm_clear(w->moves);
+		fr	= board_moves_get(g, g->b, g->movehist,
+			w->moves);
+		if (HT_FR_SUCCESS != fr)
+		{
+			return	fr;
+		}
+		mov	= & w->moves->elems[ht_rng_next(& w->rng)
+			% (HT_U64)w->moves->elemc];
+		for (i = (unsigned short)0; i < HT_TOURN_SIDES; i++)
+		{
+			HT_BOOL legal	= HT_FALSE;
+			fr	= game_move(w->g[i], mov->pos,
+				mov->dest, & legal);
+			if (HT_FR_SUCCESS != fr)
+			{
+				return	fr;
+			}
+			if (!legal)
+			{
+				return	HT_FR_FAIL_ILL_STATE;
+			}
+		}
+	}
+	return	HT_FR_SUCCESS;
+}
+
+/*
+ * Plays game number game, where A is player game % 2, and sets score
+ * to A's score (1, 0.5 or 0) and plies to the length of the game.
+ *
+ * The computer players of w are set to play for their player index
+ * in this game, and their transposition tables are cleared, so that
+ * no game is searched with what was learned in the last one.
+ */
+static
+enum HT_FR
+tourn_game (
+/*@in@*/
+/*@notnull@*/
+	struct tourn_worker * const	w,
+	const unsigned long		game,
+/*@out@*/
+/*@notnull@*/
+	double * const			score,
+/*@out@*/
+/*@notnull@*/
+	size_t * const			plies
+	)
+/*@globals errno, fileSystem, stdout, internalState@*/
+/*@modifies errno, fileSystem, stdout, internalState, * w, * score@*/
+/*@modifies * plies@*/
+{
+	const struct tourn_conf * const conf	= w->t->conf;
+	const unsigned short	p_a	= (unsigned short)(game % 2ul);
+	struct ui		interf;
+	enum HT_FR		fr	= HT_FR_NONE;
+	unsigned short		winner	= HT_PLAYER_UNINIT;
+	unsigned short		i;
+
+	interf.type	= HT_UIT_NONE;
+	for (i = (unsigned short)0; i < HT_TOURN_SIDES; i++)
+	{
+		if (NULL == w->aim[i])
+		{
+			return	HT_FR_FAIL_NULLPTR;
+		}
+		fr	= game_board_reset(w->g[i]);
+		if (HT_FR_SUCCESS != fr)
+		{
+			return	fr;
+		}
+		fr	= aiminimax_player_set(w->g[i], w->aim[i],
+			0 == i ? p_a : (unsigned short)(1 - p_a));
+		if (HT_FR_SUCCESS != fr)
+		{
+			return	fr;
+		}
+#ifdef HT_AI_MINIMAX_HASH
+		zhashtable_clear(w->aim[i]->tp_tab);
+#endif
+	}
+
+	/*
+	 * Both games of a pair get the same opening.
+	 */
+	ht_rng_seed(& w->rng, conf->seed + game / 2ul);
+	fr	= tourn_opening(w);
+
+	while (HT_FR_SUCCESS == fr && !game_over(w->g[0], & winner)
+	&& w->g[0]->movehist->elemc < (size_t)conf->plies)
+	{
+		const unsigned short side =
+			p_a == w->g[0]->b->turn ? 0 : 1;
+		struct aiminimax * const aim	= w->aim[side];
+		struct ui_action	act;
+
+		ui_action_init(& act);
+		aim->time_start	= ht_timer_ms();
+		aim->time_max	= conf->time[side];
+		fr	= aiminimax_command(w->g[side], & interf, aim,
+			& act);
+		if (HT_FR_SUCCESS == fr && HT_UI_ACT_MOVE != act.type)
+		{
+			fr	= HT_FR_FAIL_ILL_STATE;
+		}
+		for (i = (unsigned short)0; HT_FR_SUCCESS == fr
+			&& i < HT_TOURN_SIDES; i++)
+		{
+			HT_BOOL legal	= HT_FALSE;
+			fr	= game_move(w->g[i], act.info.mov.pos,
+				act.info.mov.dest, & legal);
+			if (HT_FR_SUCCESS == fr && !legal)
+			{
+				fr	= HT_FR_FAIL_ILL_STATE;
+			}
+		}
+	}
+
+	if (HT_FR_SUCCESS != fr)
+	{
+		return	fr;
+	}
+
+	* plies	= w->g[0]->movehist->elemc;
+	if (!game_over(w->g[0], & winner) || HT_PLAYER_UNINIT == winner)
+	{
+		* score	= 0.5;
+	}
+	else
+	{
+		* score	= p_a == winner ? 1.0 : 0.0;
+	}
+	return	HT_FR_SUCCESS;
+}
+
+/*
+ * Adds the result of game to t and prints it. Sets t->stop if the SPRT
+ * has accepted a hypothesis.
+ *
+ * With HT_POSIX, t->mutex must be locked.
+ */
+static
+enum HT_FR
+tourn_result (
+/*@in@*/
+/*@notnull@*/
+	struct tourn * const		t,
+	const unsigned long		game,
+	const double			score,
+	const size_t			plies
+	)
+/*@globals fileSystem, errno, stdout@*/
+/*@modifies fileSystem, errno, stdout, * t@*/
+{
+	char	res;
+	if (score > 0.75)
+	{
+		t->win++;
+		res	= '+';
+	}
+	else if (score < 0.25)
+	{
+		t->loss++;
+		res	= '-';
+	}
+	else
+	{
+		t->draw++;
+		res	= '=';
+	}
+
+	if (t->conf->sprt)
+	{
+		const double llr	= tourn_llr(t);
+		if (llr >= log((1.0 - HT_TOURN_SPRT_BETA)
+			/ HT_TOURN_SPRT_ALPHA)
+		|| llr <= log(HT_TOURN_SPRT_BETA
+			/ (1.0 - HT_TOURN_SPRT_ALPHA)))
+		{
+			t->stop	= HT_TRUE;
+		}
+	}
+
+	return	printf("%lu\t%lu\t%c\t%lu\t%lu\t%lu\t%lu\n", game,
+		game % 2ul, res, (unsigned long)plies, t->win, t->loss,
+		t->draw) < 0 ? HT_FR_FAIL_IO_PRINT : HT_FR_SUCCESS;
+}
+
+/*
+ * Locks t->mutex with HT_POSIX.
+ */
+static
+void
+tourn_lock (
+/*@in@*/
+/*@notnull@*/
+	struct tourn * const	t
+	)
+/*@modifies * t@*/
+{
+#ifdef HT_POSIX
+	(void) pthread_mutex_lock	(& t->mutex);
+#else
+	(void) t;
+#endif
+}
+
+static
+void
+tourn_unlock (
+/*@in@*/
+/*@notnull@*/
+	struct tourn * const	t
+	)
+/*@modifies * t@*/
+{
+#ifdef HT_POSIX
+	(void) pthread_mutex_unlock	(& t->mutex);
+#else
+	(void) t;
+#endif
+}
+
+/*
+ * Plays the next game in w->t until there are none left, or until the
+ * tournament is stopped.
+ */
+static
+void
+tourn_work (
+/*@in@*/
+/*@notnull@*/
+	struct tourn_worker * const	w
+	)
+/*@globals errno, fileSystem, stdout, internalState@*/
+/*@modifies errno, fileSystem, stdout, internalState, * w@*/
+{
+	struct tourn * const	t	= w->t;
+
+	for (;;)
+	{
+		enum HT_FR	fr	= HT_FR_NONE;
+		unsigned long	game;
+		double		score	= 0.0;
+		size_t		plies	= 0;
+
+		tourn_lock	(t);
+		if (t->stop || t->next >= t->conf->games)
+		{
+			tourn_unlock	(t);
+			return;
+		}
+		game	= t->next++;
+		tourn_unlock	(t);
+
+		fr	= tourn_game(w, game, & score, & plies);
+
+		tourn_lock	(t);
+		if (HT_FR_SUCCESS == fr)
+		{
+			fr	= tourn_result(t, game, score, plies);
+		}
+		if (HT_FR_SUCCESS != fr && HT_FR_SUCCESS == t->fr)
+		{
+			t->fr	= fr;
+			t->stop	= HT_TRUE;
+		}
+		tourn_unlock	(t);
+	}
+}
+
+#ifdef HT_POSIX
+
+/*@null@*/
+static
+void *
+tourn_work_thread (
+/*@in@*/
+/*@notnull@*/
+	void * const	arg
+	)
+/*@globals errno, fileSystem, stdout, internalState@*/
+/*@modifies errno, fileSystem, stdout, internalState, arg@*/
+{
+	tourn_work	(arg);
+	return		NULL;
+}
+
+#endif
+
+/*
+ * Sets up the games of both sides of w, with the weights in
+ * conf->weights. If shared is NULL, the ruleset is read for the first
+ * side, and the second side shares it. Else both sides share the
+ * ruleset and weights of the games in shared, so the ruleset is only
+ * read once for the whole tournament.
+ */
+static
+enum HT_FR
+tourn_worker_init (
+/*@in@*/
+/*@notnull@*/
+	const struct invoc * const	inv,
+/*@in@*/
+/*@notnull@*/
+	const struct tourn_conf * const	conf,
+/*@in@*/
+/*@notnull@*/
+	struct ht_line * const		line,
+/*@in@*/
+/*@null@*/
+	const struct tourn_worker * const	shared,
+/*@in@*/
+/*@notnull@*/
+	struct tourn_worker * const	w
+	)
+/*@globals fileSystem, errno, stderr@*/
+/*@modifies fileSystem, errno, stderr, * line, * w@*/
+{
+	enum HT_FR		fr		= HT_FR_NONE;
+	enum HT_FAIL_RREADER	fail_read	= HT_FAIL_RREADER_NONE;
+	struct game *		g;
+	unsigned short		i;
+
+	w->moves	= alloc_listm(HT_TOURN_LIST_CAP_DEF);
+	if (NULL == w->moves)
+	{
+		return	HT_FR_FAIL_ALLOC;
+	}
+
+	if (NULL != shared)
+	{
+		for (i = (unsigned short)0; i < HT_TOURN_SIDES; i++)
+		{
+			if (NULL == shared->g[i])
+			{
+				return	HT_FR_FAIL_NULLPTR;
+			}
+			w->g[i]	= alloc_game_share(shared->g[i]);
+			if (NULL == w->g[i])
+			{
+				return	HT_FR_FAIL_ALLOC;
+			}
+		}
+		return	HT_FR_SUCCESS;
+	}
+
+	g	= alloc_game_read(inv->file_rc, line, & fr,
+		& fail_read);
+	if (HT_FR_SUCCESS != fr || NULL == g)
+	{
+		(void) print_err_fr_rreader(stderr, fr, fail_read,
+			line);
+		if (NULL != g)
+		{
+			free_game	(g);
+		}
+		return	HT_FR_FAIL_RREADER;
+	}
+	w->g[0]	= g;
+
+	game_initopt(g);
+	fr	= HT_FR_SUCCESS;
+#ifdef HT_AI_MINIMAX_HASH
+	if (inv->zobrist_seed_set)
+	{
+		fr	= game_zobrist_seed(g, inv->zobrist_seed);
+	}
+	if (inv->hash_mem_set)
+	{
+		g->hash_conf.mem_tab		= inv->hash_mem;
+	}
+#endif
+	if (HT_FR_SUCCESS == fr)
+	{
+		fr	= game_board_reset(g);
+	}
+	if (HT_FR_SUCCESS != fr)
+	{
+		return	fr;
+	}
+	{
+		const char * const why	= ruleset_valid(g);
+		if (NULL != why)
+		{
+			(void) fputs	(why,	stderr);
+			(void) fputc	('\n',	stderr);
+			return		HT_FR_FAIL_RREADER;
+		}
+	}
+
+	/*
+	 * The second side is made before the weights are read, so that
+	 * it has the ruleset's weights unless it's given its own.
+	 */
+	w->g[1]	= alloc_game_share(g);
+	if (NULL == w->g[1])
+	{
+		return	HT_FR_FAIL_ALLOC;
+	}
+	for (i = (unsigned short)0; i < HT_TOURN_SIDES; i++)
+	{
+		if (NULL == conf->weights[i])
+		{
+			continue;
+		}
+		fr	= game_weights_read(conf->weights[i], line,
+			w->g[i], & fail_read);
+		if (HT_FR_SUCCESS != fr)
+		{
+			(void) fputs	(conf->weights[i], stderr);
+			(void) fputc	('\n', stderr);
+			(void) print_err_fr_rreader(stderr, fr,
+				fail_read, line);
+			return	HT_FR_FAIL_RREADER;
+		}
+	}
+	return	HT_FR_SUCCESS;
+}
+
+/*
+ * Makes the computer players of w, which search to conf->depth, for
+ * the games made by tourn_worker_init.
+ */
+static
+enum HT_FR
+tourn_worker_players (
+/*@in@*/
+/*@notnull@*/
+	const struct tourn_conf * const	conf,
+/*@in@*/
+/*@notnull@*/
+	struct tourn_worker * const	w
+	)
+/*@globals errno, internalState@*/
+/*@modifies errno, internalState, * w@*/
+{
+	enum HT_FR	fr	= HT_FR_NONE;
+	unsigned short	i;
+
+	for (i = (unsigned short)0; i < HT_TOURN_SIDES; i++)
+	{
+		if (NULL == w->g[i])
+		{
+			return	HT_FR_FAIL_NULLPTR;
+		}
+		w->aim[i]	= alloc_aiminimax_init(w->g[i], i,
+			conf->depth[i], & fr
+#ifdef HT_AI_MINIMAX_HASH
+			, NULL
+#endif
+			);
+		if (HT_FR_SUCCESS != fr || NULL == w->aim[i])
+		{
+			return	HT_FR_SUCCESS == fr ? HT_FR_FAIL_ALLOC
+				: fr;
+		}
+	}
+	return	HT_FR_SUCCESS;
+}
+
+static
+void
+tourn_worker_free (
+/*@in@*/
+/*@notnull@*/
+	struct tourn_worker * const	w
+	)
+/*@modifies * w@*/
+{
+	unsigned short i;
+	for (i = (unsigned short)0; i < HT_TOURN_SIDES; i++)
+	{
+		if (NULL != w->aim[i])
+		{
+			free_aiminimax	(w->aim[i]);
+			w->aim[i]	= NULL;
+		}
+		if (NULL != w->g[i])
+		{
+			free_game	(w->g[i]);
+			w->g[i]		= NULL;
+		}
+	}
+	if (NULL != w->moves)
+	{
+		free_listm	(w->moves);
+		w->moves	= NULL;
+	}
+}
+
+/*
+ * Copies str to a new string in dest.
+ */
+static
+enum HT_FR
+tourn_strdup (
+/*@in@*/
+/*@notnull@*/
+	const char * const	str,
+/*@out@*/
+/*@notnull@*/
+	char * * const		dest
+	)
+/*@modifies * dest@*/
+{
+	* dest	= malloc(strlen(str) + (size_t)1);
+	if (NULL == * dest)
+	{
+		return	HT_FR_FAIL_ALLOC;
+	}
+	(void) strcpy	(* dest, str);
+	return		HT_FR_SUCCESS;
+}
+
+/*
+ * Reads a line of the tournament file into conf. fail_read is set if
+ * it's not valid.
+ */
+static
+enum HT_FR
+tourn_conf_line (
+/*@in@*/
+/*@notnull@*/
+	const struct ht_line * const		line,
+/*@in@*/
+/*@notnull@*/
+	struct tourn_conf * const		conf,
+/*@in@*/
+/*@notnull@*/
+	enum HT_FAIL_RREADER * const		fail_read
+	)
+/*@globals errno@*/
+/*@modifies errno, * conf, * fail_read@*/
+{
+	const char * const	arg0	= line->words[0].chars;
+	size_t			argc	= (size_t)2;
+	HT_BOOL			valid	= HT_FALSE;
+
+	if (0 == strcmp(arg0, HT_L_TOURN_CMD_DEPTH)
+	|| 0 == strcmp(arg0, HT_L_TOURN_CMD_TIME)
+	|| 0 == strcmp(arg0, HT_L_TOURN_CMD_WEIGHTS)
+	|| 0 == strcmp(arg0, HT_L_TOURN_CMD_SPRT))
+	{
+		argc	= (size_t)3;
+	}
+	if (line->wordc < argc)
+	{
+		* fail_read	= HT_FAIL_RREADER_ARG_MISS;
+		return		HT_FR_FAIL_RREADER;
+	}
+	else if (line->wordc > argc)
+	{
+		* fail_read	= HT_FAIL_RREADER_ARG_EXCESS;
+		return		HT_FR_FAIL_RREADER;
+	}
+
+	if (0 == strcmp(arg0, HT_L_TOURN_CMD_GAMES))
+	{
+		valid	= texttoulong(line->words[1].chars,
+				& conf->games)
+			&& conf->games > 0ul;
+	}
+	else if (0 == strcmp(arg0, HT_L_TOURN_CMD_DEPTH))
+	{
+		valid	= texttoushort(line->words[1].chars,
+				& conf->depth[0])
+			&& texttoushort(line->words[2].chars,
+				& conf->depth[1])
+			&& aiminimax_depth_max_valid(conf->depth[0])
+			&& aiminimax_depth_max_valid(conf->depth[1]);
+	}
+	else if (0 == strcmp(arg0, HT_L_TOURN_CMD_TIME))
+	{
+		valid	= texttoulong(line->words[1].chars,
+				& conf->time[0])
+			&& texttoulong(line->words[2].chars,
+				& conf->time[1]);
+	}
+	else if (0 == strcmp(arg0, HT_L_TOURN_CMD_WEIGHTS))
+	{
+		unsigned short i;
+		for (i = (unsigned short)0; i < HT_TOURN_SIDES; i++)
+		{
+			const char * const file	=
+				line->words[1 + i].chars;
+			if (NULL != conf->weights[i])
+			{
+				free	(conf->weights[i]);
+				conf->weights[i]	= NULL;
+			}
+			if (0 != strcmp(file, HT_TOURN_WEIGHTS_RULES)
+			&& HT_FR_SUCCESS != tourn_strdup(file,
+				& conf->weights[i]))
+			{
+				return	HT_FR_FAIL_ALLOC;
+			}
+		}
+		valid	= HT_TRUE;
+	}
+	else if (0 == strcmp(arg0, HT_L_TOURN_CMD_OPENING))
+	{
+		valid	= texttoushort(line->words[1].chars,
+			& conf->opening);
+	}
+	else if (0 == strcmp(arg0, HT_L_TOURN_CMD_SEED))
+	{
+		valid	= texttoulong(line->words[1].chars,
+			& conf->seed);
+	}
+	else if (0 == strcmp(arg0, HT_L_TOURN_CMD_PLIES))
+	{
+		valid	= texttoushort(line->words[1].chars,
+				& conf->plies)
+			&& conf->plies > (unsigned short)0;
+	}
+	else if (0 == strcmp(arg0, HT_L_TOURN_CMD_SPRT))
+	{
+		valid	= texttoint(line->words[1].chars, & conf->elo0)
+			&& texttoint(line->words[2].chars, & conf->elo1)
+			&& conf->elo0 < conf->elo1;
+		conf->sprt	= valid;
+	}
+	else if (0 == strcmp(arg0, HT_L_TOURN_CMD_THREADS))
+	{
+		valid	= texttoushort(line->words[1].chars,
+			& conf->threads);
+	}
+	else
+	{
+		* fail_read	= HT_FAIL_RREADER_ARG_UNK;
+		return		HT_FR_FAIL_RREADER;
+	}
+
+	if (!valid)
+	{
+		* fail_read	= HT_FAIL_RREADER_NOOB;
+		return		HT_FR_FAIL_RREADER;
+	}
+	return	HT_FR_SUCCESS;
+}
+
+/*
+ * Reads the tournament file inv->file_tourn into conf, which must be
+ * initialized. A line that's not valid is printed with its line
+ * number, and HT_FR_FAIL_RREADER is returned.
+ */
+static
+enum HT_FR
+tourn_conf_read (
+/*@in@*/
+/*@notnull@*/
+	const struct invoc * const	inv,
+/*@in@*/
+/*@notnull@*/
+	struct ht_line * const		line,
+/*@in@*/
+/*@notnull@*/
+	struct tourn_conf * const	conf
+	)
+/*@globals fileSystem, errno, stderr@*/
+/*@modifies fileSystem, errno, stderr, * line, * conf@*/
+{
+	enum HT_FR		fr		= HT_FR_SUCCESS;
+	enum HT_FAIL_RREADER	fail_read	= HT_FAIL_RREADER_NONE;
+	unsigned long		lineno		= 0;
+	FILE * const		file	= fopen(inv->file_tourn, "r");
+	struct ht_text *	text	= NULL;
+
+	if (NULL == file)
+	{
+		return	HT_FR_FAIL_IO_FILE_R;
+	}
+	text	= alloc_ht_text(file, & fr);
+	if (0 != fclose(file) && HT_FR_SUCCESS == fr)
+	{
+		fr	= HT_FR_FAIL_IO_FILE_R;
+	}
+	if (HT_FR_SUCCESS != fr || NULL == text)
+	{
+		if (NULL != text)
+		{
+			free_ht_text	(text);
+		}
+		return	fr;
+	}
+
+	while (HT_FR_SUCCESS == fr && !ht_text_eof(text))
+	{
+		fr	= ht_line_readtext(text, line);
+		lineno++;
+		if (HT_FR_SUCCESS != fr || ht_line_empty(line))
+		{
+			continue;
+		}
+		fr	= tourn_conf_line(line, conf, & fail_read);
+		if (HT_FR_FAIL_RREADER == fr)
+		{
+			(void) fprintf(stderr, "%s:%lu: %s\n",
+				inv->file_tourn, lineno,
+				fail_rreader_what(fail_read));
+		}
+	}
+
+	free_ht_text	(text);
+	return		fr;
+}
+
+/*
+ * Returns the amount of workers, which is conf->threads if set, or
+ * else one per processor; but never more than the amount of games.
+ */
+static
+size_t
+tourn_workc (
+/*@in@*/
+/*@notnull@*/
+	const struct tourn_conf * const	conf
+	)
+/*@modifies nothing@*/
+{
+	size_t workc	= (size_t)conf->threads;
+#if defined(HT_POSIX) && !defined(HT_AI_MINIMAX_UNSAFE)
+	if (workc < (size_t)1)
+	{
+		const long cpus	= sysconf(_SC_NPROCESSORS_ONLN);
+		workc	= cpus < 1 ? (size_t)1 : (size_t)cpus;
+	}
+#else
+	/*
+	 * HT_AI_MINIMAX_UNSAFE has a global in aimalgo.c, so only one
+	 * game can be searched at a time.
+	 */
+	workc	= (size_t)1;
+#endif
+	return	(unsigned long)workc > conf->games
+		? (size_t)conf->games : workc;
+}
+
+/*
+ * Prints A's results, Elo difference to B with a 95 % confidence
+ * interval, and the SPRT's log-likelihood ratio and verdict.
+ */
+static
+enum HT_FR
+tourn_print (
+/*@in@*/
+/*@notnull@*/
+	const struct tourn * const	t
+	)
+/*@globals fileSystem, errno, stdout@*/
+/*@modifies fileSystem, errno, stdout@*/
+{
+	const unsigned long	n	= t->win + t->loss + t->draw;
+	double			score, var, err;
+	int			rv;
+
+	if (n < 1ul)
+	{
+		return	HT_FR_SUCCESS;
+	}
+	tourn_score(t, & score, & var);
+	err	= 1.96 * sqrt(var / (double)n);
+
+	rv	= printf("games\t%lu\t+%lu -%lu =%lu\nscore\t%.3f\n"
+		"elo\t%.1f\t[%.1f, %.1f]\n", n, t->win, t->loss,
+		t->draw, score, tourn_score_elo(score),
+		tourn_score_elo(score - err),
+		tourn_score_elo(score + err));
+	if (rv >= 0 && t->conf->sprt)
+	{
+		const double llr	= tourn_llr(t);
+		const double lower	= log(HT_TOURN_SPRT_BETA
+					/ (1.0 - HT_TOURN_SPRT_ALPHA));
+		const double upper	= log((1.0 - HT_TOURN_SPRT_BETA)
+					/ HT_TOURN_SPRT_ALPHA);
+		rv	= printf("sprt\t%d %d\t%.2f\t[%.2f, %.2f]"
+			"\t%s\n", t->conf->elo0, t->conf->elo1, llr,
+			lower, upper,
+			llr >= upper ? "H1"
+			: llr <= lower ? "H0" : "-");
+	}
+	return	rv < 0 ? HT_FR_FAIL_IO_PRINT : HT_FR_SUCCESS;
+}
+
+/*
+ * Runs the workers in t, in their own threads with HT_POSIX.
+ */
+static
+enum HT_FR
+tourn_play (
+/*@in@*/
+/*@notnull@*/
+	struct tourn_worker * const	workers,
+	const size_t			workc
+	)
+/*@globals errno, fileSystem, stdout, internalState@*/
+/*@modifies errno, fileSystem, stdout, internalState, * workers@*/
+{
+#ifdef HT_POSIX
+	enum HT_FR	fr	= HT_FR_SUCCESS;
+	size_t		threadc	= (size_t)1;
+	size_t		i;
+
+	/*
+	 * The first worker runs in this thread.
+	 */
+	for (; threadc < workc; threadc++)
+	{
+		if (0 != pthread_create(& workers[threadc].thread, NULL,
+			tourn_work_thread, & workers[threadc]))
+		{
+			fr	= HT_FR_FAIL_POSIX;
+			break;
+		}
+	}
+	tourn_work	(& workers[0]);
+	for (i = (size_t)1; i < threadc; i++)
+	{
+		if (0 != pthread_join(workers[i].thread, NULL))
+		{
+			fr	= HT_FR_FAIL_POSIX;
+		}
+	}
+	return	fr;
+#else
+	(void) workc;
+	tourn_work	(& workers[0]);
+	return		HT_FR_SUCCESS;
+#endif
+}
+
+/*
+ * Makes the workers for the tournament in t, with the settings in conf,
+ * lets them play every game, and frees them.
+ */
+static
+enum HT_FR
+tourn_workers (
+/*@in@*/
+/*@notnull@*/
+	const struct invoc * const	inv,
+/*@in@*/
+/*@notnull@*/
+	const struct tourn_conf * const	conf,
+/*@in@*/
+/*@notnull@*/
+	struct ht_line * const		line,
+/*@in@*/
+/*@notnull@*/
+	struct tourn * const		t
+	)
+/*@globals errno, fileSystem, stdout, stderr, internalState@*/
+/*@modifies errno, fileSystem, stdout, stderr, internalState@*/
+/*@modifies * line, * t@*/
+{
+	enum HT_FR		fr	= HT_FR_NONE;
+	const size_t		workc	= tourn_workc(conf);
+	struct tourn_worker * const workers	=
+		malloc(sizeof(* workers) * workc);
+	size_t			i;
+
+	if (NULL == workers)
+	{
+		return	HT_FR_FAIL_ALLOC;
+	}
+	for (i = (size_t)0; i < workc; i++)
+	{
+		workers[i].t		= t;
+		workers[i].g[0]		= workers[i].g[1]	= NULL;
+		workers[i].aim[0]	= workers[i].aim[1]	= NULL;
+		workers[i].moves	= NULL;
+	}
+	fr	= HT_FR_SUCCESS;
+	for (i = (size_t)0; HT_FR_SUCCESS == fr && i < workc; i++)
+	{
+		fr	= tourn_worker_init(inv, conf, line, i > 0
+			? & workers[0] : NULL, & workers[i]);
+		if (HT_FR_SUCCESS == fr)
+		{
+			fr	= tourn_worker_players(conf,
+				& workers[i]);
+		}
+	}
+
+#ifdef HT_POSIX
+	if (HT_FR_SUCCESS == fr && 0 != pthread_mutex_init(& t->mutex,
+		NULL))
+	{
+		fr	= HT_FR_FAIL_POSIX;
+	}
+	else if (HT_FR_SUCCESS == fr)
+	{
+		fr	= tourn_play(workers, workc);
+		(void) pthread_mutex_destroy	(& t->mutex);
+	}
+#else
+	if (HT_FR_SUCCESS == fr)
+	{
+		fr	= tourn_play(workers, workc);
+	}
+#endif
+
+	for (i = (size_t)0; i < workc; i++)
+	{
+		tourn_worker_free	(& workers[i]);
+	}
+	free	(workers);
+	return	fr;
+}
+
+/*
+ * Plays the tournament in the file inv->file_tourn between computer
+ * players A and B on the ruleset inv->file_rc, and prints the result of
+ * every game and then A's results and Elo difference to B.
+ *
+ * Every worker keeps its own games, so games are played at the same
+ * time in different threads with HT_POSIX. The openings are random
+ * plies from the seed, and every opening is played with A as both
+ * players. With "sprt", the tournament stops early when the sequential
+ * probability ratio test accepts either hypothesis.
+ */
+enum HT_FR
+tourn_run (
+	const struct invoc * const	inv
+	)
+{
+	enum HT_FR		fr		= HT_FR_NONE;
+	struct ht_line *	line		= NULL;
+	struct tourn_conf *	conf		= NULL;
+	struct tourn *		t		= NULL;
+	size_t			i;
+
+#ifndef HT_UNSAFE
+	if (NULL == inv || NULL == inv->file_tourn)
+	{
+		return	HT_FR_FAIL_NULLPTR;
+	}
+#endif
+
+	line	= alloc_ht_line((size_t)3, (size_t)18);
+	conf	= malloc(sizeof(* conf));
+	t	= malloc(sizeof(* t));
+	if (NULL == line || NULL == conf || NULL == t)
+	{
+		if (NULL != line)
+		{
+			free_ht_line	(line);
+		}
+		free	(conf);
+		free	(t);
+		return	HT_FR_FAIL_ALLOC;
+	}
+
+	conf->games	= HT_TOURN_GAMES_DEF;
+	conf->depth[0]	= conf->depth[1]	= HT_AIM_DEPTHMAX_MIN;
+	conf->time[0]	= conf->time[1]	= 0ul;
+	conf->weights[0]	= conf->weights[1]	= NULL;
+	conf->opening	= HT_TOURN_OPENING_DEF;
+	conf->seed	= HT_TOURN_SEED_DEF;
+	conf->plies	= HT_TOURN_PLIES_DEF;
+	conf->elo0	= conf->elo1	= 0;
+	conf->sprt	= HT_FALSE;
+	conf->threads	= (unsigned short)0;
+
+	t->conf	= conf;
+	t->next	= t->win	= t->loss	= t->draw	= 0ul;
+	t->stop	= HT_FALSE;
+	t->fr	= HT_FR_SUCCESS;
+
+	fr	= tourn_conf_read(inv, line, conf);
+	if (HT_FR_SUCCESS == fr)
+	{
+		fr	= tourn_workers(inv, conf, line, t);
+	}
+	if (HT_FR_SUCCESS == fr)
+	{
+		fr	= t->fr;
+	}
+	if (HT_FR_SUCCESS == fr)
+	{
+		fr	= tourn_print(t);
+	}
+
+	for (i = (size_t)0; i < HT_TOURN_SIDES; i++)
+	{
+		free	(conf->weights[i]);
+	}
+	free		(t);
+	free		(conf);
+	free_ht_line	(line);
+	return		fr;
+}
+
+#endif
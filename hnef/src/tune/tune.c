@@ -0,0 +1,950 @@
+/* Copyright 2013 Alexander Söderlund.
+ *
+ * This file is part of HNEFATAFL.
+ *
+ * HNEFATAFL is free software: you can distribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * HNEFATAFL is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HT_AI_MINIMAX
+
+#include <math.h>	/* exp, log, sqrt */
+#include <stdio.h>	/* fopen, fclose, printf, fprintf, stderr */
+#include <stdlib.h>	/* malloc, realloc, calloc, free */
+#include <string.h>	/* strcmp */
+
+#ifdef HT_POSIX
+#include <pthread.h>	/* pthread_create, pthread_join */
+#include <unistd.h>	/* sysconf */
+#endif
+
+#include "aimalgo.h"	/* aiminimax_features */
+#include "aimeval.h"	/* aimeval_term_name, HT_AIM_EVAL_WEIGHT_MAX */
+#include "aiminimax.h"	/* aiminimax_board_escval_init */
+#include "board.h"	/* game_move, game_over */
+#include "game.h"	/* game_initopt, game_board_reset */
+#include "invoct.h"	/* invoc */
+#include "iogen.h"	/* print_err_fr_rreader */
+#include "iotextparse.h"	/* alloc_ht_line, ht_line_readtext */
+#include "lang.h"	/* HT_L_* */
+#include "num.h"	/* texttoushort */
+#include "playert.h"	/* HT_PLAYER_UNINIT */
+#include "rreader.h"	/* alloc_game_read */
+#include "rvalid.h"	/* ruleset_valid */
+#include "tune.h"
+#include "types.h"	/* HT_TYPE_MAX */
+
+/*
+ * Word in a corpus line that means that the game was drawn.
+ */
+/*@observer@*/
+/*@unchecked@*/
+static
+const char * const HT_TUNE_RESULT_DRAW	= "-";
+
+/*
+ * Evaluation that gives the player an expected score of 1 / (1 + e^-1)
+ * (about 73 %). The evaluation is divided by this before it's passed
+ * to the logistic function.
+ *
+ * NOTE:	This only sets the scale of the tuned weights. It's
+ *		about the value of a piece with the default weights.
+ */
+/*@unchecked@*/
+static
+const double HT_TUNE_SCALE	= 1000.0;
+
+/*
+ * Amount of gradient descent iterations over the whole corpus.
+ */
+/*@unchecked@*/
+static
+const unsigned int HT_TUNE_ITER	= 2000;
+
+/*
+ * Step size of gradient descent. With Adam, this is about the largest
+ * amount that a weight changes by in one iteration.
+ */
+/*@unchecked@*/
+static
+const double HT_TUNE_RATE	= 2.0;
+
+/*
+ * Decay rates of the first and second moment estimates, and the term
+ * that prevents division by zero, for Adam.
+ */
+/*@unchecked@*/
+static
+const double HT_TUNE_BETA1	= 0.9;
+
+/*@unchecked@*/
+static
+const double HT_TUNE_BETA2	= 0.999;
+
+/*@unchecked@*/
+static
+const double HT_TUNE_EPS	= 1.0e-8;
+
+/*
+ * Initial capacity of tune_corpus->samples. It's doubled when it's
+ * full.
+ */
+/*@unchecked@*/
+static
+const size_t HT_TUNE_SAMPLES_CAP_DEF	= (size_t)4096;
+
+#ifdef HT_POSIX
+
+/*
+ * Largest amount of worker threads.
+ */
+/*@unchecked@*/
+static
+const size_t HT_TUNE_THREADS_MAX	= (size_t)64;
+
+#endif
+
+/*
+ * A position in the corpus.
+ */
+struct tune_sample
+{
+
+	/*
+	 * aiminimax_features for player 0.
+	 */
+	int	features[HT_AIM_EVAL_TERMC];
+
+	int	fixed;
+
+	/*
+	 * Score of player 0 in the game: 1, 0.5 or 0.
+	 */
+	double	result;
+
+};
+
+struct tune_corpus
+{
+
+/*@owned@*/
+/*@notnull@*/
+	struct tune_sample *	samples;
+
+	size_t			elemc;
+
+	size_t			capc;
+
+};
+
+/*
+ * Part of the corpus that a worker computes the gradient of the loss
+ * over.
+ */
+struct tune_work
+{
+
+/*@dependent@*/
+/*@notnull@*/
+	const struct tune_corpus *	corpus;
+
+/*@dependent@*/
+/*@notnull@*/
+	const double *			weights;
+
+	size_t				from;
+
+	size_t				to;
+
+	/*
+	 * Expected score minus result of every position in the corpus,
+	 * of which the worker only uses [from, to). Kept here rather
+	 * than in registers, which would be spilled across exp and log.
+	 */
+/*@dependent@*/
+/*@notnull@*/
+	double *			diffs;
+
+	/*
+	 * Sum of the gradient and of the loss over [from, to).
+	 */
+	double				grad[HT_AIM_EVAL_TERMC];
+
+	double				loss;
+
+#ifdef HT_POSIX
+	pthread_t			thread;
+#endif
+
+};
+
+/*
+ * State of the gradient descent in tune_fit, kept on the heap so that
+ * the loop doesn't have to spill it around every call to tune_grad.
+ */
+struct tune_descent
+{
+
+/*@owned@*/
+/*@notnull@*/
+	struct tune_work *	works;
+
+	size_t			workc;
+
+	/*
+	 * Mean gradient and mean loss over the corpus.
+	 */
+	double			grad[HT_AIM_EVAL_TERMC];
+
+	double			loss;
+
+	/*
+	 * First and second moment of the gradient, for Adam.
+	 */
+	double			mom1[HT_AIM_EVAL_TERMC];
+
+	double			mom2[HT_AIM_EVAL_TERMC];
+
+	/*
+	 * HT_TUNE_BETA1 and HT_TUNE_BETA2 to the power of the amount of
+	 * steps taken.
+	 */
+	double			beta1t;
+
+	double			beta2t;
+
+};
+
+/*
+ * Adds the gradient and the loss for the positions in work to work.
+ *
+ * The loss is the logistic loss (cross-entropy) of the result and the
+ * expected score of the evaluation.
+ */
+static
+void
+tune_work_grad (
+/*@in@*/
+/*@notnull@*/
+	struct tune_work * const	work
+	)
+/*@modifies work->grad, work->loss, * work->diffs@*/
+{
+	size_t		i;
+	int		j;
+
+	for (j = 0; j < (int)HT_AIM_EVAL_TERMC; j++)
+	{
+		work->grad[j]	= 0.0;
+	}
+	work->loss	= 0.0;
+
+	/*
+	 * The loss first, and then the gradient, which doesn't call
+	 * anything.
+	 */
+	for (i = work->from; i < work->to; i++)
+	{
+		const struct tune_sample * const s =
+			& work->corpus->samples[i];
+		double	eval	= (double)s->fixed;
+		double	p;
+		for (j = 0; j < (int)HT_AIM_EVAL_TERMC; j++)
+		{
+			eval	+= work->weights[j]
+				* (double)s->features[j];
+		}
+		p	= 1.0 / (1.0 + exp(-eval / HT_TUNE_SCALE));
+		/*
+		 * Keep log away from 0.
+		 */
+		p	= p < HT_TUNE_EPS ? HT_TUNE_EPS
+			: p > 1.0 - HT_TUNE_EPS ? 1.0 - HT_TUNE_EPS : p;
+		work->loss	-= s->result * log(p)
+				+ (1.0 - s->result) * log(1.0 - p);
+		work->diffs[i]	= p - s->result;
+	}
+	for (i = work->from; i < work->to; i++)
+	{
+		const struct tune_sample * const s =
+			& work->corpus->samples[i];
+		for (j = 0; j < (int)HT_AIM_EVAL_TERMC; j++)
+		{
+			work->grad[j]	+= work->diffs[i]
+				* (double)s->features[j]
+				/ HT_TUNE_SCALE;
+		}
+	}
+}
+
+#ifdef HT_POSIX
+
+/*@null@*/
+static
+void *
+tune_work_thread (
+/*@in@*/
+/*@notnull@*/
+	void * const	arg
+	)
+/*@modifies arg@*/
+{
+	tune_work_grad	(arg);
+	return		NULL;
+}
+
+#endif
+
+/*
+ * Sets desc->grad and desc->loss to the mean gradient and the mean loss
+ * over corpus with weights.
+ *
+ * The corpus is split evenly between desc->workc workers, which run in
+ * their own threads with HT_POSIX. The sums are added in the order of
+ * the workers, so the result only depends on desc->workc.
+ */
+static
+enum HT_FR
+tune_grad (
+/*@in@*/
+/*@notnull@*/
+	const struct tune_corpus * const	corpus,
+/*@in@*/
+/*@notnull@*/
+	const double * const			weights,
+/*@notnull@*/
+	struct tune_descent * const		desc
+	)
+/*@globals internalState@*/
+/*@modifies internalState, * desc->works, desc->grad, desc->loss@*/
+{
+	struct tune_work * const	works	= desc->works;
+	const size_t			workc	= desc->workc;
+	size_t				i;
+	int				j;
+#ifdef HT_POSIX
+	size_t				threadc	= (size_t)1;
+	enum HT_FR			fr	= HT_FR_SUCCESS;
+#endif
+
+	for (i = (size_t)0; i < workc; i++)
+	{
+		works[i].corpus	= corpus;
+		works[i].weights	= weights;
+		works[i].from	= corpus->elemc * i / workc;
+		works[i].to	= corpus->elemc * (i + 1) / workc;
+	}
+
+#ifdef HT_POSIX
+	/*
+	 * The first worker runs in this thread.
+	 */
+	for (; threadc < workc; threadc++)
+	{
+		if (0 != pthread_create(& works[threadc].thread, NULL,
+			tune_work_thread, & works[threadc]))
+		{
+			fr	= HT_FR_FAIL_POSIX;
+			break;
+		}
+	}
+	tune_work_grad	(& works[0]);
+	for (i = (size_t)1; i < threadc; i++)
+	{
+		if (0 != pthread_join(works[i].thread, NULL))
+		{
+			fr	= HT_FR_FAIL_POSIX;
+		}
+	}
+	if (HT_FR_SUCCESS != fr)
+	{
+		return	fr;
+	}
+#else
+	for (i = (size_t)0; i < workc; i++)
+	{
+		tune_work_grad	(& works[i]);
+	}
+#endif
+
+	for (j = 0; j < (int)HT_AIM_EVAL_TERMC; j++)
+	{
+		desc->grad[j]	= 0.0;
+	}
+	desc->loss	= 0.0;
+	for (i = (size_t)0; i < workc; i++)
+	{
+		for (j = 0; j < (int)HT_AIM_EVAL_TERMC; j++)
+		{
+			desc->grad[j]	+= works[i].grad[j];
+		}
+		desc->loss	+= works[i].loss;
+	}
+	for (j = 0; j < (int)HT_AIM_EVAL_TERMC; j++)
+	{
+		desc->grad[j]	/= (double)corpus->elemc;
+	}
+	desc->loss	/= (double)corpus->elemc;
+	return	HT_FR_SUCCESS;
+}
+
+/*
+ * Fits weights to corpus by gradient descent (with Adam) on the mean
+ * logistic loss, starting from weights. Every weight is kept within
+ * HT_AIM_EVAL_WEIGHT_MAX.
+ *
+ * loss_start and loss_end are the loss before and after.
+ */
+static
+enum HT_FR
+tune_fit (
+/*@in@*/
+/*@notnull@*/
+	const struct tune_corpus * const	corpus,
+	const size_t				workc,
+/*@in@*/
+/*@notnull@*/
+	double * const				weights,
+/*@out@*/
+/*@notnull@*/
+	double * const				loss_start,
+/*@out@*/
+/*@notnull@*/
+	double * const				loss_end
+	)
+/*@globals internalState@*/
+/*@modifies internalState, * weights, * loss_start, * loss_end@*/
+{
+	enum HT_FR		fr	= HT_FR_NONE;
+	struct tune_descent *	desc	= NULL;
+	double *		diffs	= NULL;
+	const double		wmax	=
+		(double)HT_AIM_EVAL_WEIGHT_MAX;
+	unsigned int		iter;
+	size_t			i;
+	int			j;
+
+	/*
+	 * Both moments start at 0.
+	 */
+	desc	= calloc((size_t)1, sizeof(* desc));
+	if (NULL == desc)
+	{
+		return	HT_FR_FAIL_ALLOC;
+	}
+	desc->works	= malloc(sizeof(* desc->works) * workc);
+	diffs		= malloc(sizeof(* diffs) * corpus->elemc);
+	if (NULL == desc->works || NULL == diffs)
+	{
+		free	(desc->works);
+		free	(desc);
+		free	(diffs);
+		return	HT_FR_FAIL_ALLOC;
+	}
+	desc->workc	= workc;
+	desc->beta1t	= 1.0;
+	desc->beta2t	= 1.0;
+	for (i = (size_t)0; i < workc; i++)
+	{
+		desc->works[i].diffs	= diffs;
+	}
+
+	for (iter = 0; iter < HT_TUNE_ITER; iter++)
+	{
+		fr	= tune_grad(corpus, weights, desc);
+		if (HT_FR_SUCCESS != fr)
+		{
+			free	(desc->works);
+			free	(desc);
+			free	(diffs);
+			return	fr;
+		}
+		if (0 == iter)
+		{
+			* loss_start	= desc->loss;
+		}
+
+		desc->beta1t	*= HT_TUNE_BETA1;
+		desc->beta2t	*= HT_TUNE_BETA2;
+		for (j = 0; j < (int)HT_AIM_EVAL_TERMC; j++)
+		{
+			desc->mom1[j]	= HT_TUNE_BETA1 * desc->mom1[j]
+				+ (1.0 - HT_TUNE_BETA1) * desc->grad[j];
+			desc->mom2[j]	= HT_TUNE_BETA2 * desc->mom2[j]
+				+ (1.0 - HT_TUNE_BETA2)
+				* desc->grad[j] * desc->grad[j];
+			weights[j]	-= HT_TUNE_RATE
+				* (desc->mom1[j] / (1.0 - desc->beta1t))
+				/ (sqrt(desc->mom2[j]
+				/ (1.0 - desc->beta2t))
+				+ HT_TUNE_EPS);
+			weights[j]	= weights[j] > wmax ? wmax
+				: weights[j] < -wmax ? -wmax
+				: weights[j];
+		}
+	}
+
+	/*
+	 * Loss of the final weights.
+	 */
+	fr		= tune_grad(corpus, weights, desc);
+	* loss_end	= desc->loss;
+	free	(desc->works);
+	free	(desc);
+	free	(diffs);
+	return	fr;
+}
+
+/*
+ * Adds the position in g to corpus.
+ */
+static
+enum HT_FR
+tune_corpus_add (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const	g,
+/*@in@*/
+/*@notnull@*/
+	const int * const		board_escval,
+	const double			result,
+/*@in@*/
+/*@notnull@*/
+	struct tune_corpus * const	corpus
+	)
+/*@modifies * corpus@*/
+{
+	struct tune_sample * s;
+	if (corpus->elemc >= corpus->capc)
+	{
+		struct tune_sample * const samples =
+			realloc(corpus->samples,
+			sizeof(* samples) * corpus->capc * 2);
+		if (NULL == samples)
+		{
+			return	HT_FR_FAIL_ALLOC;
+		}
+		corpus->samples	= samples;
+		corpus->capc	*= 2;
+	}
+	s	= & corpus->samples[corpus->elemc++];
+	aiminimax_features(g, g->b, board_escval,
+		(unsigned short)0, s->features, & s->fixed);
+	s->result	= result;
+	return		HT_FR_SUCCESS;
+}
+
+/*
+ * Replays the game in line from the initial position, and adds every
+ * position before the game is over to corpus.
+ *
+ * The first word is the index of the player that won, or
+ * HT_TUNE_RESULT_DRAW. Every move is then four words (x and y of the
+ * piece, and x and y of the destination), as in the command line
+ * interface. A game must not continue after it's over.
+ *
+ * valid is set to false if line isn't such a game.
+ */
+static
+enum HT_FR
+tune_corpus_game (
+/*@in@*/
+/*@notnull@*/
+	struct game * const			g,
+/*@in@*/
+/*@notnull@*/
+	const int * const			board_escval,
+/*@in@*/
+/*@notnull@*/
+	const struct ht_line * const		line,
+/*@in@*/
+/*@notnull@*/
+	struct tune_corpus * const		corpus,
+/*@notnull@*/
+	HT_BOOL * const				valid
+	)
+/*@globals errno@*/
+/*@modifies errno, * g, * corpus, * valid@*/
+{
+	enum HT_FR	fr	= HT_FR_NONE;
+	unsigned short	winner	= HT_PLAYER_UNINIT;
+	double		result	= 0.5;
+	size_t		i;
+
+	* valid	= HT_FALSE;
+	if ((line->wordc - 1) % (size_t)4 != 0)
+	{
+		return	HT_FR_SUCCESS;
+	}
+	if (0 != strcmp(line->words[0].chars, HT_TUNE_RESULT_DRAW))
+	{
+		if (!texttoushort(line->words[0].chars, & winner)
+		|| winner >= g->playerc)
+		{
+			return	HT_FR_SUCCESS;
+		}
+		result	= 0 == winner ? 1.0 : 0.0;
+	}
+
+	fr	= game_board_reset(g);
+	if (HT_FR_SUCCESS != fr)
+	{
+		return	fr;
+	}
+
+	for (i = (size_t)1; ; i += (size_t)4)
+	{
+		unsigned short	coord[4];
+		HT_BOOL		legal	= HT_FALSE;
+		size_t		k;
+
+		if (game_over(g, & winner))
+		{
+			break;
+		}
+		fr	= tune_corpus_add(g, board_escval, result,
+			corpus);
+		if (HT_FR_SUCCESS != fr)
+		{
+			return	fr;
+		}
+		if (i >= line->wordc)
+		{
+			break;
+		}
+
+		for (k = (size_t)0; k < (size_t)4; k++)
+		{
+			if (!texttoushort(line->words[i + k].chars,
+				& coord[k])
+			|| coord[k] >= (k % 2 == 0
+				? g->rules->bwidth : g->rules->bheight))
+			{
+				return	HT_FR_SUCCESS;
+			}
+		}
+		fr	= game_move(g,
+			(unsigned short)(coord[1] * g->rules->bwidth
+				+ coord[0]),
+			(unsigned short)(coord[3] * g->rules->bwidth
+				+ coord[2]),
+			& legal);
+		if (HT_FR_SUCCESS != fr)
+		{
+			return	fr;
+		}
+		if (!legal)
+		{
+			return	HT_FR_SUCCESS;
+		}
+	}
+
+	* valid	= i >= line->wordc ? HT_TRUE : HT_FALSE;
+	return	HT_FR_SUCCESS;
+}
+
+/*
+ * Reads every game in the file inv->file_tune into corpus.
+ *
+ * Empty lines and comments are ignored. An invalid game is printed
+ * with its line number, and HT_FR_FAIL_RREADER is returned.
+ */
+static
+enum HT_FR
+tune_corpus_read (
+/*@in@*/
+/*@notnull@*/
+	const struct invoc * const	inv,
+/*@in@*/
+/*@notnull@*/
+	struct game * const		g,
+/*@in@*/
+/*@notnull@*/
+	const int * const		board_escval,
+/*@in@*/
+/*@notnull@*/
+	struct ht_line * const		line,
+/*@in@*/
+/*@notnull@*/
+	struct tune_corpus * const	corpus
+	)
+/*@globals fileSystem, errno, stderr@*/
+/*@modifies fileSystem, errno, stderr, * g, * line, * corpus@*/
+{
+	enum HT_FR		fr	= HT_FR_SUCCESS;
+	unsigned long		lineno	= 0;
+	FILE * const		file	= fopen(inv->file_tune, "r");
+	struct ht_text *	text	= NULL;
+
+	if (NULL == file)
+	{
+		return	HT_FR_FAIL_IO_FILE_R;
+	}
+	text	= alloc_ht_text(file, & fr);
+	if (0 != fclose(file) && HT_FR_SUCCESS == fr)
+	{
+		fr	= HT_FR_FAIL_IO_FILE_R;
+	}
+	if (HT_FR_SUCCESS != fr || NULL == text)
+	{
+		if (NULL != text)
+		{
+			free_ht_text	(text);
+		}
+		return	fr;
+	}
+
+	while (HT_FR_SUCCESS == fr && !ht_text_eof(text))
+	{
+		HT_BOOL valid	= HT_FALSE;
+
+		fr	= ht_line_readtext(text, line);
+		lineno++;
+		if (HT_FR_SUCCESS != fr || ht_line_empty(line))
+		{
+			continue;
+		}
+		fr	= tune_corpus_game(g, board_escval, line,
+			corpus, & valid);
+		if (HT_FR_SUCCESS == fr && !valid)
+		{
+			(void) fprintf(stderr, "%s:%lu: %s\n",
+				inv->file_tune, lineno,
+				HT_L_TUNE_FAIL_GAME);
+			fr	= HT_FR_FAIL_RREADER;
+		}
+	}
+
+	free_ht_text	(text);
+	return		fr;
+}
+
+/*
+ * Prints weights as a weights file, followed by g->eval_conf.psq (which
+ * is not tuned) if there is one.
+ */
+static
+enum HT_FR
+tune_print (
+/*@in@*/
+/*@notnull@*/
+	const struct invoc * const	inv,
+/*@in@*/
+/*@notnull@*/
+	const struct game * const	g,
+/*@in@*/
+/*@notnull@*/
+	const struct tune_corpus * const corpus,
+/*@in@*/
+/*@notnull@*/
+	const double * const		weights,
+	const double			loss_start,
+	const double			loss_end
+	)
+/*@globals fileSystem, errno, stdout@*/
+/*@modifies fileSystem, errno, stdout@*/
+{
+	const unsigned short	blen	= g->rules->opt_blen;
+	int			rv;
+	unsigned short		i;
+
+	rv	= printf("# %s: %lu, %.6f -> %.6f\n", inv->file_tune,
+		(unsigned long)corpus->elemc, loss_start, loss_end);
+
+	for (i = (unsigned short)0; rv >= 0
+		&& i < (unsigned short)HT_AIM_EVAL_TERMC; i++)
+	{
+		const double	w	= floor(weights[i] + 0.5);
+		rv	= printf("%s\t%d\n",
+			aimeval_term_name((enum HT_AIM_EVAL)i), (int)w);
+	}
+
+	for (i = (unsigned short)0; rv >= 0 && NULL != g->eval_conf.psq
+		&& i < HT_TYPE_MAX; i++)
+	{
+		const int * const	row	=
+			& g->eval_conf.psq[(size_t)i * blen];
+		unsigned short		pos;
+		HT_BOOL			used	= HT_FALSE;
+
+		for (pos = (unsigned short)0; pos < blen; pos++)
+		{
+			used	= used || 0 != row[pos]
+				? HT_TRUE : HT_FALSE;
+		}
+		if (!used)
+		{
+			continue;
+		}
+		rv	= printf("%s %u", HT_L_AIMEVAL_CMD_PSQ,
+			1U << i);
+		for (pos = (unsigned short)0; rv >= 0 && pos < blen;
+			pos++)
+		{
+			rv	= printf(" %d", row[pos]);
+		}
+		rv	= rv < 0 ? rv : printf("\n");
+	}
+
+	return	rv < 0 ? HT_FR_FAIL_IO_PRINT : HT_FR_SUCCESS;
+}
+
+/*
+ * Returns the amount of workers to split the corpus between.
+ */
+static
+size_t
+tune_workc (void)
+/*@modifies nothing@*/
+{
+#ifdef HT_POSIX
+	const long	cpus	= sysconf(_SC_NPROCESSORS_ONLN);
+	if (cpus < 1)
+	{
+		return	(size_t)1;
+	}
+	return	(size_t)cpus > HT_TUNE_THREADS_MAX
+		? HT_TUNE_THREADS_MAX : (size_t)cpus;
+#else
+	return	(size_t)1;
+#endif
+}
+
+/*
+ * Reads the ruleset inv->file_rc (with its weights file, if any, which
+ * the weights start from) and the game records in inv->file_tune, fits
+ * the weights to the results of the games, and prints a weights file
+ * with them to stdout.
+ *
+ * The features of a position are computed by aiminimax_features, so
+ * they are exactly what the computer player evaluates.
+ */
+enum HT_FR
+tune_run (
+	const struct invoc * const	inv
+	)
+{
+	enum HT_FR		fr		= HT_FR_NONE;
+	enum HT_FAIL_RREADER	fail_read	= HT_FAIL_RREADER_NONE;
+	struct game *		g		= NULL;
+	struct ht_line *	line		= NULL;
+	int *			board_escval	= NULL;
+	struct tune_corpus	corpus;
+	double *		weights		= NULL;
+	double			loss_start	= 0.0;
+	double			loss_end	= 0.0;
+	int			i;
+
+#ifndef HT_UNSAFE
+	if (NULL == inv || NULL == inv->file_tune)
+	{
+		return	HT_FR_FAIL_NULLPTR;
+	}
+#endif
+
+	line	= alloc_ht_line((size_t)3, (size_t)18);
+	if (NULL == line)
+	{
+		return	HT_FR_FAIL_ALLOC;
+	}
+
+	g	= alloc_game_read(inv->file_rc, line, & fr,
+		& fail_read);
+	if (HT_FR_SUCCESS != fr || NULL == g)
+	{
+		(void) print_err_fr_rreader(stderr, fr, fail_read,
+			line);
+		if (NULL != g)
+		{
+			free_game	(g);
+		}
+		free_ht_line	(line);
+		return		HT_FR_FAIL_RREADER;
+	}
+
+	game_initopt(g);
+	fr	= game_board_reset(g);
+	if (HT_FR_SUCCESS != fr)
+	{
+		free_game	(g);
+		free_ht_line	(line);
+		return		fr;
+	}
+	{
+		const char * const rvalid_why	= ruleset_valid(g);
+		if (NULL != rvalid_why)
+		{
+			(void) fputs	(rvalid_why,	stderr);
+			(void) fputc	('\n',		stderr);
+			free_game	(g);
+			free_ht_line	(line);
+			return		HT_FR_FAIL_RREADER;
+		}
+	}
+
+	board_escval	= calloc((size_t)g->rules->opt_blen,
+				sizeof(* board_escval));
+	corpus.samples	= malloc(sizeof(* corpus.samples)
+				* HT_TUNE_SAMPLES_CAP_DEF);
+	corpus.elemc	= 0;
+	corpus.capc	= HT_TUNE_SAMPLES_CAP_DEF;
+	weights		= malloc(sizeof(* weights)
+				* (size_t)HT_AIM_EVAL_TERMC);
+	if (NULL == board_escval || NULL == corpus.samples
+	|| NULL == weights)
+	{
+		free	(board_escval);
+		free	(corpus.samples);
+		free	(weights);
+		free_game	(g);
+		free_ht_line	(line);
+		return		HT_FR_FAIL_ALLOC;
+	}
+
+	fr	= aiminimax_board_escval_init(g, board_escval);
+	if (HT_FR_SUCCESS == fr)
+	{
+		fr	= tune_corpus_read(inv, g, board_escval, line,
+			& corpus);
+	}
+	if (HT_FR_SUCCESS == fr && corpus.elemc < (size_t)1)
+	{
+		(void) fprintf(stderr, "%s: %s\n", inv->file_tune,
+			HT_L_TUNE_FAIL_EMPTY);
+		fr	= HT_FR_FAIL_RREADER;
+	}
+
+	if (HT_FR_SUCCESS == fr)
+	{
+		for (i = 0; i < (int)HT_AIM_EVAL_TERMC; i++)
+		{
+			weights[i]	=
+				(double)g->eval_conf.weights[i];
+		}
+		fr	= tune_fit(& corpus, tune_workc(), weights,
+			& loss_start, & loss_end);
+	}
+	if (HT_FR_SUCCESS == fr)
+	{
+		fr	= tune_print(inv, g, & corpus, weights,
+			loss_start, loss_end);
+	}
+
+	free		(board_escval);
+	free		(corpus.samples);
+	free		(weights);
+	free_game	(g);
+	free_ht_line	(line);
+	return		fr;
+}
+
+#endif
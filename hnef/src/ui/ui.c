@@ -30,6 +30,9 @@
 #ifdef HT_UI_MSQU
 #include "uimq.h"	/* uimq_ai_progress */
 #endif
+#ifdef HT_UI_ENGINE
+#include "uie.h"	/* uie_ai_progress */
+#endif
 
 /*
  * NOTE:	The following things must be defined for every interface
@@ -429,6 +432,8 @@ ui_def (void)
 	return	HT_UIT_CLI;
 #elif	defined(HT_UI_MSQU)
 	return	HT_UIT_MSQU;
+#elif	defined(HT_UI_ENGINE)
+	return	HT_UIT_ENGINE;
 #else
 	return	HT_UIT_NONE;
 #endif
@@ -464,6 +469,22 @@ ui_ai_stop (
 	}
 	else
 #endif
+#ifdef HT_UI_ENGINE
+	if (HT_UIT_ENGINE == interf->type)
+	{
+		return	uie_ai_stop(g, interf->data.ui_e, stop);
+	}
+	else
+#endif
+	if (HT_UIT_NONE == interf->type)
+	{
+		/*
+		 * Headless (bench.c): never interrupted.
+		 */
+		* stop	= HT_FALSE;
+		return	HT_FR_SUCCESS;
+	}
+	else
 	{
 		return	HT_FR_FAIL_ENUM_UNK;
 	}
@@ -471,6 +492,8 @@ ui_ai_stop (
 
 /*
  * Delegates either uic_ai_progress or uix_ai_progress, as appropriate.
+ *
+ * HT_UIT_NONE is accepted as a headless interface that shows nothing.
  */
 enum HT_FR
 ui_ai_progress (
@@ -499,6 +522,21 @@ ui_ai_progress (
 	}
 	else
 #endif
+#ifdef HT_UI_ENGINE
+	if (HT_UIT_ENGINE == interf->type)
+	{
+		return	uie_ai_progress(interf->data.ui_e, prog);
+	}
+	else
+#endif
+	if (HT_UIT_NONE == interf->type)
+	{
+		/*
+		 * Headless (bench.c): nothing to show.
+		 */
+		return	HT_FR_SUCCESS;
+	}
+	else
 	{
 		return	HT_FR_FAIL_ENUM_UNK;
 	}
@@ -31,6 +31,9 @@
 #ifdef HT_UI_MSQU
 #include "uimqt.h"	/* msg queue */
 #endif
+#ifdef HT_UI_ENGINE
+#include "uiet.h"	/* uie */
+#endif
 
 /*
  * Value passed to ui_ai_progress (and therefore ui#_ai_progress)
@@ -209,6 +212,9 @@ enum HT_UIT
 
 	/*
 	 * No / uninitialized interface.
+	 *
+	 * ui_ai_stop and ui_ai_progress accept it as a headless
+	 * interface, so the computer player can search without one.
 	 */
 	HT_UIT_NONE	= 0
 
@@ -236,6 +242,14 @@ enum HT_UIT
 	HT_UIT_MSQU
 #endif
 
+#ifdef HT_UI_ENGINE
+	,
+	/*
+	 * Engine protocol on stdin and stdout.
+	 */
+	HT_UIT_ENGINE
+#endif
+
 };
 
 /*
@@ -268,10 +282,19 @@ struct ui
 		struct uimq *	ui_mq;
 #endif
 
+#ifdef HT_UI_ENGINE
+		/*
+		 * Available for type = HT_UIT_ENGINE.
+		 */
+		struct uie *	ui_e;
+#endif
+
 	}		data;
 
 	/*
-	 * HT_UIT_CLI, HT_UI_XLIB or HT_UI_MSQU are the only valid values.
+	 * HT_UIT_CLI, HT_UI_XLIB, HT_UI_MSQU or HT_UIT_ENGINE are the
+	 * only valid values for playing. HT_UIT_NONE is only valid for
+	 * a headless search.
 	 */
 	enum HT_UIT	type;
 
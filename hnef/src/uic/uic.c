@@ -24,10 +24,14 @@
 #include "aimalgo.h"		/* aiminimax_command */
 #include "aiminimax.h"		/* HT_AIM_DEPTHMAX_* */
 #endif
+#ifdef HT_AI_MINIMAX_HASH
+#include "aimhash.h"		/* zhash_mem_mib */
+#endif
 #include "board.h"		/* board_move_safe */
 #include "game.h"		/* game_board_reset */
+#include "grecord.h"		/* grecord_save, grecord_load */
 #include "lang.h"		/* HT_L_* */
-#include "num.h"		/* texttoushort */
+#include "num.h"		/* texttoushort, texttoulong */
 #include "iotextparse.h"	/* ht_line, ht_line_* */
 #include "player.h"		/* player_index_valid */
 #include "playert.h"		/* player */
@@ -82,6 +86,18 @@ print_help (void)
 	r = r < 0 ? r : printf("%c\t\t", HT_L_UIC_ARG_PRINT_BOARD);
 	r = r < 0 ? r : puts(HT_L_UIC_HELP_ARG_PRINT_BOARD);
 
+	r = r < 0 ? r : printf("%c file [%c]\t", HT_L_UIC_ARG_SAVE,
+		HT_L_UIC_ARG_SAVE_BIN);
+	r = r < 0 ? r : puts(HT_L_UIC_HELP_ARG_SAVE);
+
+	r = r < 0 ? r : printf("%c file\t\t", HT_L_UIC_ARG_LOAD);
+	r = r < 0 ? r : puts(HT_L_UIC_HELP_ARG_LOAD);
+
+#ifdef HT_AI_MINIMAX_HASH
+	r = r < 0 ? r : printf("%c mib\t\t", HT_L_UIC_ARG_HASH);
+	r = r < 0 ? r : puts(HT_L_UIC_HELP_ARG_HASH);
+#endif
+
 	r = r < 0 ? r : printf("%c\t\t", HT_L_UIC_ARG_QUIT);
 	r = r < 0 ? r : puts(HT_L_UIC_HELP_ARG_QUIT);
 
@@ -660,6 +676,59 @@ cmd_human_finalize (
 	}
 }
 
+/*
+ * Translates the HT_UIC_ACT_SAVE ("s file" or "s file b"),
+ * HT_UIC_ACT_LOAD ("l file") and HT_UIC_ACT_HASH ("t mib") commands.
+ * The file or size is the second word in line, which action_perform
+ * reads.
+ */
+static
+void
+cmd_human_interp_file (
+/*@in@*/
+/*@notnull@*/
+	const struct ht_line * const HT_RSTR	line,
+/*@in@*/
+/*@notnull@*/
+	struct ui_action * const HT_RSTR	act,
+/*@in@*/
+/*@notnull@*/
+	enum HT_UIC_ACTT * const HT_RSTR	act_sp
+	)
+/*@modifies * act, * act_sp@*/
+{
+	const char	arg_ch	= line->words[0].chars[0];
+	size_t		wordc	= line->wordc;
+
+	/*
+	 * Blanks at the end of the line leave an empty word.
+	 */
+	if ('\0' == line->words[wordc - 1].chars[0])
+	{
+		wordc--;
+	}
+
+	act->type	= HT_UI_ACT_UNK;
+	if ((size_t)2 == wordc)
+	{
+		act->type	= HT_UI_ACT_SPECIAL;
+		* act_sp	= HT_L_UIC_ARG_SAVE == arg_ch ?
+				HT_UIC_ACT_SAVE : HT_UIC_ACT_LOAD;
+#ifdef HT_AI_MINIMAX_HASH
+		if (HT_L_UIC_ARG_HASH == arg_ch)
+		{
+			* act_sp	= HT_UIC_ACT_HASH;
+		}
+#endif
+	}
+	else if ((size_t)3 == wordc && HT_L_UIC_ARG_SAVE == arg_ch
+	&& HT_L_UIC_ARG_SAVE_BIN == line->words[2].chars[0])
+	{
+		act->type	= HT_UI_ACT_SPECIAL;
+		* act_sp	= HT_UIC_ACT_SAVE_BIN;
+	}
+}
+
 /*
  * Converts information in line to information in act (and possibly
  * act_sp, for CLI-specific commands) by looking at every word
@@ -695,6 +764,17 @@ cmd_human_interp (
 		return		HT_FR_SUCCESS;
 	}
 
+	if (HT_L_UIC_ARG_SAVE == line->words[0].chars[0]
+	|| HT_L_UIC_ARG_LOAD == line->words[0].chars[0]
+#ifdef HT_AI_MINIMAX_HASH
+	|| HT_L_UIC_ARG_HASH == line->words[0].chars[0]
+#endif
+	)
+	{
+		cmd_human_interp_file(line, act, act_sp);
+		return	HT_FR_SUCCESS;
+	}
+
 	act_contr_index = act_contr_type = done		= HT_FALSE;
 
 	for (i = 0; i < line->wordc && !done; i++)
@@ -780,12 +860,98 @@ cmd_human (
 	}
 }
 
+/*
+ * Saves g to file. Failing to write it is not an error.
+ */
+static
+enum HT_FR
+action_save (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const	g,
+/*@in@*/
+/*@notnull@*/
+	const char * const		file,
+	const HT_BOOL			bin
+	)
+/*@globals fileSystem, errno, stdout@*/
+/*@modifies fileSystem, errno, stdout@*/
+{
+	const enum HT_FR fr	= grecord_save(g, file, bin);
+	if (HT_FR_FAIL_IO_FILE_W == fr)
+	{
+		return puts(HT_L_UIC_ACT_SAVE_FAIL) < 0 ?
+			HT_FR_FAIL_IO_PRINT : HT_FR_SUCCESS;
+	}
+	return	fr;
+}
+
+/*
+ * Loads the game in file into g, or leaves g as it was if file is not
+ * a valid game record for the ruleset.
+ */
+static
+enum HT_FR
+action_load (
+/*@in@*/
+/*@notnull@*/
+	struct game * const	g,
+/*@in@*/
+/*@notnull@*/
+	const char * const	file
+	)
+/*@globals fileSystem, errno, stdout@*/
+/*@modifies fileSystem, errno, stdout, * g@*/
+{
+	HT_BOOL		valid	= HT_FALSE;
+	const enum HT_FR fr	= grecord_load(g, file, & valid);
+	if (HT_FR_SUCCESS != fr)
+	{
+		return	fr;
+	}
+	if (!valid && puts(HT_L_UIC_ACT_LOAD_FAIL) < 0)
+	{
+		return	HT_FR_FAIL_IO_PRINT;
+	}
+	return	print_board(g);
+}
+
+#ifdef HT_AI_MINIMAX_HASH
+/*
+ * Sets the hash table size to mib MiB. The minimax players' tables are
+ * reallocated with it when the next game starts (player_reset).
+ */
+static
+enum HT_FR
+action_hash (
+/*@in@*/
+/*@notnull@*/
+	struct game * const	g,
+/*@in@*/
+/*@notnull@*/
+	const char * const	mib
+	)
+/*@globals fileSystem, errno, stdout@*/
+/*@modifies fileSystem, errno, stdout, * g@*/
+{
+	unsigned long	num	= 0ul;
+	const HT_BOOL	valid	= texttoulong(mib, & num)
+		&& zhash_mem_mib(num, & g->hash_conf.mem_tab);
+	return	puts(valid ? HT_L_UIC_ACT_HASH_SET
+			: HT_L_UIC_ACT_HASH_ILL) < 0 ?
+		HT_FR_FAIL_IO_PRINT : HT_FR_SUCCESS;
+}
+#endif
+
 static
 enum HT_FR
 action_perform (
 /*@in@*/
 /*@notnull@*/
 	struct game * const		g,
+/*@partial@*/
+/*@notnull@*/
+	const struct ht_line * const	line,
 /*@in@*/
 /*@notnull@*/
 	const struct ui_action * const	act,
@@ -884,6 +1050,22 @@ action_perform (
 		{
 			return	print_players(g);
 		}
+		else if (HT_UIC_ACT_SAVE == * act_sp
+		||	HT_UIC_ACT_SAVE_BIN == * act_sp)
+		{
+			return	action_save(g, line->words[1].chars,
+				HT_UIC_ACT_SAVE_BIN == * act_sp);
+		}
+		else if (HT_UIC_ACT_LOAD == * act_sp)
+		{
+			return	action_load(g, line->words[1].chars);
+		}
+#ifdef HT_AI_MINIMAX_HASH
+		else if (HT_UIC_ACT_HASH == * act_sp)
+		{
+			return	action_hash(g, line->words[1].chars);
+		}
+#endif
 		else
 		{
 			return	HT_FR_FAIL_ENUM_UNK;
@@ -998,7 +1180,7 @@ player_action (
 		return	HT_FR_FAIL_ENUM_UNK;
 	}
 
-	return action_perform(g, act, & act_sp);
+	return action_perform(g, line, act, & act_sp);
 }
 
 /*
@@ -39,7 +39,24 @@ enum HT_UIC_ACTT
 	/*
 	 * Print players.
 	 */
-	HT_UIC_ACT_PRINT_PLAYERS
+	HT_UIC_ACT_PRINT_PLAYERS,
+
+	/*
+	 * Save the game to a file, as a text or binary record.
+	 */
+	HT_UIC_ACT_SAVE,
+	HT_UIC_ACT_SAVE_BIN,
+
+	/*
+	 * Load a game from a file.
+	 */
+	HT_UIC_ACT_LOAD,
+
+	/*
+	 * Set the hash table size for the next game. Only used if
+	 * HT_AI_MINIMAX_HASH.
+	 */
+	HT_UIC_ACT_HASH
 
 };
 
@@ -0,0 +1,964 @@
+/* Copyright 2013 Alexander Söderlund.
+ *
+ * This file is part of HNEFATAFL.
+ *
+ * HNEFATAFL is free software: you can distribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * HNEFATAFL is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HT_UI_ENGINE
+
+#include <stdio.h>	/* printf, fputs, fflush, stdin, stdout */
+#include <stdlib.h>	/* malloc, free */
+#include <string.h>	/* strcmp */
+
+#ifdef HT_POSIX
+#include <pthread.h>	/* pthread_* */
+#endif
+
+#include "aimalgo.h"	/* aiminimax_command */
+#ifdef HT_AI_MINIMAX_HASH
+#include "aimhash.h"	/* zhash_mem_mib, zhash_pages_name */
+#endif
+#include "aiminimax.h"	/* aiminimax_depth_max_valid */
+#include "ait.h"	/* HT_AIT_MINIMAX */
+#include "board.h"	/* game_move, game_over */
+#include "config.h"	/* HT_VERSION */
+#include "game.h"	/* game_board_reset */
+#include "grecord.h"	/* grecord_load */
+#include "iotextparse.h"	/* alloc_ht_line, ht_line_* */
+#include "lang.h"	/* HT_L_UIE_* */
+#include "num.h"	/* texttoushort, texttoulong */
+#include "playert.h"	/* HT_PLAYER_UNINIT */
+#include "timer.h"	/* ht_timer_ms */
+#include "uie.h"
+#include "ui.h"		/* ui_player_contr_set, ui_action_init */
+
+/*
+ * NOTE:	The engine protocol is line based. Every command is a
+ *		line on stdin, and every reply is a line on stdout.
+ *		Replies are not translated, so that programs can read
+ *		them.
+ *
+ *		A position is given as the moves from the initial
+ *		position, and moves are written "x1 y1 x2 y2", like in
+ *		the CLI. The engine never makes a move of its own: "go"
+ *		only prints the best move that it found.
+ */
+
+/*
+ * Depth that the computer players are allocated for, which is also
+ * the greatest depth that can be searched.
+ */
+/*@unchecked@*/
+static
+const unsigned short HT_UIE_DEPTH_MAX		= (unsigned short)64;
+
+/*
+ * Default search depth.
+ */
+/*@unchecked@*/
+static
+const unsigned short HT_UIE_DEPTH_DEF		= (unsigned short)4;
+
+/*
+ * Locks ui_e->mutex with HT_POSIX.
+ */
+static
+void
+uie_lock (
+/*@in@*/
+/*@notnull@*/
+	struct uie * const	ui_e
+	)
+/*@modifies * ui_e@*/
+{
+#ifdef HT_POSIX
+	(void) pthread_mutex_lock	(& ui_e->mutex);
+#else
+	(void) ui_e;
+#endif
+}
+
+static
+void
+uie_unlock (
+/*@in@*/
+/*@notnull@*/
+	struct uie * const	ui_e
+	)
+/*@modifies * ui_e@*/
+{
+#ifdef HT_POSIX
+	(void) pthread_mutex_unlock	(& ui_e->mutex);
+#else
+	(void) ui_e;
+#endif
+}
+
+/*
+ * Prints " x1 y1 x2 y2" for the move from pos to dest.
+ */
+static
+int
+uie_print_move (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const	g,
+	const unsigned short		pos,
+	const unsigned short		dest
+	)
+/*@globals fileSystem, errno, stdout@*/
+/*@modifies fileSystem, errno, stdout@*/
+{
+	const unsigned short bwidth	= g->rules->bwidth;
+	return	printf(" %hu %hu %hu %hu",
+		(unsigned short)(pos % bwidth),
+		(unsigned short)(pos / bwidth),
+		(unsigned short)(dest % bwidth),
+		(unsigned short)(dest / bwidth));
+}
+
+/*
+ * Prints "error" and msg.
+ */
+static
+enum HT_FR
+uie_print_error (
+/*@in@*/
+/*@notnull@*/
+	struct uie * const	ui_e,
+/*@in@*/
+/*@notnull@*/
+	const char * const	msg
+	)
+/*@globals fileSystem, errno, stdout@*/
+/*@modifies fileSystem, errno, stdout, * ui_e@*/
+{
+	int rv;
+	uie_lock	(ui_e);
+	rv	= printf("error %s\n", msg);
+	rv	= rv < 0 || 0 != fflush(stdout) ? -1 : rv;
+	uie_unlock	(ui_e);
+	return	rv < 0 ? HT_FR_FAIL_IO_PRINT : HT_FR_SUCCESS;
+}
+
+/*
+ * Prints the name of the engine, the ruleset and the options.
+ */
+static
+enum HT_FR
+uie_print_id (
+/*@in@*/
+/*@notnull@*/
+	const struct uie * const	ui_e,
+/*@in@*/
+/*@notnull@*/
+	const struct game * const	g
+	)
+/*@globals fileSystem, errno, stdout@*/
+/*@modifies fileSystem, errno, stdout@*/
+{
+	int r	= printf("id name hnefatafl %d\n", HT_VERSION);
+	r = r < 0 ? r : printf("id ruleset %s\n", g->rules->id);
+	r = r < 0 ? r : printf("option %s %hu\n", HT_L_UIE_CMD_DEPTH,
+		ui_e->depth);
+	r = r < 0 ? r : printf("option %s %lu\n", HT_L_UIE_CMD_TIME,
+		ui_e->time);
+#ifdef HT_AI_MINIMAX_HASH
+	r = r < 0 ? r : printf("option %s %lu\n", HT_L_UIE_CMD_HASH,
+		(unsigned long)(g->hash_conf.mem_tab >> 20));
+#endif
+	r = r < 0 ? r : puts("hnefok");
+	return	r < 0 || 0 != fflush(stdout) ? HT_FR_FAIL_IO_PRINT
+		: HT_FR_SUCCESS;
+}
+
+/*
+ * Searches the position in ui_e->g with ui_e->aim, and prints the best
+ * move that it found.
+ */
+static
+enum HT_FR
+uie_search (
+/*@in@*/
+/*@notnull@*/
+	struct uie * const	ui_e
+	)
+/*@globals errno, fileSystem, stdout, internalState@*/
+/*@modifies errno, fileSystem, stdout, internalState, * ui_e@*/
+{
+	struct ui		interf;
+	struct ui_action	act;
+	enum HT_FR		fr	= HT_FR_NONE;
+	int			rv;
+
+#ifndef HT_UNSAFE
+	if (NULL == ui_e->g || NULL == ui_e->aim)
+	{
+		return	HT_FR_FAIL_NULLPTR;
+	}
+#endif
+
+	interf.type		= HT_UIT_ENGINE;
+	interf.data.ui_e	= ui_e;
+	ui_action_init(& act);
+	fr	= aiminimax_command(ui_e->g, & interf, ui_e->aim,
+		& act);
+	ui_e->aim->halt		= NULL;
+	ui_e->aim->time_max	= 0ul;
+	if (HT_FR_SUCCESS != fr)
+	{
+		return	fr;
+	}
+
+	uie_lock	(ui_e);
+	rv	= fputs("bestmove", stdout);
+	if (rv >= 0 && HT_UI_ACT_MOVE == act.type)
+	{
+		rv	= uie_print_move(ui_e->g, act.info.mov.pos,
+			act.info.mov.dest);
+	}
+	else if (rv >= 0)
+	{
+		rv	= fputs(" -", stdout);
+	}
+	rv	= rv < 0 ? rv : fputc('\n', stdout);
+	rv	= rv < 0 || 0 != fflush(stdout) ? -1 : rv;
+	uie_unlock	(ui_e);
+	return	rv < 0 ? HT_FR_FAIL_IO_PRINT : HT_FR_SUCCESS;
+}
+
+#ifdef HT_POSIX
+
+/*@null@*/
+static
+void *
+uie_search_thread (
+/*@in@*/
+/*@notnull@*/
+	void * const	arg
+	)
+/*@globals errno, fileSystem, stdout, internalState@*/
+/*@modifies errno, fileSystem, stdout, internalState, arg@*/
+{
+	struct uie * const ui_e	= arg;
+	ui_e->fr	= uie_search(ui_e);
+	return		NULL;
+}
+
+#endif
+
+/*
+ * Waits for the search to finish, after telling it to stop if stop.
+ * Returns what the search returned.
+ */
+static
+enum HT_FR
+uie_wait (
+/*@in@*/
+/*@notnull@*/
+	struct uie * const	ui_e,
+	const HT_BOOL		stop
+	)
+/*@modifies * ui_e@*/
+{
+	if (!ui_e->searching)
+	{
+		return	HT_FR_SUCCESS;
+	}
+#ifdef HT_POSIX
+	if (stop)
+	{
+		uie_lock	(ui_e);
+		ui_e->stop	= HT_TRUE;
+		uie_unlock	(ui_e);
+	}
+	if (0 != pthread_join(ui_e->thread, NULL))
+	{
+		ui_e->searching	= HT_FALSE;
+		return		HT_FR_FAIL_POSIX;
+	}
+#else
+	(void) stop;
+#endif
+	ui_e->searching	= HT_FALSE;
+	return		ui_e->fr;
+}
+
+/*
+ * Starts searching the position in ui_e->g to depth, for at most time
+ * milliseconds if time is not 0, or until "stop" if ponder. Without
+ * HT_POSIX, the search is done before this function returns.
+ */
+static
+enum HT_FR
+uie_go (
+/*@in@*/
+/*@notnull@*/
+	struct uie * const	ui_e,
+	const unsigned short	depth,
+	const unsigned long	time,
+	const HT_BOOL		ponder
+	)
+/*@globals errno, fileSystem, stdout, internalState@*/
+/*@modifies errno, fileSystem, stdout, internalState, * ui_e@*/
+{
+	struct game * const	g	= ui_e->g;
+	enum HT_FR		fr	= HT_FR_NONE;
+	unsigned short		winner	= HT_PLAYER_UNINIT;
+	struct player *		pl;
+
+#ifndef HT_UNSAFE
+	if (NULL == g)
+	{
+		return	HT_FR_FAIL_NULLPTR;
+	}
+#endif
+
+	if (game_over(g, & winner))
+	{
+		return	puts("bestmove -") < 0 || 0 != fflush(stdout)
+			? HT_FR_FAIL_IO_PRINT : HT_FR_SUCCESS;
+	}
+
+	/*
+	 * The computer player has room to search HT_UIE_DEPTH_MAX, so
+	 * depth_max can be lowered for every search.
+	 */
+	pl	= g->players[g->b->turn];
+	if (HT_AIT_MINIMAX != pl->contr)
+	{
+		struct ui_action_contr	act_contr;
+		HT_BOOL			valid	= HT_FALSE;
+		act_contr.type		= HT_AIT_MINIMAX;
+		act_contr.p_index	= g->b->turn;
+		act_contr.args.minimax.depth_max = HT_UIE_DEPTH_MAX;
+		fr	= ui_player_contr_set(g, & act_contr, & valid);
+		if (HT_FR_SUCCESS != fr)
+		{
+			return	fr;
+		}
+		else if (!valid)
+		{
+			return	HT_FR_FAIL_ILL_STATE;
+		}
+	}
+	if (NULL == pl->ai.minimax)
+	{
+		return	HT_FR_FAIL_NULLPTR;
+	}
+	ui_e->aim		= pl->ai.minimax;
+	ui_e->aim->depth_max	= depth;
+
+#ifdef HT_AI_MINIMAX_HASH
+	/*
+	 * The kind of pages that the table got is only known once the
+	 * computer player is allocated, which is on the first search.
+	 */
+	if (printf("info pages %s\n",
+		zhash_pages_name(ui_e->aim->tp_tab->pages)) < 0
+	|| 0 != fflush(stdout))
+	{
+		return	HT_FR_FAIL_IO_PRINT;
+	}
+#endif
+
+	ui_e->ponder		= ponder;
+	ui_e->depth_cur		= 0;
+	ui_e->stop		= ui_e->halted	= HT_FALSE;
+	ui_e->aim->halt		= & ui_e->stop;
+	ui_e->aim->time_start	= ht_timer_ms();
+	ui_e->aim->time_max	= time;
+	ui_e->fr		= HT_FR_SUCCESS;
+	ui_e->searching		= HT_TRUE;
+
+#ifdef HT_POSIX
+	if (0 != pthread_create(& ui_e->thread, NULL, uie_search_thread,
+		ui_e))
+	{
+		ui_e->searching	= HT_FALSE;
+		return		HT_FR_FAIL_POSIX;
+	}
+	return	HT_FR_SUCCESS;
+#else
+	ui_e->fr	= uie_search(ui_e);
+	return		uie_wait(ui_e, HT_FALSE);
+#endif
+}
+
+/*
+ * Returns the amount of words in line, not counting the empty word
+ * that blanks at the end of the line leave.
+ */
+static
+size_t
+uie_wordc (
+/*@in@*/
+/*@notnull@*/
+	const struct ht_line * const	line
+	)
+/*@modifies nothing@*/
+{
+	size_t wordc	= line->wordc;
+	if (wordc > (size_t)0
+	&& '\0' == line->words[wordc - 1].chars[0])
+	{
+		wordc--;
+	}
+	return	wordc;
+}
+
+/*
+ * "position [moves x1 y1 x2 y2 ...]" or "position record file".
+ *
+ * If a move is illegal, the game is left at the initial position. If
+ * the record can't be loaded, the game is left as it was.
+ */
+static
+enum HT_FR
+uie_cmd_position (
+/*@in@*/
+/*@notnull@*/
+	struct uie * const		ui_e,
+/*@in@*/
+/*@notnull@*/
+	const struct ht_line * const	line
+	)
+/*@globals internalState, fileSystem, errno, stdout@*/
+/*@modifies internalState, fileSystem, errno, stdout, * ui_e@*/
+{
+	struct game * const	g	= ui_e->g;
+	const size_t		wordc	= uie_wordc(line);
+	enum HT_FR		fr	= HT_FR_NONE;
+	size_t			i;
+
+#ifndef HT_UNSAFE
+	if (NULL == g)
+	{
+		return	HT_FR_FAIL_NULLPTR;
+	}
+#endif
+
+	if ((size_t)3 == wordc
+	&& 0 == strcmp(line->words[1].chars, HT_L_UIE_CMD_RECORD))
+	{
+		HT_BOOL valid	= HT_FALSE;
+		fr	= grecord_load(g, line->words[2].chars,
+			& valid);
+		if (HT_FR_SUCCESS != fr)
+		{
+			return	fr;
+		}
+		return	valid ? HT_FR_SUCCESS
+			: uie_print_error(ui_e, HT_L_UIE_ERR_RECORD);
+	}
+	else if (wordc > (size_t)1
+	&& (0 != strcmp(line->words[1].chars, HT_L_UIE_CMD_MOVES)
+	|| 0 != (wordc - 2) % 4))
+	{
+		return	uie_print_error(ui_e, HT_L_UIE_ERR_ARG);
+	}
+
+	fr	= game_board_reset(g);
+	if (HT_FR_SUCCESS != fr)
+	{
+		return	fr;
+	}
+	for (i = (size_t)2; i + 3 < wordc; i += 4)
+	{
+		const unsigned short	bw	= g->rules->bwidth;
+		const unsigned short	bh	= g->rules->bheight;
+		unsigned short		c[4];
+		unsigned short		winner	= HT_PLAYER_UNINIT;
+		HT_BOOL			legal	= HT_FALSE;
+		size_t			j;
+
+		for (j = 0; j < (size_t)4; j++)
+		{
+			if (!texttoushort(line->words[i + j].chars,
+				& c[j])
+			|| c[j] >= (0 == j % 2 ? bw : bh))
+			{
+				break;
+			}
+		}
+		if (j >= (size_t)4 && !game_over(g, & winner))
+		{
+			fr	= game_move(g,
+				(unsigned short)(c[1] * bw + c[0]),
+				(unsigned short)(c[3] * bw + c[2]),
+				& legal);
+			if (HT_FR_SUCCESS != fr)
+			{
+				return	fr;
+			}
+		}
+		if (!legal)
+		{
+			fr	= game_board_reset(g);
+			if (HT_FR_SUCCESS != fr)
+			{
+				return	fr;
+			}
+			return	uie_print_error(ui_e,
+				HT_L_UIE_ERR_MOVE);
+		}
+	}
+	return	HT_FR_SUCCESS;
+}
+
+/*
+ * "go [depth n] [time ms]". Without limits, the depth and time options
+ * are used. With limits, only those that are given apply.
+ */
+static
+enum HT_FR
+uie_cmd_go (
+/*@in@*/
+/*@notnull@*/
+	struct uie * const		ui_e,
+/*@in@*/
+/*@notnull@*/
+	const struct ht_line * const	line
+	)
+/*@globals errno, fileSystem, stdout, internalState@*/
+/*@modifies errno, fileSystem, stdout, internalState, * ui_e@*/
+{
+	const size_t	wordc	= uie_wordc(line);
+	unsigned short	depth	= ui_e->depth;
+	unsigned long	time	= ui_e->time;
+	size_t		i;
+
+	if (wordc > (size_t)1)
+	{
+		depth	= HT_UIE_DEPTH_MAX;
+		time	= 0ul;
+	}
+	if (0 == wordc % 2)
+	{
+		return	uie_print_error(ui_e, HT_L_UIE_ERR_ARG);
+	}
+	for (i = (size_t)1; i + 1 < wordc; i += 2)
+	{
+		const char * const	arg	= line->words[i].chars;
+		const char * const	val = line->words[i + 1].chars;
+		HT_BOOL			valid	= HT_FALSE;
+
+		if (0 == strcmp(arg, HT_L_UIE_CMD_DEPTH))
+		{
+			valid	= texttoushort(val, & depth)
+				&& aiminimax_depth_max_valid(depth)
+				&& depth <= HT_UIE_DEPTH_MAX;
+		}
+		else if (0 == strcmp(arg, HT_L_UIE_CMD_TIME))
+		{
+			valid	= texttoulong(val, & time);
+		}
+		if (!valid)
+		{
+			return	uie_print_error(ui_e, HT_L_UIE_ERR_ARG);
+		}
+	}
+	return	uie_go(ui_e, depth, time, HT_FALSE);
+}
+
+/*
+ * "setoption name value".
+ */
+static
+enum HT_FR
+uie_cmd_setoption (
+/*@in@*/
+/*@notnull@*/
+	struct uie * const		ui_e,
+/*@in@*/
+/*@notnull@*/
+	const struct ht_line * const	line
+	)
+/*@globals internalState, fileSystem, errno, stdout@*/
+/*@modifies internalState, fileSystem, errno, stdout, * ui_e@*/
+{
+	const char *	arg;
+	const char *	val;
+	HT_BOOL		valid	= HT_FALSE;
+
+	if ((size_t)3 != uie_wordc(line))
+	{
+		return	uie_print_error(ui_e, HT_L_UIE_ERR_ARG);
+	}
+	arg	= line->words[1].chars;
+	val	= line->words[2].chars;
+
+	if (0 == strcmp(arg, HT_L_UIE_CMD_DEPTH))
+	{
+		unsigned short depth	= 0;
+		valid	= texttoushort(val, & depth)
+			&& aiminimax_depth_max_valid(depth)
+			&& depth <= HT_UIE_DEPTH_MAX;
+		if (valid)
+		{
+			ui_e->depth	= depth;
+		}
+	}
+	else if (0 == strcmp(arg, HT_L_UIE_CMD_TIME))
+	{
+		valid	= texttoulong(val, & ui_e->time);
+	}
+#ifdef HT_AI_MINIMAX_HASH
+	else if (0 == strcmp(arg, HT_L_UIE_CMD_HASH))
+	{
+		struct game * const	g	= ui_e->g;
+		unsigned long		mib	= 0ul;
+		unsigned short		i;
+#ifndef HT_UNSAFE
+		if (NULL == g)
+		{
+			return	HT_FR_FAIL_NULLPTR;
+		}
+#endif
+		valid	= texttoulong(val, & mib)
+			&& zhash_mem_mib(mib, & g->hash_conf.mem_tab);
+		/*
+		 * The computer players are allocated again with the new
+		 * table size when they're next needed.
+		 */
+		for (i = 0; valid && i < g->playerc; i++)
+		{
+			if (HT_AIT_MINIMAX == g->players[i]->contr)
+			{
+				const enum HT_FR fr =
+					ui_player_contr_unset(g, i);
+				if (HT_FR_SUCCESS != fr)
+				{
+					return	fr;
+				}
+			}
+		}
+	}
+#endif
+	return	valid ? HT_FR_SUCCESS
+		: uie_print_error(ui_e, HT_L_UIE_ERR_ARG);
+}
+
+/*
+ * Performs the command in line. quit is set on "quit".
+ */
+static
+enum HT_FR
+uie_cmd (
+/*@in@*/
+/*@notnull@*/
+	struct uie * const		ui_e,
+/*@in@*/
+/*@notnull@*/
+	const struct ht_line * const	line,
+/*@in@*/
+/*@notnull@*/
+	HT_BOOL * const			quit
+	)
+/*@globals internalState, fileSystem, errno, stdout@*/
+/*@modifies internalState, fileSystem, errno, stdout, * ui_e@*/
+/*@modifies * quit@*/
+{
+	const char * const	cmd	= line->words[0].chars;
+	enum HT_FR		fr	= HT_FR_NONE;
+
+#ifndef HT_UNSAFE
+	if (NULL == ui_e->g)
+	{
+		return	HT_FR_FAIL_NULLPTR;
+	}
+#endif
+
+	if (0 == strcmp(cmd, HT_L_UIE_CMD_ISREADY))
+	{
+		/*
+		 * Answered at once, also during a search.
+		 */
+		int rv;
+		uie_lock	(ui_e);
+		rv	= puts("readyok");
+		rv	= rv < 0 || 0 != fflush(stdout) ? -1 : rv;
+		uie_unlock	(ui_e);
+		return	rv < 0 ? HT_FR_FAIL_IO_PRINT : HT_FR_SUCCESS;
+	}
+
+	/*
+	 * Every other command waits for the search first, since it may
+	 * change the game that is searched. "stop" and "quit" stop it,
+	 * and so does any command during "ponder", which never ends on
+	 * its own.
+	 */
+	fr	= uie_wait(ui_e, ui_e->ponder
+		|| 0 == strcmp(cmd, HT_L_UIE_CMD_STOP)
+		|| 0 == strcmp(cmd, HT_L_UIE_CMD_QUIT));
+	if (HT_FR_SUCCESS != fr)
+	{
+		return	fr;
+	}
+
+	if (0 == strcmp(cmd, HT_L_UIE_CMD_HNEF))
+	{
+		return	uie_print_id(ui_e, ui_e->g);
+	}
+	else if (0 == strcmp(cmd, HT_L_UIE_CMD_NEWGAME))
+	{
+		return	game_board_reset(ui_e->g);
+	}
+	else if (0 == strcmp(cmd, HT_L_UIE_CMD_POSITION))
+	{
+		return	uie_cmd_position(ui_e, line);
+	}
+	else if (0 == strcmp(cmd, HT_L_UIE_CMD_GO))
+	{
+		return	uie_cmd_go(ui_e, line);
+	}
+	else if (0 == strcmp(cmd, HT_L_UIE_CMD_PONDER))
+	{
+		return	uie_go(ui_e, HT_UIE_DEPTH_MAX, 0ul, HT_TRUE);
+	}
+	else if (0 == strcmp(cmd, HT_L_UIE_CMD_STOP))
+	{
+		return	HT_FR_SUCCESS;
+	}
+	else if (0 == strcmp(cmd, HT_L_UIE_CMD_SETOPTION))
+	{
+		return	uie_cmd_setoption(ui_e, line);
+	}
+	else if (0 == strcmp(cmd, HT_L_UIE_CMD_QUIT))
+	{
+		* quit	= HT_TRUE;
+		return	HT_FR_SUCCESS;
+	}
+	else
+	{
+		return	uie_print_error(ui_e, HT_L_UIE_ERR_CMD);
+	}
+}
+
+/*
+ * Reads and performs commands until "quit", or until stdin ends. When
+ * stdin ends, a search started by "go" is finished before returning,
+ * and a search started by "ponder" is stopped.
+ */
+enum HT_FR
+uie_play_new (
+	struct game * const	g,
+	struct ui * const	interf
+	)
+{
+	struct uie *	ui_e;
+	enum HT_FR	fr	= HT_FR_NONE;
+	HT_BOOL		quit	= HT_FALSE;
+
+#ifndef HT_UNSAFE
+	if (NULL == g || NULL == interf)
+	{
+		return	HT_FR_FAIL_NULLPTR;
+	}
+#endif
+	ui_e	= interf->data.ui_e;
+	ui_e->g	= g;
+
+	fr	= game_board_reset(g);
+	while (HT_FR_SUCCESS == fr && !quit)
+	{
+		fr	= ht_line_readline(stdin, ui_e->line);
+		if (HT_FR_SUCCESS == fr && !ht_line_empty(ui_e->line))
+		{
+			fr	= uie_cmd(ui_e, ui_e->line, & quit);
+		}
+		if (HT_FR_SUCCESS == fr && 0 != ferror(stdin))
+		{
+			fr	= HT_FR_FAIL_IO_STDIN;
+		}
+		else if (0 != feof(stdin))
+		{
+			break;
+		}
+	}
+
+	if (HT_FR_SUCCESS == fr)
+	{
+		fr	= uie_wait(ui_e, quit || ui_e->ponder);
+	}
+	else
+	{
+		(void) uie_wait	(ui_e, HT_TRUE);
+	}
+	return	fr;
+}
+
+/*
+ * The engine quits when uie_play_new returns.
+ */
+enum HT_FR
+uie_play_again (
+	const struct game * const HT_RSTR	g,
+	struct uie * const			ui_e,
+	HT_BOOL * const HT_RSTR			again
+	)
+{
+	if (NULL != g && NULL != ui_e) {}	/* -Wunused */
+	* again	= HT_FALSE;
+	return	HT_FR_SUCCESS;
+}
+
+/*
+ * Stops the search on "stop", or when its time is up. Called by the
+ * search thread before every move at the root. Within a move, the
+ * search stops by itself on the same conditions (see aim->halt).
+ */
+enum HT_FR
+uie_ai_stop (
+	const struct game * const HT_RSTR	g,
+	struct uie * const HT_RSTR		ui_e,
+	HT_BOOL * const HT_RSTR			stop
+	)
+{
+	const struct aiminimax *	aim;
+#ifndef HT_UNSAFE
+	if (NULL == ui_e || NULL == ui_e->aim || NULL == stop)
+	{
+		return	HT_FR_FAIL_NULLPTR;
+	}
+#endif
+	if (NULL == g) {}	/* -Wunused */
+	aim	= ui_e->aim;
+
+	uie_lock	(ui_e);
+	if (aim->time_max > 0ul
+	&& ht_timer_ms() - aim->time_start >= aim->time_max)
+	{
+		ui_e->stop	= HT_TRUE;
+	}
+	if (ui_e->stop)
+	{
+		ui_e->halted	= HT_TRUE;
+		* stop		= HT_TRUE;
+	}
+	uie_unlock	(ui_e);
+	return		HT_FR_SUCCESS;
+}
+
+/*
+ * Prints "info" with the depth, amount of positions visited, value and
+ * best move whenever an iteration of the search is done. An iteration
+ * that was stopped is not printed, since it didn't search every move.
+ */
+enum HT_FR
+uie_ai_progress (
+	struct uie * const HT_RSTR	ui_e,
+	const int			prog
+	)
+{
+	const struct aiminimax *	aim;
+	int				rv;
+#ifndef HT_UNSAFE
+	if (NULL == ui_e || NULL == ui_e->aim || NULL == ui_e->g)
+	{
+		return	HT_FR_FAIL_NULLPTR;
+	}
+#endif
+	aim	= ui_e->aim;
+
+	if (HT_AIPROG_START == prog)
+	{
+		ui_e->depth_cur++;
+		return	HT_FR_SUCCESS;
+	}
+	else if (HT_AIPROG_DONE != prog)
+	{
+		return	HT_FR_SUCCESS;
+	}
+
+	uie_lock	(ui_e);
+	if (ui_e->halted || aim->halted)
+	{
+		uie_unlock	(ui_e);
+		return		HT_FR_SUCCESS;
+	}
+	rv	= printf("info depth %hu nodes %lu value %d move",
+		ui_e->depth_cur, aim->nodes, aim->value);
+	rv	= rv < 0 ? rv : uie_print_move(ui_e->g,
+		aim->opt_moves->elems[0].pos,
+		aim->opt_moves->elems[0].dest);
+	rv	= rv < 0 ? rv : fputc('\n', stdout);
+	rv	= rv < 0 || 0 != fflush(stdout) ? -1 : rv;
+	uie_unlock	(ui_e);
+	return	rv < 0 ? HT_FR_FAIL_IO_PRINT : HT_FR_SUCCESS;
+}
+
+struct uie *
+alloc_uie (
+	const struct game * const g
+	)
+{
+	struct uie * const	ui_e = malloc(sizeof(* ui_e));
+	if (NULL == ui_e)
+	{
+		return	NULL;
+	}
+
+	ui_e->line	= alloc_ht_line((size_t)8, (size_t)64);
+	if (NULL == ui_e->line)
+	{
+		free	(ui_e);
+		return	NULL;
+	}
+
+#ifdef HT_POSIX
+	if (0 != pthread_mutex_init(& ui_e->mutex, NULL))
+	{
+		free_ht_line	(ui_e->line);
+		free		(ui_e);
+		return		NULL;
+	}
+#endif
+
+	if (NULL != g) {}	/* -Wunused */
+	return	ui_e;
+}
+
+void
+free_uie (
+	struct uie * const	ui_e
+	)
+{
+#ifdef HT_POSIX
+	(void) pthread_mutex_destroy	(& ui_e->mutex);
+#endif
+	free_ht_line	(ui_e->line);
+	free		(ui_e);
+}
+
+enum HT_FR
+uie_init (
+	const struct game * const HT_RSTR	g,
+	struct uie * const HT_RSTR		ui_e
+	)
+{
+	if (NULL == g) {}	/* -Wunused */
+	ui_e->g		= NULL;
+	ui_e->aim	= NULL;
+	ui_e->depth	= HT_UIE_DEPTH_DEF;
+	ui_e->time	= 0ul;
+	ui_e->searching	= ui_e->ponder	= HT_FALSE;
+	ui_e->stop	= ui_e->halted	= HT_FALSE;
+	ui_e->depth_cur	= 0;
+	ui_e->fr	= HT_FR_SUCCESS;
+	return	HT_FR_SUCCESS;
+}
+
+#endif
+
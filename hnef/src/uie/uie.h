@@ -0,0 +1,142 @@
+/* Copyright 2013 Alexander Söderlund.
+ *
+ * This file is part of HNEFATAFL.
+ *
+ * HNEFATAFL is free software: you can distribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * HNEFATAFL is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HT_UI_ENGINE
+
+#ifndef HT_UIE_H
+#define HT_UIE_H
+
+#include "config.h"	/* HT_RSTR */
+#include "funct.h"	/* HT_FR */
+#include "gamet.h"	/* game */
+#include "uit.h"	/* ui */
+#include "uiet.h"	/* uie */
+
+/*@-protoparamname@*/
+extern
+enum HT_FR
+uie_play_new (
+/*@in@*/
+/*@notnull@*/
+	struct game * const	g,
+/*@in@*/
+/*@notnull@*/
+	struct ui * const	interf
+	)
+/*@globals internalState, fileSystem, errno, stdout, stdin@*/
+/*@modifies internalState, fileSystem, errno, stdout, stdin, * g@*/
+/*@modifies * interf@*/
+;
+/*@=protoparamname@*/
+
+/*@-protoparamname@*/
+extern
+enum HT_FR
+uie_play_again (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const HT_RSTR	g,
+/*@in@*/
+/*@notnull@*/
+	struct uie * const			ui_e,
+/*@in@*/
+/*@notnull@*/
+	HT_BOOL * const HT_RSTR			again
+	)
+/*@modifies * again@*/
+;
+/*@=protoparamname@*/
+
+/*@-protoparamname@*/
+extern
+enum HT_FR
+uie_ai_stop (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const HT_RSTR	g,
+/*@in@*/
+/*@notnull@*/
+	struct uie * const HT_RSTR		ui_e,
+/*@in@*/
+/*@notnull@*/
+	HT_BOOL * const HT_RSTR			stop
+	)
+/*@globals internalState@*/
+/*@modifies internalState, * ui_e, * stop@*/
+;
+/*@=protoparamname@*/
+
+/*@-protoparamname@*/
+extern
+enum HT_FR
+uie_ai_progress (
+/*@in@*/
+/*@notnull@*/
+	struct uie * const HT_RSTR	ui_e,
+	const int			prog
+	)
+/*@globals errno, fileSystem, stdout@*/
+/*@modifies errno, fileSystem, stdout, * ui_e@*/
+;
+/*@=protoparamname@*/
+
+/*@null@*/
+/*@only@*/
+/*@partial@*/
+extern
+struct uie *
+alloc_uie (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const
+	)
+/*@modifies nothing@*/
+;
+
+/*@-protoparamname@*/
+extern
+void
+free_uie (
+/*@notnull@*/
+/*@owned@*/
+/*@special@*/
+	struct uie * const	ui_e
+	)
+/*@modifies ui_e@*/
+/*@releases ui_e@*/
+;
+/*@=protoparamname@*/
+
+/*@-protoparamname@*/
+extern
+enum HT_FR
+uie_init (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const HT_RSTR	g,
+/*@notnull@*/
+/*@partial@*/
+	struct uie * const HT_RSTR		ui_e
+	)
+/*@modifies ui_e@*/
+;
+/*@=protoparamname@*/
+
+#endif
+
+#endif
+
@@ -0,0 +1,120 @@
+/* Copyright 2013 Alexander Söderlund.
+ *
+ * This file is part of HNEFATAFL.
+ *
+ * HNEFATAFL is free software: you can distribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * HNEFATAFL is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HT_UI_ENGINE
+
+#ifndef HT_UIE_T_H
+#define HT_UIE_T_H
+
+#ifdef HT_POSIX
+#include <pthread.h>	/* pthread_t, pthread_mutex_t */
+#endif
+
+#include "aiminimaxt.h"	/* aiminimax */
+#include "funct.h"	/* HT_FR */
+#include "gamet.h"	/* game */
+#include "iotextparset.h"	/* ht_line */
+
+/*
+ * Data that the engine protocol interface needs.
+ *
+ * With HT_POSIX, the search runs in its own thread while commands are
+ * read from stdin. The search thread only touches the fields that
+ * are marked as guarded by mutex, and g and aim, which the main thread
+ * leaves alone until the search is joined.
+ */
+struct uie
+{
+
+	/*
+	 * Line for all reading done by the interface.
+	 */
+/*@owned@*/
+/*@notnull@*/
+	struct ht_line *	line;
+
+	/*
+	 * The game given to uie_play_new.
+	 */
+/*@dependent@*/
+/*@null@*/
+	struct game *		g;
+
+	/*
+	 * Search depth and time in milliseconds (0 for no limit) that
+	 * "go" uses when it's given no limits of its own.
+	 */
+	unsigned short		depth;
+
+	unsigned long		time;
+
+	/*
+	 * The computer player that is searching, or last searched.
+	 */
+/*@dependent@*/
+/*@null@*/
+	struct aiminimax *	aim;
+
+	/*
+	 * True while a search is running (or, with HT_POSIX, until its
+	 * thread has been joined).
+	 */
+	HT_BOOL			searching;
+
+	/*
+	 * True if the search was started by "ponder", and only ends on
+	 * "stop".
+	 */
+	HT_BOOL			ponder;
+
+	/*
+	 * Depth of the iteration that is being searched.
+	 */
+	unsigned short		depth_cur;
+
+	/*
+	 * Set to stop the search. It's aim->halt while searching, so the
+	 * search sees it at once, and is otherwise guarded by mutex.
+	 */
+	volatile HT_BOOL	stop;
+
+	/*
+	 * Guarded by mutex. Set when uie_ai_stop has told the search to
+	 * stop.
+	 */
+	HT_BOOL			halted;
+
+	/*
+	 * What the search returned.
+	 */
+	enum HT_FR		fr;
+
+#ifdef HT_POSIX
+	pthread_t		thread;
+
+	/*
+	 * Guards stop, halted and stdout.
+	 */
+	pthread_mutex_t		mutex;
+#endif
+
+};
+
+#endif
+
+#endif
+
@@ -1,3 +1,5 @@
+#ifdef HT_UI_MSQU
+
 #include "console.h"
 
 #include <pthread.h>
@@ -22,16 +24,8 @@ while (1) {
 }
 }*/
 
-FILE * DequeueMessageIntoTmpFile(FILE * fp)
-{
-   char * msg = DequeueMessage(); 
-   fputs(msg, fp);
-   fseek(fp, 0, 0);
-   puts(msg);
-   free(msg);
-   return fp;
-}
-
 void startStdinThread() {
 	//pthread_create(&g_handle_message_thread, NULL, &HandleMessageThread, NULL);
 }
+
+#endif
@@ -7,8 +7,6 @@
 //char* DequeueMessage();
 void startStdinThread();
 
-FILE * DequeueMessageIntoTmpFile(FILE * fp);
-
 #endif
 
 #endif
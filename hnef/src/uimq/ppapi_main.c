@@ -96,7 +96,8 @@ static void Messaging_HandleMessage(PP_Instance instance,
   if (!EnqueueMessage(strdup(buffer))) {
     struct PP_Var var;
     var = PrintfToVar(
-        "Warning: dropped message \"%s\" because the queue was full.", message);
+        "Warning: dropped message \"%s\" because it could not be queued.",
+        buffer);
     ppb_messaging_interface->PostMessage(g_instance, var);
   }
 }
@@ -370,7 +371,7 @@ game_main (void* user_data)
 {
 	while (1) {
 		game_do_main();
-		DequeueMessage();
+		free(DequeueMessage());
 	}
 }
 
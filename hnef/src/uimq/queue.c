@@ -7,8 +7,11 @@
 
 #include <pthread.h>
 #include <stdlib.h>
+#include <string.h>
 
-#define MAX_QUEUE_SIZE 16
+/** The capacity of |g_queue| when the first message is enqueued. The queue
+ * doubles whenever it is full, so no message is ever dropped. */
+#define INITIAL_QUEUE_CAPACITY 16
 
 /** A mutex that guards |g_queue|. */
 static pthread_mutex_t g_queue_mutex;
@@ -22,12 +25,15 @@ static pthread_cond_t g_queue_not_empty_cond;
  *   all elements in the range [g_queue_start, g_queue_end) are valid.
  * If g_queue_start > g_queue_end:
  *   all elements in the ranges [0, g_queue_end) and
- *   [g_queue_start, MAX_QUEUE_SIZE) are valid.
+ *   [g_queue_start, g_queue_capacity) are valid.
  * If g_queue_start == g_queue_end, and g_queue_size > 0:
  *   all elements in the g_queue are valid.
  * If g_queue_start == g_queue_end, and g_queue_size == 0:
  *   No elements are valid. */
-static char* g_queue[MAX_QUEUE_SIZE];
+static char** g_queue = NULL;
+
+/** The number of elements allocated for |g_queue|. */
+static int g_queue_capacity = 0;
 
 /** The index of the head of the queue. */
 static int g_queue_start = 0;
@@ -42,23 +48,62 @@ static int g_queue_size = 0;
  *
  * NOTE: this function assumes g_queue_mutex lock is held.
  * @return non-zero if the queue is empty. */
-static int IsQueueEmpty() { return g_queue_size == 0; }
+static int IsQueueEmpty(void) { return g_queue_size == 0; }
 
 /** Return whether the queue is full.
  *
  * NOTE: this function assumes g_queue_mutex lock is held.
  * @return non-zero if the queue is full. */
-static int IsQueueFull() { return g_queue_size == MAX_QUEUE_SIZE; }
+static int IsQueueFull(void) { return g_queue_size == g_queue_capacity; }
+
+/** Double the capacity of the queue, keeping the messages in order.
+ *
+ * The messages are moved to the start of the new array, so that
+ * g_queue_start is 0 afterwards.
+ *
+ * NOTE: this function assumes g_queue_mutex lock is held.
+ * @return non-zero if the queue could grow. */
+static int GrowQueue(void) {
+  int capacity = g_queue_capacity > 0
+      ? g_queue_capacity * 2 : INITIAL_QUEUE_CAPACITY;
+  int head = g_queue_capacity - g_queue_start;
+  char** queue = NULL;
+
+  if (capacity <= g_queue_capacity) {
+    return 0;
+  }
+  queue = malloc(sizeof(*queue) * (size_t)capacity);
+  if (queue == NULL) {
+    return 0;
+  }
+
+  if (g_queue_size > 0) {
+    if (head > g_queue_size) {
+      head = g_queue_size;
+    }
+    memcpy(queue, g_queue + g_queue_start, sizeof(*queue) * (size_t)head);
+    memcpy(queue + head, g_queue,
+           sizeof(*queue) * (size_t)(g_queue_size - head));
+  }
+  free(g_queue);
+
+  g_queue = queue;
+  g_queue_capacity = capacity;
+  g_queue_start = 0;
+  g_queue_end = g_queue_size;
+  return 1;
+}
 
 /** Initialize the message queue. */
-void InitializeMessageQueue() {
+void InitializeMessageQueue(void) {
   pthread_mutex_init(&g_queue_mutex, NULL);
   pthread_cond_init(&g_queue_not_empty_cond, NULL);
 }
 
 /** Enqueue a message (i.e. add to the end)
  *
- * If the queue is full, the message will be dropped.
+ * If the queue is full, it grows. The message is only dropped if the queue
+ * can not grow because memory runs out.
  *
  * NOTE: this function assumes g_queue_mutex is _NOT_ held.
  * @param[in] message The message to enqueue.
@@ -67,15 +112,15 @@ int EnqueueMessage(char* message) {
   pthread_mutex_lock(&g_queue_mutex);
 
   /* We shouldn't block the main thread waiting for the queue to not be full,
-   * so just drop the message. */
-  if (IsQueueFull()) {
+   * so grow it instead. */
+  if (IsQueueFull() && !GrowQueue()) {
     pthread_mutex_unlock(&g_queue_mutex);
     free(message);
     return 0;
   }
 
   g_queue[g_queue_end] = message;
-  g_queue_end = (g_queue_end + 1) % MAX_QUEUE_SIZE;
+  g_queue_end = (g_queue_end + 1) % g_queue_capacity;
   g_queue_size++;
 
   pthread_cond_signal(&g_queue_not_empty_cond);
@@ -92,7 +137,7 @@ int EnqueueMessage(char* message) {
  *
  * NOTE: this function assumes g_queue_mutex is _NOT_ held.
  * @return The message at the head of the queue. */
-char* DequeueMessage() {
+char* DequeueMessage(void) {
   char* message = NULL;
 
   pthread_mutex_lock(&g_queue_mutex);
@@ -102,7 +147,7 @@ char* DequeueMessage() {
   }
 
   message = g_queue[g_queue_start];
-  g_queue_start = (g_queue_start + 1) % MAX_QUEUE_SIZE;
+  g_queue_start = (g_queue_start + 1) % g_queue_capacity;
   g_queue_size--;
 
   pthread_mutex_unlock(&g_queue_mutex);
@@ -16,15 +16,16 @@
  *
  * We make the assumption that messages are only enqueued on the main thread
  * and consumed on the worker thread. Because we don't want to block the main
- * thread, EnqueueMessage will return zero if the message could not be enqueued.
+ * thread, the queue grows when it's full rather than waiting for the worker
+ * thread. EnqueueMessage will return zero only if the queue could not grow.
  *
  * DequeueMessage will block until a message is available using a condition
  * variable. Again, this may not be as fast as spin-waiting, but will consume
  * much less CPU (and battery), which is important to consider for ChromeOS
  * devices. */
 
-void InitializeMessageQueue();
+void InitializeMessageQueue(void);
 int EnqueueMessage(char* message);
-char* DequeueMessage();
+char* DequeueMessage(void);
 
 #endif /* QUEUE_H_ */
@@ -27,6 +27,7 @@
 #endif
 #include "board.h"		/* board_move_safe */
 #include "game.h"		/* game_board_reset */
+#include "grecord.h"		/* grecord_save, grecord_load */
 #include "lang.h"		/* HT_L_* */
 #include "num.h"		/* texttoushort */
 #include "iotextparse.h"	/* ht_line, ht_line_* */
@@ -87,6 +88,13 @@ print_help (void)
 	r = r < 0 ? r : printf("%c\t\t", HT_L_UIC_ARG_PRINT_BOARD);
 	r = r < 0 ? r : puts(HT_L_UIC_HELP_ARG_PRINT_BOARD);
 
+	r = r < 0 ? r : printf("%c file [%c]\t", HT_L_UIC_ARG_SAVE,
+		HT_L_UIC_ARG_SAVE_BIN);
+	r = r < 0 ? r : puts(HT_L_UIC_HELP_ARG_SAVE);
+
+	r = r < 0 ? r : printf("%c file\t\t", HT_L_UIC_ARG_LOAD);
+	r = r < 0 ? r : puts(HT_L_UIC_HELP_ARG_LOAD);
+
 	r = r < 0 ? r : printf("%c\t\t", HT_L_UIC_ARG_QUIT);
 	r = r < 0 ? r : puts(HT_L_UIC_HELP_ARG_QUIT);
 
@@ -590,6 +598,52 @@ cmd_human_finalize (
 	}
 }
 
+/*
+ * Translates the HT_UIMQ_ACT_SAVE ("s file" or "s file b") and
+ * HT_UIMQ_ACT_LOAD ("l file") commands. The file is the second word in
+ * line, which action_perform reads.
+ */
+static
+void
+cmd_human_interp_file (
+/*@in@*/
+/*@notnull@*/
+	const struct ht_line * const HT_RSTR	line,
+/*@in@*/
+/*@notnull@*/
+	struct ui_action * const HT_RSTR	act,
+/*@in@*/
+/*@notnull@*/
+	enum HT_UIMQ_ACTT * const HT_RSTR	act_sp
+	)
+/*@modifies * act, * act_sp@*/
+{
+	const char	arg_ch	= line->words[0].chars[0];
+	size_t		wordc	= line->wordc;
+
+	/*
+	 * Blanks at the end of the line leave an empty word.
+	 */
+	if ('\0' == line->words[wordc - 1].chars[0])
+	{
+		wordc--;
+	}
+
+	act->type	= HT_UI_ACT_UNK;
+	if ((size_t)2 == wordc)
+	{
+		act->type	= HT_UI_ACT_SPECIAL;
+		* act_sp	= HT_L_UIC_ARG_SAVE == arg_ch ?
+				HT_UIMQ_ACT_SAVE : HT_UIMQ_ACT_LOAD;
+	}
+	else if ((size_t)3 == wordc && HT_L_UIC_ARG_SAVE == arg_ch
+	&& HT_L_UIC_ARG_SAVE_BIN == line->words[2].chars[0])
+	{
+		act->type	= HT_UI_ACT_SPECIAL;
+		* act_sp	= HT_UIMQ_ACT_SAVE_BIN;
+	}
+}
+
 /*
  * Converts information in line to information in act (and possibly
  * act_sp, for CLI-specific commands) by looking at every word
@@ -625,6 +679,13 @@ cmd_human_interp (
 		return		HT_FR_SUCCESS;
 	}
 
+	if (HT_L_UIC_ARG_SAVE == line->words[0].chars[0]
+	|| HT_L_UIC_ARG_LOAD == line->words[0].chars[0])
+	{
+		cmd_human_interp_file(line, act, act_sp);
+		return	HT_FR_SUCCESS;
+	}
+
 	act_contr_index = act_contr_type = done		= HT_FALSE;
 
 	for (i = 0; i < line->wordc && !done; i++)
@@ -685,9 +746,15 @@ cmd_human (
 	fr	= HT_FR_NONE;
 #endif
 
-	FILE* fp = fopen("/hnef.tmp" , "w+");
-	DequeueMessageIntoTmpFile(fp);
-	fr	= ht_line_readline(fp, line);
+	/*
+	 * The words of line point into the message, which is therefore
+	 * kept in line_in until the next one is dequeued (action_perform
+	 * reads the file name from line).
+	 */
+	free	(interf->data.ui_mq->line_in);
+	interf->data.ui_mq->line_in	= DequeueMessage();
+	(void) puts(interf->data.ui_mq->line_in);
+	fr	= ht_line_readstr(interf->data.ui_mq->line_in, line);
 	if (HT_FR_SUCCESS != fr)
 	{
 		return	fr;
@@ -696,32 +763,85 @@ cmd_human (
 	fr	= HT_FR_NONE;
 #endif
 
-	if (0 != ferror(fp))
-	{
-		return		HT_FR_FAIL_IO_FILE_R;
-	}
-	else if (ht_line_empty(line))
+	if (ht_line_empty(line))
 	{
 		/*
 		 * Print help.
 		 */
 		act->type	= HT_UI_ACT_UNK;
-		fclose(fp);
 		return		HT_FR_SUCCESS;
 	}
 	else
 	{
-		fclose(fp);
 		return		cmd_human_interp(g, line, act, act_sp);
 	}
 }
 
+/*
+ * Saves g to file. Failing to write it is not an error.
+ */
+static
+enum HT_FR
+action_save (
+/*@in@*/
+/*@notnull@*/
+	const struct game * const	g,
+/*@in@*/
+/*@notnull@*/
+	const char * const		file,
+	const HT_BOOL			bin
+	)
+/*@globals fileSystem, errno, stdout@*/
+/*@modifies fileSystem, errno, stdout@*/
+{
+	const enum HT_FR fr	= grecord_save(g, file, bin);
+	if (HT_FR_FAIL_IO_FILE_W == fr)
+	{
+		return puts(HT_L_UIC_ACT_SAVE_FAIL) < 0 ?
+			HT_FR_FAIL_IO_PRINT : HT_FR_SUCCESS;
+	}
+	return	fr;
+}
+
+/*
+ * Loads the game in file into g, or leaves g as it was if file is not
+ * a valid game record for the ruleset.
+ */
+static
+enum HT_FR
+action_load (
+/*@in@*/
+/*@notnull@*/
+	struct game * const	g,
+/*@in@*/
+/*@notnull@*/
+	const char * const	file
+	)
+/*@globals fileSystem, errno, stdout@*/
+/*@modifies fileSystem, errno, stdout, * g@*/
+{
+	HT_BOOL		valid	= HT_FALSE;
+	const enum HT_FR fr	= grecord_load(g, file, & valid);
+	if (HT_FR_SUCCESS != fr)
+	{
+		return	fr;
+	}
+	if (!valid && puts(HT_L_UIC_ACT_LOAD_FAIL) < 0)
+	{
+		return	HT_FR_FAIL_IO_PRINT;
+	}
+	return	print_board(g);
+}
+
 static
 enum HT_FR
 action_perform (
 /*@in@*/
 /*@notnull@*/
 	struct game * const		g,
+/*@partial@*/
+/*@notnull@*/
+	const struct ht_line * const	line,
 /*@in@*/
 /*@notnull@*/
 	const struct ui_action * const	act,
@@ -820,6 +940,16 @@ action_perform (
 		{
 			return	print_players(g);
 		}
+		else if (HT_UIMQ_ACT_SAVE == * act_sp
+		||	HT_UIMQ_ACT_SAVE_BIN == * act_sp)
+		{
+			return	action_save(g, line->words[1].chars,
+				HT_UIMQ_ACT_SAVE_BIN == * act_sp);
+		}
+		else if (HT_UIMQ_ACT_LOAD == * act_sp)
+		{
+			return	action_load(g, line->words[1].chars);
+		}
 		else
 		{
 			return	HT_FR_FAIL_ENUM_UNK;
@@ -934,7 +1064,7 @@ player_action (
 		return	HT_FR_FAIL_ENUM_UNK;
 	}
 
-	return action_perform(g, act, & act_sp);
+	return action_perform(g, line, act, & act_sp);
 }
 
 /*
@@ -1198,7 +1328,7 @@ alloc_uimq (
 		return	NULL;
 	}
 	ui_mq->line_out = malloc(255);
-	ui_mq->line_in = malloc(64);
+	ui_mq->line_in = NULL;
 	if (NULL != g) {}	/* -Wunused */
 	return	ui_mq;
 }
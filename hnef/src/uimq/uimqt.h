@@ -39,7 +39,18 @@ enum HT_UIMQ_ACTT
 	/*
 	 * Print players.
 	 */
-	HT_UIMQ_ACT_PRINT_PLAYERS
+	HT_UIMQ_ACT_PRINT_PLAYERS,
+
+	/*
+	 * Save the game to a file, as a text or binary record.
+	 */
+	HT_UIMQ_ACT_SAVE,
+	HT_UIMQ_ACT_SAVE_BIN,
+
+	/*
+	 * Load a game from a file.
+	 */
+	HT_UIMQ_ACT_LOAD
 
 };
 
@@ -60,7 +71,8 @@ struct uimq
 	char * line_out;
 
 	/*
-	 * Line for storing a dequeued message.
+	 * The last dequeued message, which line is split from. NULL
+	 * until the first message.
 	 */
 	char * line_in;
 
@@ -0,0 +1,62 @@
+/* Copyright 2013 Alexander Söderlund.
+ *
+ * This file is part of HNEFATAFL.
+ *
+ * HNEFATAFL is free software: you can distribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * HNEFATAFL is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "fnv.h"
+
+/*
+ * FNV-1a (64-bit): returns h updated with len bytes. Start with
+ * HT_FNV_INIT, and pass the return value as h to hash more bytes.
+ *
+ * This is used for fingerprints (like ruleset->hash), not for anything
+ * that must resist attacks.
+ */
+HT_U64
+ht_fnv (
+	const HT_U64			h,
+	const char * const HT_RSTR	bytes,
+	const size_t			len
+	)
+{
+	HT_U64	hash	= h;
+	size_t	i;
+	for (i = (size_t)0; i < len; i++)
+	{
+		hash	^= (HT_U64)(unsigned char)bytes[i];
+		hash	*= HT_U64_C(0x00000100ul, 0x000001B3ul);
+	}
+	return	hash;
+}
+
+/*
+ * Writes h to out as HT_FNV_HEX_LEN lowercase hexadecimal digits and a
+ * terminating '\0'. out must have room for HT_FNV_HEX_LEN + 1 chars.
+ */
+void
+ht_fnv_hex (
+	const HT_U64		h,
+	char * const HT_RSTR	out
+	)
+{
+	const char * const	digits	= "0123456789abcdef";
+	unsigned short		i;
+	for (i = (unsigned short)0; i < (unsigned short)HT_FNV_HEX_LEN; i++)
+	{
+		out[i]	= digits[(h >> (4 * (HT_FNV_HEX_LEN - 1 - i)))
+			& (HT_U64)0xF];
+	}
+	out[HT_FNV_HEX_LEN]	= '\0';
+}
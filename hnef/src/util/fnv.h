@@ -0,0 +1,63 @@
+/* Copyright 2013 Alexander Söderlund.
+ *
+ * This file is part of HNEFATAFL.
+ *
+ * HNEFATAFL is free software: you can distribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * HNEFATAFL is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef HT_FNV_H
+#define HT_FNV_H
+
+#include <stdlib.h>	/* size_t */
+
+#include "config.h"	/* HT_RSTR */
+#include "rngt.h"	/* HT_U64 */
+
+/*
+ * Length of the string written by ht_fnv_hex, not counting '\0'.
+ */
+#define HT_FNV_HEX_LEN	16
+
+/*
+ * Initial value for ht_fnv.
+ */
+#define HT_FNV_INIT	HT_U64_C(0xCBF29CE4ul, 0x84222325ul)
+
+/*@-protoparamname@*/
+extern
+HT_U64
+ht_fnv (
+	const HT_U64		h,
+/*@in@*/
+/*@notnull@*/
+	const char * const HT_RSTR	bytes,
+	const size_t		len
+	)
+/*@modifies nothing@*/
+;
+/*@=protoparamname@*/
+
+/*@-protoparamname@*/
+extern
+void
+ht_fnv_hex (
+	const HT_U64		h,
+/*@out@*/
+/*@notnull@*/
+	char * const HT_RSTR	out
+	)
+/*@modifies * out@*/
+;
+/*@=protoparamname@*/
+
+#endif
@@ -36,6 +36,26 @@ fail_invoc_what (
 			return HT_L_FAIL_INVOC_UI_UNK;
 		case HT_FAIL_INVOC_RC_NONE:
 			return HT_L_FAIL_INVOC_RC_NONE;
+		case HT_FAIL_INVOC_RCACHE:
+			return HT_L_FAIL_INVOC_RCACHE;
+#ifdef HT_AI_MINIMAX
+		case HT_FAIL_INVOC_TUNE:
+			return HT_L_FAIL_INVOC_TUNE;
+		case HT_FAIL_INVOC_TOURN:
+			return HT_L_FAIL_INVOC_TOURN;
+		case HT_FAIL_INVOC_BATCH:
+			return HT_L_FAIL_INVOC_BATCH;
+		case HT_FAIL_INVOC_SERVE:
+			return HT_L_FAIL_INVOC_SERVE;
+#endif
+#ifdef HT_AI_MINIMAX_HASH
+		case HT_FAIL_INVOC_SEED:
+			return HT_L_FAIL_INVOC_SEED;
+		case HT_FAIL_INVOC_HASHMEM:
+			return HT_L_FAIL_INVOC_HASHMEM;
+		case HT_FAIL_INVOC_HASHFILE:
+			return HT_L_FAIL_INVOC_HASHFILE;
+#endif
 		case HT_FAIL_INVOC_NONE:
 		default:
 			return HT_L_FR_UNKNOWN;
@@ -133,6 +153,8 @@ fr_fail_what (
 			return HT_L_FR_FAIL_IO_ENV_UNDEF;
 		case HT_FR_FAIL_IO_FILE_R:
 			return HT_L_FR_FAIL_IO_FILE_R;
+		case HT_FR_FAIL_IO_FILE_W:
+			return HT_L_FR_FAIL_IO_FILE_W;
 		case HT_FR_FAIL_IO_PRINT:
 			return HT_L_FR_FAIL_IO_PRINT;
 		case HT_FR_FAIL_UI_NONE:
@@ -141,7 +163,8 @@ fr_fail_what (
 		case HT_FR_FAIL_POSIX:
 			return HT_L_FR_FAIL_POSIX;
 #endif
-#ifdef HT_UI_CLI
+#if defined(HT_UI_CLI) || defined(HT_UI_ENGINE) \
+	|| defined(HT_AI_MINIMAX)
 		case HT_FR_FAIL_IO_STDIN:
 			return HT_L_FR_FAIL_IO_STDIN;
 #endif
@@ -144,7 +144,61 @@ enum HT_FAIL_INVOC
 	/*
 	 * Failed to set invoc->file_rc.
 	 */
-	HT_FAIL_INVOC_RC_NONE
+	HT_FAIL_INVOC_RC_NONE,
+
+	/*
+	 * Failed to set invoc->file_rcache because no parameter was
+	 * given.
+	 */
+	HT_FAIL_INVOC_RCACHE
+
+#ifdef HT_AI_MINIMAX
+	,
+	/*
+	 * Failed to set invoc->file_tune because no parameter was
+	 * given.
+	 */
+	HT_FAIL_INVOC_TUNE,
+
+	/*
+	 * Failed to set invoc->file_tourn because no parameter was
+	 * given.
+	 */
+	HT_FAIL_INVOC_TOURN,
+
+	/*
+	 * Failed to set invoc->file_batch because no parameter was
+	 * given.
+	 */
+	HT_FAIL_INVOC_BATCH,
+
+	/*
+	 * Failed to set invoc->serve_threads because the parameter is
+	 * not a number.
+	 */
+	HT_FAIL_INVOC_SERVE
+#endif
+
+#ifdef HT_AI_MINIMAX_HASH
+	,
+	/*
+	 * Failed to set invoc->zobrist_seed because no parameter was
+	 * given, or because it's not a number.
+	 */
+	HT_FAIL_INVOC_SEED,
+
+	/*
+	 * Failed to set invoc->hash_mem because no parameter was given,
+	 * or because it's not a valid size in MiB.
+	 */
+	HT_FAIL_INVOC_HASHMEM,
+
+	/*
+	 * Failed to set invoc->hash_file because no parameter was
+	 * given.
+	 */
+	HT_FAIL_INVOC_HASHFILE
+#endif
 
 };
 
@@ -223,6 +277,11 @@ enum HT_FR
 	 */
 	HT_FR_FAIL_IO_FILE_R,
 
+	/*
+	 * Failed to write file for some reason.
+	 */
+	HT_FR_FAIL_IO_FILE_W,
+
 	/*
 	 * Failed to print to stdout using any function (puts, printf
 	 * or other). Also used for stderr failures and string
@@ -238,7 +297,8 @@ enum HT_FR
 	HT_FR_FAIL_POSIX,
 #endif
 
-#ifdef HT_UI_CLI
+#if defined(HT_UI_CLI) || defined(HT_UI_ENGINE) \
+	|| defined(HT_AI_MINIMAX)
 	/*
 	 * Failed to read from stdin using any function.
 	 */
@@ -17,7 +17,7 @@
  */
 #include <errno.h>	/* errno */
 #include <limits.h>	/* *_MAX */
-#include <stdlib.h>	/* strtoul */
+#include <stdlib.h>	/* strtoul, strtol */
 #include <string.h>	/* strlen */
 
 #include "num.h"
@@ -77,3 +77,55 @@ texttoushort (
 	return HT_TRUE;
 }
 
+/*
+ * Sets num to ULONG_MAX upon failure.
+ */
+HT_BOOL
+texttoulong (
+	const char * const HT_RSTR	str_num,
+	unsigned long * const HT_RSTR	num
+	)
+{
+	char *		str_end;
+	unsigned long	n;
+	int		errno_old	= errno;
+			errno		= 0;
+
+	n	= strtoul(str_num, & str_end, 10);
+	if (0 != errno		|| strlen(str_end) > 0
+	|| strlen(str_num) < (size_t)1	|| '-' == str_num[0])
+	{
+		errno	= errno_old;
+		* num	= ULONG_MAX;
+		return HT_FALSE;
+	}
+	* num	= n;
+	return HT_TRUE;
+}
+
+/*
+ * Sets num to 0 upon failure.
+ */
+HT_BOOL
+texttoint (
+	const char * const HT_RSTR	str_num,
+	int * const HT_RSTR		num
+	)
+{
+	char *	str_end;
+	long	n;
+	int	errno_old	= errno;
+		errno		= 0;
+
+	n	= strtol(str_num, & str_end, 10);
+	if (0 != errno		|| strlen(str_end) > 0
+	|| strlen(str_num) < (size_t)1
+	|| n < (long)INT_MIN	|| n > (long)INT_MAX)
+	{
+		errno	= errno_old;
+		* num	= 0;
+		return HT_FALSE;
+	}
+	* num	= (int)n;
+	return HT_TRUE;
+}
@@ -63,5 +63,37 @@ texttoushort (
 ;
 /*@=protoparamname@*/
 
+/*@-protoparamname@*/
+extern
+HT_BOOL
+texttoulong (
+/*@in@*/
+/*@notnull@*/
+	const char * const HT_RSTR	str_num,
+/*@out@*/
+/*@notnull@*/
+	unsigned long * const HT_RSTR	num
+	)
+/*@globals errno@*/
+/*@modifies errno, * num@*/
+;
+/*@=protoparamname@*/
+
+/*@-protoparamname@*/
+extern
+HT_BOOL
+texttoint (
+/*@in@*/
+/*@notnull@*/
+	const char * const HT_RSTR	str_num,
+/*@out@*/
+/*@notnull@*/
+	int * const HT_RSTR		num
+	)
+/*@globals errno@*/
+/*@modifies errno, * num@*/
+;
+/*@=protoparamname@*/
+
 #endif
 
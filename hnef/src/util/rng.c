@@ -0,0 +1,91 @@
+/* Copyright 2013 Alexander Söderlund.
+ *
+ * This file is part of HNEFATAFL.
+ *
+ * HNEFATAFL is free software: you can distribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * HNEFATAFL is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "rng.h"
+
+static
+HT_U64
+rotl (
+	const HT_U64	x,
+	const int	k
+	)
+/*@modifies nothing@*/
+{
+	return	(x << k) | (x >> (64 - k));
+}
+
+/*
+ * splitmix64: returns the next value of the sequence, and advances
+ * * x.
+ *
+ * Only used to expand the seed into the xoshiro256** state, since
+ * xoshiro256** must not have an all-zero state.
+ */
+static
+HT_U64
+splitmix64 (
+/*@notnull@*/
+	HT_U64 * const	x
+	)
+/*@modifies * x@*/
+{
+	HT_U64	z;
+	* x	+= HT_U64_C(0x9E3779B9ul, 0x7F4A7C15ul);
+	z	= * x;
+	z	= (z ^ (z >> 30)) * HT_U64_C(0xBF58476Dul, 0x1CE4E5B9ul);
+	z	= (z ^ (z >> 27)) * HT_U64_C(0x94D049BBul, 0x133111EBul);
+	return	z ^ (z >> 31);
+}
+
+/*
+ * Initializes rng from seed. Equal seeds give equal sequences.
+ */
+void
+ht_rng_seed (
+	struct ht_rng * const HT_RSTR	rng,
+	const unsigned long		seed
+	)
+{
+	HT_U64		x	= (HT_U64)seed;
+	unsigned short	i;
+	for (i = (unsigned short)0; i < (unsigned short)4; i++)
+	{
+		rng->s[i]	= splitmix64(& x);
+	}
+}
+
+/*
+ * Returns the next number from rng (xoshiro256**).
+ */
+HT_U64
+ht_rng_next (
+	struct ht_rng * const HT_RSTR	rng
+	)
+{
+	HT_U64 * const	s	= rng->s;
+	const HT_U64	result	= rotl(s[1] * 5, 7) * 9;
+	const HT_U64	t	= s[1] << 17;
+
+	s[2]	^= s[0];
+	s[3]	^= s[1];
+	s[1]	^= s[2];
+	s[0]	^= s[3];
+	s[2]	^= t;
+	s[3]	= rotl(s[3], 45);
+
+	return	result;
+}
@@ -0,0 +1,49 @@
+/* Copyright 2013 Alexander Söderlund.
+ *
+ * This file is part of HNEFATAFL.
+ *
+ * HNEFATAFL is free software: you can distribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * HNEFATAFL is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef HT_RNG_H
+#define HT_RNG_H
+
+#include "config.h"	/* HT_RSTR */
+#include "rngt.h"	/* ht_rng, HT_U64 */
+
+/*@-protoparamname@*/
+extern
+void
+ht_rng_seed (
+/*@out@*/
+/*@notnull@*/
+	struct ht_rng * const HT_RSTR	rng,
+	const unsigned long		seed
+	)
+/*@modifies * rng@*/
+;
+/*@=protoparamname@*/
+
+/*@-protoparamname@*/
+extern
+HT_U64
+ht_rng_next (
+/*@in@*/
+/*@notnull@*/
+	struct ht_rng * const HT_RSTR	rng
+	)
+/*@modifies * rng@*/
+;
+/*@=protoparamname@*/
+
+#endif
@@ -0,0 +1,69 @@
+/* Copyright 2013 Alexander Söderlund.
+ *
+ * This file is part of HNEFATAFL.
+ *
+ * HNEFATAFL is free software: you can distribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * HNEFATAFL is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef HT_RNG_T_H
+#define HT_RNG_T_H
+
+/*
+ * 64-bit unsigned integer. Used where the size must be exactly the same
+ * on every platform, such as in Zobrist keys.
+ *
+ * C99 has uint64_t. C89 has no 64-bit type, but unsigned long is 64
+ * bits on LP64 platforms, and GCC has unsigned long long as an
+ * extension. Refuse to compile if neither is available.
+ */
+#ifdef	HT_C99
+
+#include <stdint.h>	/* uint64_t */
+
+typedef uint64_t HT_U64;
+
+#else	/* HT_C99 */
+
+#include <limits.h>	/* ULONG_MAX */
+
+#if	(ULONG_MAX >> 16 >> 16) >= 4294967295ul
+typedef unsigned long HT_U64;
+#elif	defined(__GNUC__)
+__extension__ typedef unsigned long long HT_U64;
+#else
+#error	"No 64-bit unsigned integer type. Use HT_C99."
+#endif
+
+#endif	/* HT_C99 */
+
+/*
+ * Builds a 64-bit constant from two 32-bit halves, since C89 has no
+ * 64-bit integer constants.
+ */
+#define HT_U64_C(hi, lo) \
+	(((HT_U64)(hi) << 32) | (HT_U64)(lo))
+
+/*
+ * State of a xoshiro256** pseudo random number generator.
+ *
+ * Unlike rand, the sequence only depends on the seed given to
+ * ht_rng_seed, so it's the same on every platform and C library.
+ */
+struct ht_rng
+{
+
+	HT_U64	s[4];
+
+};
+
+#endif
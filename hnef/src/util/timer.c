@@ -0,0 +1,47 @@
+/* Copyright 2013 Alexander Söderlund.
+ *
+ * This file is part of HNEFATAFL.
+ *
+ * HNEFATAFL is free software: you can distribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * HNEFATAFL is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <time.h>	/* clock_gettime, clock */
+
+#include "timer.h"
+
+/*
+ * Returns a time in milliseconds, for measuring how long a search
+ * takes. Only the difference between two calls means anything.
+ *
+ * With HT_POSIX, this is a monotonic clock that every thread can use.
+ * Else it's the processor time of the program, which only measures a
+ * search correctly when it's the only thing that runs.
+ */
+unsigned long
+ht_timer_ms (void)
+{
+#ifdef HT_POSIX
+	struct timespec	ts;
+	if (0 != clock_gettime(CLOCK_MONOTONIC, & ts))
+	{
+		return	0ul;
+	}
+	return	(unsigned long)ts.tv_sec * 1000ul
+		+ (unsigned long)ts.tv_nsec / 1000000ul;
+#else
+	const clock_t	ticks	= clock();
+	return	(unsigned long)((double)ticks * 1000.0
+		/ (double)CLOCKS_PER_SEC);
+#endif
+}
+
@@ -44,13 +44,16 @@
 
 	const char * HT_L_FR_FAIL_IO_FILE_R = "Failed to read file.";
 
+	const char * HT_L_FR_FAIL_IO_FILE_W = "Failed to write file.";
+
 	const char * HT_L_FR_FAIL_IO_PRINT = "Failed to print.";
 
 #ifdef HT_POSIX
 	const char * HT_L_FR_FAIL_POSIX = "POSIX failure.";
 #endif
 
-#ifdef HT_UI_CLI
+#if defined(HT_UI_CLI) || defined(HT_UI_ENGINE) \
+	|| defined(HT_AI_MINIMAX)
 	const char * HT_L_FR_FAIL_IO_STDIN = "Failed to read stdin.";
 #endif
 
@@ -96,6 +99,31 @@
 	const char * HT_L_FAIL_INVOC_RC_NONE =
 		"RC file invocation parameter missing.";
 
+	const char * HT_L_FAIL_INVOC_RCACHE =
+		"Compiled ruleset file invocation parameter missing.";
+
+#ifdef HT_AI_MINIMAX
+	const char * HT_L_FAIL_INVOC_TUNE =
+		"Game record file invocation parameter missing.";
+	const char * HT_L_FAIL_INVOC_TOURN =
+		"Tournament file invocation parameter missing.";
+	const char * HT_L_FAIL_INVOC_BATCH =
+		"Batch file invocation parameter missing.";
+	const char * HT_L_FAIL_INVOC_SERVE =
+		"Server thread amount invocation parameter invalid.";
+#endif
+
+#ifdef HT_AI_MINIMAX_HASH
+	const char * HT_L_FAIL_INVOC_SEED =
+		"Seed invocation parameter missing or invalid.";
+
+	const char * HT_L_FAIL_INVOC_HASHMEM =
+		"Transposition table size parameter missing or invalid.";
+
+	const char * HT_L_FAIL_INVOC_HASHFILE =
+		"Transposition table file invocation parameter missing.";
+#endif
+
 /***********************************************************************
  * Invocation parameter switches.
  *
@@ -109,8 +137,21 @@
 	const char HT_L_INV_S_HELP	= 'h';
 	const char HT_L_INV_S_NINE	= '9';
 	const char HT_L_INV_S_RUNCOM	= 'r';
+	const char HT_L_INV_S_RCACHE	= 'k';
 	const char HT_L_INV_S_UI	= 'i';
 	const char HT_L_INV_S_VERSION	= 'v';
+#ifdef HT_AI_MINIMAX
+	const char HT_L_INV_S_BENCH	= 'b';
+	const char HT_L_INV_S_TUNE	= 'w';
+	const char HT_L_INV_S_TOURN	= 'a';
+	const char HT_L_INV_S_BATCH	= 'e';
+	const char HT_L_INV_S_SERVE	= 'g';
+#endif
+#ifdef HT_AI_MINIMAX_HASH
+	const char HT_L_INV_S_SEED	= 's';
+	const char HT_L_INV_S_HASHMEM	= 'm';
+	const char HT_L_INV_S_HASHFILE	= 't';
+#endif
 #ifdef HT_UI_CLI
 	const char HT_L_INV_S_UI_CLI		= 'c';
 #endif
@@ -120,6 +161,9 @@
 #ifdef HT_UI_MSQU
 	const char HT_L_INV_S_UI_MSQU		= 'm';
 #endif
+#ifdef HT_UI_ENGINE
+	const char HT_L_INV_S_UI_ENGINE		= 'e';
+#endif
 
 /***********************************************************************
  * Invocation parameter help.
@@ -131,12 +175,28 @@
 
 	const char * HT_L_INV_HELP_S_RUNCOM = "RC file";
 
+	const char * HT_L_INV_HELP_S_RCACHE = "Compiled ruleset file";
+
 	const char * HT_L_INV_HELP_S_VERSION = "Print version";
 
 	const char * HT_L_INV_HELP_S_UI = "User interface";
 
 	const char * HT_L_INV_HELP_S_UI_DEF = " (default)";
 
+#ifdef HT_AI_MINIMAX
+	const char * HT_L_INV_HELP_S_BENCH = "Run search benchmark";
+	const char * HT_L_INV_HELP_S_TUNE = "Tune evaluation weights to game records";
+	const char * HT_L_INV_HELP_S_TOURN = "Play a tournament between two computer players";
+	const char * HT_L_INV_HELP_S_BATCH = "Analyze positions in game records";
+	const char * HT_L_INV_HELP_S_SERVE = "Host games for clients on stdin and stdout";
+#endif
+
+#ifdef HT_AI_MINIMAX_HASH
+	const char * HT_L_INV_HELP_S_SEED = "Zobrist seed";
+	const char * HT_L_INV_HELP_S_HASHMEM = "Transposition table size in MiB";
+	const char * HT_L_INV_HELP_S_HASHFILE = "Transposition table file";
+#endif
+
 #ifdef HT_UI_CLI
 	const char * HT_L_INV_HELP_S_UI_CLI = "Command line";
 #endif
@@ -148,6 +208,11 @@
 #ifdef HT_UI_MSQU
 	const char * HT_L_INV_HELP_S_UI_MSQU = "Message Queue";
 #endif
+
+#ifdef HT_UI_ENGINE
+	const char * HT_L_INV_HELP_S_UI_ENGINE = "Engine protocol";
+#endif
+
 /***********************************************************************
  * Function Return failure detail for HT_FR_FAIL_RREADER.
  **********************************************************************/
@@ -193,6 +258,58 @@
 	const char * HT_L_RREADER_CMD_PIECE	= "piece";
 	const char * HT_L_RREADER_CMD_PIECES	= "pieces";
 	const char * HT_L_RREADER_CMD_FREPEAT	= "forbid_repeat";
+#ifdef HT_AI_MINIMAX_HASH
+	const char * HT_L_RREADER_CMD_ZSEED	= "zobrist_seed";
+	const char * HT_L_RREADER_CMD_HASHMEM	= "hash_mem";
+#endif
+#ifdef HT_AI_MINIMAX
+	const char * HT_L_AIMEVAL_CMD_PIECE		= "piece";
+	const char * HT_L_AIMEVAL_CMD_MOVE_KING		= "move_king";
+	const char * HT_L_AIMEVAL_CMD_ESCVAL_KING	= "escval_king";
+	const char * HT_L_AIMEVAL_CMD_ESCVAL_NORM	= "escval_norm";
+	const char * HT_L_AIMEVAL_CMD_KING_ESCDIST	= "king_escdist";
+	const char * HT_L_AIMEVAL_CMD_KING_ATTACKERS	= "king_attackers";
+	const char * HT_L_AIMEVAL_CMD_EDGE		= "edge";
+	const char * HT_L_AIMEVAL_CMD_CORNER		= "corner";
+	const char * HT_L_AIMEVAL_CMD_PSQ		= "psq";
+
+	const char * HT_L_TUNE_FAIL_GAME =
+		"Invalid game record.";
+	const char * HT_L_TUNE_FAIL_EMPTY =
+		"No positions in the game records.";
+
+	const char * HT_L_TOURN_CMD_GAMES	= "games";
+	const char * HT_L_TOURN_CMD_DEPTH	= "depth";
+	const char * HT_L_TOURN_CMD_TIME	= "time";
+	const char * HT_L_TOURN_CMD_WEIGHTS	= "weights";
+	const char * HT_L_TOURN_CMD_OPENING	= "opening";
+	const char * HT_L_TOURN_CMD_SEED	= "seed";
+	const char * HT_L_TOURN_CMD_PLIES	= "plies";
+	const char * HT_L_TOURN_CMD_SPRT	= "sprt";
+	const char * HT_L_TOURN_CMD_THREADS	= "threads";
+
+	const char * HT_L_BATCH_CMD_DEPTH	= "depth";
+	const char * HT_L_BATCH_CMD_TIME	= "time";
+	const char * HT_L_BATCH_CMD_THREADS	= "threads";
+	const char * HT_L_BATCH_CMD_RECORD	= "record";
+	const char * HT_L_BATCH_FAIL_RECORD =
+		"Invalid game record, or no position at the ply.";
+
+	const char * HT_L_SERVE_CMD_NEW		= "new";
+	const char * HT_L_SERVE_CMD_MOVE	= "move";
+	const char * HT_L_SERVE_CMD_GO		= "go";
+	const char * HT_L_SERVE_CMD_DEPTH	= "depth";
+	const char * HT_L_SERVE_CMD_TIME	= "time";
+	const char * HT_L_SERVE_CMD_FREE	= "free";
+	const char * HT_L_SERVE_CMD_STATS	= "stats";
+	const char * HT_L_SERVE_CMD_QUIT	= "quit";
+	const char * HT_L_SERVE_ERR_CMD		= "Unknown command.";
+	const char * HT_L_SERVE_ERR_ARG		= "Invalid argument.";
+	const char * HT_L_SERVE_ERR_GAME	= "No such game.";
+	const char * HT_L_SERVE_ERR_MOVE	= "Illegal move.";
+	const char * HT_L_SERVE_ERR_BUSY	= "The computer player is moving.";
+	const char * HT_L_SERVE_ERR_RULES	= "Invalid ruleset.";
+#endif
 	const char * HT_L_RREADER_CMD_SQUARE	= "square";
 	const char * HT_L_RREADER_CMD_SQUARES	= "squares";
 
@@ -267,6 +384,18 @@
 	const char * HT_L_UIC_ACT_CONTR_ILL =
 		"Illegal player arguments.";
 
+	const char * HT_L_UIC_ACT_SAVE_FAIL = "Could not save game.";
+
+	const char * HT_L_UIC_ACT_LOAD_FAIL = "Could not load game.";
+
+#ifdef HT_AI_MINIMAX_HASH
+	const char * HT_L_UIC_ACT_HASH_SET =
+		"Hash table size changed from the next game.";
+
+	const char * HT_L_UIC_ACT_HASH_ILL =
+		"Invalid hash table size.";
+#endif
+
 	const char * HT_L_UIC_ACT_PLAYERS_HUMAN = "Human";
 
 #ifdef HT_AI_MINIMAX
@@ -293,6 +422,15 @@
 
 	const char * HT_L_UIC_HELP_ARG_PRINT_BOARD = "Print board.";
 
+	const char * HT_L_UIC_HELP_ARG_SAVE = "Save game to file.";
+
+	const char * HT_L_UIC_HELP_ARG_LOAD = "Load game from file.";
+
+#ifdef HT_AI_MINIMAX_HASH
+	const char * HT_L_UIC_HELP_ARG_HASH =
+		"Set hash table size in MiB.";
+#endif
+
 	const char * HT_L_UIC_HELP_ARG_QUIT = "Quit.";
 
 /***********************************************************************
@@ -310,6 +448,9 @@
  *
  * HT_L_UIC_ARG_Q_* may equal HT_L_UIC_ARG_CONTR_*.
  *
+ * HT_L_UIC_ARG_SAVE_BIN may equal any other, since it's only read as
+ * an argument to HT_L_UIC_ARG_SAVE.
+ *
  * "Print help" doesn't have a char, since help is printed on all
  * unrecognized chars in an "else" block using exactly the same logic.
  * Thus all other chars than the ones defined below work like "print
@@ -319,6 +460,12 @@
 	const char HT_L_UIC_ARG_CONTR		= 'p';
 	const char HT_L_UIC_ARG_MOVE		= 'm';
 	const char HT_L_UIC_ARG_PRINT_BOARD	= 'b';
+	const char HT_L_UIC_ARG_SAVE		= 's';
+	const char HT_L_UIC_ARG_SAVE_BIN	= 'b';
+	const char HT_L_UIC_ARG_LOAD		= 'l';
+#ifdef HT_AI_MINIMAX_HASH
+	const char HT_L_UIC_ARG_HASH		= 't';
+#endif
 	const char HT_L_UIC_ARG_QUIT		    = 'q';
 	const char HT_L_UIC_ARG_Q_YES			= 'y';
 	const char HT_L_UIC_ARG_Q_NO			= 'n';
@@ -368,3 +515,34 @@
 
 #endif /* HT_UI_XLIB */
 
+/***********************************************************************
+ * Engine protocol.
+ *
+ * The commands are the same in every language, so that programs can use
+ * the engine whatever language it's compiled with.
+ **********************************************************************/
+
+#ifdef HT_UI_ENGINE
+
+	const char * HT_L_UIE_CMD_HNEF		= "hnef";
+	const char * HT_L_UIE_CMD_ISREADY	= "isready";
+	const char * HT_L_UIE_CMD_NEWGAME	= "newgame";
+	const char * HT_L_UIE_CMD_POSITION	= "position";
+	const char * HT_L_UIE_CMD_MOVES		= "moves";
+	const char * HT_L_UIE_CMD_RECORD	= "record";
+	const char * HT_L_UIE_CMD_GO		= "go";
+	const char * HT_L_UIE_CMD_DEPTH		= "depth";
+	const char * HT_L_UIE_CMD_TIME		= "time";
+	const char * HT_L_UIE_CMD_PONDER	= "ponder";
+	const char * HT_L_UIE_CMD_STOP		= "stop";
+	const char * HT_L_UIE_CMD_SETOPTION	= "setoption";
+	const char * HT_L_UIE_CMD_HASH		= "hash";
+	const char * HT_L_UIE_CMD_QUIT		= "quit";
+
+	const char * HT_L_UIE_ERR_CMD = "Unknown command.";
+	const char * HT_L_UIE_ERR_ARG = "Invalid argument.";
+	const char * HT_L_UIE_ERR_MOVE = "Illegal move.";
+	const char * HT_L_UIE_ERR_RECORD = "Invalid game record.";
+
+#endif /* HT_UI_ENGINE */
+
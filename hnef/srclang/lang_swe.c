@@ -44,13 +44,16 @@
 
 	const char * HT_L_FR_FAIL_IO_FILE_R = "Kunde inte läsa fil.";
 
+	const char * HT_L_FR_FAIL_IO_FILE_W = "Kunde inte skriva fil.";
+
 	const char * HT_L_FR_FAIL_IO_PRINT = "Kunde inte skriva ut.";
 
 #ifdef HT_POSIX
 	const char * HT_L_FR_FAIL_POSIX = "Fel i POSIX.";
 #endif
 
-#ifdef HT_UI_CLI
+#if defined(HT_UI_CLI) || defined(HT_UI_ENGINE) \
+	|| defined(HT_AI_MINIMAX)
 	const char * HT_L_FR_FAIL_IO_STDIN = "Kunde inte läsa stdin.";
 #endif
 
@@ -96,6 +99,31 @@
 	const char * HT_L_FAIL_INVOC_RC_NONE =
 		"Startargument för regelfil saknas.";
 
+	const char * HT_L_FAIL_INVOC_RCACHE =
+		"Startargument för kompilerad regelfil saknas.";
+
+#ifdef HT_AI_MINIMAX
+	const char * HT_L_FAIL_INVOC_TUNE =
+		"Startargument för partiprotokollfil saknas.";
+	const char * HT_L_FAIL_INVOC_TOURN =
+		"Startargument för turneringsfil saknas.";
+	const char * HT_L_FAIL_INVOC_BATCH =
+		"Startargument för analysfil saknas.";
+	const char * HT_L_FAIL_INVOC_SERVE =
+		"Ogiltigt startargument för antal trådar i servern.";
+#endif
+
+#ifdef HT_AI_MINIMAX_HASH
+	const char * HT_L_FAIL_INVOC_SEED =
+		"Startargument för frö saknas eller är ogiltigt.";
+
+	const char * HT_L_FAIL_INVOC_HASHMEM =
+		"Startargument för tabellstorlek saknas eller är ogiltigt.";
+
+	const char * HT_L_FAIL_INVOC_HASHFILE =
+		"Startargument för transpositionstabellens fil saknas.";
+#endif
+
 /***********************************************************************
  * Invocation parameter switches.
  *
@@ -109,8 +137,21 @@
 	const char HT_L_INV_S_HELP	= 'h';
 	const char HT_L_INV_S_NINE	= '9';
 	const char HT_L_INV_S_RUNCOM	= 'r';
+	const char HT_L_INV_S_RCACHE	= 'k';
 	const char HT_L_INV_S_UI	= 'i';
 	const char HT_L_INV_S_VERSION	= 'v';
+#ifdef HT_AI_MINIMAX
+	const char HT_L_INV_S_BENCH	= 'b';
+	const char HT_L_INV_S_TUNE	= 'w';
+	const char HT_L_INV_S_TOURN	= 'a';
+	const char HT_L_INV_S_BATCH	= 'e';
+	const char HT_L_INV_S_SERVE	= 'g';
+#endif
+#ifdef HT_AI_MINIMAX_HASH
+	const char HT_L_INV_S_SEED	= 's';
+	const char HT_L_INV_S_HASHMEM	= 'm';
+	const char HT_L_INV_S_HASHFILE	= 't';
+#endif
 #ifdef HT_UI_CLI
 	const char HT_L_INV_S_UI_CLI		= 'c';
 #endif
@@ -120,6 +161,9 @@
 #ifdef HT_UI_MSQU
 	const char HT_L_INV_S_UI_MSQU		= 'm';
 #endif
+#ifdef HT_UI_ENGINE
+	const char HT_L_INV_S_UI_ENGINE		= 'e';
+#endif
 
 /***********************************************************************
  * Invocation parameter help.
@@ -131,12 +175,28 @@
 
 	const char * HT_L_INV_HELP_S_RUNCOM = "Regelfil";
 
+	const char * HT_L_INV_HELP_S_RCACHE = "Kompilerad regelfil";
+
 	const char * HT_L_INV_HELP_S_VERSION = "Skriv ut version";
 
 	const char * HT_L_INV_HELP_S_UI = "Användargränssnitt";
 
 	const char * HT_L_INV_HELP_S_UI_DEF = " (förval)";
 
+#ifdef HT_AI_MINIMAX
+	const char * HT_L_INV_HELP_S_BENCH = "Kör sökprestandatest";
+	const char * HT_L_INV_HELP_S_TUNE = "Anpassa värderingsvikter till partiprotokoll";
+	const char * HT_L_INV_HELP_S_TOURN = "Spela en turnering mellan två datorspelare";
+	const char * HT_L_INV_HELP_S_BATCH = "Analysera ställningar i partiprotokoll";
+	const char * HT_L_INV_HELP_S_SERVE = "Driv partier åt klienter på stdin och stdout";
+#endif
+
+#ifdef HT_AI_MINIMAX_HASH
+	const char * HT_L_INV_HELP_S_SEED = "Zobrist-frö";
+	const char * HT_L_INV_HELP_S_HASHMEM = "Transpositionstabellens storlek i MiB";
+	const char * HT_L_INV_HELP_S_HASHFILE = "Transpositionstabellens fil";
+#endif
+
 #ifdef HT_UI_CLI
 	const char * HT_L_INV_HELP_S_UI_CLI = "Kommandorad";
 #endif
@@ -148,6 +208,11 @@
 #ifdef HT_UI_MSQU
 	const char * HT_L_INV_HELP_S_UI_MSQU = "meddelandekön";
 #endif
+
+#ifdef HT_UI_ENGINE
+	const char * HT_L_INV_HELP_S_UI_ENGINE = "motorprotokoll";
+#endif
+
 /***********************************************************************
  * Function Return failure detail for HT_FR_FAIL_RREADER.
  **********************************************************************/
@@ -190,6 +255,58 @@
 	const char * HT_L_RREADER_CMD_PIECE	= "piece";
 	const char * HT_L_RREADER_CMD_PIECES	= "pieces";
 	const char * HT_L_RREADER_CMD_FREPEAT	= "forbid_repeat";
+#ifdef HT_AI_MINIMAX_HASH
+	const char * HT_L_RREADER_CMD_ZSEED	= "zobrist_seed";
+	const char * HT_L_RREADER_CMD_HASHMEM	= "hash_mem";
+#endif
+#ifdef HT_AI_MINIMAX
+	const char * HT_L_AIMEVAL_CMD_PIECE		= "piece";
+	const char * HT_L_AIMEVAL_CMD_MOVE_KING		= "move_king";
+	const char * HT_L_AIMEVAL_CMD_ESCVAL_KING	= "escval_king";
+	const char * HT_L_AIMEVAL_CMD_ESCVAL_NORM	= "escval_norm";
+	const char * HT_L_AIMEVAL_CMD_KING_ESCDIST	= "king_escdist";
+	const char * HT_L_AIMEVAL_CMD_KING_ATTACKERS	= "king_attackers";
+	const char * HT_L_AIMEVAL_CMD_EDGE		= "edge";
+	const char * HT_L_AIMEVAL_CMD_CORNER		= "corner";
+	const char * HT_L_AIMEVAL_CMD_PSQ		= "psq";
+
+	const char * HT_L_TUNE_FAIL_GAME =
+		"Ogiltigt partiprotokoll.";
+	const char * HT_L_TUNE_FAIL_EMPTY =
+		"Inga ställningar i partiprotokollen.";
+
+	const char * HT_L_TOURN_CMD_GAMES	= "games";
+	const char * HT_L_TOURN_CMD_DEPTH	= "depth";
+	const char * HT_L_TOURN_CMD_TIME	= "time";
+	const char * HT_L_TOURN_CMD_WEIGHTS	= "weights";
+	const char * HT_L_TOURN_CMD_OPENING	= "opening";
+	const char * HT_L_TOURN_CMD_SEED	= "seed";
+	const char * HT_L_TOURN_CMD_PLIES	= "plies";
+	const char * HT_L_TOURN_CMD_SPRT	= "sprt";
+	const char * HT_L_TOURN_CMD_THREADS	= "threads";
+
+	const char * HT_L_BATCH_CMD_DEPTH	= "depth";
+	const char * HT_L_BATCH_CMD_TIME	= "time";
+	const char * HT_L_BATCH_CMD_THREADS	= "threads";
+	const char * HT_L_BATCH_CMD_RECORD	= "record";
+	const char * HT_L_BATCH_FAIL_RECORD =
+		"Ogiltigt partiprotokoll, eller ingen ställning vid halvdraget.";
+
+	const char * HT_L_SERVE_CMD_NEW		= "new";
+	const char * HT_L_SERVE_CMD_MOVE	= "move";
+	const char * HT_L_SERVE_CMD_GO		= "go";
+	const char * HT_L_SERVE_CMD_DEPTH	= "depth";
+	const char * HT_L_SERVE_CMD_TIME	= "time";
+	const char * HT_L_SERVE_CMD_FREE	= "free";
+	const char * HT_L_SERVE_CMD_STATS	= "stats";
+	const char * HT_L_SERVE_CMD_QUIT	= "quit";
+	const char * HT_L_SERVE_ERR_CMD		= "Okänt kommando.";
+	const char * HT_L_SERVE_ERR_ARG		= "Ogiltigt argument.";
+	const char * HT_L_SERVE_ERR_GAME	= "Inget sådant parti.";
+	const char * HT_L_SERVE_ERR_MOVE	= "Ogiltigt drag.";
+	const char * HT_L_SERVE_ERR_BUSY	= "Datorspelaren drar.";
+	const char * HT_L_SERVE_ERR_RULES	= "Ogiltiga regler.";
+#endif
 	const char * HT_L_RREADER_CMD_SQUARE	= "square";
 	const char * HT_L_RREADER_CMD_SQUARES	= "squares";
 
@@ -265,6 +382,18 @@
 	const char * HT_L_UIC_ACT_CONTR_ILL =
 		"Otillåtna argument för spelare.";
 
+	const char * HT_L_UIC_ACT_SAVE_FAIL = "Kunde inte spara spelet.";
+
+	const char * HT_L_UIC_ACT_LOAD_FAIL = "Kunde inte ladda spelet.";
+
+#ifdef HT_AI_MINIMAX_HASH
+	const char * HT_L_UIC_ACT_HASH_SET =
+		"Hashtabellens storlek ändrad från nästa parti.";
+
+	const char * HT_L_UIC_ACT_HASH_ILL =
+		"Ogiltig storlek på hashtabellen.";
+#endif
+
 	const char * HT_L_UIC_ACT_PLAYERS_HUMAN = "Människa";
 
 #ifdef HT_AI_MINIMAX
@@ -292,6 +421,15 @@
 
 	const char * HT_L_UIC_HELP_ARG_PRINT_BOARD = "Skriv ut bräde.";
 
+	const char * HT_L_UIC_HELP_ARG_SAVE = "Spara spelet till fil.";
+
+	const char * HT_L_UIC_HELP_ARG_LOAD = "Ladda spel från fil.";
+
+#ifdef HT_AI_MINIMAX_HASH
+	const char * HT_L_UIC_HELP_ARG_HASH =
+		"Sätt hashtabellens storlek i MiB.";
+#endif
+
 	const char * HT_L_UIC_HELP_ARG_QUIT = "Avsluta.";
 
 /***********************************************************************
@@ -309,6 +447,9 @@
  *
  * HT_L_UIC_ARG_Q_* may equal HT_L_UIC_ARG_CONTR_*.
  *
+ * HT_L_UIC_ARG_SAVE_BIN may equal any other, since it's only read as
+ * an argument to HT_L_UIC_ARG_SAVE.
+ *
  * "Print help" doesn't have a char, since help is printed on all
  * unrecognized chars in an "else" block using exactly the same logic.
  * Thus all other chars than the ones defined below work like "print
@@ -318,6 +459,12 @@
 	const char HT_L_UIC_ARG_CONTR		= 'p';
 	const char HT_L_UIC_ARG_MOVE		= 'm';
 	const char HT_L_UIC_ARG_PRINT_BOARD	= 'b';
+	const char HT_L_UIC_ARG_SAVE		= 's';
+	const char HT_L_UIC_ARG_SAVE_BIN	= 'b';
+	const char HT_L_UIC_ARG_LOAD		= 'l';
+#ifdef HT_AI_MINIMAX_HASH
+	const char HT_L_UIC_ARG_HASH		= 't';
+#endif
 	const char HT_L_UIC_ARG_QUIT		    = 'q';
 	const char HT_L_UIC_ARG_Q_YES			= 'y';
 	const char HT_L_UIC_ARG_Q_NO			= 'n';
@@ -367,3 +514,34 @@
 
 #endif /* HT_UI_XLIB */
 
+/***********************************************************************
+ * Engine protocol.
+ *
+ * The commands are the same in every language, so that programs can use
+ * the engine whatever language it's compiled with.
+ **********************************************************************/
+
+#ifdef HT_UI_ENGINE
+
+	const char * HT_L_UIE_CMD_HNEF		= "hnef";
+	const char * HT_L_UIE_CMD_ISREADY	= "isready";
+	const char * HT_L_UIE_CMD_NEWGAME	= "newgame";
+	const char * HT_L_UIE_CMD_POSITION	= "position";
+	const char * HT_L_UIE_CMD_MOVES		= "moves";
+	const char * HT_L_UIE_CMD_RECORD	= "record";
+	const char * HT_L_UIE_CMD_GO		= "go";
+	const char * HT_L_UIE_CMD_DEPTH		= "depth";
+	const char * HT_L_UIE_CMD_TIME		= "time";
+	const char * HT_L_UIE_CMD_PONDER	= "ponder";
+	const char * HT_L_UIE_CMD_STOP		= "stop";
+	const char * HT_L_UIE_CMD_SETOPTION	= "setoption";
+	const char * HT_L_UIE_CMD_HASH		= "hash";
+	const char * HT_L_UIE_CMD_QUIT		= "quit";
+
+	const char * HT_L_UIE_ERR_CMD = "Okänt kommando.";
+	const char * HT_L_UIE_ERR_ARG = "Ogiltigt argument.";
+	const char * HT_L_UIE_ERR_MOVE = "Ogiltigt drag.";
+	const char * HT_L_UIE_ERR_RECORD = "Ogiltigt partiprotokoll.";
+
+#endif /* HT_UI_ENGINE */
+